@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -35,6 +35,11 @@ source distribution.
 
 namespace cro
 {
+    namespace Detail
+    {
+        class AudioDecoder;
+    }
+
     /*!
     \brief Buffers audio data used by AudioEmitter components.
     AudioBuffers are the audio equivalent to textures, as AudioEmitters
@@ -67,6 +72,38 @@ namespace cro
         */
         bool loadFromFile(const std::string&) override;
 
+        /*!
+        \brief Loads a file from the given path, decoding it on a worker thread.
+        This returns immediately, and the buffer can be used straight away by
+        AudioEmitters, although it will play silence until the file has been
+        decoded. Once the data is ready any AudioEmitters using this buffer are
+        automatically updated. Supports the same formats as loadFromFile()
+        \returns false if the buffer could not be created, else true. Note that
+        this does not mean the file will load successfully: if decoding fails
+        an error is logged and the buffer remains silent.
+        \see isLoading()
+        */
+        bool loadFromFileAsync(const std::string&);
+
+        /*!
+        \brief Returns true if the buffer is waiting for data requested
+        with loadFromFileAsync() to be decoded.
+        */
+        bool isLoading() const { return m_loading; }
+
+        /*!
+        \brief Sets a directory in which to cache decoded *.ogg and *.mp3 files.
+        When set, the first time a compressed file is loaded its decoded data is
+        written to this directory. Subsequent loads of the file, including those
+        in later sessions, map the decoded data directly from the cache instead
+        of decoding the file again. Cache entries are invalidated automatically
+        if the source file is modified. By default this is empty and caching is
+        disabled.
+        \param path Absolute path to the cache directory, such as one in the
+        user's preference directory. It is created if it doesn't exist.
+        */
+        static void setCacheDirectory(const std::string& path);
+
         /*!
         \brief Attempts to load the buffer with data stored in memory.
         Data should be uncompressed PCM audio in either mono or stereo
@@ -91,6 +128,10 @@ namespace cro
         AudioSource::Type getType() const override { return AudioSource::Type::Buffer; }
 
     private:
+        bool m_loading;
 
+        void releaseBuffer();
+        void onAsyncLoad(std::int32_t bufferID);
+        friend class Detail::AudioDecoder;
     };
 }
\ No newline at end of file
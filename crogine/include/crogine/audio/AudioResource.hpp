@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -80,6 +80,31 @@ namespace cro
         */
         std::int32_t load(const std::string& path, bool streaming = false);
 
+        /*!
+        \brief Loads an audio file into a buffer on a worker thread and maps it to the given ID.
+        The buffer is available immediately and plays silence until decoding is complete.
+        \param id Unique ID to map to the new buffer. If the ID is in use this will fail.
+        \param path String containing the path to the file to load.
+        \returns true if the buffer was created, else false. Failure to decode the
+        file is only reported in the log.
+        \see AudioBuffer::loadFromFileAsync()
+        */
+        bool loadAsync(std::int32_t id, const std::string& path);
+
+        /*!
+        \brief Loads an audio file into a buffer on a worker thread and returns an auto-mapped ID.
+        As with load() the ID of an existing buffer is returned if the path has already been loaded.
+        \param path String containing the path to the file to load.
+        \returns an integer ID, or -1 if the buffer could not be created
+        \see AudioBuffer::loadFromFileAsync()
+        */
+        std::int32_t loadAsync(const std::string& path);
+
+        /*!
+        \brief Returns true if any buffers are still waiting for their data to be decoded
+        */
+        bool isLoading() const;
+
         /*!
         \brief Attempts to return the loaded data mapped to the given ID
         If the requested ID is not found an empty buffer will be returned
@@ -88,6 +113,9 @@ namespace cro
 
     private:
 
+        bool loadSource(std::int32_t id, const std::string& path, bool streaming, bool async);
+        std::int32_t loadAutoID(const std::string& path, bool streaming, bool async);
+
         std::unique_ptr<AudioSource> m_fallback;
         std::unordered_map<std::int32_t, std::unique_ptr<AudioSource>> m_sources;
         std::unordered_map<std::string, std::int32_t> m_usedPaths;
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -79,6 +79,9 @@ namespace cro
         void removeUser(AudioEmitter*) const;
         void resetUsers();
 
+        //notifies users that the ID of this source has changed
+        void updateUsers();
+
     private:
         std::int32_t m_id;
         mutable std::vector<AudioEmitter*> m_users; //! < emitters currently using this source
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -69,6 +69,12 @@ namespace cro
         */
         AudioSource::Type getType() const override { return AudioSource::Type::Stream; }
 
+        /*!
+        \brief Returns the number of times playback of this stream stalled
+        because it ran out of data before it could be refilled.
+        */
+        std::uint32_t getUnderrunCount() const;
+
     private:
 
     };
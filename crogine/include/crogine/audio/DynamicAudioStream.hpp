@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2024
+Matt Marchant 2024 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -75,6 +75,14 @@ namespace cro
         */
         AudioSource::Type getType() const override { return AudioSource::Type::Stream; }
 
+        /*!
+        \brief Returns the number of times playback of this stream stalled
+        because it ran out of data before it could be refilled.
+        Note that if updateBuffer() is not called often enough silence is
+        played instead, which is not counted as an underrun.
+        */
+        std::uint32_t getUnderrunCount() const;
+
     private:
         Detail::BufferedStreamLoader* m_bufferedStream;
     };
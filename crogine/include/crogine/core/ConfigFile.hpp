@@ -44,6 +44,7 @@ source distribution.
 #include <string>
 #include <vector>
 #include <sstream>
+#include <unordered_map>
 
 namespace cro
 {
@@ -258,10 +259,53 @@ namespace cro
         Config files parsed from json will be written in the ConfigFile format
         when written with save()
 
+        Files may also be loaded from a compiled binary twin, see saveBinary().
+        When a file with the same path as the requested file plus BinaryExtension
+        exists, and is newer than the requested file (or the requested file
+        doesn't exist) then the binary file is loaded instead. Binary files can
+        also be loaded directly by passing their path to this function.
+
         \returns true on success, else false if something went wrong
         */
         bool loadFromFile(const std::string& path, bool relative = true);
 
+        /*!
+        \brief Writes this object and all its children to the given path in
+        a compiled binary form.
+        Binary files contain a single table of all object and property names,
+        and store numeric values as pre-parsed arrays, so that they can be loaded
+        without any tokenising or string conversion. Saving a binary file with
+        the same path as a text file plus BinaryExtension will cause it to be
+        loaded in place of the text file by loadFromFile().
+        */
+        bool saveBinary(const std::string& path) const;
+
+        /*!
+        \brief Sets a directory in which compiled binary versions of loaded
+        files are cached.
+        When set, any file loaded with loadFromFile() which doesn't have an up
+        to date binary twin is compiled and written to this directory, and
+        subsequent loads, including those in later sessions, are made from the
+        compiled version. Cached files are ignored once they're older than the
+        file from which they were compiled. By default this is empty and
+        caching is disabled.
+        \param path Absolute path to the cache directory, such as one in the
+        user's preference directory. It is created if it doesn't exist.
+        */
+        static void setCacheDirectory(const std::string& path);
+
+        /*!
+        \brief Returns the current cache directory, or an empty string
+        if caching is disabled.
+        */
+        static std::string getCacheDirectory();
+
+        /*!
+        \brief File extension appended to the path of a source file to
+        create the path of its compiled binary twin.
+        */
+        static constexpr const char* BinaryExtension = ".cfb";
+
     private:
         std::string m_id;
         std::vector<ConfigProperty> m_properties;
@@ -272,6 +316,12 @@ namespace cro
         std::size_t write(SDL_RWops* file, std::uint16_t depth = 0u);
 
         bool loadFromFile2(const std::string& path);
+
+        using StringTable = std::unordered_map<std::string, std::uint32_t>;
+        void writeBinary(std::vector<std::uint8_t>& dst, StringTable& strings) const;
+        bool readBinary(const std::uint8_t*& data, const std::uint8_t* end, const std::vector<std::string>& strings, std::uint32_t depth);
+        bool loadFromBinary(const std::string& path);
+        bool loadFromTwin(const std::string& path);
     };
 
     using ConfigFile = ConfigObject;
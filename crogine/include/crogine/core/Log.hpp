@@ -57,7 +57,11 @@ namespace cro
     /*!
     \brief Class to allowing messages to be logged to a combination
     of one or more destinations such as the console, log file or
-    output window in Visual Studio
+    output window in Visual Studio.
+    Messages sent to the log file are queued and written in batches
+    by a background thread which keeps the file open. Consecutive
+    duplicate messages are collapsed into a single line followed by
+    a count of the number of times they were repeated.
     */
     class CRO_EXPORT_API Logger final
     {
@@ -90,11 +94,24 @@ namespace cro
         */
         static std::ostream& log(Type type = Type::Info);
 
+        /*!
+        \brief Writes any messages which are still queued for the
+        log file and flushes the file to disk.
+        This blocks until the queue is empty, and is called automatically
+        by StackDump when the application crashes.
+        */
+        static void flush();
+
     private:
         static std::list<std::string> m_buffer;
         static std::string m_output;
 
         static void updateOutString(std::size_t maxBuffer);
+
+        //stops the background writer, after which
+        //file messages are written synchronously
+        static void shutdown();
+        friend class App;
     };
 
     namespace Detail
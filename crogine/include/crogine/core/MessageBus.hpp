@@ -32,13 +32,19 @@ source distribution.
 #include <crogine/core/Message.hpp>
 
 #include <vector>
-
-#ifdef USE_PARALLEL_PROCESSING
+#include <array>
+#include <memory>
 #include <mutex>
-#endif
+#include <atomic>
+#include <cstddef>
 
 namespace cro
 {   
+    namespace Detail
+    {
+        struct MessageThreadBuffer;
+    }
+
     /*!
     \brief System wide message bus for custom event messaging
 
@@ -54,12 +60,21 @@ namespace cro
     GhostEvent,
     BadgerEvent //etc...
     };
+
+    Each thread which posts to the bus is given its own buffer, so posting
+    doesn't require taking a lock once a thread has posted its first message.
+    Buffers are made of fixed size segments which are added as needed, so
+    busy frames no longer overflow. Messages posted by the same thread are
+    read in the order in which they were posted, however there is no ordering
+    guaranteed between messages posted by different threads. Messages may be
+    posted from multiple threads at once (eg from within a parallel System
+    update) but not while the bus is being read with empty()/poll().
     */
     class CRO_EXPORT_API MessageBus final
     {
     public:
         MessageBus();
-        ~MessageBus() = default;
+        ~MessageBus();
         MessageBus(const MessageBus&) = delete;
         MessageBus(MessageBus&&) = delete;
         const MessageBus& operator = (const MessageBus&) = delete;
@@ -87,37 +102,18 @@ namespace cro
         template <typename T>
         T* post(Message::ID id)
         {
-            if (!m_enabled) return static_cast<T*>((void*)m_pendingBuffer.data());
-
             static_assert(sizeof(T) < 128, "Message size limit is 128 bytes");
+            static_assert(alignof(T) <= Alignment, "Message data is over-aligned");
 
-            const auto dataSize = sizeof(T);
-            static const auto msgSize = sizeof(Message);
-            //CRO_ASSERT(dataSize < 128, "message size exceeds 128 bytes"); //limit custom data to 128 bytes
-            CRO_ASSERT(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) > (dataSize + msgSize), "buffer overflow " + std::to_string(m_pendingCount)); //make sure we have enough room in the buffer
-            //CRO_WARNING(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) < 128, "Messagebus buffer is heavily contended!");
-
-
-            //this is probably not ideal - the returned
-            //message is probably modified outside of the lock
-            //however what we're *really* protecting here
-            //is creation of new messages on the bus
-            //ALSO a lot of threads waiting on this will probably cause
-            //a stall - if we're smart each thread/group of threads
-            //would have their own mutexes and the message bus
-            //would do a collection from all of them each frame
-#ifdef USE_PARALLEL_PROCESSING
-            std::scoped_lock l(m_mutex);
-#endif
-
-            Message* msg = new (m_inPointer)Message();
-            m_inPointer += msgSize;
+            if (!m_enabled) return static_cast<T*>((void*)m_disabledBuffer.data());
+
+            char* ptr = allocate(sizeof(T));
+
+            Message* msg = new (ptr)Message();
             msg->id = id;
-            msg->m_dataSize = dataSize;
-            msg->m_data = new (m_inPointer)T();
-            m_inPointer += dataSize;
+            msg->m_dataSize = sizeof(T);
+            msg->m_data = new (ptr + MessageStride)T();
 
-            m_pendingCount++;
             return static_cast<T*>(msg->m_data);
         }
 
@@ -138,18 +134,46 @@ namespace cro
         */
         void disable() { m_enabled = false; }
 
+        /*!
+        \brief Statistics about the messages posted in a single frame
+        */
+        struct Stats final
+        {
+            std::size_t messageCount = 0; //!< number of messages posted
+            std::size_t byteCount = 0; //!< number of bytes used by posted messages, including headers
+            std::size_t segmentCount = 0; //!< number of buffer segments currently allocated across all threads
+            std::size_t threadCount = 0; //!< number of threads which have posted to this bus
+        };
+
+        /*!
+        \brief Returns the Stats for the most recent batch of messages to be
+        read from the bus - ie those posted during the previous frame.
+        */
+        const Stats& getStats() const { return m_stats; }
+
     private:
+        static constexpr std::size_t Alignment = alignof(std::max_align_t);
+        static constexpr std::size_t MessageStride = (sizeof(Message) + (Alignment - 1)) & ~(Alignment - 1);
+
+        std::array<std::max_align_t, 128 / sizeof(std::max_align_t)> m_disabledBuffer = {};
 
-        std::vector<char> m_currentBuffer;
-        std::vector<char> m_pendingBuffer;
-        char* m_inPointer;
-        char* m_outPointer;
+        const std::uint32_t m_busID;
+        std::atomic<std::uint32_t> m_writeIndex;
+
+        mutable std::mutex m_mutex; //protects the list of buffers, not the buffers themselves
+        std::vector<std::shared_ptr<Detail::MessageThreadBuffer>> m_threadBuffers;
+
+        //read position
+        std::size_t m_readBuffer;
+        std::size_t m_readSegment;
+        std::size_t m_readOffset;
         std::size_t m_currentCount;
-        std::size_t m_pendingCount;
+
+        Stats m_stats;
 
         bool m_enabled;
-#ifdef USE_PARALLEL_PROCESSING
-        std::mutex m_mutex;
-#endif
+
+        char* allocate(std::size_t dataSize);
+        Detail::MessageThreadBuffer& getThreadBuffer();
     };
 }
\ No newline at end of file
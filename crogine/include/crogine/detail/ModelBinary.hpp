@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2021 - 2022
+Matt Marchant 2021 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -39,8 +39,10 @@ source distribution.
 #include <crogine/detail/glm/vec3.hpp>
 #include <crogine/detail/glm/gtc/quaternion.hpp>
 
+#include <array>
 #include <string>
 #include <cstring>
+#include <vector>
 
 namespace cro::Detail::ModelBinary
 {
@@ -80,6 +82,14 @@ namespace cro::Detail::ModelBinary
         HeaderV2() { version = 2; };
     };
 
+    //version 3 header. Version 3 files contain MeshHeaderV3 rather
+    //than MeshHeader, and the same skeleton data as version 2
+    static constexpr std::uint32_t MappedVersion = 3;
+    struct CRO_EXPORT_API HeaderV3 final : public Header
+    {
+        HeaderV3() { version = MappedVersion; };
+    };
+
 
     //appears at Header::meshOffset bytes from beginning of the file
     struct CRO_EXPORT_API MeshHeader final
@@ -114,6 +124,74 @@ namespace cro::Detail::ModelBinary
     Vertex data is interleaved in the above order
     */
 
+    //appears at Header::meshOffset bytes from the beginning of version 3 files
+    struct CRO_EXPORT_API MeshHeaderV3 final
+    {
+        //bytes from the beginning of the file to the vertex data.
+        //This is always a multiple of 16
+        std::uint32_t vertexOffset = 0;
+        std::uint32_t vertexCount = 0;
+        //bytes from the beginning of the file to the first index array
+        std::uint32_t indexArrayOffset = 0;
+        //vertex attribute flags, as MeshHeader::flags
+        std::uint16_t flags = 0;
+        std::uint16_t indexArrayCount = 0;
+        //size of a single vertex in bytes
+        std::uint16_t vertexSize = 0;
+        //size of a single index in bytes, either 2 or 4
+        std::uint16_t indexSize = 0;
+        //min xyz, max xyz
+        float boundingBox[6] = {};
+        //centre xyz, radius
+        float boundingSphere[4] = {};
+
+        std::uint32_t reserved0 = 0;
+        std::uint32_t reserved1 = 0;
+    };
+    /*!
+    Version 3 mesh data follows the header:
+        std::uint32_t arraySizes[MeshHeaderV3::indexArrayCount] //number of indices in each array
+        padding up to MeshHeaderV3::vertexOffset
+        float vertexData[vertexCount * vertexSize / sizeof(float)]
+        index arrays of std::uint16_t or std::uint32_t, each starting on a 4 byte boundary
+
+    Unlike earlier versions the vertex data is stored exactly as it is uploaded
+    to the GPU, so that it can be used directly from a mapped file. Tangents are
+    stored as 3 floats followed by 3 floats for the bitangent, and colours are
+    always 4 floats. The order of the vertex components is the same as above.
+    Indices are 16 bit if the mesh has few enough vertices.
+    */
+
+    /*!
+    \brief The mesh data found in a version 3 model binary.
+    The pointers refer to the memory passed to getMeshView()
+    so are only valid for as long as it is.
+    */
+    struct CRO_EXPORT_API MeshView final
+    {
+        MeshHeaderV3 header;
+        std::vector<std::uint32_t> indexCounts;
+        const std::uint8_t* vertexData = nullptr;
+        std::vector<const std::uint8_t*> indexData;
+    };
+
+    /*!
+    \brief Finds the mesh data in a version 3 model binary which has been
+    loaded or mapped into memory. No vertex or index data is copied.
+    \param data Pointer to the beginning of the file
+    \param size Size of the file in bytes
+    \param dst MeshView to fill with the mesh data
+    \returns false if the data doesn't contain a valid version 3 mesh
+    */
+    CRO_EXPORT_API bool getMeshView(const std::uint8_t* data, std::size_t size, MeshView& dst);
+
+    /*!
+    \brief Returns the number of floats used by each vertex attribute, indexed
+    by Mesh::Attribute, in version 3 files with the given attribute flags.
+    This is also the layout of the Mesh::Data created from them.
+    */
+    CRO_EXPORT_API std::array<std::size_t, Mesh::Attribute::Total> getAttributeSizes(std::uint16_t flags);
+
 
 
 
@@ -273,14 +351,31 @@ namespace cro::Detail::ModelBinary
         }
     };
 
+    /*!
+    \brief Writes the Model and/or Skeleton of the given entity to a version 3
+    model binary at the given path.
+    */
     CRO_EXPORT_API bool write(cro::Entity, const std::string&, bool includeSkeleton = true);
 
+    /*!
+    \brief Converts a version 1 or 2 model binary to version 3.
+    This doesn't require an OpenGL context. Skeletons in version 1
+    files aren't supported, and are dropped.
+    \param src Path to the file to convert
+    \param dst Path to which to write the converted file. This may be the same as src
+    \returns true on success, else false. Returns true without writing anything
+    if src is already version 3 and src and dst are the same.
+    */
+    CRO_EXPORT_API bool convert(const std::string& src, const std::string& dst);
+
     /*!
     \brief Reads vertex positions and index arrays from a binary file at the given path
     If the file is successfully opened at the given path the mesh data is stored in the
     given vectors, and meta data returned in the cro::MeshData struct
     Note that this only loads position data from the file, as it is currently used
     for loading collision meshes into the golf game. TODO: fix this.
+    Version 3 files return the vertex data in its version 3 layout, and the
+    index data widened to 32 bit.
     */
     CRO_EXPORT_API cro::Mesh::Data read(const std::string&, std::vector<float>& dstVert, std::vector<std::vector<std::uint32_t>>& dstIdx);
 }
\ No newline at end of file
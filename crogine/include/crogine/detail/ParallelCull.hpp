@@ -0,0 +1,238 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+#ifdef USE_PARALLEL_PROCESSING
+#include <execution>
+#endif
+
+namespace cro::Detail
+{
+    /*!
+    \brief Culls a range of items into one or more output lists, in parallel.
+    The input range is split into fixed size chunks, each of which is processed
+    on its own thread and writes to its own set of output lists, so no locking
+    is required when an item is found to be visible. The results are then
+    gathered into the final output lists, either in input order or merged
+    by a given sort key.
+
+    Renderable systems usually keep a ParallelCuller as a member, so that
+    the chunk lists retain their memory between frames.
+    \tparam T Type of item stored in the output lists, eg Entity
+    */
+    template <typename T>
+    class ParallelCuller final
+    {
+    public:
+        //a multiple of 64 so that chunks map to whole
+        //words of a visibility bitmask
+        static constexpr std::size_t ChunkSize = 128;
+
+        /*!
+        \brief Culls the range [begin, end) in parallel.
+        \param begin Random access iterator to the beginning of the input range
+        \param end Random access iterator to the end of the input range
+        \param listCount Number of output lists, for example one per camera pass
+        or one per shadow cascade
+        \param fn Callable with the signature void(const InputType&, std::vector<T>* lists)
+        where lists points to listCount vectors local to the current chunk, to which
+        visible items are appended. Each invocation of fn may be executed on a
+        different thread, and should only modify the given lists and the input item.
+        */
+        template <typename It, typename Fn>
+        void cull(It begin, It end, std::size_t listCount, Fn&& fn)
+        {
+            cullChunks(static_cast<std::size_t>(std::distance(begin, end)), listCount,
+                [&](std::size_t start, std::size_t stop, std::vector<T>* lists)
+                {
+                    for (auto i = start; i < stop; ++i)
+                    {
+                        fn(*(begin + i), lists);
+                    }
+                });
+        }
+
+        /*!
+        \brief Culls itemCount items a chunk at a time, in parallel.
+        Use this when items are better processed in batches, for example
+        with Spatial::cullSpheres()
+        \param itemCount Total number of items to process
+        \param listCount Number of output lists
+        \param fn Callable with the signature void(std::size_t start, std::size_t end, std::vector<T>* lists)
+        which processes the items in the range [start, end). start is always a multiple
+        of ChunkSize, and end - start is never greater than ChunkSize.
+        */
+        template <typename Fn>
+        void cullChunks(std::size_t itemCount, std::size_t listCount, Fn&& fn)
+        {
+            const auto chunkCount = (itemCount + (ChunkSize - 1)) / ChunkSize;
+
+            if (m_chunks.size() < chunkCount)
+            {
+                m_chunks.resize(chunkCount);
+                m_chunkIndices.resize(chunkCount);
+                std::iota(m_chunkIndices.begin(), m_chunkIndices.end(), 0);
+            }
+            m_activeChunks = chunkCount;
+
+            const auto processChunk = [&](std::size_t chunkIndex)
+            {
+                auto& lists = m_chunks[chunkIndex];
+                if (lists.size() < listCount)
+                {
+                    lists.resize(listCount);
+                }
+                for (auto& list : lists)
+                {
+                    list.clear();
+                }
+
+                const auto start = chunkIndex * ChunkSize;
+                fn(start, std::min(start + ChunkSize, itemCount), lists.data());
+            };
+
+#ifdef USE_PARALLEL_PROCESSING
+            std::for_each(std::execution::par, m_chunkIndices.cbegin(), m_chunkIndices.cbegin() + chunkCount, processChunk);
+#else
+            std::for_each(m_chunkIndices.cbegin(), m_chunkIndices.cbegin() + chunkCount, processChunk);
+#endif
+        }
+
+        /*!
+        \brief Moves the results of the last call to cull() for the given list
+        index to the end of the output vector. Items are appended in the same
+        order as the input.
+        */
+        void gather(std::size_t listIndex, std::vector<T>& output)
+        {
+            output.reserve(output.size() + getCount(listIndex));
+            for (auto i = 0u; i < m_activeChunks; ++i)
+            {
+                if (listIndex < m_chunks[i].size())
+                {
+                    auto& list = m_chunks[i][listIndex];
+                    output.insert(output.end(), std::make_move_iterator(list.begin()), std::make_move_iterator(list.end()));
+                }
+            }
+        }
+
+        /*!
+        \brief Moves the results of the last call to cull() for the given list
+        index to the end of the output vector, sorted with the given comparison function.
+        Each chunk is sorted in parallel before the chunks are merged.
+        Note that only the appended items are sorted, any existing items in
+        output remain at the front.
+        \param comp Comparison function with the signature bool(const T&, const T&)
+        */
+        template <typename Compare>
+        void gatherSorted(std::size_t listIndex, std::vector<T>& output, Compare comp)
+        {
+            const auto sortChunk = [&, listIndex](std::size_t chunkIndex)
+            {
+                if (listIndex < m_chunks[chunkIndex].size())
+                {
+                    auto& list = m_chunks[chunkIndex][listIndex];
+                    std::sort(list.begin(), list.end(), comp);
+                }
+            };
+
+#ifdef USE_PARALLEL_PROCESSING
+            std::for_each(std::execution::par, m_chunkIndices.cbegin(), m_chunkIndices.cbegin() + m_activeChunks, sortChunk);
+#else
+            std::for_each(m_chunkIndices.cbegin(), m_chunkIndices.cbegin() + m_activeChunks, sortChunk);
+#endif
+
+            //concatenate and record the start of each sorted run
+            const auto outputStart = output.size();
+            m_runs.clear();
+            m_runs.push_back(outputStart);
+            output.reserve(outputStart + getCount(listIndex));
+            for (auto i = 0u; i < m_activeChunks; ++i)
+            {
+                if (listIndex < m_chunks[i].size()
+                    && !m_chunks[i][listIndex].empty())
+                {
+                    auto& list = m_chunks[i][listIndex];
+                    output.insert(output.end(), std::make_move_iterator(list.begin()), std::make_move_iterator(list.end()));
+                    m_runs.push_back(output.size());
+                }
+            }
+
+            //merge pairs of runs until one remains
+            while (m_runs.size() > 2)
+            {
+                std::size_t dst = 1;
+                for (auto i = 2u; i < m_runs.size(); i += 2)
+                {
+                    std::inplace_merge(output.begin() + m_runs[i - 2], output.begin() + m_runs[i - 1], output.begin() + m_runs[i], comp);
+                    m_runs[dst++] = m_runs[i];
+                }
+
+                //odd run out is carried over as is
+                if ((m_runs.size() % 2) == 0)
+                {
+                    m_runs[dst++] = m_runs.back();
+                }
+                m_runs.resize(dst);
+            }
+        }
+
+        /*!
+        \brief Returns the number of items found in the given list
+        by the last call to cull()
+        */
+        std::size_t getCount(std::size_t listIndex) const
+        {
+            std::size_t count = 0;
+            for (auto i = 0u; i < m_activeChunks; ++i)
+            {
+                if (listIndex < m_chunks[i].size())
+                {
+                    count += m_chunks[i][listIndex].size();
+                }
+            }
+            return count;
+        }
+
+    private:
+        std::vector<std::vector<std::vector<T>>> m_chunks;
+        std::vector<std::size_t> m_chunkIndices;
+        std::vector<std::size_t> m_runs;
+        std::size_t m_activeChunks = 0;
+    };
+}
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -34,10 +34,13 @@ source distribution.
 
 #include <cstdlib>
 #include <vector>
+#include <array>
+#include <atomic>
 #include <typeindex>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 
 namespace cro
 {
@@ -47,20 +50,58 @@ namespace cro
 
         using ID = std::uint32_t;
 
+        ComponentManager();
+
         /*!
-        \brief Returns a unique ID based on the component type
+        \brief Returns a unique ID based on the component type.
+        IDs are unique to each instance of a ComponentManager (ie
+        each Scene). Once a type has been looked up its ID is cached
+        in a slot indexed by a process-wide type index, so subsequent
+        calls are a bounds check and a single indexed load.
+        Safe to call from parallel system updates for types which
+        have already been registered with this ComponentManager.
         */
         template <typename T>
         ID getID()
         {
+            static const std::uint32_t typeIndex = getNextTypeIndex();
+
+            if (typeIndex < MaxCachedTypes)
+            {
+                //relaxed is enough as the ID is the only data published
+                //and every thread caching it stores the same value
+                const auto cached = m_cachedIDs[typeIndex].load(std::memory_order_relaxed);
+                if (cached != InvalidID)
+                {
+                    return cached;
+                }
+            }
+
             auto id = std::type_index(typeid(T));
-            return getFromTypeID(id);
+            return cacheID(typeIndex, getFromTypeID(id));
         }
 
         ID getFromTypeID(std::type_index);
 
     private:
+        static constexpr ID InvalidID = std::numeric_limits<ID>::max();
+
+        //this is fixed size so that it is never reallocated while
+        //being read from parallel system updates, and the entries are
+        //atomic as they're filled lazily by whichever thread first
+        //looks up a type. Any types indexed beyond this fall back to
+        //searching m_IDs
+        static constexpr std::size_t MaxCachedTypes = 256;
+        std::array<std::atomic<ID>, MaxCachedTypes> m_cachedIDs;
 
         std::vector<std::type_index> m_IDs;
+
+        ID cacheID(std::uint32_t typeIndex, ID id);
+
+        //note that a type may be given a different index in
+        //different modules (eg across shared library boundaries)
+        //but this only means that the type is cached in two slots
+        //which both map to the same ID
+        static std::uint32_t getNextTypeIndex();
     };
 }
\ No newline at end of file
@@ -47,9 +47,10 @@ namespace cro
             static constexpr auto nullindex = std::numeric_limits<std::uint32_t>::max();
 
             explicit Pool(const std::string& name)
-                : m_freeIndex(0), m_indexMap(Detail::MinFreeIDs), m_indexPool(Detail::MinFreeIDs), m_name(name)
+                : m_freeIndex(0), m_indexMap(Detail::MinFreeIDs), m_indexPool(Detail::MinFreeIDs), m_slotOwners(Detail::MinFreeIDs), m_name(name)
             {
                 std::fill(m_indexMap.begin(), m_indexMap.end(), nullindex);
+                std::fill(m_slotOwners.begin(), m_slotOwners.end(), nullindex);
                 std::iota(m_indexPool.begin(), m_indexPool.end(), 0);
             }
             
@@ -76,6 +77,7 @@ namespace cro
             std::size_t m_freeIndex;
             std::vector<std::uint32_t> m_indexMap;
             std::vector<std::uint32_t> m_indexPool;
+            std::vector<std::uint32_t> m_slotOwners; // < maps pool slot back to entity index
 
             std::string m_name;
         };
@@ -118,6 +120,7 @@ namespace cro
                 m_freeIndex++;
 
                 const auto mappedIdx = m_indexMap[idx];
+                m_slotOwners[mappedIdx] = idx;
                 if (mappedIdx >= size())
                 {
                     resize(std::min(static_cast<std::uint32_t>(Detail::MinFreeIDs), mappedIdx + 128));
@@ -139,6 +142,7 @@ namespace cro
                     m_freeIndex--;
                     m_indexPool[m_freeIndex] = mappedIdx;
                     m_indexMap[idx] = nullindex;
+                    m_slotOwners[mappedIdx] = nullindex;
                 }
             }
 
@@ -148,6 +152,7 @@ namespace cro
                 m_freeIndex = 0;
 
                 std::fill(m_indexMap.begin(), m_indexMap.end(), nullindex);
+                std::fill(m_slotOwners.begin(), m_slotOwners.end(), nullindex);
                 std::iota(m_indexPool.begin(), m_indexPool.end(), 0);
             }
 
@@ -161,6 +166,52 @@ namespace cro
                 return m_pool.size();
             }
 
+            /*!
+            \brief Calls the given function on each component in the pool
+            which is currently assigned to an entity. Components are visited
+            in pool order rather than entity order.
+            */
+            template <typename Fn>
+            void forEachActive(Fn&& fn)
+            {
+                //the index pool isn't ordered once components have been
+                //reset, so use the slot owners to find the slots in use
+                const auto count = std::min(m_pool.size(), m_slotOwners.size());
+                for (auto i = 0u; i < count; ++i)
+                {
+                    if (m_slotOwners[i] != nullindex)
+                    {
+                        fn(m_pool[i]);
+                    }
+                }
+            }
+
+            /*!
+            \brief Returns the number of storage slots which may
+            be passed to getSlotOwner() or getSlot()
+            */
+            std::size_t getSlotCount() const
+            {
+                return std::min(m_pool.size(), m_slotOwners.size());
+            }
+
+            /*!
+            \brief Returns the index of the entity which owns the component
+            in the given storage slot, or nullindex if the slot is free
+            */
+            std::uint32_t getSlotOwner(std::size_t slot) const
+            {
+                return m_slotOwners[slot];
+            }
+
+            /*!
+            \brief Returns the component in the given storage slot
+            */
+            T& getSlot(std::size_t slot)
+            {
+                return m_pool[slot];
+            }
+
         private:
             std::vector<T> m_pool;
 
@@ -41,6 +41,8 @@ source distribution.
 
 #include <bitset>
 #include <vector>
+#include <tuple>
+#include <iterator>
 #include <deque>
 #include <memory>
 
@@ -48,6 +50,94 @@ namespace cro
 {  
     using ComponentMask = std::bitset<Detail::MaxComponents>;
     class EntityManager;
+    class Entity;
+
+    /*!
+    \brief A range of all the entities which have a given set of components,
+    along with references to those components.
+    Views are created with Scene::view<T...>() and are ordered by the storage
+    order of the first component type, so iterating a view reads the first
+    component pool contiguously. When the view is created the storage slots of
+    the matching entities are gathered into a single list, so the view is
+    random-access and may be used with parallel algorithms. Iterating a view
+    yields a std::tuple<Entity, T&, Ts&...> by value
+    \begincode
+    for (auto [entity, model, transform] : scene.view<Model, Transform>()) {}
+
+    auto view = scene.view<Model, Transform>();
+    std::for_each(std::execution::par, view.begin(), view.end(),
+        [](auto item)
+        {
+            auto& [entity, model, transform] = item;
+        });
+    \endcode
+    Views are invalidated when components are added to or removed from the
+    Scene, so should not be stored between frames.
+    */
+    template <typename T, typename... Ts>
+    class ComponentView final
+    {
+    public:
+        using Item = std::tuple<Entity, T&, Ts&...>;
+
+        class Iterator final
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = Item;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Item;
+
+            Iterator() = default;
+
+            Item operator *() const;
+            Item operator [](difference_type n) const { return *(*this + n); }
+
+            Iterator& operator ++() { ++m_index; return *this; }
+            Iterator operator ++(int) { auto retVal = *this; ++m_index; return retVal; }
+            Iterator& operator --() { --m_index; return *this; }
+            Iterator operator --(int) { auto retVal = *this; --m_index; return retVal; }
+
+            Iterator& operator += (difference_type n) { m_index += n; return *this; }
+            Iterator& operator -= (difference_type n) { m_index -= n; return *this; }
+            Iterator operator + (difference_type n) const { auto retVal = *this; return retVal += n; }
+            Iterator operator - (difference_type n) const { auto retVal = *this; return retVal -= n; }
+            friend Iterator operator + (difference_type n, const Iterator& it) { return it + n; }
+            difference_type operator - (const Iterator& other) const { return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index); }
+
+            bool operator == (const Iterator& other) const { return m_index == other.m_index; }
+            bool operator != (const Iterator& other) const { return m_index != other.m_index; }
+            bool operator < (const Iterator& other) const { return m_index < other.m_index; }
+            bool operator > (const Iterator& other) const { return m_index > other.m_index; }
+            bool operator <= (const Iterator& other) const { return m_index <= other.m_index; }
+            bool operator >= (const Iterator& other) const { return m_index >= other.m_index; }
+
+        private:
+            friend class ComponentView;
+            Iterator(const ComponentView* view, std::size_t index) : m_view(view), m_index(index) {}
+
+            const ComponentView* m_view = nullptr;
+            std::size_t m_index = 0;
+        };
+
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, m_slots.size()); }
+
+        std::size_t size() const { return m_slots.size(); }
+        bool empty() const { return m_slots.empty(); }
+
+        Item operator [](std::size_t idx) const;
+
+    private:
+        friend class EntityManager;
+        ComponentView(EntityManager&, const ComponentMask&, Detail::ComponentPool<T>&, Detail::ComponentPool<Ts>&...);
+
+        EntityManager& m_entityManager;
+        Detail::ComponentPool<T>* m_pool;
+        std::tuple<Detail::ComponentPool<Ts>*...> m_pools;
+        std::vector<std::uint32_t> m_slots; // < pool slots of the matching entities, in storage order
+    };
 
     /*!
     \brief Entity class - Basically just an ID.
@@ -281,7 +371,25 @@ namespace cro
         */
         void setTitle(const std::string& s) { m_debugTitle = s; }
 
+        /*!
+        \brief Calls the given function on every active component of type T
+        \param fn A callable taking a reference to T as its only parameter
+        */
+        template <typename T, typename Fn>
+        void forEachComponent(Fn&& fn);
+
+        /*!
+        \brief Returns a ComponentView of all entities with at least the given
+        component types.
+        \see Scene::view()
+        */
+        template <typename T, typename... Ts>
+        ComponentView<T, Ts...> view();
+
     private:
+        template <typename T, typename... Ts>
+        friend class ComponentView;
+
         MessageBus& m_messageBus;
         std::size_t m_initialPoolSize;
         std::deque<std::uint32_t> m_freeIDs;
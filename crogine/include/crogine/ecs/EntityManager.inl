@@ -67,7 +67,9 @@ T& EntityManager::getComponent(Entity entity)
 
 
     CRO_ASSERT(componentID < m_componentPools.size(), "Component index out of range");
-    auto* pool = (dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    //the ID is unique to T so the pool is guaranteed to be this type
+    CRO_ASSERT(dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()), "Invalid pool type");
+    auto* pool = static_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get());
 
     //TODO this is a potential false positive as IDs don't map directly
     //to the size any more...
@@ -75,6 +77,60 @@ T& EntityManager::getComponent(Entity entity)
     return pool->at(entityID);
 }
 
+template <typename T, typename Fn>
+void EntityManager::forEachComponent(Fn&& fn)
+{
+    getPool<T>().forEachActive(std::forward<Fn>(fn));
+}
+
+template <typename T, typename... Ts>
+ComponentView<T, Ts...> EntityManager::view()
+{
+    ComponentMask mask;
+    mask.set(m_componentManager.getID<T>());
+    (mask.set(m_componentManager.getID<Ts>()), ...);
+
+    return ComponentView<T, Ts...>(*this, mask, getPool<T>(), getPool<Ts>()...);
+}
+
+template <typename T, typename... Ts>
+ComponentView<T, Ts...>::ComponentView(EntityManager& em, const ComponentMask& mask, Detail::ComponentPool<T>& pool, Detail::ComponentPool<Ts>&... pools)
+    : m_entityManager   (em),
+    m_pool              (&pool),
+    m_pools             (&pools...)
+{
+    const auto& masks = em.m_componentMasks;
+    const auto slotCount = pool.getSlotCount();
+    m_slots.reserve(pool.used());
+
+    for (auto i = 0u; i < slotCount; ++i)
+    {
+        const auto entityIdx = pool.getSlotOwner(i);
+        if (entityIdx != Detail::Pool::nullindex
+            && (masks[entityIdx] & mask) == mask)
+        {
+            m_slots.push_back(i);
+        }
+    }
+}
+
+template <typename T, typename... Ts>
+typename ComponentView<T, Ts...>::Item ComponentView<T, Ts...>::operator[](std::size_t idx) const
+{
+    CRO_ASSERT(idx < m_slots.size(), "Index out of range");
+    const auto slot = m_slots[idx];
+    const auto entityIdx = m_pool->getSlotOwner(slot);
+
+    return Item(m_entityManager.getEntity(entityIdx), m_pool->getSlot(slot),
+        std::get<Detail::ComponentPool<Ts>*>(m_pools)->at(entityIdx)...);
+}
+
+template <typename T, typename... Ts>
+typename ComponentView<T, Ts...>::Item ComponentView<T, Ts...>::Iterator::operator*() const
+{
+    return (*m_view)[m_index];
+}
+
 template <typename T>
 Detail::ComponentPool<T>& EntityManager::getPool()
 {
@@ -85,5 +141,6 @@ Detail::ComponentPool<T>& EntityManager::getPool()
         m_componentPools[componentID] = std::make_unique<Detail::ComponentPool<T>>(m_initialPoolSize);
     }
 
-    return *(dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    CRO_ASSERT(dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()), "Invalid pool type");
+    return *(static_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
 }
\ No newline at end of file
@@ -38,6 +38,7 @@ source distribution.
 #include <crogine/ecs/Sunlight.hpp>
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/ecs/Component.hpp>
+#include <crogine/ecs/components/Transform.hpp>
 #include <crogine/graphics/Shader.hpp>
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/graphics/RenderTexture.hpp>
@@ -125,6 +126,28 @@ namespace cro
         std::size_t getEntityCount() const { return m_entityManager.getEntityCount(); }
 
 
+        /*!
+        \brief Returns a ComponentView containing all the entities in the Scene
+        which have at least the given component types.
+        Entities are ordered by the storage of the first component type, which
+        makes iterating the view cache friendly for that component. Views are
+        random-access so may be used with parallel algorithms. For example:
+        \begincode
+        auto view = scene.view<Model, Transform>();
+        std::for_each(std::execution::par, view.begin(), view.end(),
+            [](auto item)
+            {
+                auto& [entity, model, transform] = item;
+            });
+        \endcode
+        Note that the view contains every entity with these components, including
+        those which were created this frame and not yet added to any Systems.
+        \see ComponentView
+        */
+        template <typename T, typename... Ts>
+        ComponentView<T, Ts...> view() { return m_entityManager.view<T, Ts...>(); }
+
+
         /*!
         \brief Creates a new system of the given type.
         All systems need to be fully created before adding entities, else
@@ -450,6 +473,14 @@ namespace cro
         */
         const std::string& getTitle() const { return m_debugTitle; }
 
+        /*!
+        \brief Returns the number of world transforms which were recalculated
+        or reused from the cache during the last call to simulate().
+        World transforms are resolved once per frame at the end of simulate(),
+        parents first, so that renderers read cached matrices.
+        */
+        const Transform::ResolveStats& getTransformStats() const { return m_transformStats; }
+
     private:
         MessageBus& m_messageBus;
         std::size_t m_uid;
@@ -464,6 +495,9 @@ namespace cro
         std::vector<Entity> m_destroyedEntities;
         std::vector<Entity> m_destroyedBuffer;
 
+        Transform::ResolveStats m_transformStats;
+        void resolveTransforms();
+
         ComponentManager m_componentManager;
         EntityManager m_entityManager;
         SystemManager m_systemManager;
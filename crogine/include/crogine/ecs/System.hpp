@@ -84,7 +84,10 @@ namespace cro
         void addEntity(Entity);
 
         /*!
-        \brief Removes an entity from the list to process
+        \brief Removes an entity from the list to process.
+        By default this is done in constant time by swapping the entity
+        with the last in the list, which changes the order of the list.
+        \see setOrderedRemoval()
         */
         void removeEntity(Entity);
 
@@ -119,6 +122,14 @@ namespace cro
         template <typename T>
         void requireComponent();
 
+        /*!
+        \brief Set to true if the system relies on getEntities() remaining
+        in the order in which entities were added. This makes removing entities
+        linear in the number of entities which follow the removed entity, rather
+        than constant time. Defaults to false.
+        */
+        void setOrderedRemoval(bool ordered) { m_orderedRemoval = ordered; }
+
         /*!
         \brief Optional callback performed when an entity is added
         */
@@ -158,6 +169,11 @@ namespace cro
         ComponentMask m_componentMask;
         std::vector<Entity> m_entities;
 
+        //indexed by entity index, contains the entity's position in m_entities
+        std::vector<std::uint32_t> m_entitySlots;
+        bool m_orderedRemoval;
+        std::uint32_t findSlot(Entity);
+
         Scene* m_scene;
         std::size_t m_updateIndex; //ensures when the system is active that it is updated in the order in which is was added to the manager
 
@@ -141,6 +141,21 @@ namespace cro
         */
         bool isHidden() const { return m_hidden; }
 
+        /*!
+        \brief Marks this model as static, ie it never moves once added to the Scene.
+        When ModelRenderer has tree queries enabled the bounds of static models are
+        only inserted into the tree once, when the model is added, and are never
+        updated. Therefore the Transform of the entity should be set before the
+        Model component is added.
+        \see ModelRenderer::setUseTreeQueries()
+        */
+        void setStatic(bool isStatic) { m_static = isStatic; }
+
+        /*!
+        \brief Returns whether or not this model is marked as static
+        */
+        bool isStatic() const { return m_static; }
+
         /*!
         \brief Sets the render flags for this model.
         If the render flags, when AND'd with the current render flags of the active camera,
@@ -266,6 +281,7 @@ namespace cro
         void decrementDrawlistCount() const { m_drawlistCount--; } //hax because we're supposedly const while drawing
 
         bool m_hidden;
+        bool m_static;
         std::uint64_t m_renderFlags;
         std::uint32_t m_facing;
         cro::Sphere m_boundingSphere;
@@ -321,6 +337,10 @@ namespace cro
         std::int32_t m_treeID = -1;
         glm::vec3 m_lastWorldPosition = glm::vec3(0.f);
 
+        //set when the model is added to a camera draw list, and
+        //cleared by the SkeletalAnimator when choosing an update rate
+        bool m_visibleInDrawList = false;
+
         //we don't want to access this elsewhere, but we also
         //need to make sure we only update this once per tick
         //not every time one of the materials is rendered
@@ -331,5 +351,6 @@ namespace cro
         friend class ModelRenderer;
         friend class ShadowMapRenderer;
         friend class DeferredRenderSystem;
+        friend class SkeletalAnimator;
     };
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -39,13 +39,16 @@ source distribution.
 #include <crogine/detail/glm/vec3.hpp>
 
 #include <array>
+#include <vector>
 
 namespace cro
 {
     class TextureResource;
 
     /*!
-    \brief Data struct for a single particle
+    \brief Data struct for a single particle.
+    Used when spawning new particles, which are then
+    stored by the emitter in a ParticleData array.
     */
     struct CRO_EXPORT_API Particle final
     {
@@ -55,15 +58,71 @@ namespace cro
         
         glm::vec3 position = glm::vec3(0.f);
         glm::vec3 velocity = glm::vec3(0.f);
-        glm::vec3 gravity = glm::vec3(0.f);
         float lifetime = 0.f;
         float maxLifeTime = 1.f;
         float frameTime = 0.f;
         float rotation = 0.f;
         float scale = 1.f;
+
+        /*!
+        \deprecated Copied from EmitterSettings::gravity when the particle
+        is spawned, but no longer stored per particle. Modify the emitter's
+        settings instead, which also affects existing particles.
+        */
+        glm::vec3 gravity = glm::vec3(0.f);
+
+        /*!
+        \deprecated Copied from EmitterSettings::acceleration when the particle
+        is spawned, but no longer stored per particle. Modify the emitter's
+        settings instead, which also affects existing particles.
+        */
         float acceleration = 1.f;
     };
 
+    /*!
+    \brief Structure of arrays used by ParticleEmitters to store their particles.
+    Each array is indexed by particle, so that the ParticleSystem can update
+    several particles at once with SIMD instructions, and vertex data can be
+    read directly from each array when updating the emitter's VBO.
+    Gravity and acceleration are read from the EmitterSettings, so changing
+    them will affect existing particles.
+    */
+    struct CRO_EXPORT_API ParticleData final
+    {
+        explicit ParticleData(std::size_t count);
+
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> positionZ;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> velocityZ;
+        std::vector<float> lifetime;
+        std::vector<float> maxLifetime;
+        std::vector<float> alpha;
+        std::vector<float> rotation;
+        std::vector<float> scale;
+        std::vector<float> frameTime;
+        std::vector<Colour> colour; //!< alpha is stored separately in the alpha array
+        std::vector<std::uint32_t> frameID;
+        std::vector<std::uint32_t> loopCount;
+
+        /*!
+        \brief Returns the number of particles which can be stored
+        */
+        std::size_t size() const { return lifetime.size(); }
+
+        /*!
+        \brief Writes the given Particle to the arrays at the given index
+        */
+        void set(std::size_t index, const Particle& particle);
+
+        /*!
+        \brief Copies the particle at index src to index dst
+        */
+        void copy(std::size_t dst, std::size_t src);
+    };
+
     /*!
     \brief Encapsulates settings used by an emitter to
     initialise particles it creates
@@ -173,11 +232,7 @@ namespace cro
 
 
     private:
-        std::uint32_t m_vbo;
-        std::uint32_t m_vao; //< used on desktop
-        
-        //std::array<Particle, MaxParticles> m_particles;
-        std::vector<Particle> m_particles;
+        ParticleData m_particles;
         std::size_t m_nextFreeParticle;
 
         bool m_culledLastFrame;
@@ -195,6 +250,14 @@ namespace cro
 
         std::int32_t m_releaseCount;
 
+        //vertex data is packed here during the (parallel) update
+        //then streamed to the ParticleSystem's vertex buffer
+        std::vector<float> m_vertexData;
+        std::size_t m_vertexOffset; //first vertex in the stream buffer
+        std::size_t m_vertexCount;
+        std::uint64_t m_visibleFrame; //the last frame this was found in a draw list
+        std::uint64_t m_uploadFrame; //the last frame m_vertexOffset was valid
+
         friend class ParticleSystem;
     };
 }
\ No newline at end of file
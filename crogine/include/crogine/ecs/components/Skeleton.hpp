@@ -420,6 +420,15 @@ namespace cro
         */
         std::pair<std::int32_t, std::int32_t> getActiveAnimations() const { return std::make_pair(m_currentAnimation, m_nextAnimation); }
 
+        /*!
+        \brief Returns the animation LOD level assigned to this skeleton by the
+        SkeletalAnimator on the last frame. Level 0 is updated every frame, and
+        levels 1, 2 and 3 are updated every 2nd, 4th and 8th frame respectively.
+        Always returns 0 if LOD is not enabled on the SkeletalAnimator.
+        \see SkeletalAnimator::setLODEnabled()
+        */
+        std::int32_t getLODLevel() const { return m_lodLevel; }
+
     private:
 
         std::int32_t m_currentAnimation;
@@ -432,6 +441,9 @@ namespace cro
         bool m_useInterpolation;
         float m_interpolationDistance;
 
+        std::int32_t m_lodLevel = 0;
+        float m_lodTime = 0.f; //time accumulated over frames skipped by LOD
+
         std::size_t m_frameSize; //joints in a frame
         std::size_t m_frameCount;
         std::vector<Joint> m_frames; //indexed by steps of frameSize
@@ -448,6 +460,11 @@ namespace cro
 
         std::vector<cro::Box> m_keyFrameBounds; //calc'd on joining the System for each key frame
 
+        //joint indices sorted so that parents always come before their children
+        //allowing world transforms to be built in a single pass
+        std::vector<std::uint32_t> m_jointOrder;
+        void buildJointOrder();
+
         friend class SkeletalAnimator;
         friend struct SkeletalAnim;
         friend struct Detail::ModelBinary::SkeletonHeader;
@@ -39,6 +39,7 @@ source distribution.
 
 #include <vector>
 #include <functional>
+#include <atomic>
 
 #ifdef USE_PARALLEL_PROCESSING
 #include <mutex>
@@ -243,7 +244,11 @@ namespace cro
 
         /*!
         \brief Returns a matrix representing the world space Transform.
-        This is the local transform multiplied by all parenting transforms
+        This is the local transform multiplied by all parenting transforms.
+        The result is cached and only recalculated when this transform,
+        or one of its parents, has been modified since the last call.
+        Reading world transforms from multiple threads at once is safe,
+        provided that no transforms are modified at the same time.
         */
         glm::mat4 getWorldTransform() const;
 
@@ -298,6 +303,32 @@ namespace cro
         */
         void addCallback(std::function<void()> callback);
 
+        /*!
+        \brief Counters updated by resolveHierarchy()
+        */
+        struct ResolveStats final
+        {
+            std::uint32_t recomputed = 0; //!< world matrices which were dirty and recalculated
+            std::uint32_t reused = 0; //!< world matrices which were clean and reused from the cache
+        };
+
+        /*!
+        \brief Updates the cached world transform of this transform and all
+        of its children, parents first. This is called once per frame by the
+        Scene on each root transform so that subsequent calls to getWorldTransform()
+        et al during rendering return the cached values without walking the
+        hierarchy.
+        \param stats Optional pointer to a ResolveStats struct which has
+        its counters incremented for each transform visited
+        */
+        void resolveHierarchy(ResolveStats* stats = nullptr) const;
+
+        /*!
+        \brief Returns true if this transform is the root of a hierarchy
+        (ie it has no parent)
+        */
+        bool isRoot() const { return m_parent == nullptr; }
+
         static constexpr glm::vec3 X_AXIS = glm::vec3(1.f, 0.f, 0.f);
         static constexpr glm::vec3 Y_AXIS = glm::vec3(0.f, 1.f, 0.f);
         static constexpr glm::vec3 Z_AXIS = glm::vec3(0.f, 0.f, 1.f);
@@ -310,6 +341,15 @@ namespace cro
         glm::quat m_rotation;
         mutable glm::mat4 m_transform;
 
+        //cached world space values, updated by resolveHierarchy()
+        //or lazily when a getter is called on a dirty transform
+        mutable glm::mat4 m_worldTransform;
+        mutable glm::vec3 m_worldPosition;
+        mutable glm::vec3 m_worldScale;
+        mutable glm::quat m_worldRotation;
+        void updateWorldTransform() const;
+        void markWorldDirty(bool force = false);
+
         Transform* m_parent;
         std::vector<Transform*> m_children = {};
         void doCallbacks() const; //actually mutable - called from getTransform()
@@ -327,9 +367,12 @@ namespace cro
             Parent = 0x1,
             Child = 0x2,
             Tx = 0x4,
-            All = Parent | Child | Tx
+            World = 0x8,
+            All = Parent | Child | Tx | World
         };
-        mutable std::uint8_t m_dirtyFlags;
+        //atomic as world values are resolved lazily, and
+        //the flags may be read from parallel loops
+        mutable std::atomic<std::uint8_t> m_dirtyFlags;
 
         std::vector<std::function<void()>> m_callbacks;
 
@@ -339,6 +382,7 @@ namespace cro
         //skeletal attachment points
         glm::mat4 m_attachmentTransform;
         Attachment* m_attachmentParent = nullptr; //use this to make sure we're only parented to one attachment at a time.
+        void setAttachmentTransform(const glm::mat4&);
         friend class SkeletalAnimator;
         friend struct Attachment;
     };
@@ -36,7 +36,10 @@ source distribution.
 #include <crogine/ecs/components/Model.hpp>
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/graphics/UniformBuffer.hpp>
+#include <crogine/graphics/Spatial.hpp>
+#include <crogine/graphics/RenderStateCache.hpp>
 #include <crogine/detail/BalancedTree.hpp>
+#include <crogine/detail/ParallelCull.hpp>
 #include <crogine/detail/SDLResource.hpp>
 
 //#define BENCHMARK
@@ -147,6 +150,55 @@ namespace cro
         */
         static const std::string& getDefaultFragmentShader(std::int32_t type);
 
+        /*!
+        \brief Enables or disables culling with a bounding volume tree.
+        By default every Model is tested against the view frustum of each
+        active camera. When this is enabled Models are stored in a dynamic
+        AABB tree which is queried instead, so that large numbers of Models
+        outside of the view are rejected without being tested individually.
+        This works best for scenes with many Models which rarely move, as
+        the tree nodes of moving models need to be updated each frame.
+        \see Model::setStatic()
+        */
+        void setUseTreeQueries(bool useTree);
+
+        /*!
+        \brief Returns true if culling with a bounding volume tree is enabled
+        */
+        bool getUseTreeQueries() const { return m_useTreeQueries; }
+
+        struct TreeStats final
+        {
+            std::size_t nodesVisited = 0; //!< Number of tree nodes tested against camera frusta
+            std::size_t entitiesCulled = 0; //!< Number of Models rejected by the tree without being tested individually
+            std::size_t nodesUpdated = 0; //!< Number of non-static Models which were re-inserted into the tree
+        };
+
+        /*!
+        \brief Returns the statistics of the tree queries made for all cameras
+        during the last frame. These are all zero if tree queries are not enabled.
+        */
+        const TreeStats& getTreeStats() const { return m_treeStats; }
+
+        /*!
+        \brief Sets a vector to which render() records the commands it would
+        otherwise issue to OpenGL.
+        While a recorder is set no OpenGL commands are issued by render(), which
+        allows draw lists to be analysed, for example to count the number of state
+        changes made each frame, without an active OpenGL context. The
+        uniform buffers used by the renderer aren't created until the first
+        frame processed without a recorder.
+        \param recorder Pointer to a vector to which RenderCommands are appended.
+        The vector must remain valid until the recorder is removed by passing nullptr
+        */
+        void setCommandRecorder(std::vector<RenderCommand>* recorder);
+
+        /*!
+        \brief Returns the number of OpenGL state changes issued and skipped
+        as redundant during the last call to render()
+        */
+        const RenderStateCache::Stats& getStateStats() const { return m_stateCache.getStats(); }
+
         void onEntityAdded(Entity) override;
 
         void onEntityRemoved(Entity) override;
@@ -155,11 +207,19 @@ namespace cro
 
         using DrawList = std::array<PassList, 2u>;
         std::vector<DrawList> m_drawLists;
+        Detail::ParallelCuller<MaterialPair> m_culler;
+        SphereBatch m_cullSpheres; //indexed the same as the entity list
 
         Mesh::IndexData::Pass m_pass;
 
-        /*Detail::BalancedTree m_tree;
-        bool m_useTreeQueries;*/
+        Detail::BalancedTree m_tree;
+        bool m_useTreeQueries;
+        bool m_treeUpdatePending;
+        std::vector<Entity> m_treeCandidates;
+        TreeStats m_treeStats;
+
+        RenderStateCache m_stateCache;
+        std::vector<std::uint32_t> m_passUniformPrograms;
 
         struct CameraUniformBlock final
         {
@@ -181,7 +241,9 @@ namespace cro
             glm::vec3 lightDirection = glm::vec3(0.f, 0.f, 1.f);
             float Padding = 0.f;
         }m_lightUniforms;
-        UniformBuffer<LightUniformBlock> m_lightUBO;
+        //UBOs are created on first use so that no OpenGL
+        //commands are issued while a recorder is set
+        std::unique_ptr<UniformBuffer<LightUniformBlock>> m_lightUBO;
 
 #if defined(BENCHMARK)
         cro::HiResTimer m_timer;
@@ -199,7 +261,11 @@ namespace cro
         void flushEntity(Entity) override;
         void updateDrawListDefault(Entity);
         void updateDrawListBalancedTree(Entity);
-        //std::vector<Entity> queryTree(Box) const;
+        void cullEntities(Entity, const std::vector<Entity>&);
+
+        void addToTree(Entity);
+        void updateTree();
+        void queryTree(const Camera&, std::int32_t passCount);
 
         friend class DeferredRenderSystem;
         //these funcs are shared with above system - should probably be free funcs somewhere?
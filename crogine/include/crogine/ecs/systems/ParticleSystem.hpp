@@ -35,14 +35,22 @@ source distribution.
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/graphics/Shader.hpp>
 #include <crogine/graphics/Texture.hpp>
+#include <crogine/detail/ParallelCull.hpp>
 
 #include <crogine/gui/GuiClient.hpp>
 
+//#define BENCHMARK
+#ifdef BENCHMARK
+#include <crogine/core/HiResTimer.hpp>
+#endif
+
 #include <vector>
 #include <memory>
 
 namespace cro
 {
+    class ParticleEmitter;
+
     /*!
     \brief Particle system.
     Updates and renders all particle emitters in the scene.
@@ -53,7 +61,7 @@ namespace cro
     particle systems.
     */
     class CRO_EXPORT_API ParticleSystem final : public Renderable, public System
-#ifdef CRO_DEBUG_
+#if defined(CRO_DEBUG_) || defined(BENCHMARK)
         ,public GuiClient
 #endif
     {
@@ -80,11 +88,21 @@ namespace cro
         */
         void setRandomColours(const std::array<Colour, MaxRandomColours>& colours) { m_randomColours = colours; }
 
+        /*!
+        \brief Returns the number of bytes of vertex data streamed to the GPU
+        during the last call to process().
+        Only emitters which appear in the draw list of at least one camera
+        are uploaded, so this should be proportional to the number of
+        visible particles rather than the total number of particles.
+        */
+        std::size_t getBytesUploaded() const { return m_bytesUploaded; }
+
     private:
         //for two passes, normal and reflection
         using DrawList = std::array<std::vector<Entity>, 2u>;
         //one of these is inserted for each active camera based on the Camera draw list index
         std::vector<DrawList> m_drawLists;
+        Detail::ParallelCuller<Entity> m_culler;
 
         //std::vector<Entity> m_potentiallyVisible; //entities which are in front of at least one camera
 
@@ -92,11 +110,30 @@ namespace cro
         void onEntityRemoved(Entity) override;
         void flushEntity(Entity) override;
 
-        std::vector<float> m_dataBuffer;
-        std::vector<std::uint32_t> m_vboIDs;
-        std::vector<std::uint32_t> m_vaoIDs; //< used on desktop
-        std::size_t m_nextBuffer;
-        std::size_t m_bufferCount;
+        //vertex data of all visible emitters is written to a single
+        //ring buffer each frame, which is persistently mapped where
+        //glBufferStorage is available, else orphaned when it wraps.
+        struct StreamBuffer final
+        {
+            static constexpr std::size_t SegmentCount = 3;
+
+            std::uint32_t vbo = 0;
+            std::uint32_t vao = 0; //< used on desktop
+            std::size_t capacity = 0; //< in vertices, per segment if persistent
+            std::size_t head = 0; //< next free vertex when orphaning
+            std::size_t segment = 0;
+            bool persistent = false;
+            void* mappedData = nullptr;
+            std::array<void*, SegmentCount> fences = {}; //< GLsync
+        }m_streamBuffer;
+
+        std::uint64_t m_frameID;
+        std::size_t m_bytesUploaded;
+        std::vector<ParticleEmitter*> m_uploadList;
+
+        void createStreamBuffer(std::size_t vertexCount);
+        void deleteStreamBuffer();
+        void uploadVertexData();
 
         //this is a fallback texture for untextured systems.
         //probably not less optimal than switching between
@@ -105,8 +142,6 @@ namespace cro
 
         std::array<cro::Colour, MaxRandomColours> m_randomColours = {};
 
-        void allocateBuffer();
-
         std::vector<std::unique_ptr<Shader>> m_shaders;
 
         enum UniformID
@@ -150,5 +185,13 @@ namespace cro
             };
         };
         std::array<ShaderHandle, ShaderID::Count> m_shaderHandles = {};
+
+#ifdef BENCHMARK
+        cro::HiResTimer m_timer;
+        static constexpr std::size_t MaxBenchSamples = 60;
+        std::array<float, MaxBenchSamples> m_benchSamples = {};
+        std::size_t m_benchIndex = 0;
+        float m_avgUpdateTime = 0.f;
+#endif
     };
 }
\ No newline at end of file
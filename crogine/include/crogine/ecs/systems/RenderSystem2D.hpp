@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/graphics/Shader.hpp>
 #include <crogine/detail/QuadTree.hpp>
+#include <crogine/detail/ParallelCull.hpp>
 #include <crogine/detail/glm/vec2.hpp>
 #include <crogine/detail/glm/matrix.hpp>
 
@@ -153,6 +154,7 @@ namespace cro
         DepthAxis m_sortOrder;
         bool m_needsSort;
         std::vector<std::vector<Entity>> m_drawLists;
+        Detail::ParallelCuller<Entity> m_culler;
 
         void applyBlendMode(Material::BlendMode);
         glm::ivec2 mapCoordsToPixel(glm::vec2, const glm::mat4& viewProjMat, IntRect) const;
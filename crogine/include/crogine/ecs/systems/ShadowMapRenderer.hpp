@@ -36,6 +36,8 @@ source distribution.
 #include <crogine/graphics/DepthTexture.hpp>
 #include <crogine/graphics/SimpleQuad.hpp>
 #include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/Spatial.hpp>
+#include <crogine/detail/ParallelCull.hpp>
 
 #ifdef CRO_DEBUG_
 #include <crogine/gui/GuiClient.hpp>
@@ -146,6 +148,8 @@ namespace cro
         };
         //for each camera, for each camera cascade, a vector of entities
         std::vector<std::vector<std::vector<Drawable>>> m_drawLists;
+        Detail::ParallelCuller<Drawable> m_culler;
+        SphereBatch m_cullSpheres; //indexed the same as the entity list
 
         //buffer to render first pass blur if soft shadowing
         DepthTexture m_blurBuffer;
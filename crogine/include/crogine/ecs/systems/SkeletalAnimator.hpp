@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/ecs/components/Skeleton.hpp>
 #include <crogine/graphics/MeshData.hpp>
 
+#include <array>
 #include <vector>
 
 namespace cro
@@ -52,8 +53,66 @@ namespace cro
 
         float getPlaybackRate() const;
 
+        /*!
+        \brief Enables or disables animation LOD.
+        When enabled skeletons which were not in the draw list of any camera
+        on the previous frame, or which appear small on screen, are updated
+        at 1/2, 1/4 or 1/8 of the frame rate instead of every frame. The
+        update phase of each skeleton is offset by its entity ID so that the
+        work is spread evenly over consecutive frames. Skipped time is
+        accumulated and applied on the next update, so animations keep
+        their correct speed and notification events are still raised.
+        Attachments are updated every frame regardless. Disabled by default.
+        \see setLODSettings()
+        */
+        void setLODEnabled(bool enabled);
+
+        /*!
+        \brief Returns true if animation LOD is enabled
+        */
+        bool getLODEnabled() const { return m_lodEnabled; }
+
+        struct LODSettings final
+        {
+            //the minimum projected size of a skeleton's bounding sphere, as a
+            //fraction of the viewport height, at which LOD levels 0, 1 and 2 are
+            //used. Visible skeletons smaller than this, and all skeletons which
+            //were culled from the last draw list, use level 3.
+            std::array<float, 3u> screenSize = { 0.25f, 0.1f, 0.04f };
+        };
+
+        /*!
+        \brief Sets the screen size thresholds used to select animation LOD levels
+        \see LODSettings
+        */
+        void setLODSettings(const LODSettings& settings);
+
+        /*!
+        \brief Returns the current LOD settings
+        */
+        const LODSettings& getLODSettings() const { return m_lodSettings; }
+
+        struct LODStats final
+        {
+            static constexpr std::size_t LevelCount = 4;
+
+            std::size_t evaluated = 0; //!< number of skeletons which were updated on the last frame
+            std::size_t skipped = 0; //!< number of skeletons whose update was deferred by LOD
+            std::array<std::size_t, LevelCount> levelCounts = {}; //!< number of skeletons assigned to each LOD level
+        };
+
+        /*!
+        \brief Returns the animation LOD statistics for the last frame
+        */
+        const LODStats& getLODStats() const { return m_lodStats; }
+
     private:
-        
+
+        bool m_lodEnabled;
+        std::uint32_t m_frameCounter;
+        LODSettings m_lodSettings;
+        LODStats m_lodStats;
+
         void onEntityAdded(Entity) override;
 
         struct AnimationContext final
@@ -32,6 +32,8 @@ source distribution.
 #include <crogine/Config.hpp>
 #include <crogine/core/Log.hpp>
 #include <crogine/graphics/ImageArray.hpp>
+#include <crogine/graphics/CompressedImage.hpp>
+#include <crogine/graphics/Texture.hpp>
 #include <crogine/graphics/MaterialData.hpp>
 #include <crogine/detail/OpenGL.hpp>
 #include <crogine/detail/glm/vec2.hpp>
@@ -53,7 +55,8 @@ namespace cro
 
     Currently only supports 4 channel image data. Precision
     paramater only affects float textures, where low precision
-    uses 16 bit floats instead of 32 bit.
+    uses 16 bit floats instead of 32 bit. 8 bit textures can also
+    be created from CompressedImages.
     */
     template <class T, std::uint32_t Layers, std::uint32_t Precision = TexturePrecision::High>
     class ArrayTexture final
@@ -114,6 +117,14 @@ namespace cro
                 glGenTextures(1, &m_handle);
             }
 
+            if (m_compressed)
+            {
+                //compressed images may have limited the mip chain
+                glBindTexture(Layers == 1 ? GL_TEXTURE_2D : GL_TEXTURE_2D_ARRAY, m_handle);
+                glTexParameteri(Layers == 1 ? GL_TEXTURE_2D : GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 1000);
+                m_compressed = false;
+            }
+
             if constexpr (Layers == 1)
             {
                 //create a regular texture so we can at least render a preview with ImGui or so
@@ -139,6 +150,90 @@ namespace cro
             m_height = height;
         }
 
+        /*!
+        \brief Creates the texture from a CompressedImage containing the
+        same number of layers as this texture, including any mip levels.
+        Images are uploaded in the order their rows are stored, see
+        CompressedImage::isBottomUp(). If the format of the image isn't
+        supported on this device the top level of each layer is decompressed
+        instead, where possible. Compressed textures can't have layers inserted.
+        \returns true on success, else false
+        */
+        bool create(const CompressedImage& image)
+        {
+            static_assert(std::is_same<T, std::uint8_t>::value, "Must be a uint8_t texture");
+
+            if (image.getLayerCount() != Layers
+                || image.getFaceCount() != 1)
+            {
+                LogE << __FILE__ << " compressed image has " << image.getLayerCount() << " layers, expected " << Layers << std::endl;
+                return false;
+            }
+
+            const auto size = image.getSize();
+            if (!Texture::isFormatSupported(image.getFormat()))
+            {
+                if (!CompressedImage::canDecompress(image.getFormat()))
+                {
+                    LogE << __FILE__ << " " << CompressedImage::getFormatName(image.getFormat()) << " is not supported on this device" << std::endl;
+                    return false;
+                }
+
+                create(size.x, size.y);
+                std::vector<std::uint8_t> pixels;
+                for (auto i = 0u; i < Layers; ++i)
+                {
+                    if (!image.decompress(pixels, 0, i)
+                        || !updateTexture(pixels.data(), i))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            if (!m_handle)
+            {
+                glGenTextures(1, &m_handle);
+            }
+
+            const auto glFormat = CompressedImage::getGLFormat(image.getFormat());
+            const auto levelCount = image.getLevelCount();
+            const GLenum target = Layers == 1 ? GL_TEXTURE_2D : GL_TEXTURE_2D_ARRAY;
+
+            glBindTexture(target, m_handle);
+            for (auto i = 0u; i < levelCount; ++i)
+            {
+                const auto levelSize = image.getSize(i);
+                const auto dataSize = static_cast<GLsizei>(image.getDataSize(i) * Layers);
+                if constexpr (Layers == 1)
+                {
+                    glCompressedTexImage2D(GL_TEXTURE_2D, i, glFormat, levelSize.x, levelSize.y, 0, dataSize, image.getData(i));
+                }
+                else
+                {
+                    glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, i, glFormat, levelSize.x, levelSize.y, Layers, 0, dataSize, image.getData(i));
+                }
+            }
+
+            if constexpr (Layers > 1)
+            {
+                glTexParameteri(target, GL_TEXTURE_WRAP_R, GL_REPEAT);
+            }
+            glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(target, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_NEAREST_MIPMAP_LINEAR : GL_NEAREST);
+            glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+            glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+            m_width = size.x;
+            m_height = size.y;
+            m_compressed = true;
+
+            return true;
+        }
+
         std::uint32_t getGLHandle() const { return m_handle; }
         glm::uvec2 getSize() const { return glm::uvec2(m_width, m_height); }
 
@@ -248,8 +343,16 @@ namespace cro
         std::uint32_t m_width = 0;
         std::uint32_t m_height = 0;
 
+        bool m_compressed = false;
+
         bool updateTexture(const void* data, std::uint32_t layer)
         {
+            if (m_compressed)
+            {
+                LogE << __FILE__ << " compressed textures can't be updated" << std::endl;
+                return false;
+            }
+
             if (m_handle)
             {
                 if constexpr (Layers == 1)
@@ -0,0 +1,242 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/detail/glm/vec2.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cro
+{
+    /*!
+    \brief CPU side representation of a block compressed image.
+    CompressedImages can be loaded from KTX2 or DDS containers which hold
+    BC1-5, BC7 or ETC2 data, including any pre-generated mip levels, array
+    layers or cubemap faces. They are usually uploaded to the GPU as they are
+    via Texture, ArrayTexture or CubemapTexture, although BC1-5 and ETC2
+    images can also be decompressed to RGBA on platforms which don't support
+    their format natively.
+
+    No OpenGL context is required to load, modify or save a CompressedImage.
+    KTX2 files with supercompression (such as Basis Universal) are not supported.
+    sRGB formats are loaded as their linear equivalent, as with other textures.
+    */
+    class CRO_EXPORT_API CompressedImage final
+    {
+    public:
+        struct Format final
+        {
+            enum Type
+            {
+                None,
+                BC1RGB,
+                BC1RGBA,
+                BC2,
+                BC3,
+                BC4,
+                BC5,
+                BC7,
+                ETC2RGB,
+                ETC2RGBA,
+
+                Count
+            };
+        };
+
+        CompressedImage();
+
+        /*!
+        \brief Creates an empty image of the given format.
+        The data for each image can then be written with getData()
+        \param format The compressed format of the image
+        \param size The size in pixels of the top mip level
+        \param levelCount Number of mip levels to allocate. This is
+        clamped to the number of levels required for a complete chain
+        \param layerCount Number of array layers
+        \param faceCount 1 for regular images or 6 for cubemaps
+        \returns false if any of the parameters are invalid
+        */
+        bool create(Format::Type format, glm::uvec2 size, std::uint32_t levelCount = 1, std::uint32_t layerCount = 1, std::uint32_t faceCount = 1);
+
+        /*!
+        \brief Attempts to load a *.ktx2 or *.dds file from the given path
+        \returns true on success, else false
+        */
+        bool loadFromFile(const std::string& path);
+
+        /*!
+        \brief Attempts to load a KTX2 or DDS container from memory
+        \returns true on success, else false
+        */
+        bool loadFromMemory(const void* data, std::size_t size);
+
+        /*!
+        \brief Saves the image to a KTX2 file at the given path.
+        \returns true on success else false
+        */
+        bool saveToFile(const std::string& path) const;
+
+        /*!
+        \brief Returns the format of the compressed data, or Format::None
+        if no image is loaded
+        */
+        Format::Type getFormat() const { return m_format; }
+
+        /*!
+        \brief Returns the size in pixels of the given mip level
+        */
+        glm::uvec2 getSize(std::uint32_t level = 0) const;
+
+        std::uint32_t getLevelCount() const { return static_cast<std::uint32_t>(m_levels.size()); }
+        std::uint32_t getLayerCount() const { return m_layerCount; }
+        std::uint32_t getFaceCount() const { return m_faceCount; }
+
+        /*!
+        \brief Returns a pointer to the compressed data of the given mip level,
+        array layer and cubemap face. All the layers and faces of a level
+        are stored contiguously, layer by layer, so the pointer to layer and
+        face 0 can be used to upload entire levels of arrays or cubemaps.
+        \returns nullptr if the requested image doesn't exist
+        */
+        const std::uint8_t* getData(std::uint32_t level = 0, std::uint32_t layer = 0, std::uint32_t face = 0) const;
+        std::uint8_t* getData(std::uint32_t level = 0, std::uint32_t layer = 0, std::uint32_t face = 0);
+
+        /*!
+        \brief Returns the size in bytes of a single layer or face of the given mip level
+        */
+        std::size_t getDataSize(std::uint32_t level = 0) const;
+
+        /*!
+        \brief Returns true if the first row of each image is the bottom
+        row, as OpenGL expects, rather than the top row.
+        Images loaded from DDS files are always top-down.
+        */
+        bool isBottomUp() const { return m_bottomUp; }
+        void setBottomUp(bool bottomUp) { m_bottomUp = bottomUp; }
+
+        /*!
+        \brief Flips all the images vertically without decompressing them.
+        This is only possible with BC1-5 formats and levels whose height
+        is either less than or a multiple of 4, else this returns false
+        and the image is not modified.
+        */
+        bool flipVertically();
+
+        /*!
+        \brief Returns the index of the largest mip level no larger than
+        maxSize in either dimension, after skipping the given number of levels.
+        The smallest level is returned if none fit.
+        */
+        std::uint32_t selectBaseLevel(std::uint32_t maxSize, std::uint32_t skip = 0) const;
+
+        /*!
+        \brief Removes all the mip levels larger than the given level,
+        so that it becomes level 0
+        */
+        void setBaseLevel(std::uint32_t level);
+
+        /*!
+        \brief Decompresses the requested image to 8 bit RGBA.
+        Rows are written in the same order as they are stored.
+        \param dst Vector to hold the decompressed pixels. This is resized
+        to fit the image
+        \returns false if the image doesn't exist or its format can't be decompressed
+        \see canDecompress()
+        */
+        bool decompress(std::vector<std::uint8_t>& dst, std::uint32_t level = 0, std::uint32_t layer = 0, std::uint32_t face = 0) const;
+
+        /*!
+        \brief Returns true if the given format can be decompressed on the CPU.
+        Currently this is all formats except BC7.
+        */
+        static bool canDecompress(Format::Type format);
+
+        /*!
+        \brief Returns the number of bytes used to store each 4x4 block
+        of pixels in the given format
+        */
+        static std::size_t getBlockSize(Format::Type format);
+
+        /*!
+        \brief Returns the number of bytes used by an image of the given
+        format and dimensions
+        */
+        static std::size_t getImageSize(Format::Type format, glm::uvec2 size);
+
+        /*!
+        \brief Returns the OpenGL internal format used to upload the
+        given format, or 0 if it is invalid
+        */
+        static std::uint32_t getGLFormat(Format::Type format);
+
+        /*!
+        \brief Returns the name of the given format as a string
+        */
+        static const std::string& getFormatName(Format::Type format);
+
+        /*!
+        \brief Returns the path to a KTX2 or DDS file which should be loaded
+        in place of the image at the given path, or an empty string if there
+        is none. If the path is already a compressed file it is returned as
+        it is. Otherwise a *.ktx2 or *.dds file with the same name is returned
+        if it is newer than the given file.
+        */
+        static std::string getCompressedPath(const std::string& path);
+
+        /*!
+        \brief Returns the path of an uncompressed image with the same name
+        as the given compressed file, or an empty string if none exists.
+        Used as a fallback when a compressed image can't be loaded.
+        */
+        static std::string getUncompressedPath(const std::string& path);
+
+    private:
+        Format::Type m_format;
+        glm::uvec2 m_size;
+        std::uint32_t m_layerCount;
+        std::uint32_t m_faceCount;
+        bool m_bottomUp;
+
+        struct Level final
+        {
+            std::size_t offset = 0; //start of the level in m_data
+            std::size_t imageSize = 0; //size of a single layer/face
+        };
+        std::vector<Level> m_levels;
+        std::vector<std::uint8_t> m_data;
+
+        bool loadKTX2(const std::uint8_t* data, std::size_t size);
+        bool loadDDS(const std::uint8_t* data, std::size_t size);
+    };
+}
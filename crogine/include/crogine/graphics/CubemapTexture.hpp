@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2022 - 2024
+Matt Marchant 2022 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -49,6 +49,10 @@ namespace cro
     /endcode
     Image files may be referenced in the same directory as the *.ccm file, be realtive
     to the current working directory or have absolute paths.
+
+    Cubemaps can also be loaded from KTX2 or DDS files containing six faces,
+    including any mip levels they contain. If such a file exists with the same
+    name as a *.ccm file, and is at least as new, it is loaded in its place.
     */
     class CRO_EXPORT_API CubemapTexture : public Detail::SDLResource
     {
@@ -72,7 +76,9 @@ namespace cro
         std::uint32_t getCubemapCount() const { return m_cubemapCount; }
 
         /*!
-        \brief Attempts to load a cubemap from a *.ccm configuration file
+        \brief Attempts to load a cubemap from a *.ccm configuration file,
+        or a compressed *.ktx2 or *.dds file. Compressed files which contain
+        more than one cubemap are loaded as a cubemap array.
         \returns true on success else false.
         */
         bool loadFromFile(const std::string& path);
@@ -96,5 +102,6 @@ namespace cro
         std::uint32_t m_cubemapCount;
 
         bool parseInputFile(const std::string& filePath, std::array<std::string, 6u>& outFiles);
+        bool loadCompressed(const std::string& path);
     };
 }
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -40,6 +40,7 @@ source distribution.
 #include <crogine/detail/glm/mat4x4.hpp>
 
 #include <unordered_map>
+#include <vector>
 
 namespace cro
 {
@@ -166,8 +167,141 @@ namespace cro
             Property();
         };
 
-        //allows looking up uniform name when paired location/value
-        using PropertyList = std::unordered_map<std::string, std::pair<std::int32_t, Property>>;
+        /*!
+        \brief Allows looking up uniform name when paired location/value.
+        Behaves as an unordered_map, but counts every change to its
+        structure, ie insertions, erasures and clears, so that anything
+        holding pointers to its elements, such as Data::getResolvedProperties(),
+        knows when they may have been invalidated.
+        */
+        class CRO_EXPORT_API PropertyList final
+        {
+        public:
+            using Map = std::unordered_map<std::string, std::pair<std::int32_t, Property>>;
+            using key_type = Map::key_type;
+            using mapped_type = Map::mapped_type;
+            using value_type = Map::value_type;
+            using size_type = Map::size_type;
+            using iterator = Map::iterator;
+            using const_iterator = Map::const_iterator;
+
+            iterator begin() { return m_map.begin(); }
+            iterator end() { return m_map.end(); }
+            const_iterator begin() const { return m_map.begin(); }
+            const_iterator end() const { return m_map.end(); }
+            const_iterator cbegin() const { return m_map.cbegin(); }
+            const_iterator cend() const { return m_map.cend(); }
+
+            bool empty() const { return m_map.empty(); }
+            size_type size() const { return m_map.size(); }
+            size_type count(const key_type& key) const { return m_map.count(key); }
+
+            iterator find(const key_type& key) { return m_map.find(key); }
+            const_iterator find(const key_type& key) const { return m_map.find(key); }
+
+            mapped_type& at(const key_type& key) { return m_map.at(key); }
+            const mapped_type& at(const key_type& key) const { return m_map.at(key); }
+
+            mapped_type& operator[](const key_type& key)
+            {
+                const auto size = m_map.size();
+                auto& value = m_map[key];
+                if (m_map.size() != size)
+                {
+                    m_generation++;
+                }
+                return value;
+            }
+
+            template <typename T>
+            std::pair<iterator, bool> insert(T&& value)
+            {
+                auto result = m_map.insert(std::forward<T>(value));
+                if (result.second)
+                {
+                    m_generation++;
+                }
+                return result;
+            }
+
+            template <typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args)
+            {
+                auto result = m_map.emplace(std::forward<Args>(args)...);
+                if (result.second)
+                {
+                    m_generation++;
+                }
+                return result;
+            }
+
+            iterator erase(const_iterator position)
+            {
+                m_generation++;
+                return m_map.erase(position);
+            }
+
+            size_type erase(const key_type& key)
+            {
+                const auto count = m_map.erase(key);
+                if (count)
+                {
+                    m_generation++;
+                }
+                return count;
+            }
+
+            void clear()
+            {
+                m_map.clear();
+                m_generation++;
+            }
+
+            /*!
+            \brief Returns a value which changes every time an
+            element is inserted or erased
+            */
+            std::size_t getGeneration() const { return m_generation; }
+
+        private:
+            Map m_map;
+            std::size_t m_generation = 0;
+        };
+
+        /*!
+        \brief A material Property paired with its uniform location.
+        Renderers use a flat array of these, rather than iterating the
+        PropertyList, so that no string keyed lookups are made at draw time.
+        \see Data::getResolvedProperties()
+        */
+        struct ResolvedProperty final
+        {
+            std::int32_t location = -1;
+            const Property* property = nullptr;
+        };
+
+        /*!
+        \brief Counts the number of string keyed property lookups,
+        and the number of times a list of resolved properties was
+        (re)allocated, during the last frame. These are updated by
+        the App at the end of every frame, and can be used to catch
+        regressions where properties are set by name in hot loops.
+        */
+        struct CRO_EXPORT_API Stats final
+        {
+            std::size_t propertyLookups = 0;
+            std::size_t resolvedAllocations = 0;
+        };
+
+        /*!
+        \brief Returns the Stats for the last completed frame
+        */
+        CRO_EXPORT_API const Stats& getFrameStats();
+
+        /*!
+        \brief Used internally by the App to mark the end of a frame
+        */
+        CRO_EXPORT_API void updateFrameStats();
 
         /*!
         \brief Material data held by a model component and used for rendering.
@@ -180,7 +314,8 @@ namespace cro
             {
                 Index = 0,
                 Size,
-                Offset
+                Offset,
+                Format //!< Mesh::AttributeFormat of the attribute in the mesh VBO
             };
 
             /*!
@@ -315,6 +450,11 @@ namespace cro
             */
             void disableCustomSettings() const;
 
+            /*!
+            \brief Returns true if this material has any custom settings
+            */
+            bool hasCustomSettings() const { return m_customSettingsCount != 0; }
+
             /*!
             \brief Animation data used if material is animated
             Note that this cannot be changed once it is assigned
@@ -361,6 +501,16 @@ namespace cro
             */
             bool hasLightUBO() const { return m_hasLightUBO; }
 
+            /*!
+            \brief Returns the properties of this material as a flat array sorted
+            by uniform location. The array is rebuilt if properties have been added
+            or removed since the last time it was requested, or if the material has
+            been copied, otherwise no lookups or allocations are made. Setting the
+            value of an existing property doesn't require a rebuild.
+            Used internally by renderers.
+            */
+            const std::vector<ResolvedProperty>& getResolvedProperties() const;
+
 
             /*
             Here be dragons! Don't modify these variables as they are configured
@@ -368,8 +518,8 @@ namespace cro
             */
 
             std::uint32_t shader = 0;
-            //maps attrib location to attrib size between shader and mesh - index, size, pointer offset
-            std::array<std::array<std::int32_t, 3u>, Shader::AttributeID::Count> attribs{};
+            //maps attrib location to attrib size between shader and mesh - index, size, pointer offset, format
+            std::array<std::array<std::int32_t, 4u>, Shader::AttributeID::Count> attribs{};
             std::size_t attribCount = 0; //< count of attributes successfully mapped
             //maps uniform locations by indexing via Uniform enum
             std::array<std::int32_t, Uniform::Total> uniforms{-1,-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
@@ -384,10 +534,25 @@ namespace cro
         private:
             std::unordered_map<std::string, bool> m_warnings;
             void exists(const std::string&);
+            Property* findProperty(const std::string&);
 
             bool m_hasCameraUBO = false;
             bool m_hasLightUBO = false;
 
+            //this points into the PropertyList owned by this instance so
+            //copies always start empty and are rebuilt from their own list
+            struct ResolvedList final
+            {
+                ResolvedList() = default;
+                ResolvedList(const ResolvedList&) {}
+                ResolvedList& operator = (const ResolvedList&) { properties.clear(); dirty = true; return *this; }
+
+                std::vector<ResolvedProperty> properties;
+                std::size_t generation = 0; //of the PropertyList when this was built
+                bool dirty = true;
+            };
+            mutable ResolvedList m_resolvedProperties;
+
             static constexpr std::size_t MaxCustomSettings = 10;
             std::size_t m_customSettingsCount = 0;
             std::array<std::uint32_t, MaxCustomSettings> m_customSettings = {};
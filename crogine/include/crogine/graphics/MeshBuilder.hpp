@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -100,6 +100,36 @@ namespace cro
         */
         virtual Skeleton getSkeleton() const { return {}; }
 
+        /*!
+        \brief Requests that the given attribute is stored in the given
+        Mesh::AttributeFormat when the mesh is built, reducing the size
+        of the mesh's vertex data.
+        Position and BlendIndices are always stored as floats. Colours and
+        BlendWeights may be HalfFloat or UNorm8, normals, tangents and
+        bitangents HalfFloat or SNorm10_10_10_2 and UVs HalfFloat. Requests
+        for any other format are ignored. This is only supported by builders
+        which create static meshes from float vertex data, and has no effect
+        on mobile platforms. Note that the MeshResource will return existing
+        mesh data if a builder with the same UID has already been loaded, in
+        which case the formats of the existing mesh are used.
+        \param attribute Mesh::Attribute to set the format of
+        \param format Mesh::AttributeFormat in which to store the attribute
+        */
+        void setAttributeFormat(Mesh::Attribute attribute, std::uint8_t format);
+
+        /*!
+        \brief Sets the default quantised formats for all attributes which
+        support them, or resets them all to floats.
+        When enabled colours are stored as UNorm8, normals, tangents and
+        bitangents as SNorm10_10_10_2 and UVs as HalfFloat.
+        */
+        void setQuantised(bool quantised);
+
+        /*!
+        \brief Returns the Mesh::AttributeFormat requested for each attribute
+        */
+        const std::array<std::uint8_t, Mesh::Attribute::Total>& getAttributeFormats() const { return m_attributeFormats; }
+
     protected:
         friend class MeshResource;
         friend class SpriteSystem3D;
@@ -112,7 +142,24 @@ namespace cro
 
         static std::size_t getAttributeSize(const std::array<std::size_t, Mesh::Attribute::Total>& attrib);
         static std::size_t getVertexSize(const std::array<std::size_t, Mesh::Attribute::Total>& attrib);
-        static void createVBO(Mesh::Data& meshData, const std::vector<float>& vertexData);
+
+        /*!
+        \brief Uploads the given float vertex data, laid out as described by
+        meshData.attributes, to a new VBO. Any attributes for which a format
+        has been requested with setAttributeFormat() are packed first, and
+        meshData.vertexSize and meshData.attributeFormats are updated to match.
+        */
+        void createVBO(Mesh::Data& meshData, const std::vector<float>& vertexData) const;
+        void createVBO(Mesh::Data& meshData, const float* vertexData) const;
+
+        /*!
+        \brief Uploads meshData.vertexCount vertices of meshData.vertexSize
+        bytes as they are.
+        */
+        static void createVBO(Mesh::Data& meshData, const void* vertexData);
         static void createIBO(Mesh::Data& meshData, const void* idxData, std::size_t idx, std::int32_t dataSize);
+
+    private:
+        std::array<std::uint8_t, Mesh::Attribute::Total> m_attributeFormats = {};
     };
 }
\ No newline at end of file
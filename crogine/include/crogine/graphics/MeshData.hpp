@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2021
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -76,6 +76,27 @@ namespace cro
             Total
         };
 
+        /*!
+        \brief Storage formats of vertex attributes.
+        By default all attributes are stored as 32 bit floats. Static
+        meshes may request that some attributes are stored in smaller
+        formats with MeshBuilder::setAttributeFormat(). These are unpacked
+        by the GPU when the vertex data is read so that no changes
+        are required to existing shaders.
+        */
+        struct AttributeFormat final
+        {
+            enum
+            {
+                Float,          //!< 32 bit float per component
+                HalfFloat,      //!< 16 bit float per component. Suitable for UV coordinates
+                UNorm8,         //!< 8 bit unsigned normalised integer per component. Suitable for colours or blend weights in the range 0-1
+                SNorm10_10_10_2, //!< Up to 4 signed normalised components packed into 32 bits. Suitable for normals, tangents and bitangents
+
+                Count
+            };
+        };
+
         /*!
         \brief Index data for sub-mesh
         */
@@ -111,6 +132,7 @@ namespace cro
             std::uint32_t primitiveType = 0;
             std::array<std::size_t, Mesh::Attribute::Total> attributes{}; //!< size of attribute if it exists
             std::uint32_t attributeFlags = 0; //!< bitmask of VertexProperty flags indicating the current properties of the vertex data.
+            std::array<std::uint8_t, Mesh::Attribute::Total> attributeFormats{}; //!< AttributeFormat in which each attribute is stored in the VBO
 
             //index arrays
             std::size_t submeshCount = 0;
@@ -122,7 +144,59 @@ namespace cro
         };
 
         /*!
-        \brief Utility to read back vertex data and index data
+        \brief Returns the number of bytes used to store an attribute
+        with the given number of components in the given AttributeFormat.
+        Attributes are padded to a multiple of 4 bytes.
+        */
+        std::size_t CRO_EXPORT_API getAttributeByteSize(std::size_t componentCount, std::uint8_t format);
+
+        /*!
+        \brief Returns the offset in bytes of each attribute from the start
+        of a vertex in the VBO of the given mesh data, taking into account
+        the format in which each attribute is stored.
+        */
+        std::array<std::size_t, Mesh::Attribute::Total> CRO_EXPORT_API getAttributeOffsets(const Data& meshData);
+
+        /*!
+        \brief Returns the size in bytes of a single vertex of the given mesh
+        data if all of its attributes were stored as floats. This is the stride
+        of the vertex data returned by readVertexData() and is the same as
+        Data::vertexSize for meshes which have not been quantised.
+        */
+        std::size_t CRO_EXPORT_API getUnpackedVertexSize(const Data& meshData);
+
+        /*!
+        \brief Returns the number of bytes of VBO memory saved by storing
+        the vertex data of the given mesh in its quantised formats, or 0
+        if the mesh is stored entirely as floats.
+        */
+        std::size_t CRO_EXPORT_API getQuantisedBytesSaved(const Data& meshData);
+
+        /*!
+        \brief Packs float vertex data into the formats given by Data::attributeFormats.
+        \param meshData Mesh data describing the attributes, their formats and
+        the number of vertices. Data::vertexSize is ignored and expected to be
+        updated with the returned vertex size.
+        \param src Pointer to meshData.vertexCount vertices laid out as floats
+        as described by Data::attributes
+        \param dst Vector to receive the packed vertex data
+        \returns The size in bytes of a single packed vertex
+        */
+        std::size_t CRO_EXPORT_API packVertexData(const Data& meshData, const float* src, std::vector<std::uint8_t>& dst);
+
+        /*!
+        \brief Unpacks vertex data stored in the formats given by Data::attributeFormats
+        into floats, laid out as described by Data::attributes
+        \param meshData Mesh data describing the attributes and their formats
+        \param src Pointer to meshData.vertexCount vertices, each Data::vertexSize bytes
+        \param dst Vector to receive the unpacked vertices
+        */
+        void CRO_EXPORT_API unpackVertexData(const Data& meshData, const std::uint8_t* src, std::vector<float>& dst);
+
+        /*!
+        \brief Utility to read back vertex data and index data.
+        Vertex data is always returned as floats, unpacking any quantised
+        attributes, so vertices are getUnpackedVertexSize() bytes apart.
         */
         void CRO_EXPORT_API readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint8_t>>& destIndices);
         void CRO_EXPORT_API readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint16_t>>& destIndices);
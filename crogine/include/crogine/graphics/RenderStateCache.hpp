@@ -0,0 +1,194 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace cro
+{
+    namespace Material
+    {
+        struct Data;
+    }
+
+    /*!
+    \brief A command recorded by a RenderStateCache when it
+    is created with a recorder.
+    */
+    struct CRO_EXPORT_API RenderCommand final
+    {
+        enum Type
+        {
+            UseProgram,   //!< a is the shader handle
+            FrontFace,    //!< a is the winding order
+            Enable,       //!< a is the capability
+            Disable,      //!< a is the capability
+            DepthMask,    //!< a is 1 to enable writing, else 0
+            BlendFunc,    //!< a is the source factor, b the destination factor
+            BlendEquation,//!< a is the equation
+            Uniforms,     //!< a is the shader handle, b the number of uniforms set
+            Draw          //!< a is the VAO (or VBO on mobile) b is the submesh index
+        }type = UseProgram;
+
+        std::uint32_t a = 0;
+        std::uint32_t b = 0;
+    };
+
+    /*!
+    \brief Tracks a subset of the OpenGL state, so that redundant
+    state changes can be skipped when drawing.
+    The state is unknown when the cache is created, or after calling
+    invalidate(), so that the first call to each function will always
+    issue the OpenGL command. The cache should therefore be invalidated
+    if anything other than the cache modifies the tracked state.
+
+    If the cache is created with a pointer to a vector of RenderCommands
+    then the commands are appended to the vector instead of being issued
+    to OpenGL. This allows the state changes made by, for example, a draw
+    list to be measured without an active OpenGL context.
+    */
+    class CRO_EXPORT_API RenderStateCache final
+    {
+    public:
+        /*!
+        \brief Constructor.
+        \param recorder Optional pointer to a vector of RenderCommands.
+        If this is not nullptr then no OpenGL commands are issued.
+        */
+        explicit RenderStateCache(std::vector<RenderCommand>* recorder = nullptr);
+
+        /*!
+        \brief Binds the given shader program if it is not already bound
+        \returns true if the program was bound, or false if it was
+        already the active program
+        */
+        bool useProgram(std::uint32_t program);
+
+        /*!
+        \brief Sets the winding order of front facing polygons
+        eg GL_CCW
+        */
+        void setFrontFace(std::uint32_t winding);
+
+        /*!
+        \brief Enables or disables the given capability.
+        Only GL_BLEND, GL_CULL_FACE and GL_DEPTH_TEST are tracked,
+        other capabilities are always passed through.
+        */
+        void setEnabled(std::uint32_t capability, bool enabled);
+
+        /*!
+        \brief Enables or disables writing to the depth buffer
+        */
+        void setDepthMask(bool enabled);
+
+        /*!
+        \brief Sets the blend function source and destination factors
+        */
+        void setBlendFunc(std::uint32_t src, std::uint32_t dst);
+
+        /*!
+        \brief Sets the blend equation, eg GL_FUNC_ADD
+        */
+        void setBlendEquation(std::uint32_t equation);
+
+        /*!
+        \brief Applies the blend state of the given material's BlendMode
+        */
+        void applyBlendMode(const Material::Data& material);
+
+        /*!
+        \brief Applies the blend mode, face culling and depth testing
+        of the given material
+        */
+        void applyMaterial(const Material::Data& material);
+
+        /*!
+        \brief Appends a command to the recorder, if there is one.
+        Use this to log commands which aren't handled by the cache,
+        such as uniform updates or draw calls, when recording.
+        */
+        void record(RenderCommand::Type type, std::uint32_t a = 0, std::uint32_t b = 0);
+
+        /*!
+        \brief Returns true if commands are being recorded rather
+        than being issued to OpenGL
+        */
+        bool isRecording() const { return m_recorder != nullptr; }
+
+        /*!
+        \brief Marks all tracked state as unknown
+        */
+        void invalidate();
+
+        struct Stats final
+        {
+            std::size_t issued = 0; //!< state changes which were issued (or recorded)
+            std::size_t skipped = 0; //!< redundant state changes which were skipped
+        };
+
+        /*!
+        \brief Returns the number of state changes issued and
+        skipped since construction or the last call to resetStats()
+        */
+        const Stats& getStats() const { return m_stats; }
+
+        /*!
+        \brief Resets the Stats counters to zero
+        */
+        void resetStats() { m_stats = {}; }
+
+    private:
+        std::vector<RenderCommand>* m_recorder;
+        Stats m_stats;
+
+        static constexpr std::uint32_t Unknown = 0xFFFFFFFF;
+
+        std::uint32_t m_program;
+        std::uint32_t m_frontFace;
+        std::uint32_t m_depthMask;
+        std::array<std::uint32_t, 2u> m_blendFunc = {};
+        std::uint32_t m_blendEquation;
+
+        enum Capability
+        {
+            Blend, CullFace, DepthTest,
+            Count
+        };
+        std::array<std::uint32_t, Capability::Count> m_capabilities = {};
+
+        bool changed(std::uint32_t& current, std::uint32_t value);
+    };
+}
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -34,6 +34,9 @@ source distribution.
 #include <crogine/detail/glm/vec4.hpp>
 
 #include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
 
 namespace cro
 {
@@ -52,6 +55,42 @@ namespace cro
         bool contains(glm::vec3) const;
     };
 
+    /*!
+    \brief Stores bounding spheres as separate arrays of centre
+    positions and radii, so that they can be tested against a
+    Frustum in batches with Spatial::cullSpheres()
+    */
+    struct SphereBatch final
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<float> radius;
+
+        void resize(std::size_t size)
+        {
+            x.resize(size);
+            y.resize(size);
+            z.resize(size);
+            radius.resize(size);
+        }
+
+        std::size_t size() const { return radius.size(); }
+
+        void set(std::size_t index, const Sphere& sphere)
+        {
+            x[index] = sphere.centre.x;
+            y[index] = sphere.centre.y;
+            z[index] = sphere.centre.z;
+            radius[index] = sphere.radius;
+        }
+
+        Sphere get(std::size_t index) const
+        {
+            return Sphere(radius[index], glm::vec3(x[index], y[index], z[index]));
+        }
+    };
+
     enum class Planar
     {
         Intersection, Front, Back
@@ -83,5 +122,21 @@ namespace cro
         \return cro::Box containing the AABB of the newly updated frustum
         */
         cro::Box CRO_EXPORT_API updateFrustum(std::array<Plane, 6u>& frustum, glm::mat4 viewProj);
+
+        /*!
+        \brief Tests a range of spheres in a SphereBatch against the given Frustum.
+        Spheres are tested 8 at a time when crogine is built with USE_AVX, 4 at a
+        time on other platforms which support SSE2, else one at a time. A sphere is considered visible if it
+        is not entirely behind any of the frustum planes, the same as testing each
+        plane with intersects() != Planar::Back
+        \param frustum The Frustum to test against
+        \param spheres SphereBatch containing the spheres to test
+        \param start Index of the first sphere in the batch to test
+        \param count Number of spheres to test
+        \param output Pointer to an array of at least (count + 63) / 64 words. Bit N
+        is set if sphere start + N is visible, else it is cleared.
+        \returns The number of visible spheres
+        */
+        std::size_t CRO_EXPORT_API cullSpheres(const Frustum& frustum, const SphereBatch& spheres, std::size_t start, std::size_t count, std::uint64_t* output);
     }
 }
\ No newline at end of file
@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/detail/Types.hpp>
 #include <crogine/detail/SDLResource.hpp>
 #include <crogine/graphics/Rectangle.hpp>
+#include <crogine/graphics/CompressedImage.hpp>
 
 #include <crogine/detail/glm/vec2.hpp>
 
@@ -42,11 +43,23 @@ namespace cro
 {
     class Image;
     class Colour;
+    template <typename T>
+    class ImageArray;
+
+    namespace Detail
+    {
+        class TextureLoader;
+    }
 
     /*!
     \brief Generic texture wrapper for OpenGL RGB or RGBA textures.
     This class is intended for use with mesh texturing, rather than any
     advanced texture usage.
+
+    Textures can also be loaded from block compressed KTX2 or DDS files,
+    see CompressedImage. When loading an image such as a *.png file, a
+    *.ktx2 or *.dds file with the same name is loaded instead if it is at
+    least as new as the image.
     */
     class CRO_EXPORT_API Texture final : public Detail::SDLResource
     {
@@ -76,12 +89,39 @@ namespace cro
 
         /*!
         \brief Attempts to load the file in the given file path.
+        If the file is a compressed KTX2 or DDS file any mip levels it contains
+        are used if createMipMaps is true, as they can't be created at run time.
+        If the compressed format is not supported on the current device the image
+        is decompressed where possible, else an uncompressed image with the same
+        name, such as a *.png, is loaded in its place.
         \param path Path to file to load. The image file should have pow2 dimensions on mobile platforms
         \param createMipMaps Set true to automatically create mipmap levels for this texture
         \returns true on success, else false
         */
         bool loadFromFile(const std::string& path, bool createMipMaps = false);
 
+        /*!
+        \brief Loads the file at the given path, decoding it on a worker thread.
+        This returns immediately. The texture keeps its current contents until
+        the image has been decoded and uploaded, which happens during a later
+        frame. If the texture is empty a small transparent texture is created
+        in the meantime. The OpenGL handle of the texture is not changed by
+        the upload, so the texture can be assigned to materials straight away,
+        although its size will change once the image is loaded.
+        \param path Path to the image file to load
+        \param createMipMaps Set true to create mipmap levels once the image is uploaded
+        \returns true if the load was queued. If decoding fails later on an error
+        is logged and the texture keeps its current contents.
+        \see isLoading()
+        */
+        bool loadFromFileAsync(const std::string& path, bool createMipMaps = false);
+
+        /*!
+        \brief Returns true if the texture is waiting for an image requested
+        with loadFromFileAsync() to be decoded and uploaded.
+        */
+        bool isLoading() const { return m_loading; }
+
         /*!
         \brief Attempts to create the texture from a given Image.
         \param image A reference to a loaded image from which to create a texture
@@ -91,6 +131,22 @@ namespace cro
         */
         bool loadFromImage(const Image& image, bool createMipmaps = false);
 
+        /*!
+        \brief Attempts to create the texture from a CompressedImage.
+        The rows of the image are
+        uploaded in the order they are stored, so unlike loadFromFile() images
+        which are not bottom-up will appear upside down. If the format of the
+        image is not supported on this device the top level is decompressed
+        instead, if possible.
+        \param image The CompressedImage to upload. Only the first layer and
+        face are used if the image is an array or cubemap.
+        \param useMipMaps Set true to upload all the mip levels of the image,
+        else only the top level is used.
+        \returns true on success, else false
+        \see isFormatSupported()
+        */
+        bool loadFromImage(const CompressedImage& image, bool useMipMaps = false);
+
         /*!
         \brief Updates the pixel data for the texture.
         Ensure the texture is valid by calling create() or successfully calling loadFromFile()
@@ -118,11 +174,24 @@ namespace cro
         */
         ImageFormat::Type getFormat() const;
 
+        /*!
+        \brief Returns true if the texture was loaded from a CompressedImage.
+        Compressed textures can't be updated with update()
+        */
+        bool isCompressed() const { return m_compressedSize != 0; }
+
         /*!
         brief Returns the OpenGL handle used by this texture.
         */
         std::uint32_t getGLHandle() const;
 
+        /*!
+        \brief Returns an estimate of the number of bytes of video memory
+        used by the texture, including any mip maps. This doesn't account
+        for driver padding, or textures created with floating point storage.
+        */
+        std::size_t getMemorySize() const;
+
         /*!
         \brief Enables texture smoothing
         */
@@ -159,6 +228,22 @@ namespace cro
         */
         static std::uint32_t getMaxTextureSize();
 
+        /*!
+        \brief Returns true if the current device can use the given
+        compressed format. Requires a valid OpenGL context.
+        */
+        static bool isFormatSupported(CompressedImage::Format::Type format);
+
+        /*!
+        \brief Sets the number of mip levels skipped when loading compressed
+        files which contain a mip chain, so that lower resolution textures are
+        used. For example skipping 1 level loads 1024px textures at 512px. This
+        can be used to reduce memory use on lower spec hardware, and only affects
+        textures loaded after it has been set. Default is 0.
+        */
+        static void setMipLevelSkip(std::uint32_t skip);
+        static std::uint32_t getMipLevelSkip();
+
         /*!
         \brief Swaps this texture with the given texture
         */
@@ -206,8 +291,17 @@ namespace cro
         bool m_smooth;
         bool m_repeated;
         bool m_hasMipMaps;
+        bool m_loading;
+        std::size_t m_compressedSize; //bytes uploaded if compressed, else 0
 
         bool update(const void* pixels, bool createMipMaps, URect area);
         void generateMipMaps();
+        bool uploadCompressed(const CompressedImage& image, bool useMipMaps);
+        static std::uint32_t getSupportedFormats();
+
+        void cancelAsync();
+        friend class Detail::TextureLoader;
+        void onAsyncLoad(const ImageArray<std::uint8_t>* image, bool createMipMaps, const void* pixels);
+        void onAsyncLoad(const CompressedImage& image, bool useMipMaps);
     };
 }
\ No newline at end of file
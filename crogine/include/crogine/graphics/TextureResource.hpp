@@ -35,7 +35,10 @@ source distribution.
 
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 //hash for colours
 namespace std
@@ -55,10 +58,48 @@ namespace cro
     /*!
     \brief Used to manage the lifetime of textures as well as ensure single instances
     are loaded.
+    Textures are indexed by path and by OpenGL handle, so get(path) and getByHandle()
+    are hash lookups. These two functions may be called from worker threads, so long
+    as the requested texture is already loaded - loading a texture, or creating the
+    fallback texture, requires the OpenGL context.
     */
     class CRO_EXPORT_API TextureResource final : public Detail::SDLResource
     {
     public:
+        /*!
+        \brief Handle to a texture requested with loadAsync().
+        Handles are only valid for the lifetime of the TextureResource
+        which returned them, and should not be used once the resource
+        has been moved.
+        */
+        class CRO_EXPORT_API Handle final
+        {
+        public:
+            /*!
+            \brief Returns true once the texture has finished loading,
+            or failed to load.
+            */
+            bool isReady() const;
+
+            /*!
+            \brief Returns the texture.
+            While the texture is loading it contains the fallback colour, but
+            its OpenGL handle doesn't change once loading completes, so it can
+            be assigned to materials immediately.
+            */
+            Texture& getTexture() const;
+
+            /*!
+            \brief Returns the ID with which the texture was loaded
+            */
+            std::uint32_t getID() const { return m_id; }
+
+        private:
+            TextureResource* m_resource = nullptr;
+            std::uint32_t m_id = 0;
+            friend class TextureResource;
+        };
+
         TextureResource();
         ~TextureResource() = default;
 
@@ -78,6 +119,49 @@ namespace cro
         */
         bool load(std::uint32_t id, const std::string& path, bool createMipMaps = false);
 
+        /*!
+        \brief Loads the image at the given path, decoding it on a worker thread.
+        This returns immediately with a handle to the texture. Until the image
+        has been decoded and uploaded (which is done a few textures at a time
+        at the beginning of each frame) the texture is filled with the current
+        fallback colour. If the ID is already in use the existing texture is
+        returned instead.
+        \param id ID to assign to the texture
+        \param path String containing the path of the image to load
+        \param createMipMaps Creates the default MipMap levels once the texture
+        has been loaded.
+        \see getLoadProgress()
+        */
+        Handle loadAsync(std::uint32_t id, const std::string& path, bool createMipMaps = false);
+
+        /*!
+        \brief Returns true if the texture with the given ID was requested with
+        loadAsync() and has not yet finished loading
+        */
+        bool isLoading(std::uint32_t id) const;
+
+        /*!
+        \brief Returns the number of textures requested with loadAsync()
+        which are still loading.
+        */
+        std::size_t getPendingCount() const;
+
+        /*!
+        \brief Returns the progress of all textures requested with loadAsync()
+        since the last time nothing was pending, in the range 0 - 1.
+        Use this to drive a loading screen. Returns 1 if nothing is loading.
+        */
+        float getLoadProgress() const;
+
+        /*!
+        \brief Sets the maximum number of bytes of texture data uploaded each
+        frame by textures loaded asynchronously. Larger values complete loading
+        sooner, at the expense of longer frames. At least one texture is
+        always uploaded per frame. Defaults to 8MB. This applies to all
+        TextureResources.
+        */
+        static void setUploadBudget(std::size_t bytes);
+
         /*!
         \brief Returns true if a texture has been loaded with the given texture ID
         */
@@ -97,6 +181,26 @@ namespace cro
         */
         Texture& getByHandle(std::uint32_t handle);
 
+        struct Stats final
+        {
+            std::size_t hits = 0; //!< calls to get(path) or getByHandle() which found a loaded texture
+            std::size_t misses = 0; //!< calls to get(path) which loaded a texture, or to getByHandle() which returned the fallback
+            std::size_t textureCount = 0; //!< number of textures loaded by this resource, not including fallbacks
+            std::size_t memoryUsage = 0; //!< estimated bytes of video memory used by those textures
+        };
+
+        /*!
+        \brief Returns the lookup counts since construction or the last call to
+        resetStats(), along with the number and size of the currently loaded textures.
+        \see Texture::getMemorySize()
+        */
+        Stats getStats() const;
+
+        /*!
+        \brief Resets the hit and miss counts to zero
+        */
+        void resetStats();
+
         /*!
         \brief Sets the current fallback colour.
         If a texture fails to load then a texture filled with the current
@@ -122,6 +226,25 @@ namespace cro
         std::unordered_map<Colour, std::unique_ptr<Texture>> m_fallbackTextures;
         Colour m_fallbackColour;
 
+        //the path keys view the strings stored in m_textures, which
+        //don't move once inserted, so each path is only stored once
+        std::unordered_map<std::string_view, Texture*> m_pathIndex;
+        std::unordered_map<std::uint32_t, Texture*> m_handleIndex;
+
+        //guards the above maps and the stats. Stored as a pointer
+        //so that the resource remains movable
+        std::unique_ptr<std::mutex> m_mutex;
+        std::size_t m_hitCount;
+        std::size_t m_missCount;
+
+        //IDs requested with loadAsync(). Pruned when queried
+        mutable std::vector<std::uint32_t> m_pendingIDs;
+        mutable std::size_t m_asyncRequestCount;
+
         Texture& getFallbackTexture();
+        void updatePending() const;
+
+        //call with m_mutex locked
+        Texture& insert(std::uint32_t id, const std::string& path, std::unique_ptr<Texture> texture);
     };
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2022
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -29,12 +29,15 @@ source distribution.
 
 #pragma once
 
+#include <crogine/Config.hpp>
 #include <crogine/detail/Assert.hpp>
 #include <crogine/detail/glm/gtc/quaternion.hpp>
 #include <crogine/graphics/Rectangle.hpp>
 
 #include <random>
-#include <ctime>
+#include <array>
+#include <limits>
+#include <cstdint>
 
 namespace cro
 {
@@ -45,7 +48,181 @@ namespace cro
         */
         namespace Random
         {
-            static std::mt19937 rndEngine(static_cast<unsigned long>(std::time(nullptr)));
+            /*!
+            \brief xoshiro256** pseudo random number generator.
+            Each thread has its own instance of this, returned by getGenerator(),
+            which is used by the value() functions. Generators can also be created
+            and seeded explicitly, for example one per Scene, where a reproducible
+            sequence is required.
+            Satisfies UniformRandomBitGenerator so it can also be used with
+            std distributions and algorithms such as std::shuffle()
+            */
+            class CRO_EXPORT_API Generator final
+            {
+            public:
+                using result_type = std::uint64_t;
+
+                explicit Generator(std::uint64_t seed = 0x853c49e6748fea9bull) { this->seed(seed); }
+
+                /*!
+                \brief Resets the state of the generator from the given seed.
+                Generators with the same seed always produce the same sequence.
+                */
+                void seed(std::uint64_t seed)
+                {
+                    //expand the seed with splitmix64 as recommended by the xoshiro authors
+                    for (auto& s : m_state)
+                    {
+                        seed += 0x9e3779b97f4a7c15ull;
+                        auto z = seed;
+                        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                        s = z ^ (z >> 31);
+                    }
+                }
+
+                static constexpr result_type min() { return 0; }
+                static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+                result_type operator()()
+                {
+                    const auto result = rotl(m_state[1] * 5, 7) * 9;
+                    const auto t = m_state[1] << 17;
+
+                    m_state[2] ^= m_state[0];
+                    m_state[3] ^= m_state[1];
+                    m_state[1] ^= m_state[2];
+                    m_state[0] ^= m_state[3];
+                    m_state[2] ^= t;
+                    m_state[3] = rotl(m_state[3], 45);
+
+                    return result;
+                }
+
+                /*!
+                \brief Returns a floating point value in the range [begin, end)
+                */
+                float value(float begin, float end)
+                {
+                    return begin + ((end - begin) * unit());
+                }
+
+                /*!
+                \brief Returns an integer value in the range [begin, end]
+                */
+                int value(int begin, int end)
+                {
+                    const auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(end) - begin) + 1;
+                    return static_cast<int>(begin + static_cast<std::int64_t>(bounded(range)));
+                }
+
+                /*!
+                \brief Returns an unsigned integer value in the range [begin, end]
+                */
+                std::size_t value(std::size_t begin, std::size_t end)
+                {
+                    const auto range = static_cast<std::uint64_t>(end - begin);
+                    if (range == std::numeric_limits<std::uint64_t>::max())
+                    {
+                        return static_cast<std::size_t>((*this)());
+                    }
+                    return begin + static_cast<std::size_t>(bounded(range + 1));
+                }
+
+                /*!
+                \brief Fills count floats starting at output with values
+                in the range [begin, end)
+                */
+                void fill(float* output, std::size_t count, float begin, float end)
+                {
+                    const auto range = end - begin;
+                    for (auto i = 0u; i < count; ++i)
+                    {
+                        output[i] = begin + (range * unit());
+                    }
+                }
+
+                /*!
+                \brief Fills count vec3 starting at output with components
+                in the range [begin, end)
+                */
+                void fill(glm::vec3* output, std::size_t count, float begin, float end)
+                {
+                    fill(&output[0].x, count * 3, begin, end);
+                }
+
+            private:
+                std::array<std::uint64_t, 4u> m_state = {};
+
+                static constexpr std::uint64_t rotl(std::uint64_t x, std::int32_t k)
+                {
+                    return (x << k) | (x >> (64 - k));
+                }
+
+                //uses the top 24 bits which are all a float can represent in [0, 1)
+                float unit()
+                {
+                    return static_cast<float>((*this)() >> 40) * (1.f / 16777216.f);
+                }
+
+                //returns a value in the range [0, range)
+                std::uint64_t bounded(std::uint64_t range)
+                {
+                    CRO_ASSERT(range != 0, "");
+                    if (range <= std::numeric_limits<std::uint32_t>::max())
+                    {
+                        //Lemire's multiply-shift, which avoids the division
+                        return ((*this)() >> 32) * range >> 32;
+                    }
+                    return (*this)() % range;
+                }
+            };
+
+            static_assert(sizeof(glm::vec3) == sizeof(float) * 3, "");
+
+            /*!
+            \brief Returns the Generator for the calling thread.
+            This is created on first use and seeded either randomly or, if
+            deterministic mode is enabled, from the deterministic seed.
+            */
+            CRO_EXPORT_API Generator& getGenerator();
+
+            /*!
+            \brief Reseeds the Generator of the calling thread only
+            */
+            CRO_EXPORT_API void setSeed(std::uint64_t seed);
+
+            /*!
+            \brief Enables or disables deterministic mode, for replays and tests.
+            When enabled the Generator of the calling thread is seeded with the
+            given seed, and every other thread's Generator is reseeded on its next
+            use with a value derived from the seed and the order in which the threads
+            next use it, so the same seed and order reproduce the same sequences.
+            When disabled all Generators are reseeded randomly.
+            Note that work distributed over a thread pool, such as with std::execution::par,
+            is not guaranteed to run on the same threads, so code which needs to be
+            reproducible across threads should use its own seeded Generator.
+            */
+            CRO_EXPORT_API void setDeterministic(bool enabled, std::uint64_t seed = 0);
+
+            /*!
+            \brief Returns true if deterministic mode is enabled
+            */
+            CRO_EXPORT_API bool isDeterministic();
+
+            /*!
+            \brief Forwards to the calling thread's Generator.
+            Existing code can continue to use this with std algorithms,
+            eg std::shuffle(begin, end, rndEngine), safely from any thread.
+            */
+            struct EngineProxy final
+            {
+                using result_type = Generator::result_type;
+                static constexpr result_type min() { return Generator::min(); }
+                static constexpr result_type max() { return Generator::max(); }
+                result_type operator()() const { return getGenerator()(); }
+            };
+            inline constexpr EngineProxy rndEngine{};
 
             /*!
             \brief Returns a pseudo random floating point value
@@ -55,8 +232,7 @@ namespace cro
             static inline float value(float begin, float end)
             {
                 CRO_ASSERT(begin < end, "first value is not less than last value");
-                std::uniform_real_distribution<float> dist(begin, end);
-                return dist(rndEngine);
+                return getGenerator().value(begin, end);
             }
             /*!
             \brief Returns a pseudo random integer value
@@ -66,8 +242,7 @@ namespace cro
             static inline int value(int begin, int end)
             {
                 CRO_ASSERT(begin < end, "first value is not less than last value");
-                std::uniform_int_distribution<int> dist(begin, end);
-                return dist(rndEngine);
+                return getGenerator().value(begin, end);
             }
             /*!
             \brief Returns a pseudo random unsigned integer value
@@ -77,8 +252,33 @@ namespace cro
             static inline std::size_t value(std::size_t begin, std::size_t end)
             {
                 //CRO_ASSERT(begin < end, "first value is not less than last value");
-                std::uniform_int_distribution<std::size_t> dist(begin, end);
-                return dist(rndEngine);
+                return getGenerator().value(begin, end);
+            }
+
+            /*!
+            \brief Fills count floats starting at output with pseudo random values
+            \param output Pointer to the first value to fill
+            \param count Number of values to fill
+            \param begin Minimum value
+            \param end Maximum value
+            */
+            static inline void fill(float* output, std::size_t count, float begin, float end)
+            {
+                CRO_ASSERT(begin < end, "first value is not less than last value");
+                getGenerator().fill(output, count, begin, end);
+            }
+
+            /*!
+            \brief Fills count vectors starting at output with pseudo random components
+            \param output Pointer to the first vector to fill
+            \param count Number of vectors to fill
+            \param begin Minimum value of each component
+            \param end Maximum value of each component
+            */
+            static inline void fill(glm::vec3* output, std::size_t count, float begin, float end)
+            {
+                CRO_ASSERT(begin < end, "first value is not less than last value");
+                getGenerator().fill(output, count, begin, end);
             }
             /*!
             \brief Returns a poisson disc sampled distribution of points within a given area
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -31,11 +31,15 @@ source distribution.
 #include <crogine/detail/Assert.hpp>
 
 #include "AudioRenderer.hpp"
+#include "AudioDecoder.hpp"
 #include "PCMData.hpp"
 
+#include <crogine/core/FileSystem.hpp>
+
 using namespace cro;
 
 AudioBuffer::AudioBuffer()
+    : m_loading(false)
 {
 
 }
@@ -45,17 +49,22 @@ AudioBuffer::~AudioBuffer()
     if (getID() > 0)
     {
         resetUsers();
-
-        AudioRenderer::deleteBuffer(getID());
-        setID(-1);
+        releaseBuffer();
     }
 }
 
 AudioBuffer::AudioBuffer(AudioBuffer&& other) noexcept
+    : m_loading(false)
 {
     auto id = getID();
     setID(other.getID());
     other.setID(id);
+
+    std::swap(m_loading, other.m_loading);
+    if (m_loading)
+    {
+        Detail::AudioDecoder::swapTargets(&other, this);
+    }
 }
 
 AudioBuffer& AudioBuffer::operator=(AudioBuffer&& other) noexcept
@@ -65,6 +74,12 @@ AudioBuffer& AudioBuffer::operator=(AudioBuffer&& other) noexcept
         auto id = getID();
         setID(other.getID());
         other.setID(id);
+
+        if (m_loading || other.m_loading)
+        {
+            Detail::AudioDecoder::swapTargets(&other, this);
+        }
+        std::swap(m_loading, other.m_loading);
     }
     return *this;
 }
@@ -74,14 +89,43 @@ bool AudioBuffer::loadFromFile(const std::string& path)
 {
     if (getID() > 0)
     {
-        AudioRenderer::deleteBuffer(getID());
-        setID(-1);
+        releaseBuffer();
     }
     
     setID(AudioRenderer::requestNewBuffer(path));
     return getID() != -1;
 }
 
+bool AudioBuffer::loadFromFileAsync(const std::string& path)
+{
+    if (getID() > 0)
+    {
+        releaseBuffer();
+    }
+
+    //the placeholder is shared by all loading buffers so that emitters
+    //have something valid to play until the real buffer is ready
+    setID(Detail::AudioDecoder::getPlaceholderBuffer());
+    if (getID() < 1)
+    {
+        setID(-1);
+        return false;
+    }
+
+    m_loading = true;
+    Detail::AudioDecoder::decodeAsync(FileSystem::getResourcePath() + path, this);
+
+    //any emitters already using this buffer need to swap to the placeholder
+    updateUsers();
+
+    return true;
+}
+
+void AudioBuffer::setCacheDirectory(const std::string& path)
+{
+    Detail::AudioDecoder::setCacheDirectory(path);
+}
+
 bool AudioBuffer::loadFromMemory(void* data, std::uint8_t bitDepth, std::uint32_t sampleRate, bool stereo, std::size_t size)
 {
     CRO_ASSERT(bitDepth == 8 || bitDepth == 16, "Invalid bitdepth value, must be 8 or 16");
@@ -98,7 +142,47 @@ bool AudioBuffer::loadFromMemory(void* data, std::uint8_t bitDepth, std::uint32_
     }
     pcmData.frequency = sampleRate;
     pcmData.size = static_cast<std::uint32_t>(size);
+
+    if (getID() > 0)
+    {
+        releaseBuffer();
+    }
         
     setID(AudioRenderer::requestNewBuffer(pcmData));
     return getID() != -1;
+}
+
+//private
+void AudioBuffer::releaseBuffer()
+{
+    if (m_loading)
+    {
+        //the placeholder isn't ours to delete
+        Detail::AudioDecoder::cancel(this);
+        m_loading = false;
+    }
+    else
+    {
+        AudioRenderer::deleteBuffer(getID());
+    }
+    setID(-1);
+}
+
+void AudioBuffer::onAsyncLoad(std::int32_t bufferID)
+{
+    CRO_ASSERT(m_loading, "");
+    m_loading = false;
+
+    if (bufferID > 0)
+    {
+        setID(bufferID);
+        updateUsers();
+    }
+    else
+    {
+        //as if we were destroyed - but we mustn't delete
+        //the placeholder so we don't call releaseBuffer()
+        resetUsers();
+        setID(-1);
+    }
 }
\ No newline at end of file
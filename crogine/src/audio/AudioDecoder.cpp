@@ -0,0 +1,336 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "AudioDecoder.hpp"
+#include "AudioRenderer.hpp"
+#include "WavLoader.hpp"
+#include "VorbisLoader.hpp"
+#include "Mp3Loader.hpp"
+#include "../detail/FileCache.hpp"
+#include "../detail/JobPool.hpp"
+
+#include <crogine/audio/AudioBuffer.hpp>
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    struct CacheHeader final
+    {
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        std::int64_t modifiedTime = 0; //of the source file
+        std::uint64_t fileSize = 0; //of the source file
+        std::uint32_t format = 0;
+        std::uint32_t frequency = 0;
+        std::uint32_t dataSize = 0;
+        std::uint32_t padding = 0;
+    };
+    static_assert(sizeof(CacheHeader) == 40);
+
+    constexpr std::uint32_t CacheMagic = 0x4d435043; //CPCM
+    constexpr std::uint32_t CacheVersion = 1;
+
+    FileCache fileCache("audio", ".pcm");
+
+    bool getFileInfo(const std::string& path, std::int64_t& modifiedTime, std::uint64_t& fileSize)
+    {
+        try
+        {
+            const auto u8p = std::filesystem::u8path(path);
+
+            std::error_code ec;
+            fileSize = std::filesystem::file_size(u8p, ec);
+            if (ec)
+            {
+                return false;
+            }
+
+            const auto time = std::filesystem::last_write_time(u8p, ec);
+            if (ec)
+            {
+                return false;
+            }
+            modifiedTime = static_cast<std::int64_t>(time.time_since_epoch().count());
+
+            return true;
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    bool readCache(const std::string& cachePath, std::int64_t modifiedTime, std::uint64_t fileSize, DecodedAudio& dst)
+    {
+        MappedFile file;
+        if (!file.open(cachePath)
+            || file.size() < sizeof(CacheHeader))
+        {
+            return false;
+        }
+
+        CacheHeader header;
+        std::memcpy(&header, file.data(), sizeof(CacheHeader));
+
+        if (header.magic != CacheMagic
+            || header.version != CacheVersion
+            || header.modifiedTime != modifiedTime
+            || header.fileSize != fileSize
+            || header.format >= static_cast<std::uint32_t>(PCMData::Format::NONE)
+            || header.dataSize == 0
+            || header.dataSize > file.size() - sizeof(CacheHeader))
+        {
+            //stale or corrupt - this will be overwritten once the file is decoded
+            return false;
+        }
+
+        //the mapping is read-only, although PCMData isn't const
+        //nothing writes to the data once it is decoded
+        dst.pcmData.format = static_cast<PCMData::Format>(header.format);
+        dst.pcmData.frequency = header.frequency;
+        dst.pcmData.size = header.dataSize;
+        dst.pcmData.data = const_cast<std::uint8_t*>(file.data() + sizeof(CacheHeader));
+        dst.cacheFile = std::move(file);
+
+        return true;
+    }
+
+    void writeCache(const std::string& cachePath, std::int64_t modifiedTime, std::uint64_t fileSize, const PCMData& data)
+    {
+        CacheHeader header;
+        header.magic = CacheMagic;
+        header.version = CacheVersion;
+        header.modifiedTime = modifiedTime;
+        header.fileSize = fileSize;
+        header.format = static_cast<std::uint32_t>(data.format);
+        header.frequency = data.frequency;
+        header.dataSize = data.size;
+
+        //write to a temp file first so a partially written
+        //file is never mistaken for a valid cache entry
+        FileCache::writeAtomic(cachePath, [&](const std::string& tempPath)
+            {
+                std::ofstream file(std::filesystem::u8path(tempPath), std::ios::binary);
+                if (!file.is_open())
+                {
+                    LogW << "Failed opening " << tempPath << " for writing" << std::endl;
+                    return false;
+                }
+
+                file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+                file.write(static_cast<const char*>(data.data), data.size);
+
+                if (!file.good())
+                {
+                    LogW << "Failed writing audio cache " << tempPath << std::endl;
+                    return false;
+                }
+                return true;
+            });
+    }
+
+    std::unique_ptr<AudioFile> createLoader(const std::string& ext)
+    {
+        if (ext == ".wav")
+        {
+            return std::make_unique<WavLoader>();
+        }
+        else if (ext == ".ogg")
+        {
+            return std::make_unique<VorbisLoader>();
+        }
+        else if (ext == ".mp3")
+        {
+            return std::make_unique<Mp3Loader>();
+        }
+        return nullptr;
+    }
+
+    //async loading
+    struct Job final
+    {
+        std::string path;
+        AudioBuffer* target = nullptr; //nullptr if cancelled
+        DecodedAudio result;
+        bool success = false;
+
+        void run()
+        {
+            success = AudioDecoder::decode(path, result);
+        }
+    };
+
+    //decoding is mostly IO bound so don't use too many threads
+    JobPool<Job, AudioBuffer> workerPool(std::clamp(std::thread::hardware_concurrency() / 2u, 1u, 4u));
+
+    std::int32_t placeholderBuffer = -1;
+}
+
+bool AudioDecoder::decode(const std::string& path, DecodedAudio& dst)
+{
+    const auto ext = FileSystem::getFileExtension(path);
+
+    //wav files are already PCM so there's nothing to gain by caching them
+    std::int64_t modifiedTime = 0;
+    std::uint64_t fileSize = 0;
+    const auto cachePath = (ext == ".ogg" || ext == ".mp3") ? fileCache.getPath(path) : std::string();
+    const bool useCache = !cachePath.empty() && getFileInfo(path, modifiedTime, fileSize);
+
+    if (useCache
+        && readCache(cachePath, modifiedTime, fileSize, dst))
+    {
+        return true;
+    }
+
+    dst.audioFile = createLoader(ext);
+    if (!dst.audioFile)
+    {
+        LogE << ext << ": format not supported" << std::endl;
+        return false;
+    }
+
+    if (!dst.audioFile->open(path))
+    {
+        dst.audioFile.reset();
+        LogE << "Failed to open " << path << std::endl;
+        return false;
+    }
+
+    dst.pcmData = dst.audioFile->getData();
+    if (!dst.pcmData.data)
+    {
+        dst.audioFile.reset();
+        return false;
+    }
+
+    if (useCache)
+    {
+        writeCache(cachePath, modifiedTime, fileSize, dst.pcmData);
+    }
+
+    return true;
+}
+
+void AudioDecoder::setCacheDirectory(const std::string& path)
+{
+    fileCache.setDirectory(path);
+}
+
+std::string AudioDecoder::getCacheDirectory()
+{
+    return fileCache.getDirectory();
+}
+
+void AudioDecoder::decodeAsync(const std::string& path, AudioBuffer* dst)
+{
+    CRO_ASSERT(dst, "");
+
+    auto job = std::make_shared<Job>();
+    job->path = path;
+    job->target = dst;
+
+    workerPool.submit(std::move(job));
+}
+
+void AudioDecoder::cancel(const AudioBuffer* dst)
+{
+    workerPool.cancel(dst);
+}
+
+void AudioDecoder::swapTargets(const AudioBuffer* a, AudioBuffer* b)
+{
+    workerPool.swapTargets(a, b);
+}
+
+void AudioDecoder::update()
+{
+    while (auto job = workerPool.popCompleted())
+    {
+        if (job->target)
+        {
+            std::int32_t bufferID = -1;
+            if (job->success)
+            {
+                bufferID = AudioRenderer::requestNewBuffer(job->result.pcmData);
+            }
+            else
+            {
+                LogE << "Failed decoding " << job->path << std::endl;
+            }
+            job->target->onAsyncLoad(bufferID);
+        }
+    }
+}
+
+void AudioDecoder::shutdown()
+{
+    workerPool.stop();
+
+    if (placeholderBuffer > 0)
+    {
+        AudioRenderer::deleteBuffer(placeholderBuffer);
+        placeholderBuffer = -1;
+    }
+}
+
+std::int32_t AudioDecoder::getPlaceholderBuffer()
+{
+    if (placeholderBuffer < 1
+        && AudioRenderer::isValid())
+    {
+        static std::array<std::int16_t, 16> silence = {};
+
+        PCMData data;
+        data.format = PCMData::Format::MONO16;
+        data.frequency = 22050;
+        data.size = static_cast<std::uint32_t>(silence.size() * sizeof(std::int16_t));
+        data.data = silence.data();
+
+        placeholderBuffer = AudioRenderer::requestNewBuffer(data);
+    }
+    return placeholderBuffer;
+}
+
+std::size_t AudioDecoder::getPendingCount()
+{
+    return workerPool.getPendingCount();
+}
@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include "AudioFile.hpp"
+#include "PCMData.hpp"
+#include "../detail/MappedFile.hpp"
+
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace cro
+{
+    class AudioBuffer;
+
+    namespace Detail
+    {
+        /*!
+        \brief Decoded PCM data along with whichever object owns it.
+        The data belongs either to the AudioFile which decoded it, or
+        is mapped directly from the decode cache. It remains valid
+        for the lifetime of this struct.
+        */
+        struct DecodedAudio final
+        {
+            PCMData pcmData;
+            std::unique_ptr<AudioFile> audioFile;
+            MappedFile cacheFile;
+        };
+
+        /*!
+        \brief Decodes audio files into PCM data, either immediately
+        or on a pool of worker threads.
+        If a cache directory is set then decoded compressed formats
+        (ogg and mp3) are written to it, keyed by a hash of the file path
+        and validated against the file size and modification time, so
+        that subsequent loads map the cached PCM instead of decoding again.
+        */
+        class AudioDecoder final
+        {
+        public:
+            /*!
+            \brief Decodes the file at the given absolute path into dst.
+            Safe to call from any thread.
+            \returns true on success
+            */
+            static bool decode(const std::string& path, DecodedAudio& dst);
+
+            /*!
+            \brief Sets the directory in which decoded audio is cached.
+            Pass an empty string to disable caching (the default).
+            */
+            static void setCacheDirectory(const std::string& path);
+
+            static std::string getCacheDirectory();
+
+            /*!
+            \brief Queues the file at the given absolute path to be decoded
+            on a worker thread. Once decoding is complete the data is
+            uploaded to a new buffer which is passed to the destination
+            AudioBuffer during update()
+            */
+            static void decodeAsync(const std::string& path, AudioBuffer* dst);
+
+            /*!
+            \brief Cancels any pending decodes for the given AudioBuffer
+            */
+            static void cancel(const AudioBuffer* dst);
+
+            /*!
+            \brief Swaps the destinations of any pending decodes between
+            two buffers, used when AudioBuffers are moved.
+            */
+            static void swapTargets(const AudioBuffer* a, AudioBuffer* b);
+
+            /*!
+            \brief Uploads any completed decodes. Called once per frame
+            on the main thread by the App.
+            */
+            static void update();
+
+            /*!
+            \brief Stops any worker threads and frees the placeholder buffer
+            */
+            static void shutdown();
+
+            /*!
+            \brief Returns the ID of a silent buffer shared by all AudioBuffers
+            which are waiting for their data to be decoded
+            */
+            static std::int32_t getPlaceholderBuffer();
+
+            /*!
+            \brief Returns the number of files queued or being decoded
+            */
+            static std::size_t getPendingCount();
+        };
+    }
+}
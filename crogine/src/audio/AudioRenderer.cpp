@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -295,4 +295,10 @@ void AudioRenderer::printDebug()
 {
     CRO_ASSERT(m_impl, "");
     m_impl->printDebug();
+}
+
+std::uint32_t AudioRenderer::getStreamUnderrunCount(std::int32_t streamID)
+{
+    CRO_ASSERT(m_impl, "");
+    return m_impl->getStreamUnderrunCount(streamID);
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -117,6 +117,10 @@ namespace cro
         //optionally override this to implement ImGui debug printing
         //*without* window begin/end
         virtual void printDebug() {}
+
+        //optionally return the number of times a stream ran out
+        //of data before the implementation could refill it
+        virtual std::uint32_t getStreamUnderrunCount(std::int32_t) const { return 0; }
     };
 
 
@@ -367,6 +371,14 @@ namespace cro
         */
         static void printDebug();
 
+        /*!
+        \brief Returns the number of times the stream with the given ID
+        ran out of queued audio data before it was refilled, causing
+        playback to stall. Always returns 0 if the implementation doesn't
+        support streaming, or the stream ID is invalid.
+        */
+        static std::uint32_t getStreamUnderrunCount(std::int32_t streamID);
+
 
         /*!
         \brief Returns a pointer to the active implementation cast to type T
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/core/Log.hpp>
 #include <crogine/detail/Assert.hpp>
 
+#include <algorithm>
 #include <vector>
 
 using namespace cro;
@@ -51,6 +52,43 @@ AudioResource::AudioResource()
 
 //public
 bool AudioResource::load(std::int32_t ID, const std::string& path, bool streaming)
+{
+    return loadSource(ID, path, streaming, false);
+}
+
+std::int32_t AudioResource::load(const std::string& path, bool streaming)
+{
+    return loadAutoID(path, streaming, false);
+}
+
+bool AudioResource::loadAsync(std::int32_t ID, const std::string& path)
+{
+    return loadSource(ID, path, false, true);
+}
+
+std::int32_t AudioResource::loadAsync(const std::string& path)
+{
+    return loadAutoID(path, false, true);
+}
+
+bool AudioResource::isLoading() const
+{
+    return std::any_of(m_sources.begin(), m_sources.end(), 
+        [](const auto& source)
+        {
+            return source.second->getType() == AudioSource::Type::Buffer
+                && static_cast<const AudioBuffer*>(source.second.get())->isLoading();
+        });
+}
+
+const AudioSource& AudioResource::get(std::int32_t id) const
+{
+    if (m_sources.count(id) == 0) return *m_fallback;
+    return *m_sources.find(id)->second;
+}
+
+//private
+bool AudioResource::loadSource(std::int32_t ID, const std::string& path, bool streaming, bool async)
 {
     if (!streaming &&
         m_sources.count(ID) > 0)
@@ -60,17 +98,20 @@ bool AudioResource::load(std::int32_t ID, const std::string& path, bool streamin
     }
 
     std::unique_ptr<AudioSource> buffer;
+    bool result = false;
     
     if (streaming)
     {
         buffer = std::make_unique<AudioStream>();
+        result = buffer->loadFromFile(path);
     }
     else
     {
-        buffer = std::make_unique<AudioBuffer>();
+        auto audioBuffer = std::make_unique<AudioBuffer>();
+        result = async ? audioBuffer->loadFromFileAsync(path) : audioBuffer->loadFromFile(path);
+        buffer = std::move(audioBuffer);
     }
     
-    auto result = buffer->loadFromFile(path);
     if (result)
     {
         m_sources.insert(std::make_pair(ID, std::move(buffer)));
@@ -83,7 +124,7 @@ bool AudioResource::load(std::int32_t ID, const std::string& path, bool streamin
     return result;
 }
 
-std::int32_t AudioResource::load(const std::string& path, bool streaming)
+std::int32_t AudioResource::loadAutoID(const std::string& path, bool streaming, bool async)
 {
     //streaming sources shouldn't be shared
     //cos, well, they're streaming
@@ -97,7 +138,7 @@ std::int32_t AudioResource::load(const std::string& path, bool streaming)
     CRO_ASSERT(autoID > 0, "Something is very wrong if you've used this many IDs.");
     auto id = autoID;
 
-    if (load(id, path, streaming))
+    if (loadSource(id, path, streaming, async))
     {
         autoID--;
         return id;
@@ -105,9 +146,3 @@ std::int32_t AudioResource::load(const std::string& path, bool streaming)
 
     return -1;
 }
-
-const AudioSource& AudioResource::get(std::int32_t id) const
-{
-    if (m_sources.count(id) == 0) return *m_fallback;
-    return *m_sources.find(id)->second;
-}
\ No newline at end of file
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -61,4 +61,20 @@ void AudioSource::resetUsers()
     {
         user->reset(this);
     }
-}
\ No newline at end of file
+}
+
+void AudioSource::updateUsers()
+{
+    for (auto* user : m_users)
+    {
+        user->m_dataSourceID = m_id;
+        user->m_newDataSource = true;
+
+        //rebinding the source stops it, so make sure anything
+        //still playing (eg looped sounds) is restarted
+        if (user->m_state == AudioEmitter::State::Playing)
+        {
+            user->m_transportFlags |= AudioEmitter::Play;
+        }
+    }
+}
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -79,3 +79,12 @@ bool AudioStream::loadFromFile(const std::string& path)
     setID(AudioRenderer::requestNewStream(path));
     return getID() != -1;
 }
+
+std::uint32_t AudioStream::getUnderrunCount() const
+{
+    if (getID() > -1)
+    {
+        return AudioRenderer::getStreamUnderrunCount(getID());
+    }
+    return 0;
+}
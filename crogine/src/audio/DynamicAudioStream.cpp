@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2024
+Matt Marchant 2024 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -87,4 +87,13 @@ void DynamicAudioStream::updateBuffer(const int16_t* data, std::int32_t sampleCo
 {
     CRO_ASSERT(m_bufferedStream, "");
     m_bufferedStream->updateBuffer(data, sampleCount);
-}
\ No newline at end of file
+}
+
+std::uint32_t DynamicAudioStream::getUnderrunCount() const
+{
+    if (getID() > -1)
+    {
+        return AudioRenderer::getStreamUnderrunCount(getID());
+    }
+    return 0;
+}
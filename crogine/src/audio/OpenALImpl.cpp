@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -33,6 +33,7 @@ source distribution.
 #include "VorbisLoader.hpp"
 #include "Mp3Loader.hpp"
 #include "BufferedStreamLoader.hpp"
+#include "AudioDecoder.hpp"
 
 #include <crogine/detail/Assert.hpp>
 #include <crogine/util/String.hpp>
@@ -47,6 +48,7 @@ source distribution.
 #endif
 
 #include <array>
+#include <algorithm>
 
 using namespace cro;
 using namespace cro::Detail;
@@ -55,6 +57,12 @@ namespace
 {
     constexpr std::size_t STREAM_CHUNK_SIZE = 32768;// 48000u * sizeof(std::uint16_t) * 30; //30 sec of stereo @ highest quality (mono)
 
+    //bounds on how long the streaming thread sleeps between updates
+    //the max is used when no stream is playing, or as a fallback
+    //if a wake up is somehow missed
+    constexpr float MinStreamWait = 0.002f;
+    constexpr float MaxStreamWait = 0.1f;
+
     ALenum getFormatFromData(const PCMData& data)
     {
         switch (data.format)
@@ -70,13 +78,29 @@ namespace
             return AL_FORMAT_STEREO16;
         }
     }
+
+#ifdef AL_SOFT_events
+    //raised by OpenAL-soft on its mixer thread when a queued buffer
+    //has finished playing, so we can wake the streaming thread
+    //immediately rather than relying on the estimated wait time
+    void AL_APIENTRY onALEvent(ALenum type, ALuint object, ALuint, ALsizei, const ALchar*, void* userParam) noexcept
+    {
+        if (type == AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT
+            || type == AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT)
+        {
+            static_cast<OpenALImpl*>(userParam)->onSourceEvent(static_cast<std::int32_t>(object));
+        }
+    }
+#endif
 }
 
 OpenALImpl::OpenALImpl()
     : m_device          (nullptr),
     m_context           (nullptr),
     m_nextFreeStream    (0),
-    m_nextFreeSource    (0)
+    m_nextFreeSource    (0),
+    m_streamThreadRunning(false),
+    m_eventsAvailable   (false)
 {
     for (auto i = 0u; i < m_streamIDs.size(); ++i)
     {
@@ -136,6 +160,11 @@ bool OpenALImpl::init()
         m_devices.push_back("default");
     }
 
+    if (current)
+    {
+        startStreamThread();
+    }
+
     return current;
 }
 
@@ -144,6 +173,10 @@ void OpenALImpl::shutdown()
     unregisterWindows();
     removeCommands();
 
+    //stop the streaming thread first so it isn't
+    //touching streams while they're destroyed
+    stopStreamThread();
+
     for (auto i = 0u; i < m_nextFreeSource; ++i)
     {
         deleteAudioSource(m_sourcePool[i]);
@@ -197,42 +230,11 @@ std::int32_t OpenALImpl::requestNewBuffer(const std::string& filePath)
 {
     auto path = FileSystem::getResourcePath() + filePath;
 
-    std::unique_ptr<AudioFile> loader;
-    
-    auto ext = FileSystem::getFileExtension(path);
-    PCMData data;
-    if (ext == ".wav")
-    {      
-        loader = std::make_unique<WavLoader>();
-        if (loader->open(path))
-        {
-            data = loader->getData();
-        }
-    }
-    else if (ext == ".ogg")
+    //this reads from the decode cache if it's enabled
+    DecodedAudio decoded;
+    if (AudioDecoder::decode(path, decoded))
     {
-        loader = std::make_unique<VorbisLoader>();
-        if (loader->open(path))
-        {
-            data = loader->getData();
-        }
-    }
-    else if (ext == ".mp3")
-    {
-        loader = std::make_unique<Mp3Loader>();
-        if (loader->open(path))
-        {
-            data = loader->getData();
-        }
-    }
-    else
-    {
-        Logger::log(ext + ": format not supported", Logger::Type::Error);
-    }
-
-    if (data.data)
-    {
-        return requestNewBuffer(data);
+        return requestNewBuffer(decoded.pcmData);
     }
     
     return -1;
@@ -348,19 +350,16 @@ std::int32_t OpenALImpl::requestNewBufferableStream(BufferedStreamLoader** dstPt
 void OpenALImpl::deleteStream(std::int32_t id)
 {
     auto& stream = m_streams[id];
+
+    //once this is locked the streaming thread won't
+    //touch the stream again until it is re-initialised
+    std::scoped_lock lock(stream.mutex);
+    stream.active = false;
+
     if (stream.sourceID > 0)
     {
         alCheck(alSourceStop(stream.sourceID));
     }
-    stream.running = false;
-
-    if (stream.thread)
-    {
-        //we can't just detach as we need to reset the
-        //thread pointer.
-        stream.thread->join();
-        stream.thread.reset();
-    }
 
     if (stream.buffers[0])
     {
@@ -375,6 +374,10 @@ void OpenALImpl::deleteStream(std::int32_t id)
         stream.audioFile.reset();
         stream.currentBuffer = 0;
         stream.sourceID = -1;
+        stream.state = AL_STOPPED;
+        stream.endOfStream = false;
+        stream.stopRequested = false;
+        stream.underrunCount = 0;
 
         m_nextFreeStream--;
 
@@ -415,12 +418,10 @@ std::int32_t OpenALImpl::requestAudioSource(std::int32_t buffer, bool streaming)
         {
             //sync with the stream thread...
             auto& stream = m_streams[buffer];
-            while (stream.busy) {}
+            std::scoped_lock lock(stream.mutex);
 
-            stream.accessed = true;
             stream.sourceID = source;
             alCheck(alSourceQueueBuffers(source, static_cast<ALsizei>(stream.buffers.size()), stream.buffers.data()));
-            stream.accessed = false;
         }
 
         return source;
@@ -451,13 +452,10 @@ void OpenALImpl::updateAudioSource(std::int32_t sourceID, std::int32_t bufferID,
     else
     {
         auto& stream = m_streams[bufferID];
+        std::scoped_lock lock(stream.mutex);
 
-        while (stream.busy) {}
-
-        stream.accessed = true;
         stream.sourceID = sourceID;
         alCheck(alSourceQueueBuffers(sourceID, static_cast<ALsizei>(stream.buffers.size()), stream.buffers.data()));
-        stream.accessed = false;
     }
 }
 
@@ -519,13 +517,16 @@ void OpenALImpl::playSource(std::int32_t source, bool looped)
     }
     else
     {
-        while (result->busy) {}
-
-        result->accessed = true;
         result->looped = looped;
-        result->accessed = false;
+        result->stopRequested = false;
     }
     alCheck(alSourcePlay(src));
+
+    if (result != m_streams.end())
+    {
+        //make sure the stream thread sees the new state
+        signalStream(result->streamID);
+    }
 }
 
 void OpenALImpl::pauseSource(std::int32_t source)
@@ -538,7 +539,20 @@ void OpenALImpl::pauseSource(std::int32_t source)
 void OpenALImpl::stopSource(std::int32_t source)
 {
     ALuint src = static_cast<ALuint>(source);
+
+    //flag streams so that stopping isn't mistaken for an underrun
+    auto streamID = findStream(source);
+    if (streamID > -1)
+    {
+        m_streams[streamID].stopRequested = true;
+    }
+
     alCheck(alSourceStop(src));
+
+    if (streamID > -1)
+    {
+        signalStream(streamID);
+    }
 }
 
 void OpenALImpl::setPlayingOffset(std::int32_t source, cro::Time offset)
@@ -562,11 +576,9 @@ void OpenALImpl::setPlayingOffset(std::int32_t source, cro::Time offset)
     }
     else
     {
-        while (result->busy) {}
-
-        result->accessed = true;
+        std::scoped_lock lock(result->mutex);
         result->audioFile->seek(offset);
-        result->accessed = false;
+        result->endOfStream = false;
     }
 }
 
@@ -689,6 +701,32 @@ void OpenALImpl::printDebug()
 {
     ImGui::Text("Source Cache Size %lu", m_sourcePool.size());
     ImGui::Text("Sources In Use %lu", m_nextFreeSource);
+
+    ImGui::Text("Active Streams %lu", m_nextFreeStream);
+    ImGui::Text("Stream Events: %s", m_eventsAvailable ? "Yes" : "No");
+    for (auto i = 0u; i < m_nextFreeStream; ++i)
+    {
+        const auto id = m_streamIDs[i];
+        ImGui::Text("Stream %d Underruns: %u", id, m_streams[id].underrunCount.load());
+    }
+}
+
+std::uint32_t OpenALImpl::getStreamUnderrunCount(std::int32_t streamID) const
+{
+    if (streamID < 0 || streamID >= static_cast<std::int32_t>(MaxStreams))
+    {
+        return 0;
+    }
+    return m_streams[streamID].underrunCount;
+}
+
+void OpenALImpl::onSourceEvent(std::int32_t sourceID)
+{
+    auto streamID = findStream(sourceID);
+    if (streamID > -1)
+    {
+        signalStream(streamID);
+    }
 }
 
 //private
@@ -860,7 +898,7 @@ OpenALStream& OpenALImpl::getNextFreeStream()
 
     //attempt to open the file
     auto& stream = m_streams[streamID];
-    CRO_ASSERT(!stream.thread, "this shouldn't be running yet!");
+    CRO_ASSERT(!stream.active, "this shouldn't be running yet!");
     stream.streamID = streamID;
 
     return stream;
@@ -879,8 +917,14 @@ bool OpenALImpl::initStream(OpenALStream& stream)
             alCheck(alBufferData(b, getFormatFromData(audioData), audioData.data, audioData.size, audioData.frequency));
         }
 
-        stream.running = true;
-        stream.thread = std::make_unique<std::thread>(&OpenALStream::updateStream, &stream);
+        {
+            std::scoped_lock lock(stream.mutex);
+            stream.state = AL_STOPPED;
+            stream.endOfStream = false;
+            stream.nextUpdate = std::chrono::steady_clock::now();
+            stream.active = true;
+        }
+        signalStream(stream.streamID);
 
         //hurrah we has stream
         m_nextFreeStream++;
@@ -971,75 +1015,228 @@ void OpenALImpl::reconnect(const char* deviceStr)
     }
 }
 
-//stream thread function
-void OpenALStream::updateStream()
+void OpenALImpl::startStreamThread()
 {
-    //this is called by a stream's thread
-    while (running)
+    m_eventsAvailable = false;
+#ifdef AL_SOFT_events
+    if (alIsExtensionPresent("AL_SOFT_events"))
     {
-        //wait for the main thread to finish what it's
-        //doing to the stream
-        while (accessed) {}
+        auto eventControl = reinterpret_cast<LPALEVENTCONTROLSOFT>(alGetProcAddress("alEventControlSOFT"));
+        auto eventCallback = reinterpret_cast<LPALEVENTCALLBACKSOFT>(alGetProcAddress("alEventCallbackSOFT"));
 
-        //check if we need update
-        busy = true;
+        if (eventControl && eventCallback)
+        {
+            const std::array<ALenum, 2u> types = { AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT, AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT };
+            alCheck(eventCallback(onALEvent, this));
+            alCheck(eventControl(static_cast<ALsizei>(types.size()), types.data(), AL_TRUE));
+            m_eventsAvailable = true;
+        }
+    }
+#endif
+
+    m_streamThreadRunning = true;
+    m_streamThread = std::thread(&OpenALImpl::streamThreadFunc, this);
+}
 
-        if (sourceID > -1)
+void OpenALImpl::stopStreamThread()
+{
+#ifdef AL_SOFT_events
+    if (m_eventsAvailable)
+    {
+        auto eventCallback = reinterpret_cast<LPALEVENTCALLBACKSOFT>(alGetProcAddress("alEventCallbackSOFT"));
+        alCheck(eventCallback(nullptr, nullptr));
+        m_eventsAvailable = false;
+    }
+#endif
+
+    if (m_streamThread.joinable())
+    {
         {
-            std::int32_t processed = 0;
-            alCheck(alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed));
+            std::scoped_lock lock(m_streamMutex);
+            m_streamThreadRunning = false;
+        }
+        m_streamCondition.notify_one();
+        m_streamThread.join();
+    }
+}
 
-            //if stopped rewind file and load buffers
-            ALenum newState;
-            alCheck(alGetSourcei(sourceID, AL_SOURCE_STATE, &newState));
-            if (newState != state && newState == AL_STOPPED)
+void OpenALImpl::signalStream(std::int32_t streamID)
+{
+    {
+        std::scoped_lock lock(m_streamMutex);
+        m_readyStreams.push_back(streamID);
+    }
+    m_streamCondition.notify_one();
+}
+
+std::int32_t OpenALImpl::findStream(std::int32_t sourceID) const
+{
+    if (sourceID > 0)
+    {
+        for (const auto& stream : m_streams)
+        {
+            if (stream.sourceID == sourceID)
             {
-                audioFile->seek(cro::Time());
-                processed = static_cast<ALint>(buffers.size());
+                return stream.streamID;
             }
+        }
+    }
+    return -1;
+}
 
-            //update the buffers if necessary
-            if (processed > 0
-                && (state == AL_PLAYING))
-            {
-                for (auto i = 0; i < processed; ++i)
-                {
-                    //fill buffer
-                    const auto& data = audioFile->getData(STREAM_CHUNK_SIZE, looped);
-                    if (data.size > 0) //only update if we have data else we'll loop even if we don't want to
-                    {
-                        //unqueue
-                        alCheck(alSourceUnqueueBuffers(sourceID, 1, &buffers[currentBuffer]));
+//stream thread function
+void OpenALImpl::streamThreadFunc()
+{
+    std::vector<std::int32_t> readyStreams;
+    auto nextWake = std::chrono::steady_clock::now();
 
-                        //refill
-                        alCheck(alBufferData(buffers[currentBuffer], getFormatFromData(data), data.data, data.size, data.frequency));
+    while (m_streamThreadRunning)
+    {
+        readyStreams.clear();
+        {
+            std::unique_lock lock(m_streamMutex);
+            m_streamCondition.wait_until(lock, nextWake, [&]() {return !m_readyStreams.empty() || !m_streamThreadRunning; });
+            readyStreams.swap(m_readyStreams);
+        }
 
-                        //requeue
-                        alCheck(alSourceQueueBuffers(sourceID, 1, &buffers[currentBuffer]));
+        const auto now = std::chrono::steady_clock::now();
+        for (auto id : readyStreams)
+        {
+            std::scoped_lock lock(m_streams[id].mutex);
+            m_streams[id].nextUpdate = now;
+        }
 
-                        //increment currentBuffer
-                        currentBuffer = (currentBuffer + 1) % buffers.size();
-                    }
-                }
+        //only update streams which are due, then sleep until the earliest
+        //time a stream is expected to need refilling
+        nextWake = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(MaxStreamWait));
+        for (auto& stream : m_streams)
+        {
+            if (!stream.active)
+            {
+                continue;
+            }
 
-                busy = false;
-                processed = 0;
+            std::scoped_lock lock(stream.mutex);
+            if (!stream.active) //might have been deleted while we were waiting
+            {
+                continue;
             }
-            else
+
+            if (stream.nextUpdate <= now)
             {
-                //sleep for a bit
-                //it's important to sleep *after* the busy flag is set to
-                //false as this is the time the main thread might set the 'accessed' flag
-                busy = false;
-                std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(50));
+                const auto wait = std::clamp(stream.update(), MinStreamWait, MaxStreamWait);
+                stream.nextUpdate = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(wait));
             }
-            state = newState;
+            nextWake = std::min(nextWake, stream.nextUpdate);
+        }
+    }
+}
+
+float OpenALStream::update()
+{
+    //this is called by the streaming thread with the stream locked
+    if (sourceID < 0)
+    {
+        return MaxStreamWait;
+    }
+
+    std::int32_t processed = 0;
+    alCheck(alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed));
+
+    //if stopped rewind file and load buffers
+    ALenum newState;
+    alCheck(alGetSourcei(sourceID, AL_SOURCE_STATE, &newState));
+
+    bool restart = false;
+    if (newState != state && newState == AL_STOPPED)
+    {
+        if (state == AL_PLAYING
+            && !stopRequested
+            && !endOfStream)
+        {
+            //the source played everything queued before
+            //we refilled it, so top it up and carry on
+            underrunCount++;
+            restart = true;
         }
         else
         {
-            //sleep for a bit
-            busy = false;
-            std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(50));
+            audioFile->seek(cro::Time());
+            endOfStream = false;
+        }
+        stopRequested = false;
+        processed = static_cast<ALint>(buffers.size());
+    }
+
+    //update the buffers if necessary
+    if (processed > 0
+        && (state == AL_PLAYING))
+    {
+        for (auto i = 0; i < processed; ++i)
+        {
+            //fill buffer
+            const auto& data = audioFile->getData(STREAM_CHUNK_SIZE, looped);
+            if (data.size > 0) //only update if we have data else we'll loop even if we don't want to
+            {
+                //unqueue
+                alCheck(alSourceUnqueueBuffers(sourceID, 1, &buffers[currentBuffer]));
+
+                //refill
+                alCheck(alBufferData(buffers[currentBuffer], getFormatFromData(data), data.data, data.size, data.frequency));
+
+                //requeue
+                alCheck(alSourceQueueBuffers(sourceID, 1, &buffers[currentBuffer]));
+
+                //increment currentBuffer
+                currentBuffer = (currentBuffer + 1) % buffers.size();
+            }
+            else
+            {
+                endOfStream = true;
+            }
         }
     }
+
+    if (restart)
+    {
+        alCheck(alSourcePlay(sourceID));
+        newState = AL_PLAYING;
+    }
+    state = newState;
+
+    if (state != AL_PLAYING
+        || endOfStream)
+    {
+        //nothing to do until the main thread plays the stream, or
+        //the final buffers are played out, so no need to rush back
+        return MaxStreamWait;
+    }
+
+    //estimate how long until the oldest queued buffer is done
+    //with. The sample offset is relative to the first queued buffer
+    //which is the one at currentBuffer once processed buffers are
+    //unqueued.
+    ALint offset = 0;
+    ALint size = 0;
+    ALint channels = 0;
+    ALint bits = 0;
+    ALint frequency = 0;
+    ALfloat pitch = 1.f;
+    alCheck(alGetSourcei(sourceID, AL_SAMPLE_OFFSET, &offset));
+    alCheck(alGetSourcef(sourceID, AL_PITCH, &pitch));
+    alCheck(alGetBufferi(buffers[currentBuffer], AL_SIZE, &size));
+    alCheck(alGetBufferi(buffers[currentBuffer], AL_CHANNELS, &channels));
+    alCheck(alGetBufferi(buffers[currentBuffer], AL_BITS, &bits));
+    alCheck(alGetBufferi(buffers[currentBuffer], AL_FREQUENCY, &frequency));
+
+    const auto bytesPerSample = channels * (bits / 8);
+    if (bytesPerSample == 0
+        || frequency == 0
+        || pitch <= 0.f)
+    {
+        return MinStreamWait;
+    }
+
+    const auto remaining = (size / bytesPerSample) - offset;
+    return (static_cast<float>(remaining) / static_cast<float>(frequency)) / pitch;
 }
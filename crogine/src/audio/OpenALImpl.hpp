@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -46,8 +46,12 @@ source distribution.
 
 #include <atomic>
 #include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <memory>
+#include <vector>
 
 namespace cro
 {
@@ -61,18 +65,24 @@ namespace cro
             std::array<ALuint, 4u> buffers{};
             std::size_t currentBuffer = 0;
             std::int32_t streamID = -1; //NOT the same as source ID!
-            //ALint processed = 0;
 
-            std::atomic<bool> busy{ false }; //signifies the thread is processing
-            std::atomic<bool> running{ false }; //signifies the thread is running
-            std::atomic<bool> accessed{ false }; //signifies the main thread is modifying the stream
-            
-            std::unique_ptr<std::thread> thread;
-            void updateStream(); //runs in own thread
+            //held by the streaming thread while the stream is updated
+            //and by the main thread while it modifies the stream
+            std::mutex mutex;
+            std::atomic<bool> active{ false }; //signifies the stream is serviced by the streaming thread
 
-            std::int32_t sourceID = -1;
+            std::atomic<std::int32_t> sourceID{ -1 };
             std::atomic<bool> looped{ false };
+            std::atomic<bool> stopRequested{ false }; //set when the main thread stops the source so it's not counted as an underrun
+            bool endOfStream = false;
             ALenum state = AL_STOPPED;
+
+            std::atomic<std::uint32_t> underrunCount{ 0 };
+            std::chrono::steady_clock::time_point nextUpdate; //only accessed with mutex held
+
+            //called by the streaming thread. Returns the time in
+            //seconds until the stream next expects to need refilling
+            float update();
         };
 
         class OpenALImpl final : public cro::AudioRendererImpl,
@@ -131,6 +141,11 @@ namespace cro
 
             void printDebug() override;
 
+            std::uint32_t getStreamUnderrunCount(std::int32_t) const override;
+
+            //called from the OpenAL event callback, if it's available
+            void onSourceEvent(std::int32_t sourceID);
+
         private:
             ALCdevice* m_device;
             ALCcontext* m_context;
@@ -157,6 +172,22 @@ namespace cro
             OpenALStream& getNextFreeStream();
             bool initStream(OpenALStream&);
 
+            //a single thread services all streams. It sleeps until
+            //the next stream is expected to need refilling, or until
+            //a stream is signalled as ready via the queue
+            std::thread m_streamThread;
+            std::mutex m_streamMutex;
+            std::condition_variable m_streamCondition;
+            std::vector<std::int32_t> m_readyStreams;
+            std::atomic<bool> m_streamThreadRunning;
+            bool m_eventsAvailable;
+
+            void startStreamThread();
+            void stopStreamThread();
+            void streamThreadFunc();
+            void signalStream(std::int32_t streamID);
+            std::int32_t findStream(std::int32_t sourceID) const;
+
             void refreshDeviceList();
             void reconnect(const char*);
         };
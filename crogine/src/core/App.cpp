@@ -63,6 +63,7 @@ static void winFPE(int)
 #include <crogine/detail/PoolLog.hpp>
 #include <crogine/audio/AudioMixer.hpp>
 #include <crogine/gui/Gui.hpp>
+#include <crogine/graphics/MaterialData.hpp>
 #include <crogine/util/String.hpp>
 
 #include <SDL.h>
@@ -90,6 +91,8 @@ static void winFPE(int)
 
 
 #include "../audio/AudioRenderer.hpp"
+#include "../audio/AudioDecoder.hpp"
+#include "../graphics/TextureLoader.hpp"
 
 #include <algorithm>
 #include <iomanip>
@@ -325,7 +328,9 @@ App::App(std::uint32_t styleFlags)
 
 App::~App()
 {
+    Detail::AudioDecoder::shutdown();
     AudioRenderer::shutdown();
+    Detail::TextureLoader::shutdown();
     
     for (auto js : m_joysticks)
     {
@@ -341,6 +346,10 @@ App::~App()
         SDL_GameControllerClose(info.controller);
     }
     
+    //write any remaining log messages while
+    //we're still in control of thread shutdown
+    Logger::shutdown();
+
     //SDL cleanup
     SDL_Quit();
 }
@@ -521,6 +530,9 @@ void App::run(bool resetSettings)
             handleEvents();
             handleMessages();
 
+            //hands any asynchronously decoded audio to its buffers
+            Detail::AudioDecoder::update();
+
             simulate(frameTime);
 
             framesRendered = 0;
@@ -528,6 +540,9 @@ void App::run(bool resetSettings)
 
         if (framesRendered++ < MaxFrames)
         {
+            //uploads any asynchronously decoded textures, within budget
+            Detail::TextureLoader::update();
+
             doImGui();
 
             ImGui::Render();
@@ -535,6 +550,8 @@ void App::run(bool resetSettings)
             render();
             ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
             m_window.display();
+
+            Material::updateFrameStats();
         }
     }
 
@@ -1062,7 +1079,12 @@ void App::addWindow(const std::function<void()>& func, const GuiClient* c, bool
 
 void App::removeWindows(const GuiClient* c)
 {
-    CRO_ASSERT(m_instance, "App not properly instanciated!");
+    //clients such as an EntityManager may be created without
+    //an App, eg in the tests, so there's nothing to remove
+    if (!m_instance)
+    {
+        return;
+    }
 
     m_instance->m_guiWindows.erase(
         std::remove_if(std::begin(m_instance->m_guiWindows), std::end(m_instance->m_guiWindows),
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -27,6 +27,7 @@ source distribution.
 
 -----------------------------------------------------------------------*/
 
+#include "../detail/FileCache.hpp"
 #include "../detail/json.hpp"
 
 #include <crogine/core/ConfigFile.hpp>
@@ -40,6 +41,10 @@ source distribution.
 #include <sstream>
 #include <fstream>
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
 
 using namespace cro;
 using json = nlohmann::json;
@@ -56,6 +61,187 @@ namespace
         T v = value;
         dst->addProperty(key).setValue(v);
     }
+
+    //compiled binary format. All values are stored in
+    //native (little endian) byte order
+    struct BinaryHeader final
+    {
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        std::uint32_t stringCount = 0;
+        std::uint32_t padding = 0;
+    };
+    static_assert(sizeof(BinaryHeader) == 16);
+
+    constexpr std::uint32_t BinaryMagic = 0x42464343; //CCFB
+    constexpr std::uint32_t BinaryVersion = 1;
+    constexpr std::uint32_t MaxBinaryDepth = 256;
+
+    Detail::FileCache fileCache("config", ConfigObject::BinaryExtension);
+
+    template <typename T>
+    void writeValue(std::vector<std::uint8_t>& dst, T value)
+    {
+        const auto pos = dst.size();
+        dst.resize(pos + sizeof(T));
+        std::memcpy(dst.data() + pos, &value, sizeof(T));
+    }
+
+    void writeBytes(std::vector<std::uint8_t>& dst, const void* data, std::size_t size)
+    {
+        writeValue(dst, static_cast<std::uint32_t>(size));
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        dst.insert(dst.end(), bytes, bytes + size);
+    }
+
+    std::uint32_t internString(std::unordered_map<std::string, std::uint32_t>& strings, const std::string& str)
+    {
+        return strings.try_emplace(str, static_cast<std::uint32_t>(strings.size())).first->second;
+    }
+
+    template <typename T>
+    bool readValue(const std::uint8_t*& data, const std::uint8_t* end, T& dst)
+    {
+        if (static_cast<std::size_t>(end - data) < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&dst, data, sizeof(T));
+        data += sizeof(T);
+        return true;
+    }
+
+    //returns a view of the bytes, which is only valid as long as the source data
+    bool readBytes(const std::uint8_t*& data, const std::uint8_t* end, std::basic_string_view<std::uint8_t>& dst)
+    {
+        std::uint32_t size = 0;
+        if (!readValue(data, end, size)
+            || static_cast<std::size_t>(end - data) < size)
+        {
+            return false;
+        }
+        dst = { data, size };
+        data += size;
+        return true;
+    }
+
+    bool readString(const std::uint8_t*& data, const std::uint8_t* end,
+        const std::vector<std::string>& strings, const std::string*& dst)
+    {
+        std::uint32_t idx = 0;
+        if (!readValue(data, end, idx)
+            || idx >= strings.size())
+        {
+            return false;
+        }
+        dst = &strings[idx];
+        return true;
+    }
+
+    //splits a line of a config file into tokens. Tabs and carriage returns
+    //are stripped by compacting the line in place, so that every token is
+    //a contiguous view into the line without copying it. Empty tokens are
+    //not stored. Returns true if the line has an unterminated string literal.
+    bool tokenise(char* line, std::size_t length, std::vector<std::string_view>& tokens)
+    {
+        tokens.clear();
+
+        std::size_t i = 0;
+        while (i < length
+            && (line[i] == ' ' || line[i] == '\t'))
+        {
+            //skip indentation
+            i++;
+        }
+
+        //characters are written back to the line at the write
+        //index, which never overtakes the read index
+        std::size_t writeIndex = i;
+        std::size_t tokenStart = i;
+
+        const auto endToken = [&]()
+        {
+            if (writeIndex != tokenStart)
+            {
+                tokens.emplace_back(line + tokenStart, writeIndex - tokenStart);
+            }
+            tokenStart = writeIndex;
+        };
+
+        bool stringOpen = false; //tracks if the token is part of a string value
+        bool foundProperty = false; //once we found an assignment allow spaces in property values, eg float arrays
+
+        for (; i < length; ++i)
+        {
+            const auto c = line[i];
+
+            //if this is a comment then quit here
+            if (!stringOpen
+                && c == '/'
+                && i < length - 1
+                && line[i + 1] == '/')
+            {
+                break;
+            }
+
+            //if we hit a space start a new token
+            //as long as it's not part of a string literal
+            //or property array value
+            if (!stringOpen
+                && !foundProperty
+                && c == ' ')
+            {
+                endToken();
+            }
+
+            //if we hit an assignment store it in its own token
+            //so we know we have a property, then start a new
+            //token, skipping a possible space
+            else if (!stringOpen
+                && c == '=')
+            {
+                endToken();
+                line[writeIndex++] = c;
+
+                if (i < length - 1)
+                {
+                    endToken();
+                    if (line[i + 1] == ' ')
+                    {
+                        i++;
+                    }
+                }
+
+                foundProperty = true;
+            }
+
+            //check to see if we open or close a string
+            else if (c == '"')
+            {
+                stringOpen = !stringOpen;
+
+                //we need to store these so we can identify the value as a string
+                line[writeIndex++] = c;
+
+                //if this is the closing quotes, end the line here
+                //to skip potential trailing white space
+                if (!stringOpen)
+                {
+                    break;
+                }
+            }
+
+            //make sure this isn't whitespace like \t or \r
+            else if (c != '\t'
+                && c != '\r')
+            {
+                line[writeIndex++] = c;
+            }
+        }
+        endToken();
+
+        return stringOpen;
+    }
 }
 
 //--------------------//
@@ -237,7 +423,30 @@ bool ConfigObject::loadFromFile(const std::string& filePath, bool relative)
     m_properties.clear();
     m_objects.clear();
 
-    return loadFromFile2(relative ? FileSystem::getResourcePath() + filePath : filePath);
+    const auto path = relative ? FileSystem::getResourcePath() + filePath : filePath;
+    if (FileSystem::getFileExtension(path) == BinaryExtension)
+    {
+        return loadFromBinary(path);
+    }
+
+    if (loadFromTwin(path))
+    {
+        return true;
+    }
+
+    if (!loadFromFile2(path))
+    {
+        return false;
+    }
+
+    if (const auto cachePath = fileCache.getPath(path); !cachePath.empty())
+    {
+        //write to a temp file first so a partially written
+        //file is never picked up by another load
+        Detail::FileCache::writeAtomic(cachePath, [&](const std::string& tempPath) { return saveBinary(tempPath); });
+    }
+
+    return true;
 }
 
 const std::string& ConfigObject::getId() const
@@ -545,6 +754,56 @@ bool ConfigObject::save(const std::string& path)
     return false;
 }
 
+bool ConfigObject::saveBinary(const std::string& path) const
+{
+    //the string table has to be written before the objects
+    //but isn't complete until they've all been written...
+    StringTable strings;
+    std::vector<std::uint8_t> objectData;
+    writeBinary(objectData, strings);
+
+    std::vector<const std::string*> sortedStrings(strings.size());
+    for (const auto& [str, idx] : strings)
+    {
+        sortedStrings[idx] = &str;
+    }
+
+    std::vector<std::uint8_t> fileData;
+    BinaryHeader header;
+    header.magic = BinaryMagic;
+    header.version = BinaryVersion;
+    header.stringCount = static_cast<std::uint32_t>(sortedStrings.size());
+    writeValue(fileData, header);
+
+    for (const auto* str : sortedStrings)
+    {
+        writeBytes(fileData, str->data(), str->size());
+    }
+    fileData.insert(fileData.end(), objectData.begin(), objectData.end());
+
+    RaiiRWops out;
+    out.file = SDL_RWFromFile(path.c_str(), "wb");
+    if (out.file
+        && SDL_RWwrite(out.file, fileData.data(), fileData.size(), 1) == 1)
+    {
+        return true;
+    }
+
+    Logger::log("failed to write binary configuration to: \'" + path + "\'", Logger::Type::Error);
+    return false;
+}
+
+void ConfigObject::setCacheDirectory(const std::string& path)
+{
+    fileCache.setDirectory(path);
+}
+
+std::string ConfigObject::getCacheDirectory()
+{
+    return fileCache.getDirectory();
+}
+
+//private
 std::size_t ConfigObject::write(SDL_RWops* file, std::uint16_t depth)
 {
     //add the correct amount of indenting based on this objects's depth
@@ -689,6 +948,197 @@ std::size_t ConfigObject::write(SDL_RWops* file, std::uint16_t depth)
     return written;
 }
 
+void ConfigObject::writeBinary(std::vector<std::uint8_t>& dst, StringTable& strings) const
+{
+    writeValue(dst, internString(strings, getName()));
+    writeValue(dst, internString(strings, m_id));
+    writeValue(dst, static_cast<std::uint32_t>(m_properties.size()));
+    writeValue(dst, static_cast<std::uint32_t>(m_objects.size()));
+
+    for (const auto& p : m_properties)
+    {
+        writeValue(dst, internString(strings, p.getName()));
+        writeValue(dst, static_cast<std::uint32_t>(p.m_boolValue ? 1 : 0));
+        writeValue(dst, static_cast<std::uint32_t>(p.m_floatValues.size()));
+        writeValue(dst, static_cast<std::uint32_t>(p.m_utf8Values.size()));
+
+        for (auto v : p.m_floatValues)
+        {
+            writeValue(dst, v);
+        }
+
+        for (const auto& utf : p.m_utf8Values)
+        {
+            writeBytes(dst, utf.data(), utf.size());
+        }
+    }
+
+    for (const auto& o : m_objects)
+    {
+        o.writeBinary(dst, strings);
+    }
+}
+
+bool ConfigObject::readBinary(const std::uint8_t*& data, const std::uint8_t* end, const std::vector<std::string>& strings, std::uint32_t depth)
+{
+    const std::string* name = nullptr;
+    const std::string* id = nullptr;
+    std::uint32_t propertyCount = 0;
+    std::uint32_t objectCount = 0;
+
+    if (depth > MaxBinaryDepth
+        || !readString(data, end, strings, name)
+        || !readString(data, end, strings, id)
+        || !readValue(data, end, propertyCount)
+        || !readValue(data, end, objectCount))
+    {
+        return false;
+    }
+
+    //names were sanitised when the file was compiled
+    //so they can be copied directly
+    setName(*name);
+    m_id = *id;
+
+    //every property or object takes at least 16 bytes so
+    //this stops us reserving anything silly from a bad file
+    if (propertyCount > static_cast<std::size_t>(end - data) / 16
+        || objectCount > static_cast<std::size_t>(end - data) / 16)
+    {
+        return false;
+    }
+    m_properties.reserve(propertyCount);
+    m_objects.reserve(objectCount);
+
+    for (auto i = 0u; i < propertyCount; ++i)
+    {
+        std::uint32_t boolValue = 0;
+        std::uint32_t floatCount = 0;
+        std::uint32_t stringCount = 0;
+        if (!readString(data, end, strings, name)
+            || !readValue(data, end, boolValue)
+            || !readValue(data, end, floatCount)
+            || !readValue(data, end, stringCount)
+            || floatCount > static_cast<std::size_t>(end - data) / sizeof(double))
+        {
+            return false;
+        }
+
+        auto& prop = m_properties.emplace_back("");
+        prop.setName(*name);
+        prop.setParent(this);
+        prop.m_boolValue = boolValue != 0;
+
+        prop.m_floatValues.resize(floatCount);
+        std::memcpy(prop.m_floatValues.data(), data, floatCount * sizeof(double));
+        data += floatCount * sizeof(double);
+
+        for (auto j = 0u; j < stringCount; ++j)
+        {
+            std::basic_string_view<std::uint8_t> utf;
+            if (!readBytes(data, end, utf))
+            {
+                return false;
+            }
+            prop.m_utf8Values.emplace_back(utf);
+        }
+    }
+
+    for (auto i = 0u; i < objectCount; ++i)
+    {
+        auto& obj = m_objects.emplace_back();
+        obj.setParent(this);
+        if (!obj.readBinary(data, end, strings, depth + 1))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ConfigObject::loadFromBinary(const std::string& path)
+{
+    //these are mostly small enough that mapping them
+    //costs more than reading them in one go
+    RaiiRWops rr;
+    rr.file = SDL_RWFromFile(path.c_str(), "rb");
+    if (!rr.file)
+    {
+        Logger::log(path + " file invalid or not found.", Logger::Type::Warning);
+        return false;
+    }
+
+    const auto fileSize = SDL_RWsize(rr.file);
+    std::vector<std::uint8_t> fileData(std::max(Sint64(0), fileSize));
+    if (fileData.empty()
+        || SDL_RWread(rr.file, fileData.data(), fileData.size(), 1) != 1)
+    {
+        LogE << path << ": failed reading file" << std::endl;
+        return false;
+    }
+
+    const auto* data = fileData.data();
+    const auto* end = data + fileData.size();
+
+    BinaryHeader header;
+    if (!readValue(data, end, header)
+        || header.magic != BinaryMagic
+        || header.version != BinaryVersion
+        || header.stringCount > fileData.size() / sizeof(std::uint32_t))
+    {
+        LogE << path << ": not a valid compiled config file" << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> strings(header.stringCount);
+    for (auto& str : strings)
+    {
+        std::basic_string_view<std::uint8_t> bytes;
+        if (!readBytes(data, end, bytes))
+        {
+            LogE << path << ": not a valid compiled config file" << std::endl;
+            return false;
+        }
+        str.assign(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    if (!readBinary(data, end, strings, 0))
+    {
+        LogE << path << ": compiled config file is corrupt" << std::endl;
+
+        m_id.clear();
+        setName("");
+        m_properties.clear();
+        m_objects.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool ConfigObject::loadFromTwin(const std::string& path)
+{
+    Detail::FileCache::TwinCheck twinCheck(path);
+
+    //shipped next to the source file
+    if (const auto twinPath = path + BinaryExtension;
+        twinCheck.isNewer(twinPath) && loadFromBinary(twinPath))
+    {
+        return true;
+    }
+
+    //previously compiled into the cache directory. These are
+    //only valid as long as the source exists to be compared to
+    if (const auto cachePath = fileCache.getPath(path);
+        !cachePath.empty() && twinCheck.isNewer(cachePath)
+        && twinCheck.hasSource() && loadFromBinary(cachePath))
+    {
+        return true;
+    }
+    return false;
+}
+
 bool ConfigObject::loadFromFile2(const std::string& path)
 {
     RaiiRWops rr;
@@ -708,331 +1158,202 @@ bool ConfigObject::loadFromFile2(const std::string& path)
         return false;
     }
 
-    if (rr.file)
+    if (FileSystem::getFileExtension(path) == ".json")
     {
-        if (FileSystem::getFileExtension(path) == ".json")
-        {
-            return parseAsJson(rr.file);
-        }
-
-        std::int64_t readCount = 0;
+        return parseAsJson(rr.file);
+    }
 
-        std::vector<ConfigObject*> objectStack;
+    //read the whole file in one go - lines are then tokenised
+    //in place rather than copying each one into a new string
+    std::vector<char> fileData(static_cast<std::size_t>(fileSize));
+    if (SDL_RWread(rr.file, fileData.data(), fileData.size(), 1) != 1)
+    {
+        LogE << path << ": failed reading file" << std::endl;
+        return false;
+    }
 
-        std::basic_string<std::uint8_t> currentLine;
-        std::uint8_t currentByte = 0;
+    std::vector<ConfigObject*> objectStack;
+    std::vector<std::string_view> tokens;
 
-        std::int32_t lineNumber = 1;
-        std::string objectName;
-        std::string objectID;
+    std::int32_t lineNumber = 1;
+    std::string objectName;
+    std::string objectID;
+    std::string tmp;
 
-        while (readCount != fileSize)
+    const auto parseProperty = [&](ConfigProperty& prop, std::string_view value)
+    {
+        if (value.size() > 1
+            && value[0] == '"')
         {
-            readCount += SDL_RWread(rr.file, &currentByte, 1, 1);
-            if (currentByte != '\n')
+            //this is a string
+            auto tokenEnd = value.size() - 1;
+
+            //this assumes we stripped trailing whitespace (above)
+            //really we should be reverse iterating to the final "
+            if (value.back() != '"')
             {
-                currentLine.push_back(currentByte);
+                //we're malformed but attempt to copy anyway
+                tokenEnd++;
             }
-            else
+
+            //TODO we should be further splitting this if it's a string array
+            //but we don't support getter/setter yet
+            const auto* str = reinterpret_cast<const std::uint8_t*>(value.data());
+            prop.m_utf8Values.emplace_back(str + 1, str + tokenEnd);
+            return;
+        }
+
+        //try parsing the value as a CSV of floats
+        const auto parseFloat = [&]()
+        {
+            if (prop.m_floatValues.empty())
             {
-                //line is complete, so parse it
-                std::size_t lineStart = 0;
-                while (currentLine[lineStart] == ' ' || currentLine[lineStart] == '\t')
+                if (tmp == "true")
                 {
-                    //skip indentation
-                    lineStart++;
+                    prop.setValue(true);
+                    return;
                 }
-
-                //split into tokens
-                std::vector<std::basic_string<std::uint8_t>> tokens;
-                //std::vector<std::vector<char>> tokens; //use this for debugging as it makes strings visible in the debugger
-                tokens.emplace_back();
-                auto tokenIndex = 0;
-
-                bool stringOpen = false; //tracks if the token is part of a string value
-                bool foundProperty = false; //once we found an assignment allow spaces in property values, eg float arrays
-
-                for (auto i = lineStart; i < currentLine.size(); ++i)
+                else if (tmp == "false")
                 {
+                    prop.setValue(false);
+                    return;
+                }
+            }
 
-                    //if this is a comment then quit here
-                    if (!stringOpen
-                        && currentLine[i] == '/'
-                        && i < currentLine.size() - 1
-                        && currentLine[i + 1] == '/')
-                    {
-                        break;
-                    }
-
-                    //if we hit a space start a new token
-                    //as long as it's not part of a string literal
-                    //or property array value
-                    if (!stringOpen &&
-                        !foundProperty &&
-                        currentLine[i] == ' ')
-                    {
-                        tokens.emplace_back();
-                        tokenIndex++;
-                    }
-
-                    //if we hit an assignment and current token not empty
-                    //start a new token because the spaces are missing
-                    else if (!stringOpen &&
-                        currentLine[i] == '=')
-                    {
-                        if (!tokens[tokenIndex].empty())
-                        {
-                            //there was no preceding space to start a new one
-                            tokens.emplace_back();
-                            tokenIndex++;
-                        }
-
-                        //store the assignment in its own token so we know
-                        //we have a property, and then create a new token
-                        //skipping possible space
-                        tokens[tokenIndex].push_back(currentLine[i]);
+            //strtod() rather than stod() means we don't have
+            //to catch an exception for every unquoted string
+            errno = 0;
+            char* end = nullptr;
+            const auto v = std::strtod(tmp.c_str(), &end);
 
-                        if (i < currentLine.size() - 1
-                            /*&& currentLine[i + 1] != ' '*/)
-                        {
-                            tokens.emplace_back();
-                            tokenIndex++;
+            if (end != tmp.c_str()
+                && errno != ERANGE)
+            {
+                prop.m_floatValues.push_back(v);
+            }
+            else
+            {
+                //for backwards compat stash this as a string
+                const auto* str = reinterpret_cast<const std::uint8_t*>(value.data());
+                prop.m_utf8Values.emplace_back(str, str + value.size());
 
-                            if (currentLine[i + 1] == ' ')
-                            {
-                                i++;
-                            }
-                        }
+                //but we don't want to encourage this so nag with a warning
+#ifdef CRO_DEBUG_
+                LogW << FileSystem::getFileName(path) << " line:" << lineNumber << ", value: " << tmp << ": potential unquoted string value" << std::endl;
+#endif
+            }
+        };
 
-                        foundProperty = true;
-                    }
+        tmp.clear();
+        for (auto c : value)
+        {
+            if (c == ',')
+            {
+                //attempt to parse to double.
+                parseFloat();
+                tmp.clear();
+            }
+            else if (c != ' ')
+            {
+                tmp.push_back(c);
+            }
+        }
+        //don't forget the final value!
+        if (!tmp.empty())
+        {
+            parseFloat();
+        }
+    };
 
+    const auto parseLine = [&](char* line, std::size_t length)
+    {
+        const bool stringOpen = tokenise(line, length, tokens);
 
-                    //check to see if we open or close a string
-                    else if (currentLine[i] == '"')
+        //examine our list of tokens and decide what to do with them
+        //we may have an array here where spaces were placed between
+        //components... or we may have single/mixed tokens with comma
+        //separated values.....
+        if (!tokens.empty())
+        {
+            if (tokens.size() < 3)
+            {
+                //this is an object name/id pair
+                //or an opening/closing brace
+                if (tokens[0][0] == '{')
+                {
+                    //this is the first object
+                    if (objectStack.empty())
                     {
-                        stringOpen = !stringOpen;
-                        
-                        //we need to store these so we can identify the value as a string
-                        tokens[tokenIndex].push_back(currentLine[i]);
-
-                        //if this is the closing quotes, end the line here
-                        //to skip potential trailing white space 
-                        //(TODO this is no good for string arrays if we ever implement them)
-                        if (!stringOpen)
-                        {
-                            break;
-                        }
+                        objectStack.push_back(this);
+                        setName(objectName);
+                        setId(objectID);
                     }
-
-                    //else push back current char
                     else
                     {
-                        //make sure this isn't whitespace like \t or \r
-                        if (currentLine[i] != '\t'
-                            && currentLine[i] != '\r')
-                        {
-                            tokens[tokenIndex].push_back(currentLine[i]);
-                        }
+                        auto* o = objectStack.back();
+                        objectStack.push_back(o->addObject(objectName, objectID));
                     }
-                }
-
-                //if there was any white space at the end of a line we'll have created
-                //empty tokens, which throws off the token count, so remove them
-                tokens.erase(std::remove_if(tokens.begin(), tokens.end(), 
-                    [](const std::basic_string<std::uint8_t>& s)
-                    {
-                        return s.empty();
-                    }), tokens.end());
-
 
-                //examine our list of tokens and decide what to do with them
-                //we may have an array here where spaces were placed between
-                //components... or we may have single/mixed tokens with comma
-                //separated values.....
-                if (!tokens.empty())
+                    objectName.clear();
+                    objectID.clear();
+                }
+                else if (tokens[0][0] == '}')
                 {
-                    if (tokens.size() < 3)
+                    if (!objectStack.empty())
                     {
-                        //this is an object name/id pair
-                        //or an opening/closing brace
-                        if (!tokens[0].empty())
-                        {
-                            //hm, empty lines create an empty token...
-
-                            if (tokens[0][0] == '{')
-                            {
-                                //this is the first object
-                                if (objectStack.empty())
-                                {
-                                    objectStack.push_back(this);
-                                    setName(objectName);
-                                    setId(objectID);
-                                }
-                                else
-                                {
-                                    auto* o = objectStack.back();
-                                    objectStack.push_back(o->addObject(objectName, objectID));
-                                }
-
-                                objectName.clear();
-                                objectID.clear();
-                            }
-                            else if (tokens[0][0] == '}')
-                            {
-                                objectStack.pop_back();
-                            }
-                            else
-                            {
-                                //stash name/id strings so we can add them when creating a new object
-                                objectName = { tokens[0].begin(), tokens[0].end() };
-
-                                if (tokens.size() > 1 &&
-                                    !tokens[1].empty())
-                                {
-                                    objectID = { tokens[1].begin(), tokens[1].end() };
-                                }
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if (tokens[1][0] == '=')
-                        {
-                            //this is a property
-                            auto& prop = objectStack.back()->addProperty(std::string(tokens[0].begin(), tokens[0].end()));
-
-                            if (tokens[2].size() > 1
-                                && tokens[2][0] == '"')
-                            {
-                                //this is a string
-                                auto tokenEnd = tokens[2].size() - 1;
-
-                                //this assumes we stripped trailing whitespace (above)
-                                //really we should be reverse iterating to the final "
-                                if (tokens[2].back() != '"')
-                                {
-                                    //we're malformed but attempt to copy anyway
-                                    tokenEnd++;
-                                }
-
-                                //TODO we should be further splitting this if it's a string array
-                                //but we don't support getter/setter yet
-                                auto& utf = prop.m_utf8Values.emplace_back();
-                                for (auto i = 1u; i < tokenEnd; ++i)
-                                {
-                                    utf.push_back(tokens[2][i]);
-                                }
-                            }
-
-                            else
-                            {
-                                //try parsing tokens[2] as a CSV of floats
-                                std::string tmp;
-                                const auto parseFloat = [&]()
-                                    {
-                                        Util::String::removeChar(tmp, ' ');
-
-                                        if (prop.m_floatValues.empty())
-                                        {
-                                            if (tmp == "true")
-                                            {
-                                                prop.setValue(true);
-                                                return;
-                                            }
-                                            else if (tmp == "false")
-                                            {
-                                                prop.setValue(false);
-                                                return;
-                                            }
-                                        }
-
-
-                                        try
-                                        {
-                                            prop.m_floatValues.push_back(std::stod(tmp));
-                                        }
-                                        catch (...)
-                                        {
-                                            //for backwards compat stash this as a string
-                                            auto& utf = prop.m_utf8Values.emplace_back();
-                                            for (auto i = 0u; i < tokens[2].size(); ++i)
-                                            {
-                                                utf.push_back(tokens[2][i]);
-                                            }
-                                            //but we don't want to encourage this so nag with a warning
-#ifdef CRO_DEBUG_
-                                            LogW << FileSystem::getFileName(path) << " line:" << lineNumber << ", value: " << tmp << ": potential unquoted string value" << std::endl;
-#endif
-                                            //for now log these so we know what to edit MUST REMOVE IT THOUGH
-                                            //also below for missing quotes
-                                            /*std::ofstream f("cfg_corrections.txt", std::ios::app);
-                                            if (f.is_open() && f.good())
-                                            {
-                                                f << path << " - line: " << lineNumber << "\n";
-                                            }*/
-                                        };
-
-                                        tmp.clear();
-                                    };
-
-                                for (auto c : tokens[2])
-                                {
-                                    if (c != ',')
-                                    {
-                                        tmp.push_back(c);
-                                    }
-                                    else
-                                    {
-                                        //attempt to parse to double. 
-                                        parseFloat();
-                                    }
-                                }
-                                //don't forget the final value!
-                                if (!tmp.empty())
-                                {
-                                    parseFloat();
-                                }
-                            }
-                        }
+                        objectStack.pop_back();
                     }
                 }
-
-                if (stringOpen)
+                else
                 {
-                    LogW << FileSystem::getFileName(path) << " - Missing \" on line: " << lineNumber << std::endl;
-                    /*std::ofstream f("cfg_corrections.txt", std::ios::app);
-                    if (f.is_open() && f.good())
+                    //stash name/id strings so we can add them when creating a new object
+                    objectName = tokens[0];
+
+                    if (tokens.size() > 1)
                     {
-                        f << path << "(missing \") - line: " << lineNumber << "\n";
-                    }*/
+                        objectID = tokens[1];
+                    }
                 }
-
-                stringOpen = false;
-                foundProperty = false;
-                currentLine.clear();
-                lineNumber++;
+            }
+            else if (tokens[1][0] == '='
+                && !objectStack.empty())
+            {
+                //this is a property
+                auto& prop = objectStack.back()->addProperty(std::string(tokens[0]));
+                parseProperty(prop, tokens[2]);
             }
         }
 
-        if (!objectStack.empty()
-            && objectStack.back() != this) //*sigh* if there's no newline at the end of the file the very last } won't get read...
+        if (stringOpen)
         {
-            //we were missing a closing brace somewhere
-            //TODO find the line it was missing from (approx) based on indent??
-            LogW << FileSystem::getFileName(path) << ": at least one closing brace is missing" << std::endl;
+            LogW << FileSystem::getFileName(path) << " - Missing \" on line: " << lineNumber << std::endl;
+        }
+        lineNumber++;
+    };
 
-            /*std::ofstream f("cfg_corrections.txt", std::ios::app);
-            if (f.is_open() && f.good())
-            {
-                f << path << " at least one closing brace is missing" << "\n";
-            }*/
+    auto* lineStart = fileData.data();
+    auto* const fileEnd = lineStart + fileData.size();
+    while (lineStart < fileEnd)
+    {
+        auto* lineEnd = static_cast<char*>(std::memchr(lineStart, '\n', fileEnd - lineStart));
+        if (!lineEnd)
+        {
+            //no newline at the end of the file
+            lineEnd = fileEnd;
         }
 
-        return readCount == fileSize;
+        parseLine(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
     }
 
-    return false;
+    if (!objectStack.empty())
+    {
+        //we were missing a closing brace somewhere
+        //TODO find the line it was missing from (approx) based on indent??
+        LogW << FileSystem::getFileName(path) << ": at least one closing brace is missing" << std::endl;
+    }
+
+    return true;
 }
 
 
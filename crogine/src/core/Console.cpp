@@ -121,7 +121,8 @@ void Console::print(const std::string& line)
         buffer.pop_front();
     }
 
-    if (isNewFrame)
+    //the App may not exist if we're logging from a headless tool or test
+    if (isNewFrame && App::isValid())
     {
         auto* msg = App::getInstance().getMessageBus().post<Message::ConsoleEvent>(Message::ConsoleMessage);
         msg->type = Message::ConsoleEvent::LinePrinted;
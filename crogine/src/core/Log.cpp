@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -31,15 +31,403 @@ source distribution.
 #include <crogine/core/App.hpp>
 #include <crogine/core/Console.hpp>
 #include <crogine/core/String.hpp>
-#include <crogine/core/SysTime.hpp>
 #include <crogine/detail/Types.hpp>
 
 #include <SDL_log.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 using namespace cro;
 
+namespace
+{
+    struct LogEntry final
+    {
+        std::string message;
+        std::time_t time = 0;
+    };
+
+    //bounded multi-producer queue. Producers claim a slot by
+    //incrementing the tail, then publish it by updating the slot's
+    //sequence number, so posting a message never takes a lock.
+    //Only one consumer may pop at a time.
+    class LogQueue final
+    {
+    public:
+        static constexpr std::size_t Capacity = 1024;
+
+        LogQueue()
+        {
+            for (auto i = 0u; i < Capacity; ++i)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        //returns false if the queue is full. If notify is set
+        //the caller should wake the consumer as the queue is filling up
+        bool push(LogEntry&& entry, bool& notify)
+        {
+            auto pos = m_tail.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+
+            for (;;)
+            {
+                slot = &m_slots[pos & (Capacity - 1)];
+                auto seq = slot->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    notify = true;
+                    return false;
+                }
+                else
+                {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->entry = std::move(entry);
+            slot->sequence.store(pos + 1, std::memory_order_release);
+
+            notify = ((pos + 1) & ((Capacity / 2) - 1)) == 0;
+            return true;
+        }
+
+        bool pop(LogEntry& entry)
+        {
+            auto& slot = m_slots[m_head & (Capacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+            {
+                return false;
+            }
+
+            entry = std::move(slot.entry);
+            slot.sequence.store(m_head + Capacity, std::memory_order_release);
+            m_head++;
+            return true;
+        }
+
+    private:
+        struct Slot final
+        {
+            std::atomic<std::size_t> sequence = 0;
+            LogEntry entry;
+        };
+        std::array<Slot, Capacity> m_slots = {};
+
+        alignas(64) std::atomic<std::size_t> m_tail = 0;
+        alignas(64) std::size_t m_head = 0;
+    };
+
+    //drains the queue on a background thread, keeping the log file
+    //open between writes and collapsing consecutive duplicate messages
+    class LogWriter final
+    {
+    public:
+        ~LogWriter()
+        {
+            stop();
+        }
+
+        //returns false if the writer has been stopped, in which
+        //case the message should be written synchronously
+        bool post(const std::string& message)
+        {
+            if (m_state == State::Idle)
+            {
+                start();
+            }
+
+            if (m_state != State::Running)
+            {
+                return false;
+            }
+
+            LogEntry entry = { message, std::time(nullptr) };
+            bool notify = false;
+            auto pushed = m_queue.push(std::move(entry), notify);
+
+            if (notify)
+            {
+                wake();
+            }
+
+            //if the queue is full give the writer a moment
+            //to catch up before giving up on the message
+            for (auto i = 0; i < MaxRetries && !pushed; ++i)
+            {
+                std::this_thread::yield();
+                pushed = m_queue.push(std::move(entry), notify);
+            }
+
+            if (!pushed)
+            {
+                m_dropCount++;
+            }
+            return true;
+        }
+
+        void flush()
+        {
+            //if we crashed on the writer thread it may be holding the lock
+            //so don't wait forever, just write what we can and bail.
+            std::unique_lock lock(m_consumerMutex, std::defer_lock);
+            for (auto i = 0; i < 20 && !lock.try_lock(); ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            if (lock.owns_lock())
+            {
+                drain(true);
+            }
+        }
+
+        void stop()
+        {
+            {
+                std::scoped_lock lock(m_threadMutex);
+                if (m_state != State::Running)
+                {
+                    m_state = State::Stopped;
+                    return;
+                }
+                m_state = State::Stopped;
+            }
+
+            wake();
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+
+            std::scoped_lock lock(m_consumerMutex);
+            drain(true);
+        }
+
+        //used once the writer has been stopped
+        static void writeImmediate(const std::string& path, const std::string& message)
+        {
+            RaiiRWops file;
+            file.file = SDL_RWFromFile(path.c_str(), "a");
+            if (file.file)
+            {
+                auto t = std::time(nullptr);
+                auto stamp = formatTime(t);
+                SDL_RWwrite(file.file, stamp.c_str(), 1, stamp.size());
+                SDL_RWwrite(file.file, message.c_str(), 1, message.size());
+                if (message.empty() || message.back() != '\n')
+                {
+                    SDL_RWwrite(file.file, "\n", 1, 1);
+                }
+            }
+            else
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s\nAbove message was intended for log file. Opening file probably failed.", message.c_str());
+            }
+        }
+
+        const std::string& getPath() const { return m_path; }
+
+    private:
+        enum class State
+        {
+            Idle, Running, Stopped
+        };
+        std::atomic<State> m_state = State::Idle;
+
+        LogQueue m_queue;
+        std::atomic<std::uint32_t> m_dropCount = 0;
+
+        std::mutex m_threadMutex;
+        std::thread m_thread;
+        std::condition_variable m_condition;
+        std::atomic<bool> m_wakeRequested = false;
+        static constexpr std::int32_t MaxRetries = 1000;
+
+        //everything below here is owned by whoever holds the consumer mutex
+        std::mutex m_consumerMutex;
+        std::string m_path;
+        SDL_RWops* m_file = nullptr;
+        bool m_fileFailed = false;
+
+        std::string m_batch;
+        std::string m_lastMessage;
+        std::uint32_t m_repeatCount = 0;
+        std::time_t m_repeatStart = 0;
+        std::time_t m_stampTime = -1;
+        std::string m_stamp;
+
+        //how long, in seconds, duplicates are held before their count is written
+        static constexpr std::time_t RepeatInterval = 5;
+        //how long the writer sleeps between batches if not woken
+        static constexpr std::chrono::milliseconds BatchInterval = std::chrono::milliseconds(50);
+
+        void start()
+        {
+            std::scoped_lock lock(m_threadMutex);
+            if (m_state == State::Idle)
+            {
+                m_path = App::getPreferencePath() + "output.log";
+                m_state = State::Running;
+                m_thread = std::thread(&LogWriter::threadFunc, this);
+            }
+        }
+
+        void wake()
+        {
+            m_wakeRequested = true;
+            m_condition.notify_one();
+        }
+
+        void threadFunc()
+        {
+            while (m_state == State::Running)
+            {
+                {
+                    //we don't care too much about spurious or missed wake-ups
+                    //here as the wait always times out in time for the next batch
+                    std::unique_lock lock(m_threadMutex);
+                    m_condition.wait_for(lock, BatchInterval, [&]() { return m_wakeRequested || m_state != State::Running; });
+                    m_wakeRequested = false;
+                }
+
+                std::scoped_lock lock(m_consumerMutex);
+                drain(false);
+            }
+        }
+
+        static std::string formatTime(std::time_t t)
+        {
+            std::tm tm = {};
+#ifdef _WIN32
+            localtime_s(&tm, &t);
+#else
+            localtime_r(&t, &tm);
+#endif
+            std::array<char, 32> buff = {};
+            auto len = std::strftime(buff.data(), buff.size(), "%H:%M:%S - %d/%m/%Y: ", &tm);
+            return std::string(buff.data(), len);
+        }
+
+        const std::string& getStamp(std::time_t t)
+        {
+            if (t != m_stampTime)
+            {
+                m_stamp = formatTime(t);
+                m_stampTime = t;
+            }
+            return m_stamp;
+        }
+
+        void writeRepeatCount(std::time_t t)
+        {
+            if (m_repeatCount != 0)
+            {
+                m_batch += getStamp(t);
+                m_batch += "Last message repeated " + std::to_string(m_repeatCount) + " times\n";
+                m_repeatCount = 0;
+            }
+        }
+
+        //must hold the consumer mutex
+        void drain(bool closeFile)
+        {
+            LogEntry entry;
+            while (m_queue.pop(entry))
+            {
+                if (entry.message == m_lastMessage)
+                {
+                    if (m_repeatCount == 0)
+                    {
+                        m_repeatStart = entry.time;
+                    }
+                    m_repeatCount++;
+
+                    if (entry.time - m_repeatStart >= RepeatInterval)
+                    {
+                        writeRepeatCount(entry.time);
+                    }
+                    continue;
+                }
+
+                writeRepeatCount(entry.time);
+
+                m_batch += getStamp(entry.time);
+                m_batch += entry.message;
+                if (m_batch.back() != '\n')
+                {
+                    m_batch.push_back('\n');
+                }
+                m_lastMessage.swap(entry.message);
+            }
+
+            auto now = std::time(nullptr);
+            if (closeFile
+                || (m_repeatCount && now - m_repeatStart >= RepeatInterval))
+            {
+                writeRepeatCount(now);
+            }
+
+            if (auto dropped = m_dropCount.exchange(0); dropped != 0)
+            {
+                m_batch += getStamp(now);
+                m_batch += "WARNING: Log queue was full, " + std::to_string(dropped) + " messages were dropped\n";
+            }
+
+            if (!m_batch.empty())
+            {
+                if (!m_file && !m_fileFailed)
+                {
+                    m_file = SDL_RWFromFile(m_path.c_str(), "a");
+                    if (!m_file)
+                    {
+                        //only warn once rather than every batch
+                        m_fileFailed = true;
+                        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed opening %s, messages intended for the log file will be lost.", m_path.c_str());
+                    }
+                }
+
+                if (m_file)
+                {
+                    SDL_RWwrite(m_file, m_batch.data(), 1, m_batch.size());
+                }
+                m_batch.clear();
+            }
+
+            //closing the file is the only way to make sure
+            //SDL has flushed everything to disk
+            if (closeFile && m_file)
+            {
+                SDL_RWclose(m_file);
+                m_file = nullptr;
+            }
+        }
+    };
+
+    LogWriter& getWriter()
+    {
+        static LogWriter writer;
+        return writer;
+    }
+}
+
 std::list<std::string> Logger::m_buffer;
 std::string Logger::m_output;
 
@@ -89,26 +477,16 @@ void Logger::log(const std::string& message, Type type, Output output)
         OutputDebugStringA(outstring.c_str());
 #endif //_MSC_VER
     }
-    if (output == Output::File || output == Output::All)
+    //the log file lives in the preference path so can't be
+    //written until an App has been created, eg in tests
+    if ((output == Output::File || output == Output::All)
+        && App::isValid())
     {
-        //output to a log file
-        RaiiRWops file;
-        auto logPath = cro::App::getPreferencePath() + "output.log";
-        file.file = SDL_RWFromFile(logPath.c_str(), "a");
-        if (file.file)
-        {
-            auto timeStamp = SysTime::timeString();
-            timeStamp += " - ";
-            timeStamp += SysTime::dateString();
-            timeStamp += ": ";
-
-            SDL_RWwrite(file.file, timeStamp.c_str(), 1, timeStamp.size());
-            SDL_RWwrite(file.file, outstring.c_str(), 1, outstring.size());
-        }
-        else
+        //queue for the log writer, or write directly if it has shut down
+        auto& writer = getWriter();
+        if (!writer.post(outstring))
         {
-            log(message, type, Output::Console);
-            log("Above message was intended for log file. Opening file probably failed.", Type::Warning, Output::Console);
+            LogWriter::writeImmediate(writer.getPath().empty() ? App::getPreferencePath() + "output.log" : writer.getPath(), outstring);
         }
     }
 #else
@@ -137,7 +515,17 @@ std::ostream& Logger::log(Logger::Type type)
     return stream;
 }
 
+void Logger::flush()
+{
+    getWriter().flush();
+}
+
 //private
+void Logger::shutdown()
+{
+    getWriter().stop();
+}
+
 void Logger::updateOutString(std::size_t maxBuffer)
 {
     static size_t count = 0;
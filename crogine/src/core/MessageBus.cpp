@@ -28,31 +28,162 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/core/MessageBus.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
 
 using namespace cro;
 
+namespace cro::Detail
+{
+    //a block of storage to which messages are written.
+    //max msg size is 128 bytes plus the header, so this
+    //holds at least 128 messages before a new segment is used
+    struct MessageSegment final
+    {
+        static constexpr std::size_t Size = 16384u;
+        std::vector<std::max_align_t> data = std::vector<std::max_align_t>(Size / sizeof(std::max_align_t));
+        std::size_t used = 0;
+
+        char* begin() { return reinterpret_cast<char*>(data.data()); }
+    };
+
+    struct MessageSegmentList final
+    {
+        std::vector<MessageSegment> segments;
+        std::size_t activeSegment = 0;
+        std::size_t messageCount = 0;
+        std::size_t byteCount = 0;
+
+        char* allocate(std::size_t size)
+        {
+            if (segments.empty())
+            {
+                segments.emplace_back();
+            }
+
+            if (segments[activeSegment].used + size > MessageSegment::Size)
+            {
+                //existing segments are reset rather than freed
+                //so only add a new one if we've used them all
+                activeSegment++;
+                if (activeSegment == segments.size())
+                {
+                    segments.emplace_back();
+                }
+            }
+
+            auto& segment = segments[activeSegment];
+            char* ptr = segment.begin() + segment.used;
+            segment.used += size;
+
+            messageCount++;
+            byteCount += size;
+
+            return ptr;
+        }
+
+        void reset()
+        {
+            for (auto& segment : segments)
+            {
+                segment.used = 0;
+            }
+            activeSegment = 0;
+            messageCount = 0;
+            byteCount = 0;
+        }
+    };
+
+    //double buffered so the previous frame can be read
+    //while new messages are posted
+    struct MessageThreadBuffer final
+    {
+        std::array<MessageSegmentList, 2u> lists;
+        std::atomic<bool> released = false; //true if the owning thread exited and the buffer can be reused
+    };
+}
+
 namespace
 {
-    //max msg size is 128 bytes, so 128 messages
-    //maximum per frame is 16384 bytes
-    const std::size_t bufferSize = 16384u;
+    std::atomic<std::uint32_t> nextBusID = 1;
+
+    //each thread keeps a list of the buffers it owns for each
+    //bus it has posted to. Usually this is just one or two.
+    struct ThreadBufferRegistry final
+    {
+        struct Entry final
+        {
+            std::uint32_t busID = 0;
+            Detail::MessageThreadBuffer* buffer = nullptr;
+            std::weak_ptr<Detail::MessageThreadBuffer> owner;
+        };
+        std::vector<Entry> entries;
+
+        ~ThreadBufferRegistry()
+        {
+            //let any buses which are still alive know they can recycle our buffers
+            for (auto& entry : entries)
+            {
+                if (auto buffer = entry.owner.lock(); buffer)
+                {
+                    buffer->released = true;
+                }
+            }
+        }
+    };
+    thread_local ThreadBufferRegistry threadRegistry;
+
+    std::size_t alignSize(std::size_t size)
+    {
+        constexpr auto Alignment = alignof(std::max_align_t);
+        return (size + (Alignment - 1)) & ~(Alignment - 1);
+    }
 }
 
 MessageBus::MessageBus()
-    : m_currentBuffer   (bufferSize),
-    m_pendingBuffer     (bufferSize),
-    m_inPointer         (m_pendingBuffer.data()),
-    m_outPointer        (m_currentBuffer.data()),
+    : m_busID           (nextBusID++),
+    m_writeIndex        (0),
+    m_readBuffer        (0),
+    m_readSegment       (0),
+    m_readOffset        (0),
     m_currentCount      (0),
-    m_pendingCount      (0),
     m_enabled           (true)
 {}
 
+MessageBus::~MessageBus() = default;
+
 const Message& MessageBus::poll()
 {
-    static constexpr auto size = sizeof(Message);
-    const Message& m = *reinterpret_cast<Message*>(m_outPointer);
-    m_outPointer += (size + m.m_dataSize);
+    CRO_ASSERT(m_currentCount != 0, "No messages to poll");
+
+    const auto readIndex = 1 - m_writeIndex.load(std::memory_order_relaxed);
+
+    //skip to the next segment with any unread data in it
+    for (;;)
+    {
+        auto& list = m_threadBuffers[m_readBuffer]->lists[readIndex];
+        if (m_readSegment < list.segments.size()
+            && m_readOffset < list.segments[m_readSegment].used)
+        {
+            break;
+        }
+
+        if (m_readSegment < list.segments.size())
+        {
+            m_readSegment++;
+        }
+        else
+        {
+            m_readBuffer++;
+            m_readSegment = 0;
+        }
+        m_readOffset = 0;
+    }
+
+    auto& segment = m_threadBuffers[m_readBuffer]->lists[readIndex].segments[m_readSegment];
+    const Message& m = *reinterpret_cast<Message*>(segment.begin() + m_readOffset);
+    m_readOffset += MessageStride + alignSize(m.m_dataSize);
     m_currentCount--;
 
     return m;
@@ -62,14 +193,33 @@ bool MessageBus::empty()
 {
     if (m_currentCount == 0)
     {
-#ifdef USE_PARALLEL_PROCESSING
         std::scoped_lock l(m_mutex);
-#endif
-        m_currentBuffer.swap(m_pendingBuffer);
-        m_inPointer = m_pendingBuffer.data();
-        m_outPointer = m_currentBuffer.data();
-        m_currentCount = m_pendingCount;
-        m_pendingCount = 0;
+
+        //the previous read lists have all been consumed
+        //so reset them and use them for writing, and read
+        //the lists we were writing to
+        const auto readIndex = m_writeIndex.load(std::memory_order_relaxed);
+        const auto writeIndex = 1 - readIndex;
+
+        m_stats = {};
+        m_stats.threadCount = m_threadBuffers.size();
+
+        for (auto& buffer : m_threadBuffers)
+        {
+            buffer->lists[writeIndex].reset();
+
+            const auto& list = buffer->lists[readIndex];
+            m_currentCount += list.messageCount;
+            m_stats.messageCount += list.messageCount;
+            m_stats.byteCount += list.byteCount;
+            m_stats.segmentCount += list.segments.size() + buffer->lists[writeIndex].segments.size();
+        }
+        m_writeIndex.store(writeIndex, std::memory_order_release);
+
+        m_readBuffer = 0;
+        m_readSegment = 0;
+        m_readOffset = 0;
+
         return true;
     }
     return false;
@@ -77,5 +227,68 @@ bool MessageBus::empty()
 
 std::size_t MessageBus::pendingMessageCount() const
 {
-    return m_pendingCount;
+    std::scoped_lock l(m_mutex);
+
+    const auto writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    std::size_t count = 0;
+    for (const auto& buffer : m_threadBuffers)
+    {
+        count += buffer->lists[writeIndex].messageCount;
+    }
+    return count;
+}
+
+//private
+char* MessageBus::allocate(std::size_t dataSize)
+{
+    auto& buffer = getThreadBuffer();
+    return buffer.lists[m_writeIndex.load(std::memory_order_acquire)].allocate(MessageStride + alignSize(dataSize));
+}
+
+Detail::MessageThreadBuffer& MessageBus::getThreadBuffer()
+{
+    //fast path, we've already posted to this bus from this thread
+    for (const auto& entry : threadRegistry.entries)
+    {
+        if (entry.busID == m_busID)
+        {
+            return *entry.buffer;
+        }
+    }
+
+    std::shared_ptr<Detail::MessageThreadBuffer> buffer;
+    {
+        std::scoped_lock l(m_mutex);
+
+        //recycle the buffer of any thread which has exited
+        auto result = std::find_if(m_threadBuffers.begin(), m_threadBuffers.end(),
+            [](const std::shared_ptr<Detail::MessageThreadBuffer>& b)
+            {
+                return b->released.load();
+            });
+
+        if (result != m_threadBuffers.end())
+        {
+            buffer = *result;
+            buffer->released = false;
+        }
+        else
+        {
+            buffer = m_threadBuffers.emplace_back(std::make_shared<Detail::MessageThreadBuffer>());
+        }
+    }
+
+    //remove any stale entries for buses which no longer exist
+    threadRegistry.entries.erase(std::remove_if(threadRegistry.entries.begin(), threadRegistry.entries.end(),
+        [](const ThreadBufferRegistry::Entry& e)
+        {
+            return e.owner.expired();
+        }), threadRegistry.entries.end());
+
+    auto& entry = threadRegistry.entries.emplace_back();
+    entry.busID = m_busID;
+    entry.buffer = buffer.get();
+    entry.owner = buffer;
+
+    return *buffer;
 }
\ No newline at end of file
@@ -0,0 +1,211 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "FileCache.hpp"
+
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    std::uint64_t getProcessKey()
+    {
+        //there's no portable process ID so this is seeded per process
+        //from the random device and clock, in case the random device
+        //is deterministic on this platform
+        static const std::uint64_t key = []()
+            {
+                std::random_device rd;
+                const auto time = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                return ((static_cast<std::uint64_t>(rd()) << 32) | rd()) ^ time;
+            }();
+        return key;
+    }
+
+    std::atomic<std::uint32_t> tempCounter = 0;
+}
+
+FileCache::FileCache(const std::string& name, const std::string& extension)
+    : m_name        (name),
+    m_extension     (extension)
+{
+
+}
+
+//public
+void FileCache::setDirectory(const std::string& path)
+{
+    std::scoped_lock lock(m_mutex);
+    m_directory = path;
+
+    if (!m_directory.empty())
+    {
+        std::replace(m_directory.begin(), m_directory.end(), '\\', '/');
+        if (m_directory.back() != '/')
+        {
+            m_directory.push_back('/');
+        }
+
+        if (!FileSystem::directoryExists(m_directory)
+            && !FileSystem::createDirectory(m_directory))
+        {
+            LogW << "Unable to create " << m_name << " cache directory " << m_directory << ", caching is disabled" << std::endl;
+            m_directory.clear();
+        }
+    }
+}
+
+std::string FileCache::getDirectory() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_directory;
+}
+
+std::string FileCache::getPath(const std::string& sourcePath) const
+{
+    std::scoped_lock lock(m_mutex);
+    if (m_directory.empty())
+    {
+        return {};
+    }
+
+    std::array<char, 17> hex = {};
+    std::snprintf(hex.data(), hex.size(), "%016llx", static_cast<unsigned long long>(hashPath(sourcePath)));
+
+    return m_directory + hex.data() + m_extension;
+}
+
+std::uint64_t FileCache::hashPath(const std::string& path)
+{
+    //FNV-1a
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (auto c : path)
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+std::string FileCache::getTempPath(const std::string& path)
+{
+    const auto threadKey = static_cast<std::uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    const auto count = tempCounter.fetch_add(1, std::memory_order_relaxed);
+
+    std::array<char, 40> suffix = {};
+    std::snprintf(suffix.data(), suffix.size(), ".%016llx%08x.tmp",
+        static_cast<unsigned long long>(getProcessKey() ^ threadKey), count);
+
+    return path + suffix.data();
+}
+
+bool FileCache::writeAtomic(const std::string& path, const std::function<bool(const std::string&)>& writeFunc)
+{
+    const auto tempPath = getTempPath(path);
+
+    std::error_code ec;
+    try
+    {
+        const auto u8Temp = std::filesystem::u8path(tempPath);
+        if (!writeFunc(tempPath))
+        {
+            std::filesystem::remove(u8Temp, ec);
+            return false;
+        }
+
+        //if another writer got here first this replaces its file
+        //with one which ought to be identical
+        std::filesystem::rename(u8Temp, std::filesystem::u8path(path), ec);
+        if (ec)
+        {
+            LogW << "Failed writing " << path << ": " << ec.message() << std::endl;
+            std::filesystem::remove(u8Temp, ec);
+            return false;
+        }
+    }
+    catch (...)
+    {
+        //u8path() may throw on invalid paths
+        return false;
+    }
+    return true;
+}
+
+FileCache::TwinCheck::TwinCheck(const std::string& sourcePath)
+    : m_sourcePath(sourcePath)
+{
+
+}
+
+bool FileCache::TwinCheck::isNewer(const std::string& twinPath)
+{
+#ifdef __ANDROID__
+    //files are in the apk so we can't check them with std::filesystem
+    return false;
+#else
+    try
+    {
+        std::error_code ec;
+        const auto twinTime = std::filesystem::last_write_time(std::filesystem::u8path(twinPath), ec);
+        if (ec)
+        {
+            return false;
+        }
+
+        if (!m_sourceChecked)
+        {
+            const auto sourceTime = std::filesystem::last_write_time(std::filesystem::u8path(m_sourcePath), ec);
+            if (!ec)
+            {
+                m_sourceTime = sourceTime;
+            }
+            m_sourceChecked = true;
+        }
+        return !m_sourceTime || twinTime > *m_sourceTime;
+    }
+    catch (...)
+    {
+        //u8path() may throw on invalid paths
+        return false;
+    }
+#endif
+}
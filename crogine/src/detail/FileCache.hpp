@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace cro::Detail
+{
+    /*!
+    \brief A directory of files compiled or decoded from source files,
+    such as the audio decode cache and compiled config files.
+    Each source file maps to a single cache file named by a hash of
+    its path. Safe to use from multiple threads at once.
+    */
+    class FileCache final
+    {
+    public:
+        /*!
+        \param name Used in warning messages, eg "audio"
+        \param extension Appended to cache file names, eg ".pcm"
+        */
+        FileCache(const std::string& name, const std::string& extension);
+
+        FileCache(const FileCache&) = delete;
+        FileCache& operator = (const FileCache&) = delete;
+
+        /*!
+        \brief Sets the cache directory, creating it if it doesn't exist.
+        Pass an empty string to disable the cache.
+        */
+        void setDirectory(const std::string& path);
+
+        /*!
+        \brief Returns the cache directory, or an empty string if disabled
+        */
+        std::string getDirectory() const;
+
+        /*!
+        \brief Returns the path of the cache file for the given source
+        file, or an empty string if the cache is disabled
+        */
+        std::string getPath(const std::string& sourcePath) const;
+
+        /*!
+        \brief 64 bit FNV-1a hash of the given path
+        */
+        static std::uint64_t hashPath(const std::string& path);
+
+        /*!
+        \brief Returns a temporary path next to the given path which is
+        unique to this call, so that concurrent writers, in this or any
+        other process, never write to the same temporary file.
+        */
+        static std::string getTempPath(const std::string& path);
+
+        /*!
+        \brief Writes a file by passing a unique temporary path to writeFunc
+        and then renaming the result to the given path, so that a partially
+        written file is never read in place of a complete one.
+        \param writeFunc Writes the file to the path it is given and
+        returns true on success
+        \returns true if the file was written and renamed, else false
+        */
+        static bool writeAtomic(const std::string& path, const std::function<bool(const std::string&)>& writeFunc);
+
+        /*!
+        \brief Checks whether files derived from a source file, such as
+        compiled twins and cache files, should be loaded in its place.
+        The source is only checked once, and only when a derived file
+        exists to compare it to.
+        */
+        class TwinCheck final
+        {
+        public:
+            explicit TwinCheck(const std::string& sourcePath);
+
+            /*!
+            \brief Returns true if the file at twinPath exists and is newer
+            than the source file, or if the source file doesn't exist, eg
+            when only the twin is shipped. A twin with the same modification
+            time as the source is not used, as coarse file system timestamps
+            can't tell which of the two was written last. Always returns false
+            on Android, where files in the apk can't be checked.
+            */
+            bool isNewer(const std::string& twinPath);
+
+            /*!
+            \brief Returns true if the source file exists. Only valid after
+            isNewer() has returned true.
+            */
+            bool hasSource() const { return m_sourceTime.has_value(); }
+
+        private:
+            std::string m_sourcePath;
+            std::optional<std::filesystem::file_time_type> m_sourceTime;
+            bool m_sourceChecked = false;
+        };
+
+    private:
+        const std::string m_name;
+        const std::string m_extension;
+
+        mutable std::mutex m_mutex;
+        std::string m_directory;
+    };
+}
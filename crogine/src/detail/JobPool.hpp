@@ -0,0 +1,266 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cro::Detail
+{
+    /*!
+    \brief Worker threads shared by the asynchronous loaders, such as the
+    AudioDecoder and TextureLoader.
+    Jobs are run on a worker thread and then handed back, in the order in
+    which they finished, to the main thread which delivers the result to
+    the job's target. Job types must have a member
+    \begincode
+    Target* target;
+    \endcode
+    which is set to nullptr if the job is cancelled, and a function
+    \begincode
+    void run();
+    \endcode
+    which does the work on the worker thread. Targets are only cancelled
+    or swapped on the main thread, so it's safe to read the target of a
+    job returned by popCompleted() without locking.
+    */
+    template <typename Job, typename Target>
+    class JobPool final
+    {
+    public:
+        /*!
+        \param threadCount Number of workers started when the first job
+        is submitted
+        */
+        explicit JobPool(std::size_t threadCount)
+            : m_threadCount(std::max(threadCount, std::size_t(1))) {}
+
+        ~JobPool()
+        {
+            stop();
+        }
+
+        JobPool(const JobPool&) = delete;
+        JobPool& operator = (const JobPool&) = delete;
+
+        /*!
+        \brief Queues a job, starting the worker threads if needed
+        */
+        void submit(std::shared_ptr<Job> job)
+        {
+            {
+                std::scoped_lock lock(m_mutex);
+                m_jobs.push_back(job);
+                m_queue.push_back(std::move(job));
+            }
+
+            if (m_threads.empty())
+            {
+                start();
+            }
+            m_condition.notify_one();
+        }
+
+        /*!
+        \brief Cancels all jobs waiting to be delivered to the given target
+        */
+        void cancel(const Target* target)
+        {
+            std::scoped_lock lock(m_mutex);
+            for (auto& job : m_jobs)
+            {
+                if (job->target == target)
+                {
+                    job->target = nullptr;
+                }
+            }
+        }
+
+        /*!
+        \brief Swaps the targets of any jobs waiting to be delivered
+        to a or b, for example when the targets are moved
+        */
+        void swapTargets(const Target* a, Target* b)
+        {
+            std::scoped_lock lock(m_mutex);
+            for (auto& job : m_jobs)
+            {
+                if (job->target == a)
+                {
+                    job->target = b;
+                }
+                else if (job->target == b)
+                {
+                    job->target = const_cast<Target*>(a);
+                }
+            }
+        }
+
+        /*!
+        \brief Removes and returns the oldest completed job if accept
+        returns true for it, else returns nullptr.
+        \param accept Callable with the signature bool(const Job&) used
+        to leave completed jobs in the pool, eg for an upload budget
+        */
+        template <typename Fn>
+        std::shared_ptr<Job> popCompleted(Fn&& accept)
+        {
+            std::scoped_lock lock(m_mutex);
+            if (m_completed.empty()
+                || !accept(*m_completed.front()))
+            {
+                return nullptr;
+            }
+
+            auto job = m_completed.front();
+            m_completed.pop_front();
+            m_jobs.erase(std::remove(m_jobs.begin(), m_jobs.end(), job), m_jobs.end());
+
+            return job;
+        }
+
+        std::shared_ptr<Job> popCompleted()
+        {
+            return popCompleted([](const Job&) {return true; });
+        }
+
+        /*!
+        \brief Returns the number of jobs queued, running or
+        waiting to be delivered
+        */
+        std::size_t getPendingCount() const
+        {
+            std::scoped_lock lock(m_mutex);
+            return m_jobs.size();
+        }
+
+        /*!
+        \brief Returns the number of jobs waiting to be delivered
+        */
+        std::size_t getCompletedCount() const
+        {
+            std::scoped_lock lock(m_mutex);
+            return m_completed.size();
+        }
+
+        /*!
+        \brief Returns the number of worker threads, which
+        is 0 until the first job is submitted
+        */
+        std::size_t getWorkerCount() const
+        {
+            return m_threads.size();
+        }
+
+        /*!
+        \brief Stops the worker threads and drops all jobs
+        */
+        void stop()
+        {
+            if (m_threads.empty())
+            {
+                return;
+            }
+
+            {
+                std::scoped_lock lock(m_mutex);
+                m_running = false;
+            }
+            m_condition.notify_all();
+
+            for (auto& t : m_threads)
+            {
+                t.join();
+            }
+            m_threads.clear();
+
+            m_jobs.clear();
+            m_queue.clear();
+            m_completed.clear();
+        }
+
+    private:
+        std::size_t m_threadCount;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::vector<std::shared_ptr<Job>> m_jobs; //all jobs not yet delivered
+        std::deque<std::shared_ptr<Job>> m_queue; //jobs waiting for a worker
+        std::deque<std::shared_ptr<Job>> m_completed; //jobs waiting to be delivered, in the order they finished
+        std::vector<std::thread> m_threads;
+        bool m_running = false;
+
+        void start()
+        {
+            m_running = true;
+            for (auto i = 0u; i < m_threadCount; ++i)
+            {
+                m_threads.emplace_back(&JobPool::threadFunc, this);
+            }
+        }
+
+        void threadFunc()
+        {
+            while (true)
+            {
+                std::shared_ptr<Job> job;
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_condition.wait(lock, [&]() {return !m_queue.empty() || !m_running; });
+
+                    if (!m_running)
+                    {
+                        return;
+                    }
+
+                    job = m_queue.front();
+                    m_queue.pop_front();
+
+                    if (job->target == nullptr)
+                    {
+                        //cancelled before we got to it
+                        m_jobs.erase(std::remove(m_jobs.begin(), m_jobs.end(), job), m_jobs.end());
+                        continue;
+                    }
+                }
+
+                job->run();
+
+                std::scoped_lock lock(m_mutex);
+                m_completed.push_back(job);
+            }
+        }
+    };
+}
@@ -34,21 +34,279 @@ source distribution.
 #include <crogine/ecs/components/Model.hpp>
 #include <crogine/ecs/components/Skeleton.hpp>
 
+#include <algorithm>
+#include <limits>
+
 using namespace cro;
 
+namespace
+{
+    constexpr std::uint32_t align(std::uint32_t value, std::uint32_t alignment)
+    {
+        return (value + (alignment - 1)) & ~(alignment - 1);
+    }
+
+    struct MeshV3 final
+    {
+        Detail::ModelBinary::MeshHeaderV3 header;
+        std::vector<std::uint32_t> indexSizes;
+        std::vector<float> vertexData;
+        std::vector<std::uint8_t> indexData; //all arrays, padded to 4 bytes
+        std::uint32_t size = 0; //from the beginning of the header to the end of the index data
+    };
+
+    //converts vertices in the version 1/2 layout, where tangents have a 4th
+    //component containing the sign of the bitangent, to the version 3 layout
+    MeshV3 createMeshV3(std::uint32_t meshOffset, std::uint16_t flags, const std::vector<float>& vertexData,
+        const std::vector<std::vector<std::uint32_t>>& indexData)
+    {
+        MeshV3 mesh;
+        mesh.header.flags = flags & ~VertexProperty::Bitangent;
+
+        std::uint32_t srcStride = 0;
+        const auto attribSizes = Detail::ModelBinary::getAttributeSizes(mesh.header.flags);
+        for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+        {
+            if (i == Mesh::Attribute::Tangent
+                && attribSizes[i] != 0)
+            {
+                srcStride += 4;
+            }
+            else if (i != Mesh::Attribute::Bitangent)
+            {
+                srcStride += static_cast<std::uint32_t>(attribSizes[i]);
+            }
+        }
+        CRO_ASSERT(srcStride != 0 && vertexData.size() % srcStride == 0, "");
+
+        std::size_t dstStride = 0;
+        for (auto size : attribSizes)
+        {
+            dstStride += size;
+        }
+
+        const auto vertexCount = vertexData.size() / srcStride;
+        mesh.vertexData.reserve(vertexCount * dstStride);
+
+        glm::vec3 boxMin(std::numeric_limits<float>::max());
+        glm::vec3 boxMax(std::numeric_limits<float>::lowest());
+
+        for (auto i = 0u; i < vertexData.size(); i += srcStride)
+        {
+            std::uint32_t offset = 0;
+            glm::vec3 normal(0.f);
+            for (auto j = 0u; j < Mesh::Attribute::Total; ++j)
+            {
+                if (attribSizes[j] == 0
+                    || j == Mesh::Attribute::Bitangent)
+                {
+                    continue;
+                }
+
+                if (j == Mesh::Attribute::Tangent)
+                {
+                    const glm::vec3 tan(vertexData[i + offset], vertexData[i + offset + 1], vertexData[i + offset + 2]);
+                    const auto bitan = glm::cross(normal, tan) * vertexData[i + offset + 3];
+
+                    mesh.vertexData.insert(mesh.vertexData.end(), { tan.x, tan.y, tan.z, bitan.x, bitan.y, bitan.z });
+                    offset += 4;
+                    continue;
+                }
+
+                if (j == Mesh::Attribute::Position)
+                {
+                    const glm::vec3 position(vertexData[i + offset], vertexData[i + offset + 1], vertexData[i + offset + 2]);
+                    boxMin = glm::min(boxMin, position);
+                    boxMax = glm::max(boxMax, position);
+                }
+                else if (j == Mesh::Attribute::Normal)
+                {
+                    normal = { vertexData[i + offset], vertexData[i + offset + 1], vertexData[i + offset + 2] };
+                }
+
+                mesh.vertexData.insert(mesh.vertexData.end(), vertexData.begin() + i + offset, vertexData.begin() + i + offset + attribSizes[j]);
+                offset += static_cast<std::uint32_t>(attribSizes[j]);
+            }
+        }
+
+        if (vertexCount != 0)
+        {
+            //matches the bounds calculated by BinaryMeshBuilder for older versions
+            const auto rad = (boxMax - boxMin) / 2.f;
+            const auto centre = boxMin + rad;
+            const auto radius = std::max(std::abs(rad.x), std::max(std::abs(rad.y), std::abs(rad.z)));
+
+            std::memcpy(mesh.header.boundingBox, &boxMin, sizeof(glm::vec3));
+            std::memcpy(mesh.header.boundingBox + 3, &boxMax, sizeof(glm::vec3));
+            std::memcpy(mesh.header.boundingSphere, &centre, sizeof(glm::vec3));
+            mesh.header.boundingSphere[3] = radius;
+        }
+
+        std::uint32_t maxIndex = 0;
+        for (const auto& indices : indexData)
+        {
+            for (auto index : indices)
+            {
+                maxIndex = std::max(maxIndex, index);
+            }
+        }
+        mesh.header.indexSize = maxIndex <= std::numeric_limits<std::uint16_t>::max() ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+
+        for (const auto& indices : indexData)
+        {
+            mesh.indexSizes.push_back(static_cast<std::uint32_t>(indices.size()));
+
+            if (mesh.header.indexSize == sizeof(std::uint16_t))
+            {
+                for (auto index : indices)
+                {
+                    const auto i = static_cast<std::uint16_t>(index);
+                    mesh.indexData.insert(mesh.indexData.end(), reinterpret_cast<const std::uint8_t*>(&i), reinterpret_cast<const std::uint8_t*>(&i) + sizeof(i));
+                }
+            }
+            else
+            {
+                const auto* data = reinterpret_cast<const std::uint8_t*>(indices.data());
+                mesh.indexData.insert(mesh.indexData.end(), data, data + (indices.size() * sizeof(std::uint32_t)));
+            }
+            mesh.indexData.resize(align(static_cast<std::uint32_t>(mesh.indexData.size()), 4));
+        }
+
+        mesh.header.vertexCount = static_cast<std::uint32_t>(vertexCount);
+        mesh.header.vertexSize = static_cast<std::uint16_t>(dstStride * sizeof(float));
+        mesh.header.indexArrayCount = static_cast<std::uint16_t>(indexData.size());
+        mesh.header.vertexOffset = align(meshOffset + static_cast<std::uint32_t>(sizeof(mesh.header) + (mesh.indexSizes.size() * sizeof(std::uint32_t))), 16);
+        mesh.header.indexArrayOffset = mesh.header.vertexOffset + static_cast<std::uint32_t>(mesh.vertexData.size() * sizeof(float));
+        mesh.size = mesh.header.indexArrayOffset + static_cast<std::uint32_t>(mesh.indexData.size()) - meshOffset;
+
+        return mesh;
+    }
+
+    //writes the mesh at the current position of the file, which
+    //must be the meshOffset passed to createMeshV3()
+    void writeMeshV3(SDL_RWops* file, std::uint32_t meshOffset, const MeshV3& mesh)
+    {
+        SDL_RWwrite(file, &mesh.header, sizeof(mesh.header), 1);
+        SDL_RWwrite(file, mesh.indexSizes.data(), sizeof(std::uint32_t), mesh.indexSizes.size());
+
+        const std::array<std::uint8_t, 16u> padding = {};
+        const auto paddingSize = mesh.header.vertexOffset - (meshOffset + sizeof(mesh.header) + (mesh.indexSizes.size() * sizeof(std::uint32_t)));
+        SDL_RWwrite(file, padding.data(), 1, paddingSize);
+
+        SDL_RWwrite(file, mesh.vertexData.data(), sizeof(float), mesh.vertexData.size());
+        SDL_RWwrite(file, mesh.indexData.data(), 1, mesh.indexData.size());
+    }
+}
+
+std::array<std::size_t, Mesh::Attribute::Total> cro::Detail::ModelBinary::getAttributeSizes(std::uint16_t flags)
+{
+    std::array<std::size_t, Mesh::Attribute::Total> sizes = {};
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        if (flags & (1 << i))
+        {
+            switch (i)
+            {
+            default:
+            case Mesh::Attribute::Bitangent:
+                break;
+            case Mesh::Attribute::Position:
+            case Mesh::Attribute::Normal:
+                sizes[i] = 3;
+                break;
+            case Mesh::Attribute::Colour:
+            case Mesh::Attribute::BlendIndices:
+            case Mesh::Attribute::BlendWeights:
+                sizes[i] = 4;
+                break;
+            case Mesh::Attribute::Tangent:
+                sizes[i] = 3;
+                sizes[Mesh::Attribute::Bitangent] = 3;
+                break;
+            case Mesh::Attribute::UV0:
+            case Mesh::Attribute::UV1:
+                sizes[i] = 2;
+                break;
+            }
+        }
+    }
+    return sizes;
+}
+
+bool cro::Detail::ModelBinary::getMeshView(const std::uint8_t* data, std::size_t size, MeshView& dst)
+{
+    Header header;
+    if (!data
+        || size < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != MAGIC
+        || header.version < MappedVersion
+        || header.meshOffset == 0
+        || std::uint64_t(header.meshOffset) + sizeof(MeshHeaderV3) > size)
+    {
+        return false;
+    }
+
+    auto& meshHeader = dst.header;
+    std::memcpy(&meshHeader, data + header.meshOffset, sizeof(meshHeader));
+
+    std::size_t vertexSize = 0;
+    for (auto attribSize : getAttributeSizes(meshHeader.flags))
+    {
+        vertexSize += attribSize * sizeof(float);
+    }
+
+    if ((meshHeader.flags & VertexProperty::Position) == 0
+        || meshHeader.vertexSize != vertexSize
+        || (meshHeader.indexSize != sizeof(std::uint16_t) && meshHeader.indexSize != sizeof(std::uint32_t))
+        || meshHeader.indexArrayCount > Mesh::IndexData::MaxBuffers)
+    {
+        return false;
+    }
+
+    const auto sizesOffset = std::uint64_t(header.meshOffset) + sizeof(meshHeader);
+    if (sizesOffset + (meshHeader.indexArrayCount * sizeof(std::uint32_t)) > size
+        || std::uint64_t(meshHeader.vertexOffset) + (std::uint64_t(meshHeader.vertexCount) * meshHeader.vertexSize) > size)
+    {
+        return false;
+    }
+
+    dst.indexCounts.resize(meshHeader.indexArrayCount);
+    std::memcpy(dst.indexCounts.data(), data + sizesOffset, dst.indexCounts.size() * sizeof(std::uint32_t));
+    dst.vertexData = data + meshHeader.vertexOffset;
+
+    dst.indexData.clear();
+    std::uint64_t offset = meshHeader.indexArrayOffset;
+    for (auto count : dst.indexCounts)
+    {
+        const auto arraySize = std::uint64_t(count) * meshHeader.indexSize;
+        if (offset + arraySize > size)
+        {
+            return false;
+        }
+        dst.indexData.push_back(data + offset);
+        offset = align(static_cast<std::uint32_t>(offset + arraySize), 4);
+    }
+
+    return true;
+}
+
 bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path, bool includeSkeleton)
 {
     bool retVal = false;
 
-    Detail::ModelBinary::HeaderV2 header;
+    Detail::ModelBinary::HeaderV3 header;
     std::uint32_t skelOffset = sizeof(header);
 
     //if these are not empty after processing
     //then they'll be written to the file
     Detail::ModelBinary::MeshHeader meshHeader;
-    std::vector<std::uint32_t> outIndexSizes;
     std::vector<float> outVertexData;
-    std::vector<std::uint32_t> outIndexData;
+    MeshV3 outMesh;
 
     if (entity.hasComponent<Model>())
     {
@@ -60,10 +318,14 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
         std::vector<float> vertexData;
         std::vector<std::vector<std::uint32_t>> indexData;
 
-        vertexData.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
+        //the VBO may contain quantised attributes so download the raw
+        //bytes and unpack them to floats, laid out as described by
+        //meshData.attributes, which is what the loop below expects
+        std::vector<std::uint8_t> packedData(meshData.vertexCount * meshData.vertexSize);
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-        glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, vertexData.data()));
+        glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, packedData.size(), packedData.data()));
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        Mesh::unpackVertexData(meshData, packedData.data(), vertexData);
 
         indexData.resize(meshData.submeshCount);
 
@@ -232,27 +494,10 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
                 return v.empty();
             }), indexData.end());
 
-        //copy index data
-        for (const auto& data : indexData)
-        {
-            outIndexSizes.push_back(static_cast<std::uint32_t>(data.size()));
-            for (auto d : data)
-            {
-                outIndexData.push_back(d);
-            }
-        }
-
-
-        //update the header with relevant detail
-        meshHeader.indexArrayCount = static_cast<std::uint16_t>(indexData.size());
-        meshHeader.indexArrayOffset = header.meshOffset
-            + static_cast<std::uint32_t>(sizeof(meshHeader)
-            + (outIndexSizes.size() * sizeof(std::uint32_t))
-            + (outVertexData.size() * sizeof(float)));
+        outMesh = createMeshV3(header.meshOffset, meshHeader.flags, outVertexData, indexData);
 
         //update the skeleton offset with the size of the mesh data
-        skelOffset = meshHeader.indexArrayOffset
-            + static_cast<std::uint32_t>(outIndexData.size() * sizeof(std::uint32_t));
+        skelOffset = align(header.meshOffset + outMesh.size, 8);
 
         retVal = true;
     }
@@ -325,14 +570,14 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
             if (header.meshOffset)
             {
                 //write mesh data
-                SDL_RWwrite(file, &meshHeader, sizeof(meshHeader), 1);
-                SDL_RWwrite(file, outIndexSizes.data(), sizeof(std::uint32_t), outIndexSizes.size());
-                SDL_RWwrite(file, outVertexData.data(), sizeof(float), outVertexData.size());
-                SDL_RWwrite(file, outIndexData.data(), sizeof(std::uint32_t), outIndexData.size());
+                writeMeshV3(file, header.meshOffset, outMesh);
             }
 
             if (header.skeletonOffset)
             {
+                const std::array<std::uint8_t, 8u> padding = {};
+                SDL_RWwrite(file, padding.data(), 1, static_cast<std::size_t>(header.skeletonOffset - SDL_RWtell(file)));
+
                 const auto& frames = entity.getComponent<cro::Skeleton>().getFrames();
 
                 //write skel data
@@ -384,7 +629,51 @@ cro::Mesh::Data cro::Detail::ModelBinary::read(const std::string& binPath, std::
             return {};
         }
 
-        if (header.meshOffset)
+        if (header.meshOffset
+            && header.version >= MappedVersion)
+        {
+            std::vector<std::uint8_t> fileData(static_cast<std::size_t>(len));
+            SDL_RWseek(file.file, 0, RW_SEEK_SET);
+            SDL_RWread(file.file, fileData.data(), fileData.size(), 1);
+
+            MeshView view;
+            if (!getMeshView(fileData.data(), fileData.size(), view))
+            {
+                LogE << binPath << ": invalid mesh data" << std::endl;
+                return {};
+            }
+
+            meshData.attributes = getAttributeSizes(view.header.flags);
+            meshData.attributeFlags = view.header.flags;
+            meshData.primitiveType = GL_TRIANGLES;
+            meshData.vertexSize = view.header.vertexSize;
+            meshData.vertexCount = view.header.vertexCount;
+
+            dstVert.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
+            std::memcpy(dstVert.data(), view.vertexData, dstVert.size() * sizeof(float));
+
+            dstIdx.resize(view.indexCounts.size());
+            meshData.submeshCount = view.indexCounts.size();
+            for (auto i = 0u; i < meshData.submeshCount; ++i)
+            {
+                dstIdx[i].resize(view.indexCounts[i]);
+                if (view.header.indexSize == sizeof(std::uint16_t))
+                {
+                    std::vector<std::uint16_t> temp(view.indexCounts[i]);
+                    std::memcpy(temp.data(), view.indexData[i], temp.size() * sizeof(std::uint16_t));
+                    std::copy(temp.begin(), temp.end(), dstIdx[i].begin());
+                }
+                else
+                {
+                    std::memcpy(dstIdx[i].data(), view.indexData[i], dstIdx[i].size() * sizeof(std::uint32_t));
+                }
+
+                meshData.indexData[i].format = GL_UNSIGNED_INT;
+                meshData.indexData[i].primitiveType = meshData.primitiveType;
+                meshData.indexData[i].indexCount = view.indexCounts[i];
+            }
+        }
+        else if (header.meshOffset)
         {
             cro::Detail::ModelBinary::MeshHeader meshHeader;
             SDL_RWread(file.file, &meshHeader, sizeof(meshHeader), 1);
@@ -510,4 +799,157 @@ cro::Mesh::Data cro::Detail::ModelBinary::read(const std::string& binPath, std::
         return {};
     }
     return meshData;
+}
+
+bool cro::Detail::ModelBinary::convert(const std::string& src, const std::string& dst)
+{
+    std::vector<std::uint8_t> fileData;
+    {
+        cro::RaiiRWops file;
+        file.file = SDL_RWFromFile(src.c_str(), "rb");
+        if (!file.file)
+        {
+            LogE << "SDL: " << src << ": " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        const auto len = SDL_RWsize(file.file);
+        if (len < static_cast<Sint64>(sizeof(Header)))
+        {
+            LogE << "Unable to open " << src << ": invalid file size" << std::endl;
+            return false;
+        }
+
+        fileData.resize(static_cast<std::size_t>(len));
+        if (SDL_RWread(file.file, fileData.data(), fileData.size(), 1) != 1)
+        {
+            LogE << "Failed reading " << src << std::endl;
+            return false;
+        }
+    }
+
+    Header header;
+    std::memcpy(&header, fileData.data(), sizeof(header));
+
+    if (header.magic != MAGIC
+        && header.magic != MAGIC_V1)
+    {
+        LogE << src << ": Invalid header found" << std::endl;
+        return false;
+    }
+
+    if (header.version >= MappedVersion
+        && src == dst)
+    {
+        return true;
+    }
+
+    HeaderV3 outHeader;
+    MeshV3 outMesh;
+    std::uint32_t skelOffset = sizeof(outHeader);
+
+    if (header.version >= MappedVersion)
+    {
+        //just copy it
+    }
+    else if (header.meshOffset)
+    {
+        MeshHeader meshHeader;
+        const auto sizesOffset = std::uint64_t(header.meshOffset) + sizeof(meshHeader);
+        if (sizesOffset > fileData.size())
+        {
+            LogE << src << ": invalid mesh header" << std::endl;
+            return false;
+        }
+        std::memcpy(&meshHeader, fileData.data() + header.meshOffset, sizeof(meshHeader));
+
+        const auto vertexOffset = sizesOffset + (meshHeader.indexArrayCount * sizeof(std::uint32_t));
+        if ((meshHeader.flags & VertexProperty::Position) == 0
+            || vertexOffset > meshHeader.indexArrayOffset
+            || meshHeader.indexArrayOffset > fileData.size())
+        {
+            LogE << src << ": invalid mesh data" << std::endl;
+            return false;
+        }
+
+        std::vector<std::uint32_t> sizes(meshHeader.indexArrayCount);
+        std::memcpy(sizes.data(), fileData.data() + sizesOffset, sizes.size() * sizeof(std::uint32_t));
+
+        std::vector<float> vertexData((meshHeader.indexArrayOffset - vertexOffset) / sizeof(float));
+        std::memcpy(vertexData.data(), fileData.data() + vertexOffset, vertexData.size() * sizeof(float));
+
+        std::vector<std::vector<std::uint32_t>> indexData(meshHeader.indexArrayCount);
+        std::uint64_t indexOffset = meshHeader.indexArrayOffset;
+        for (auto i = 0u; i < indexData.size(); ++i)
+        {
+            const auto arraySize = std::uint64_t(sizes[i]) * sizeof(std::uint32_t);
+            if (indexOffset + arraySize > fileData.size())
+            {
+                LogE << src << ": invalid index data" << std::endl;
+                return false;
+            }
+
+            indexData[i].resize(sizes[i]);
+            std::memcpy(indexData[i].data(), fileData.data() + indexOffset, arraySize);
+            indexOffset += arraySize;
+        }
+
+        outHeader.meshOffset = sizeof(outHeader);
+        outMesh = createMeshV3(outHeader.meshOffset, meshHeader.flags, vertexData, indexData);
+        skelOffset = align(outHeader.meshOffset + outMesh.size, 8);
+    }
+
+    //skeleton data is the same in versions 2 and 3
+    //so it's copied from the skeleton offset to the end
+    const std::uint8_t* skeletonData = nullptr;
+    std::size_t skeletonSize = 0;
+    if (header.skeletonOffset
+        && header.skeletonOffset < fileData.size())
+    {
+        if (header.version < 2)
+        {
+            LogW << src << ": skeletons in version 1 files are not supported, the skeleton will be removed" << std::endl;
+        }
+        else
+        {
+            outHeader.skeletonOffset = skelOffset;
+            skeletonData = fileData.data() + header.skeletonOffset;
+            skeletonSize = fileData.size() - header.skeletonOffset;
+        }
+    }
+
+    SDL_RWops* file = SDL_RWFromFile(dst.c_str(), "wb");
+    if (!file)
+    {
+        LogE << "Failed opening " << dst << " for writing" << std::endl;
+        return false;
+    }
+
+    if (header.version >= MappedVersion)
+    {
+        SDL_RWwrite(file, fileData.data(), fileData.size(), 1);
+    }
+    else
+    {
+        SDL_RWwrite(file, &outHeader, sizeof(outHeader), 1);
+
+        if (outHeader.meshOffset)
+        {
+            writeMeshV3(file, outHeader.meshOffset, outMesh);
+        }
+
+        if (outHeader.skeletonOffset)
+        {
+            const std::array<std::uint8_t, 8u> padding = {};
+            SDL_RWwrite(file, padding.data(), 1, static_cast<std::size_t>(outHeader.skeletonOffset - SDL_RWtell(file)));
+            SDL_RWwrite(file, skeletonData, 1, skeletonSize);
+        }
+    }
+
+    if (SDL_RWclose(file))
+    {
+        LogE << "SDL: Failed writing model binary - " << SDL_GetError() << std::endl;
+        return false;
+    }
+    return true;
 }
\ No newline at end of file
@@ -0,0 +1,187 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "ParticleSimulation.hpp"
+
+#include <crogine/ecs/components/ParticleEmitter.hpp>
+
+#include <algorithm>
+#include <array>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CRO_PARTICLE_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CRO_PARTICLE_SSE
+#endif
+
+using namespace cro;
+
+namespace
+{
+#if defined(CRO_PARTICLE_AVX)
+    using SimdFloat = __m256;
+    constexpr std::size_t SimdWidth = 8;
+    inline SimdFloat simdLoad(const float* p) { return _mm256_loadu_ps(p); }
+    inline void simdStore(float* p, SimdFloat v) { _mm256_storeu_ps(p, v); }
+    inline SimdFloat simdSet(float f) { return _mm256_set1_ps(f); }
+    inline SimdFloat simdAdd(SimdFloat a, SimdFloat b) { return _mm256_add_ps(a, b); }
+    inline SimdFloat simdSub(SimdFloat a, SimdFloat b) { return _mm256_sub_ps(a, b); }
+    inline SimdFloat simdMul(SimdFloat a, SimdFloat b) { return _mm256_mul_ps(a, b); }
+    inline SimdFloat simdDiv(SimdFloat a, SimdFloat b) { return _mm256_div_ps(a, b); }
+    inline SimdFloat simdMin(SimdFloat a, SimdFloat b) { return _mm256_min_ps(a, b); }
+    inline SimdFloat simdMax(SimdFloat a, SimdFloat b) { return _mm256_max_ps(a, b); }
+    inline std::int32_t simdNegativeMask(SimdFloat a) { return _mm256_movemask_ps(_mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_LT_OQ)); }
+#elif defined(CRO_PARTICLE_SSE)
+    using SimdFloat = __m128;
+    constexpr std::size_t SimdWidth = 4;
+    inline SimdFloat simdLoad(const float* p) { return _mm_loadu_ps(p); }
+    inline void simdStore(float* p, SimdFloat v) { _mm_storeu_ps(p, v); }
+    inline SimdFloat simdSet(float f) { return _mm_set1_ps(f); }
+    inline SimdFloat simdAdd(SimdFloat a, SimdFloat b) { return _mm_add_ps(a, b); }
+    inline SimdFloat simdSub(SimdFloat a, SimdFloat b) { return _mm_sub_ps(a, b); }
+    inline SimdFloat simdMul(SimdFloat a, SimdFloat b) { return _mm_mul_ps(a, b); }
+    inline SimdFloat simdDiv(SimdFloat a, SimdFloat b) { return _mm_div_ps(a, b); }
+    inline SimdFloat simdMin(SimdFloat a, SimdFloat b) { return _mm_min_ps(a, b); }
+    inline SimdFloat simdMax(SimdFloat a, SimdFloat b) { return _mm_max_ps(a, b); }
+    inline std::int32_t simdNegativeMask(SimdFloat a) { return _mm_movemask_ps(_mm_cmplt_ps(a, _mm_setzero_ps())); }
+#endif
+}
+
+bool Detail::simulateParticles(ParticleData& p, std::size_t count, const ParticleSimulationParams& params, glm::vec3& minBounds, glm::vec3& maxBounds)
+{
+    std::size_t i = 0;
+    bool expired = false;
+
+#if defined(CRO_PARTICLE_AVX) || defined(CRO_PARTICLE_SSE)
+    const auto blockCount = count - (count % SimdWidth);
+    if (blockCount)
+    {
+        const auto acceleration = simdSet(params.acceleration);
+        const auto dt = simdSet(params.dt);
+        const auto offsetX = simdSet(params.velocityOffset.x);
+        const auto offsetY = simdSet(params.velocityOffset.y);
+        const auto offsetZ = simdSet(params.velocityOffset.z);
+        const auto rotation = simdSet(params.rotation);
+        const auto scale = simdSet(params.scale);
+        const auto zero = simdSet(0.f);
+        const auto one = simdSet(1.f);
+
+        auto minX = simdSet(minBounds.x);
+        auto minY = simdSet(minBounds.y);
+        auto minZ = simdSet(minBounds.z);
+        auto maxX = simdSet(maxBounds.x);
+        auto maxY = simdSet(maxBounds.y);
+        auto maxZ = simdSet(maxBounds.z);
+        std::int32_t expiredMask = 0;
+
+        for (; i < blockCount; i += SimdWidth)
+        {
+            auto velocity = simdAdd(simdMul(simdLoad(&p.velocityX[i]), acceleration), offsetX);
+            simdStore(&p.velocityX[i], velocity);
+            auto position = simdAdd(simdLoad(&p.positionX[i]), simdMul(velocity, dt));
+            simdStore(&p.positionX[i], position);
+            minX = simdMin(minX, position);
+            maxX = simdMax(maxX, position);
+
+            velocity = simdAdd(simdMul(simdLoad(&p.velocityY[i]), acceleration), offsetY);
+            simdStore(&p.velocityY[i], velocity);
+            position = simdAdd(simdLoad(&p.positionY[i]), simdMul(velocity, dt));
+            simdStore(&p.positionY[i], position);
+            minY = simdMin(minY, position);
+            maxY = simdMax(maxY, position);
+
+            velocity = simdAdd(simdMul(simdLoad(&p.velocityZ[i]), acceleration), offsetZ);
+            simdStore(&p.velocityZ[i], velocity);
+            position = simdAdd(simdLoad(&p.positionZ[i]), simdMul(velocity, dt));
+            simdStore(&p.positionZ[i], position);
+            minZ = simdMin(minZ, position);
+            maxZ = simdMax(maxZ, position);
+
+            const auto lifetime = simdSub(simdLoad(&p.lifetime[i]), dt);
+            simdStore(&p.lifetime[i], lifetime);
+            simdStore(&p.alpha[i], simdMin(one, simdMax(simdDiv(lifetime, simdLoad(&p.maxLifetime[i])), zero)));
+            expiredMask |= simdNegativeMask(lifetime);
+
+            simdStore(&p.rotation[i], simdAdd(simdLoad(&p.rotation[i]), rotation));
+            simdStore(&p.scale[i], simdMul(simdLoad(&p.scale[i]), scale));
+        }
+
+        std::array<float, SimdWidth> result = {};
+        const auto reduce = [&result](SimdFloat v, float& output, auto op)
+        {
+            simdStore(result.data(), v);
+            for (auto f : result)
+            {
+                output = op(output, f);
+            }
+        };
+        const auto minOp = [](float a, float b) { return std::min(a, b); };
+        const auto maxOp = [](float a, float b) { return std::max(a, b); };
+        reduce(minX, minBounds.x, minOp);
+        reduce(minY, minBounds.y, minOp);
+        reduce(minZ, minBounds.z, minOp);
+        reduce(maxX, maxBounds.x, maxOp);
+        reduce(maxY, maxBounds.y, maxOp);
+        reduce(maxZ, maxBounds.z, maxOp);
+
+        expired = (expiredMask != 0);
+    }
+#endif
+
+    //remainder, or everything if SIMD isn't available
+    for (; i < count; ++i)
+    {
+        p.velocityX[i] = p.velocityX[i] * params.acceleration + params.velocityOffset.x;
+        p.velocityY[i] = p.velocityY[i] * params.acceleration + params.velocityOffset.y;
+        p.velocityZ[i] = p.velocityZ[i] * params.acceleration + params.velocityOffset.z;
+
+        p.positionX[i] += p.velocityX[i] * params.dt;
+        p.positionY[i] += p.velocityY[i] * params.dt;
+        p.positionZ[i] += p.velocityZ[i] * params.dt;
+
+        minBounds.x = std::min(minBounds.x, p.positionX[i]);
+        minBounds.y = std::min(minBounds.y, p.positionY[i]);
+        minBounds.z = std::min(minBounds.z, p.positionZ[i]);
+        maxBounds.x = std::max(maxBounds.x, p.positionX[i]);
+        maxBounds.y = std::max(maxBounds.y, p.positionY[i]);
+        maxBounds.z = std::max(maxBounds.z, p.positionZ[i]);
+
+        p.lifetime[i] -= params.dt;
+        p.alpha[i] = std::min(1.f, std::max(p.lifetime[i] / p.maxLifetime[i], 0.f));
+        expired = expired || (p.lifetime[i] < 0.f);
+
+        p.rotation[i] += params.rotation;
+        p.scale[i] *= params.scale;
+    }
+
+    return expired;
+}
@@ -0,0 +1,61 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/detail/glm/vec3.hpp>
+
+#include <cstddef>
+
+namespace cro
+{
+    struct ParticleData;
+
+    namespace Detail
+    {
+        struct ParticleSimulationParams final
+        {
+            glm::vec3 velocityOffset = glm::vec3(0.f); //gravity and forces multiplied by dt
+            float acceleration = 1.f;
+            float dt = 0.f;
+            float rotation = 0.f; //rotation speed multiplied by dt
+            float scale = 1.f; //1 + scale modifier multiplied by dt
+        };
+
+        /*!
+        \brief Integrates the velocity and position of the first count particles
+        and updates their lifetime, alpha, rotation and scale, 8 or 4 at a time
+        when AVX or SSE2 are available.
+        \param minBounds, maxBounds Expanded to include the updated positions
+        \returns true if any particle's lifetime expired
+        */
+        bool simulateParticles(ParticleData& particles, std::size_t count, const ParticleSimulationParams& params, glm::vec3& minBounds, glm::vec3& maxBounds);
+    }
+}
@@ -0,0 +1,162 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "PoseArena.hpp"
+
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CRO_SKELETON_SSE
+#endif
+
+using namespace cro;
+
+namespace
+{
+    //coefficients for slerp without trig functions, from
+    //David Eberly's "A Fast and Accurate Algorithm for Computing SLERP"
+    constexpr std::size_t SlerpTerms = 8;
+    constexpr float SlerpMu = 1.85298109240830f;
+    constexpr std::array<float, SlerpTerms> SlerpU =
+    {
+        1.f / (1.f * 3.f), 1.f / (2.f * 5.f), 1.f / (3.f * 7.f), 1.f / (4.f * 9.f),
+        1.f / (5.f * 11.f), 1.f / (6.f * 13.f), 1.f / (7.f * 15.f), SlerpMu / (8.f * 17.f)
+    };
+    constexpr std::array<float, SlerpTerms> SlerpV =
+    {
+        1.f / 3.f, 2.f / 5.f, 3.f / 7.f, 4.f / 9.f,
+        5.f / 11.f, 6.f / 13.f, 7.f / 15.f, SlerpMu * 8.f / 17.f
+    };
+}
+
+void Detail::mixPose(PoseArena& arena, std::size_t jointCount, float time)
+{
+    const float invTime = 1.f - time;
+
+    //these only depend on time so are the same for every joint
+    std::array<float, SlerpTerms> coeffT = {};
+    std::array<float, SlerpTerms> coeffD = {};
+    for (auto i = 0u; i < SlerpTerms; ++i)
+    {
+        coeffT[i] = (SlerpU[i] * time * time) - SlerpV[i];
+        coeffD[i] = (SlerpU[i] * invTime * invTime) - SlerpV[i];
+    }
+
+    std::size_t i = 0;
+
+#ifdef CRO_SKELETON_SSE
+    const auto t = _mm_set1_ps(time);
+    const auto d = _mm_set1_ps(invTime);
+    const auto one = _mm_set1_ps(1.f);
+    const auto signMask = _mm_set1_ps(-0.f);
+
+    const auto lerp = [&](std::int32_t component, std::size_t idx)
+    {
+        const auto a = _mm_loadu_ps(arena.get(arena.a, component) + idx);
+        const auto b = _mm_loadu_ps(arena.get(arena.b, component) + idx);
+        _mm_storeu_ps(arena.get(arena.output, component) + idx, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)));
+    };
+
+    //any remaining joints are mixed by the scalar loop below
+    const std::size_t simdCount = jointCount & ~std::size_t(3);
+    for (; i < simdCount; i += 4)
+    {
+        lerp(PoseArena::TX, i);
+        lerp(PoseArena::TY, i);
+        lerp(PoseArena::TZ, i);
+        lerp(PoseArena::SX, i);
+        lerp(PoseArena::SY, i);
+        lerp(PoseArena::SZ, i);
+
+        __m128 qa[4];
+        __m128 qb[4];
+        for (auto c = 0; c < 4; ++c)
+        {
+            qa[c] = _mm_loadu_ps(arena.get(arena.a, PoseArena::RX + c) + i);
+            qb[c] = _mm_loadu_ps(arena.get(arena.b, PoseArena::RX + c) + i);
+        }
+
+        auto cosTheta = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qa[0], qb[0]), _mm_mul_ps(qa[1], qb[1])),
+                                    _mm_add_ps(_mm_mul_ps(qa[2], qb[2]), _mm_mul_ps(qa[3], qb[3])));
+        const auto sign = _mm_and_ps(cosTheta, signMask);
+        cosTheta = _mm_xor_ps(cosTheta, sign);
+        const auto xm1 = _mm_sub_ps(cosTheta, one);
+
+        auto accT = _mm_add_ps(one, _mm_mul_ps(_mm_set1_ps(coeffT[SlerpTerms - 1]), xm1));
+        auto accD = _mm_add_ps(one, _mm_mul_ps(_mm_set1_ps(coeffD[SlerpTerms - 1]), xm1));
+        for (auto j = static_cast<std::int32_t>(SlerpTerms) - 2; j >= 0; --j)
+        {
+            accT = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(coeffT[j]), xm1), accT));
+            accD = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(coeffD[j]), xm1), accD));
+        }
+        const auto cT = _mm_xor_ps(_mm_mul_ps(t, accT), sign);
+        const auto cD = _mm_mul_ps(d, accD);
+
+        for (auto c = 0; c < 4; ++c)
+        {
+            _mm_storeu_ps(arena.get(arena.output, PoseArena::RX + c) + i, _mm_add_ps(_mm_mul_ps(qa[c], cD), _mm_mul_ps(qb[c], cT)));
+        }
+    }
+#endif
+
+    for (; i < jointCount; ++i)
+    {
+        for (auto c : { PoseArena::TX, PoseArena::TY, PoseArena::TZ, PoseArena::SX, PoseArena::SY, PoseArena::SZ })
+        {
+            const auto a = arena.get(arena.a, c)[i];
+            const auto b = arena.get(arena.b, c)[i];
+            arena.get(arena.output, c)[i] = a + ((b - a) * time);
+        }
+
+        float cosTheta = 0.f;
+        for (auto c = 0; c < 4; ++c)
+        {
+            cosTheta += arena.get(arena.a, PoseArena::RX + c)[i] * arena.get(arena.b, PoseArena::RX + c)[i];
+        }
+        const float sign = cosTheta < 0.f ? -1.f : 1.f;
+        const float xm1 = (cosTheta * sign) - 1.f;
+
+        float accT = 1.f;
+        float accD = 1.f;
+        for (auto j = static_cast<std::int32_t>(SlerpTerms) - 1; j >= 0; --j)
+        {
+            accT = 1.f + (coeffT[j] * xm1 * accT);
+            accD = 1.f + (coeffD[j] * xm1 * accD);
+        }
+        const float cT = sign * time * accT;
+        const float cD = invTime * accD;
+
+        for (auto c = 0; c < 4; ++c)
+        {
+            arena.get(arena.output, PoseArena::RX + c)[i] =
+                (arena.get(arena.a, PoseArena::RX + c)[i] * cD) + (arena.get(arena.b, PoseArena::RX + c)[i] * cT);
+        }
+    }
+}
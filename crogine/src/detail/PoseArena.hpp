@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/ecs/components/Skeleton.hpp>
+
+#include <crogine/detail/glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cro::Detail
+{
+    //per-thread scratch space used when posing skeletons, so that
+    //once it has grown to fit the largest skeleton nothing is allocated.
+    //Joints are stored as structures of arrays so that they can be
+    //mixed 4 at a time.
+    struct PoseArena final
+    {
+        enum Component
+        {
+            TX, TY, TZ,
+            RX, RY, RZ, RW,
+            SX, SY, SZ,
+            Count
+        };
+
+        std::size_t stride = 0; //joint count padded to SIMD width
+        std::vector<float> a;
+        std::vector<float> b;
+        std::vector<float> output;
+        std::vector<glm::mat4> localMatrices;
+        std::vector<glm::mat4> worldMatrices;
+
+        void resize(std::size_t jointCount)
+        {
+            stride = (jointCount + 3) & ~std::size_t(3);
+            if (a.size() < stride * Component::Count)
+            {
+                a.resize(stride * Component::Count);
+                b.resize(stride * Component::Count);
+                output.resize(stride * Component::Count);
+            }
+
+            if (localMatrices.size() < jointCount)
+            {
+                localMatrices.resize(jointCount);
+                worldMatrices.resize(jointCount);
+            }
+        }
+
+        float* get(std::vector<float>& data, std::int32_t component) { return data.data() + (component * stride); }
+
+        void gather(std::vector<float>& dst, const Joint* joints, std::size_t count)
+        {
+            for (auto i = 0u; i < count; ++i)
+            {
+                const auto& j = joints[i];
+                get(dst, TX)[i] = j.translation.x;
+                get(dst, TY)[i] = j.translation.y;
+                get(dst, TZ)[i] = j.translation.z;
+                get(dst, RX)[i] = j.rotation.x;
+                get(dst, RY)[i] = j.rotation.y;
+                get(dst, RZ)[i] = j.rotation.z;
+                get(dst, RW)[i] = j.rotation.w;
+                get(dst, SX)[i] = j.scale.x;
+                get(dst, SY)[i] = j.scale.y;
+                get(dst, SZ)[i] = j.scale.z;
+            }
+        }
+
+        void scatter(Joint* joints, std::size_t count)
+        {
+            for (auto i = 0u; i < count; ++i)
+            {
+                auto& j = joints[i];
+                j.translation = { get(output, TX)[i], get(output, TY)[i], get(output, TZ)[i] };
+                j.rotation = glm::quat(get(output, RW)[i], get(output, RX)[i], get(output, RY)[i], get(output, RZ)[i]);
+                j.scale = { get(output, SX)[i], get(output, SY)[i], get(output, SZ)[i] };
+            }
+        }
+    };
+
+    /*!
+    \brief Mixes the translation, rotation and scale of arena.a and arena.b into arena.output.
+    Rotations are interpolated with a polynomial approximation of slerp, 4 joints at a
+    time when SSE2 is available, and take the shortest path as glm::slerp() does.
+    */
+    void mixPose(PoseArena& arena, std::size_t jointCount, float time);
+}
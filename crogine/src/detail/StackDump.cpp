@@ -36,6 +36,7 @@ source distribution.
 
 #include <crogine/core/Console.hpp>
 #include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
 #include <crogine/detail/StackDump.hpp>
 
 #include <iostream>
@@ -58,6 +59,10 @@ void StackDump::dump(int type)
         return;
     }
 
+    //make sure anything still queued for the log file is
+    //written before we're brought down
+    Logger::flush();
+
 //#ifdef _MSC_VER
     auto t = std::time(nullptr);
     auto* tm = std::localtime(&t);
@@ -0,0 +1,71 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/graphics/MeshData.hpp>
+
+#include "GLCheck.hpp"
+
+namespace cro::Detail
+{
+    /*!
+    \brief GL type and normalisation of a vertex attribute stored
+    in the given Mesh::AttributeFormat, along with the component
+    count which should be passed to glVertexAttribPointer()
+    */
+    struct VertexAttribFormat final
+    {
+        GLenum type = GL_FLOAT;
+        GLboolean normalised = GL_FALSE;
+        GLint size = 0;
+
+        VertexAttribFormat(std::int32_t format, std::int32_t componentCount)
+            : size(componentCount)
+        {
+            switch (format)
+            {
+            default: break;
+            case Mesh::AttributeFormat::HalfFloat:
+                type = GL_HALF_FLOAT;
+                break;
+            case Mesh::AttributeFormat::UNorm8:
+                type = GL_UNSIGNED_BYTE;
+                normalised = GL_TRUE;
+                break;
+            case Mesh::AttributeFormat::SNorm10_10_10_2:
+                //packed formats must always be read as 4 components
+                type = GL_INT_2_10_10_10_REV;
+                normalised = GL_TRUE;
+                size = 4;
+                break;
+            }
+        }
+    };
+}
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -30,8 +30,19 @@ source distribution.
 #include <crogine/ecs/Component.hpp>
 #include <crogine/ecs/Entity.hpp>
 
+#include <atomic>
+
 using namespace cro;
 
+ComponentManager::ComponentManager()
+{
+    for (auto& id : m_cachedIDs)
+    {
+        id.store(InvalidID, std::memory_order_relaxed);
+    }
+}
+
+//public
 ComponentManager::ID ComponentManager::getFromTypeID(std::type_index id)
 {
     auto result = std::find(std::begin(m_IDs), std::end(m_IDs), id);
@@ -42,4 +53,20 @@ ComponentManager::ID ComponentManager::getFromTypeID(std::type_index id)
         return static_cast<ID>(m_IDs.size() - 1);
     }
     return static_cast<ID>(std::distance(m_IDs.begin(), result));
+}
+
+//private
+ComponentManager::ID ComponentManager::cacheID(std::uint32_t typeIndex, ID id)
+{
+    if (typeIndex < MaxCachedTypes)
+    {
+        m_cachedIDs[typeIndex].store(id, std::memory_order_relaxed);
+    }
+    return id;
+}
+
+std::uint32_t ComponentManager::getNextTypeIndex()
+{
+    static std::atomic<std::uint32_t> nextIndex = 0;
+    return nextIndex++;
 }
\ No newline at end of file
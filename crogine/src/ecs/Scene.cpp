@@ -261,6 +261,8 @@ void Scene::simulate(float dt)
     {
         p->process(dt);
     }
+
+    resolveTransforms();
 }
 
 Entity Scene::createEntity()
@@ -732,6 +734,21 @@ void Scene::postRenderPath(const RenderTarget&, const Entity* cameraList, std::s
     m_postEffects.back()->apply(*inTex);
 }
 
+void Scene::resolveTransforms()
+{
+    m_transformStats = {};
+
+    //only start from root nodes, resolveHierarchy()
+    //will visit each child after its parent
+    m_entityManager.forEachComponent<Transform>([&](const Transform& tx)
+        {
+            if (tx.isRoot())
+            {
+                tx.resolveHierarchy(&m_transformStats);
+            }
+        });
+}
+
 void Scene::destroySkybox()
 {
     if (m_skybox.vao)
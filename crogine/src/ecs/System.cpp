@@ -32,9 +32,15 @@ source distribution.
 
 using namespace cro;
 
+namespace
+{
+    constexpr std::uint32_t NoSlot = std::numeric_limits<std::uint32_t>::max();
+}
+
 System::System(MessageBus& mb, UniqueType t)
     : m_messageBus  (mb),
     m_type          (t),
+    m_orderedRemoval(false),
     m_scene         (nullptr),
     m_updateIndex   (0),
     m_active        (false)
@@ -53,25 +59,53 @@ const std::vector<Entity>& System::getEntities() const
 
 void System::addEntity(Entity entity)
 {
+    const auto idx = entity.getIndex();
+    if (idx >= m_entitySlots.size())
+    {
+        m_entitySlots.resize(idx + 1, NoSlot);
+    }
+
+    m_entitySlots[idx] = static_cast<std::uint32_t>(m_entities.size());
     m_entities.push_back(entity);
     onEntityAdded(entity);
+
+    //some systems reject the entity by popping
+    //it from the list in onEntityAdded()
+    if (m_entities.empty()
+        || m_entities.back() != entity)
+    {
+        m_entitySlots[idx] = NoSlot;
+    }
 }
 
 void System::removeEntity(Entity entity)
 {
-    //on the face of it this might seem weird, but it's the easiest way to
-    //know if the entity actually exists in this system and should have the
-    //removal callback invoked...
-    m_entities.erase(std::remove_if(m_entities.begin(), m_entities.end(),
-        [&, entity](const Entity& e)
+    const auto slot = findSlot(entity);
+    if (slot == NoSlot)
     {
-            if (entity == e)
-            {
-                onEntityRemoved(entity);
-                return true;
-            }
-            return false;
-    }), m_entities.end());
+        return;
+    }
+
+    onEntityRemoved(entity);
+    m_entitySlots[entity.getIndex()] = NoSlot;
+
+    if (m_orderedRemoval)
+    {
+        m_entities.erase(m_entities.begin() + slot);
+        for (auto i = slot; i < m_entities.size(); ++i)
+        {
+            m_entitySlots[m_entities[i].getIndex()] = i;
+        }
+    }
+    else
+    {
+        if (slot != m_entities.size() - 1)
+        {
+            m_entities[slot] = m_entities.back();
+            m_entitySlots[m_entities[slot].getIndex()] = slot;
+        }
+        m_entities.pop_back();
+    }
 }
 
 const ComponentMask& System::getComponentMask() const
@@ -96,6 +130,45 @@ Scene* System::getScene()
 }
 
 //private
+std::uint32_t System::findSlot(Entity entity)
+{
+    const auto idx = entity.getIndex();
+    if (idx >= m_entitySlots.size())
+    {
+        return NoSlot;
+    }
+
+    const auto slot = m_entitySlots[idx];
+    if (slot < m_entities.size()
+        && m_entities[slot] == entity)
+    {
+        return slot;
+    }
+
+    //the entity list is exposed via getEntities() so it may
+    //have been reordered by a derived class - in which case
+    //fall back to searching the list and rebuild the index
+    if (slot != NoSlot)
+    {
+        std::fill(m_entitySlots.begin(), m_entitySlots.end(), NoSlot);
+        for (auto i = 0u; i < m_entities.size(); ++i)
+        {
+            const auto entIdx = m_entities[i].getIndex();
+            if (entIdx >= m_entitySlots.size())
+            {
+                m_entitySlots.resize(entIdx + 1, NoSlot);
+            }
+            m_entitySlots[entIdx] = i;
+        }
+
+        if (m_entitySlots[idx] != NoSlot)
+        {
+            return m_entitySlots[idx];
+        }
+    }
+    return NoSlot;
+}
+
 void System::processTypes(ComponentManager& cm)
 {
     for (const auto& componentType : m_pendingTypes)
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -131,7 +131,10 @@ AudioEmitter& AudioEmitter::operator=(AudioEmitter&& other) noexcept
 //public
 void AudioEmitter::setSource(const AudioSource& dataSource)
 {
-    if (m_dataSourceID == dataSource.getID())
+    //sources which are loading share a placeholder ID
+    //so make sure this is actually the same source
+    if (m_dataSourceID == dataSource.getID()
+        && m_audioSource == &dataSource)
     {
         //already have this source
         return;
@@ -30,6 +30,7 @@ source distribution.
 #include <crogine/ecs/components/Model.hpp>
 #include <crogine/detail/Assert.hpp>
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/VertexAttribFormat.hpp"
 
 #include <crogine/detail/glm/gtc/matrix_inverse.hpp>
 
@@ -63,6 +64,7 @@ namespace
 Model::Model()
     : m_drawlistCount   (0),
     m_hidden            (false),
+    m_static            (false),
     m_renderFlags       (std::numeric_limits<std::uint64_t>::max()),
     m_facing            (GL_CCW),
     m_skeleton          (nullptr),
@@ -77,6 +79,7 @@ Model::Model()
 Model::Model(Mesh::Data data, Material::Data material)
     : m_drawlistCount   (0),
     m_hidden            (false),
+    m_static            (false),
     m_renderFlags       (std::numeric_limits<std::uint64_t>::max()),
     m_facing            (GL_CCW),
     m_boundingSphere    (data.boundingSphere),
@@ -141,6 +144,7 @@ Model::Model(Model&& other) noexcept
 {
     //we can swap because we initialised to nothing
     std::swap(m_hidden, other.m_hidden);
+    std::swap(m_static, other.m_static);
     std::swap(m_renderFlags, other.m_renderFlags);
     std::swap(m_facing, other.m_facing);
     std::swap(m_boundingSphere, other.m_boundingSphere);
@@ -172,6 +176,7 @@ Model& Model::operator=(Model&& other) noexcept
     if (&other != this)
     {
         m_hidden = other.m_hidden;
+        m_static = other.m_static;
         m_renderFlags = other.m_renderFlags;
         m_facing = other.m_facing;
         other.m_facing = GL_CCW;
@@ -477,8 +482,9 @@ void Model::updateMaterialAnimations(float dt)
 
 void Model::bindMaterial(Material::Data& material)
 {
-    //map attributes to material
-    std::size_t pointerOffset = 0;
+    //map attributes to material - offsets are counted for all attributes
+    //regardless as the mesh may have more attributes than material
+    const auto offsets = Mesh::getAttributeOffsets(m_meshData);
     for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
     {
         if (material.attribs[i][Material::Data::Index] > -1)
@@ -487,7 +493,10 @@ void Model::bindMaterial(Material::Data& material)
             material.attribs[i][Material::Data::Size] = static_cast<std::int32_t>(m_meshData.attributes[i]);
 
             //calc the pointer offset for each attrib
-            material.attribs[i][Material::Data::Offset] = static_cast<std::int32_t>(pointerOffset * sizeof(float));
+            material.attribs[i][Material::Data::Offset] = static_cast<std::int32_t>(offsets[i]);
+
+            //and the format it's stored in
+            material.attribs[i][Material::Data::Format] = m_meshData.attributeFormats[i];
         }
         else
         {
@@ -495,14 +504,14 @@ void Model::bindMaterial(Material::Data& material)
             //with a new shader
             material.attribs[i][Material::Data::Size] = 0;
             material.attribs[i][Material::Data::Offset] = 0;
+            material.attribs[i][Material::Data::Format] = Mesh::AttributeFormat::Float;
         }
-        pointerOffset += m_meshData.attributes[i]; //count the offset regardless as the mesh may have more attributes than material
     }
 
     //sort by size
     std::sort(std::begin(material.attribs), std::end(material.attribs),
-        [](const std::array<std::int32_t, 3>& ip,
-            const std::array<std::int32_t, 3>& op)
+        [](const std::array<std::int32_t, 4>& ip,
+            const std::array<std::int32_t, 4>& op)
         {
             return ip[Material::Data::Size] > op[Material::Data::Size];
         });
@@ -562,9 +571,10 @@ void Model::updateVAO(std::size_t idx, std::int32_t passIndex)
     const auto& attribs = m_materials[passIndex][idx].attribs;
     for (auto j = 0u; j < m_materials[passIndex][idx].attribCount; ++j)
     {
+        const Detail::VertexAttribFormat format(attribs[j][Material::Data::Format], attribs[j][Material::Data::Size]);
         glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
-        glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-            GL_FLOAT, GL_FALSE, static_cast<GLsizei>(m_meshData.vertexSize),
+        glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], format.size,
+            format.type, format.normalised, static_cast<GLsizei>(m_meshData.vertexSize),
             reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
     }
     
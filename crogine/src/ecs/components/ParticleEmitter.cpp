@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2023
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -31,13 +31,74 @@ source distribution.
 
 #include <crogine/graphics/TextureResource.hpp>
 #include <crogine/core/ConfigFile.hpp>
+#include <crogine/detail/Assert.hpp>
 
 using namespace cro;
 
+ParticleData::ParticleData(std::size_t count)
+    : positionX (count, 0.f),
+    positionY   (count, 0.f),
+    positionZ   (count, 0.f),
+    velocityX   (count, 0.f),
+    velocityY   (count, 0.f),
+    velocityZ   (count, 0.f),
+    lifetime    (count, 0.f),
+    maxLifetime (count, 1.f),
+    alpha       (count, 1.f),
+    rotation    (count, 0.f),
+    scale       (count, 1.f),
+    frameTime   (count, 0.f),
+    colour      (count),
+    frameID     (count, 0),
+    loopCount   (count, 0)
+{
+
+}
+
+void ParticleData::set(std::size_t index, const Particle& p)
+{
+    CRO_ASSERT(index < size(), "Index out of range");
+
+    positionX[index] = p.position.x;
+    positionY[index] = p.position.y;
+    positionZ[index] = p.position.z;
+    velocityX[index] = p.velocity.x;
+    velocityY[index] = p.velocity.y;
+    velocityZ[index] = p.velocity.z;
+    lifetime[index] = p.lifetime;
+    maxLifetime[index] = p.maxLifeTime;
+    alpha[index] = p.colour.getAlpha();
+    rotation[index] = p.rotation;
+    scale[index] = p.scale;
+    frameTime[index] = p.frameTime;
+    colour[index] = p.colour;
+    frameID[index] = p.frameID;
+    loopCount[index] = p.loopCount;
+}
+
+void ParticleData::copy(std::size_t dst, std::size_t src)
+{
+    CRO_ASSERT(dst < size() && src < size(), "Index out of range");
+
+    positionX[dst] = positionX[src];
+    positionY[dst] = positionY[src];
+    positionZ[dst] = positionZ[src];
+    velocityX[dst] = velocityX[src];
+    velocityY[dst] = velocityY[src];
+    velocityZ[dst] = velocityZ[src];
+    lifetime[dst] = lifetime[src];
+    maxLifetime[dst] = maxLifetime[src];
+    alpha[dst] = alpha[src];
+    rotation[dst] = rotation[src];
+    scale[dst] = scale[src];
+    frameTime[dst] = frameTime[src];
+    colour[dst] = colour[src];
+    frameID[dst] = frameID[src];
+    loopCount[dst] = loopCount[src];
+}
+
 ParticleEmitter::ParticleEmitter()
-    : m_vbo                 (0),
-    m_vao                   (0),
-    m_particles             (MaxParticles),
+    : m_particles           (MaxParticles),
     m_nextFreeParticle      (0),
     m_culledLastFrame       (false),
     m_running               (false),
@@ -48,7 +109,11 @@ ParticleEmitter::ParticleEmitter()
     m_emissionTimestamp     (0.f),
     //m_pendingUpdate         (true),
     m_renderFlags           (std::numeric_limits<std::uint64_t>::max()),
-    m_releaseCount          (-1)
+    m_releaseCount          (-1),
+    m_vertexOffset          (0),
+    m_vertexCount           (0),
+    m_visibleFrame          (0),
+    m_uploadFrame           (0)
 {
 
 }
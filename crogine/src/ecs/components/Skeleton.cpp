@@ -27,6 +27,7 @@ source distribution.
 
 -----------------------------------------------------------------------*/
 
+#include <crogine/core/Log.hpp>
 #include <crogine/detail/Assert.hpp>
 #include <crogine/detail/glm/gtx/matrix_interpolation.hpp>
 #include <crogine/ecs/components/Skeleton.hpp>
@@ -383,6 +384,47 @@ void Skeleton::buildKeyframe(std::size_t frame)
     }
 }
 
+void Skeleton::buildJointOrder()
+{
+    m_jointOrder.clear();
+    m_jointOrder.reserve(m_frameSize);
+
+    if (m_frames.size() < m_frameSize)
+    {
+        return;
+    }
+
+    //joints are usually stored parent first so this
+    //will normally be done in a single iteration
+    std::vector<bool> added(m_frameSize, false);
+    while (m_jointOrder.size() < m_frameSize)
+    {
+        const auto previousSize = m_jointOrder.size();
+        for (auto i = 0u; i < m_frameSize; ++i)
+        {
+            const auto parent = m_frames[i].parent;
+            if (!added[i]
+                && (parent < 0 || (static_cast<std::size_t>(parent) < m_frameSize && added[parent])))
+            {
+                m_jointOrder.push_back(i);
+                added[i] = true;
+            }
+        }
+
+        if (m_jointOrder.size() == previousSize)
+        {
+            LogE << "Skeleton joint hierarchy is invalid, some joints will not be animated correctly" << std::endl;
+            for (auto i = 0u; i < m_frameSize; ++i)
+            {
+                if (!added[i])
+                {
+                    m_jointOrder.push_back(i);
+                }
+            }
+        }
+    }
+}
+
 //----attachment struct-----//
 void Attachment::setParent(std::int32_t parent)
 {
@@ -409,7 +451,7 @@ void Attachment::setModel(cro::Entity model)
         m_model.hasComponent<cro::Transform>())
     {
         m_model.getComponent<cro::Transform>().m_attachmentParent = nullptr;
-        m_model.getComponent<cro::Transform>().m_attachmentTransform = glm::mat4(1.f);
+        m_model.getComponent<cro::Transform>().setAttachmentTransform(glm::mat4(1.f));
     }
 
     m_model = model;
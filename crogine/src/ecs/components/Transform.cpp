@@ -44,9 +44,13 @@ Transform::Transform()
     m_scale                 (1.f, 1.f, 1.f),
     m_rotation              (1.f, 0.f, 0.f, 0.f),
     m_transform             (1.f),
+    m_worldTransform        (1.f),
+    m_worldPosition         (0.f),
+    m_worldScale            (1.f),
+    m_worldRotation         (1.f, 0.f, 0.f, 0.f),
     m_parent                (nullptr),
     //m_depth                 (0),
-    m_dirtyFlags            (Flags::Tx),
+    m_dirtyFlags            (Flags::Tx | Flags::World),
     m_attachmentTransform   (1.f)
 {
 
@@ -58,9 +62,13 @@ Transform::Transform(Transform&& other) noexcept
     m_scale                 (1.f, 1.f, 1.f),
     m_rotation              (1.f, 0.f, 0.f, 0.f),
     m_transform             (1.f),
+    m_worldTransform        (1.f),
+    m_worldPosition         (0.f),
+    m_worldScale            (1.f),
+    m_worldRotation         (1.f, 0.f, 0.f, 0.f),
     m_parent                (nullptr),
     //m_depth                 (0),
-    m_dirtyFlags            (Flags::Tx),
+    m_dirtyFlags            (Flags::Tx | Flags::World),
     m_attachmentTransform   (1.f)
 {
     CRO_ASSERT(other.m_parent != this, "Invalid assignment");
@@ -126,6 +134,7 @@ Transform::Transform(Transform&& other) noexcept
         setOrigin(other.getOrigin());
         m_dirtyFlags = Flags::Tx;
         m_attachmentTransform = other.m_attachmentTransform;
+        markWorldDirty(true);
         m_callbacks.swap(other.m_callbacks);
 
         other.reset();
@@ -205,6 +214,7 @@ Transform& Transform::operator=(Transform&& other) noexcept
         setOrigin(other.getOrigin());
         m_dirtyFlags = Flags::Tx;
         m_attachmentTransform = other.m_attachmentTransform;
+        markWorldDirty(true);
         m_callbacks.swap(other.m_callbacks);
 
         other.reset();
@@ -241,6 +251,7 @@ void Transform::setOrigin(glm::vec3 o)
 
     m_origin = o;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::setOrigin(glm::vec2 o)
@@ -256,6 +267,7 @@ void Transform::setPosition(glm::vec3 position)
 
     m_position = position;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::setPosition(glm::vec2 position)
@@ -267,6 +279,7 @@ void Transform::setPosition(glm::vec2 position)
     m_position.x = position.x;
     m_position.y = position.t;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::setRotation(glm::vec3 axis, float angle)
@@ -278,6 +291,7 @@ void Transform::setRotation(glm::vec3 axis, float angle)
     glm::quat q = glm::quat(1.f, 0.f, 0.f, 0.f);
     m_rotation = glm::rotate(q, angle, axis);
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::setRotation(float radians)
@@ -293,6 +307,7 @@ void Transform::setRotation(glm::quat rotation)
 
     m_rotation = rotation;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::setRotation(glm::mat4 rotation)
@@ -302,6 +317,7 @@ void Transform::setRotation(glm::mat4 rotation)
 #endif
     m_rotation = glm::quat_cast(rotation);
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::setScale(glm::vec3 scale)
@@ -311,6 +327,7 @@ void Transform::setScale(glm::vec3 scale)
 #endif
     m_scale = scale;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::setScale(glm::vec2 scale)
@@ -325,6 +342,7 @@ void Transform::move(glm::vec3 distance)
 #endif
     m_position += distance;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::move(glm::vec2 distance)
@@ -339,6 +357,7 @@ void Transform::rotate(glm::vec3 axis, float rotation)
 #endif
     m_rotation = glm::rotate(m_rotation, rotation, glm::normalize(axis));
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::rotate(float amount)
@@ -353,6 +372,7 @@ void Transform::rotate(glm::quat rotation)
 #endif
     m_rotation = rotation * m_rotation;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::rotate(glm::mat4 rotation)
@@ -362,6 +382,7 @@ void Transform::rotate(glm::mat4 rotation)
 #endif
     m_rotation = glm::quat_cast(rotation) * m_rotation;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::scale(glm::vec3 scale)
@@ -371,6 +392,7 @@ void Transform::scale(glm::vec3 scale)
 #endif
     m_scale *= scale;
     m_dirtyFlags |= Tx;
+    markWorldDirty();
 }
 
 void Transform::scale(glm::vec2 amount)
@@ -390,8 +412,11 @@ glm::vec3 Transform::getPosition() const
 
 glm::vec3 Transform::getWorldPosition() const
 {
-    const auto t = glm::vec3(getWorldTransform()[3]);
-    return t - ((m_origin * m_scale) * m_rotation);
+    if (m_dirtyFlags & World)
+    {
+        updateWorldTransform();
+    }
+    return m_worldPosition;
 }
 
 glm::quat Transform::getRotation() const
@@ -406,11 +431,11 @@ float Transform::getRotation2D() const
 
 glm::quat Transform::getWorldRotation() const
 {
-    if (m_parent)
+    if (m_dirtyFlags & World)
     {
-        return m_parent->getWorldRotation() * m_rotation;
+        updateWorldTransform();
     }
-    return m_rotation;
+    return m_worldRotation;
 }
 
 glm::vec3 Transform::getScale() const
@@ -420,11 +445,11 @@ glm::vec3 Transform::getScale() const
 
 glm::vec3 Transform::getWorldScale() const
 {
-    if (m_parent)
+    if (m_dirtyFlags & World)
     {
-        return m_parent->getWorldScale() * m_scale;
+        updateWorldTransform();
     }
-    return m_scale;
+    return m_worldScale;
 }
 
 glm::mat4 Transform::getLocalTransform() const
@@ -434,6 +459,12 @@ glm::mat4 Transform::getLocalTransform() const
     {
 #ifdef USE_PARALLEL_PROCESSING
         std::scoped_lock l(m_mutex);
+
+        //updated by another thread while we waited
+        if ((m_dirtyFlags & Tx) == 0)
+        {
+            return m_attachmentTransform * m_transform;
+        }
 #endif 
         m_transform = glm::translate(glm::mat4(1.f), m_position);
         m_transform *= glm::toMat4(m_rotation);
@@ -481,17 +512,18 @@ void Transform::setLocalTransform(glm::mat4 transform)
     //m_dirtyFlags |= Tx;
     m_transform = glm::translate(transform, -m_origin);
     m_dirtyFlags &= ~Tx;
+    markWorldDirty();
 
     doCallbacks();
 }
 
 glm::mat4 Transform::getWorldTransform() const
 {
-    if (m_parent)
+    if (m_dirtyFlags & World)
     {
-        return m_parent->getWorldTransform() * getLocalTransform();
+        updateWorldTransform();
     }
-    return getLocalTransform();
+    return m_worldTransform;
 }
 
 glm::vec3 Transform::getForwardVector() const
@@ -545,6 +577,7 @@ bool Transform::addChild(Transform& child)
 #endif
             child.m_parent = this;
         }
+        child.markWorldDirty(true);
 
 
         //correct the depth
@@ -581,6 +614,7 @@ void Transform::removeChild(Transform& tx)
 #endif
         tx.m_parent = nullptr;
     }
+    tx.markWorldDirty(true);
 
 
     /*while (tx.m_depth > 0)
@@ -598,6 +632,28 @@ void Transform::removeChild(Transform& tx)
         }), m_children.end());
 }
 
+void Transform::resolveHierarchy(ResolveStats* stats) const
+{
+    if (m_dirtyFlags & World)
+    {
+        updateWorldTransform();
+
+        if (stats)
+        {
+            stats->recomputed++;
+        }
+    }
+    else if (stats)
+    {
+        stats->reused++;
+    }
+
+    for (auto c : m_children)
+    {
+        c->resolveHierarchy(stats);
+    }
+}
+
 void Transform::addCallback(std::function<void()> cb)
 {
 #ifdef USE_PARALLEL_PROCESSING
@@ -617,6 +673,10 @@ void Transform::reset()
     m_scale = glm::vec3(1.f, 1.f, 1.f);
     m_rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
     m_transform = glm::mat4(1.f);
+    m_worldTransform = glm::mat4(1.f);
+    m_worldPosition = glm::vec3(0.f);
+    m_worldScale = glm::vec3(1.f);
+    m_worldRotation = glm::quat(1.f, 0.f, 0.f, 0.f);
     m_parent = nullptr;
     m_dirtyFlags = 0;
     //m_depth = 0;
@@ -626,6 +686,66 @@ void Transform::reset()
     m_children.clear();
 }
 
+void Transform::updateWorldTransform() const
+{
+    //this may be called lazily from parallel loops, so make sure
+    //the parent is up to date first via its getters, which resolve
+    //it under its own lock - this is a no-op if it's already clean
+    glm::mat4 parentTx(1.f);
+    glm::quat parentRotation(1.f, 0.f, 0.f, 0.f);
+    glm::vec3 parentScale(1.f);
+    if (m_parent)
+    {
+        parentTx = m_parent->getWorldTransform();
+        parentRotation = m_parent->getWorldRotation();
+        parentScale = m_parent->getWorldScale();
+    }
+
+    //locks internally so do this before locking below
+    const auto localTx = getLocalTransform();
+
+#ifdef USE_PARALLEL_PROCESSING
+    std::scoped_lock l(m_mutex);
+#endif
+    //another thread may have resolved this while we waited
+    //for the lock, in which case the cached values may already
+    //be being read, so mustn't be written again
+    if ((m_dirtyFlags & World) == 0)
+    {
+        return;
+    }
+
+    m_worldTransform = parentTx * localTx;
+    m_worldRotation = parentRotation * m_rotation;
+    m_worldScale = parentScale * m_scale;
+    m_worldPosition = glm::vec3(m_worldTransform[3]) - ((m_origin * m_scale) * m_rotation);
+
+    //clearing the flag publishes the values above
+    //to any thread which then reads it as clean
+    m_dirtyFlags &= ~World;
+}
+
+void Transform::markWorldDirty(bool force)
+{
+    //if we're already dirty then so are all our
+    //children, so there's no need to walk the tree
+    if ((m_dirtyFlags & World) == 0
+        || force)
+    {
+        m_dirtyFlags |= World;
+        for (auto c : m_children)
+        {
+            c->markWorldDirty();
+        }
+    }
+}
+
+void Transform::setAttachmentTransform(const glm::mat4& tx)
+{
+    m_attachmentTransform = tx;
+    markWorldDirty();
+}
+
 void Transform::doCallbacks() const
 {
     for (auto& c : m_callbacks)
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2021
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -237,6 +237,8 @@ void DeferredRenderSystem::updateDrawList(Entity camera)
                 {
                     forward.push_back(f);
                 }
+
+                model.m_visibleInDrawList = true;
             }
         //}
     }
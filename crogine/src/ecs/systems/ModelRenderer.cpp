@@ -32,6 +32,7 @@ source distribution.
 #include "../../graphics/shaders/PBR.hpp"
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/VertexAttribFormat.hpp"
 
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/Console.hpp>
@@ -53,6 +54,8 @@ source distribution.
 #include <crogine/detail/glm/gtc/matrix_inverse.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
 
+#include <cstring>
+
 //#define PARALLEL_DISABLE
 #ifdef PARALLEL_DISABLE
 #undef USE_PARALLEL_PROCESSING
@@ -68,6 +71,31 @@ using namespace cro;
 namespace
 {
     float lightMultiplier = 1.f;
+
+    //the bits of a positive float sort in the same order as its value
+    std::int64_t depthBits(float distance)
+    {
+        distance = std::max(0.f, distance);
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &distance, sizeof(bits));
+        return bits;
+    }
+
+    //opaque models are grouped by shader then VAO to reduce state changes,
+    //and drawn front to back within each group. Transparent models are
+    //always drawn last, back to front.
+    constexpr std::int64_t TransparentBit = (1ll << 62);
+    std::int64_t opaqueSortKey(std::uint32_t shader, std::uint32_t vao, float distance)
+    {
+        return (static_cast<std::int64_t>(shader & 0xfff) << 48)
+            | (static_cast<std::int64_t>(vao & 0xffff) << 32)
+            | depthBits(distance);
+    }
+
+    std::int64_t transparentSortKey(float distance)
+    {
+        return TransparentBit | (0x7fffffff - depthBits(distance));
+    }
 }
 //void ModelRenderer::setLightMultiplier(float m) { lightMultiplier = m; }
 
@@ -76,9 +104,9 @@ ModelRenderer::ModelRenderer(MessageBus& mb)
     : System                (mb, typeid(ModelRenderer)),
     m_drawLists             (),
     m_pass                  (Mesh::IndexData::Final),
-    m_lightUBO              ("LightUniforms")/*,
-    m_tree          (1.f),
-    m_useTreeQueries(false)*/
+    m_tree                  (1.f),
+    m_useTreeQueries        (false),
+    m_treeUpdatePending     (true)
 {
     requireComponent<Transform>();
     requireComponent<Model>();
@@ -98,6 +126,16 @@ ModelRenderer::ModelRenderer(MessageBus& mb)
                     ImGui::Text("%3.3f,%3.3f,%3.3f,%3.3f", mat[j][0], mat[j][1], mat[j][2], mat[j][3]);
                 }
             }
+
+            if (m_useTreeQueries)
+            {
+                ImGui::Text("Tree nodes visited: %lu, Entities culled: %lu, Nodes updated: %lu",
+                    m_treeStats.nodesVisited, m_treeStats.entitiesCulled, m_treeStats.nodesUpdated);
+            }
+
+            const auto& materialStats = Material::getFrameStats();
+            ImGui::Text("Material property lookups: %lu, Resolved allocations: %lu",
+                materialStats.propertyLookups, materialStats.resolvedAllocations);
         });
 
     registerWindow([&]() 
@@ -149,9 +187,12 @@ void ModelRenderer::updateDrawList(Entity cameraEnt)
 #ifdef BENCHMARK
         m_benchmarks.resize(m_drawLists.size());
 #endif
-
+    }
 
 #ifdef PLATFORM_DESKTOP
+    if (m_cameraUBOs.size() < m_drawLists.size()
+        && !m_stateCache.isRecording())
+    {
         m_cameraUBOs.resize(m_drawLists.size());
         for (auto& uboPair : m_cameraUBOs)
         {
@@ -178,14 +219,14 @@ void ModelRenderer::updateDrawList(Entity cameraEnt)
                 }
             }
         }
-#endif
     }
+#endif
 
-    /*if (m_useTreeQueries)
+    if (m_useTreeQueries)
     {
         updateDrawListBalancedTree(cameraEnt);
     }
-    else*/
+    else
     {
         updateDrawListDefault(cameraEnt);
     }
@@ -194,13 +235,10 @@ void ModelRenderer::updateDrawList(Entity cameraEnt)
     //DPRINT("Visible 3D ents in Scene " + std::to_string(getScene()->getInstanceID()) 
     //    + ", Camera " + std::to_string(cameraEnt.getIndex()), std::to_string(m_drawLists[camComponent.getDrawListIndex()][0].size()));
 
-    //sort lists by depth
-    //flag values make sure transparent materials are rendered last
-    //with opaque going front to back and transparent back to front
-    auto& drawList = m_drawLists[camIndex];
-    for (auto i = 0; i < passCount; ++i)
-    {
 #ifdef PLATFORM_DESKTOP
+    //update the camera uniforms for each pass
+    for (auto i = 0; i < passCount && camIndex < m_cameraUBOs.size(); ++i)
+    {
         auto& ubo = m_cameraUBOs[camIndex][i];
         if (ubo->hasShaders())
         {
@@ -215,77 +253,59 @@ void ModelRenderer::updateDrawList(Entity cameraEnt)
 
             ubo->setData(block);
         }
-#endif
-
-
-//apparently this won't work on gcc 9/10/11 (and should be disabled on lower versions anyway)
-#ifndef _MSC_VER
-#if __GNUC__ <= 14
-#ifdef USE_PARALLEL_PROCESSING
-#undef USE_PARALLEL_PROCESSING
-#define GNUC_UNSUPPORTED
-#endif //USE_PARALLEL_PROCESSING
-#endif //__GNUC__
-#endif //_MSC_VER
-
-#if defined USE_PARALLEL_PROCESSING
-        std::sort(std::execution::par, std::begin(drawList[i].renderables), std::end(drawList[i].renderables),
-#else
-        std::sort(std::begin(drawList[i].renderables), std::end(drawList[i].renderables),
-#endif
-            [](MaterialPair& a, MaterialPair& b)
-            {
-                return a.second.flags < b.second.flags;
-            });
-#ifdef GNUC_UNSUPPORTED
-#define USE_PARALLEL_PROCESSING
-#undef GNUC_UNSUPPORTED
-#endif
-
     }
+#endif
 }
 
 void ModelRenderer::process(float dt)
 {
+    //the tree is updated by the first camera to request
+    //a draw list each frame, see updateDrawListBalancedTree()
+    m_treeUpdatePending = true;
+
     m_lightUniforms.lightColour = getScene()->getSunlight().getComponent<Sunlight>().getColour().getVec4();
     m_lightUniforms.lightDirection = getScene()->getSunlight().getComponent<Sunlight>().getDirection();
-    m_lightUBO.setData(m_lightUniforms);
+    if (!m_stateCache.isRecording())
+    {
+        if (!m_lightUBO)
+        {
+            m_lightUBO = std::make_unique<UniformBuffer<LightUniformBlock>>("LightUniforms");
+#ifdef PLATFORM_DESKTOP
+            for (auto entity : getEntities())
+            {
+                const auto& model = entity.getComponent<Model>();
+                for (auto i = 0u; i < model.getMeshData().submeshCount; ++i)
+                {
+                    const auto& mat = model.getMaterialData(Mesh::IndexData::Final, i);
+                    if (mat.hasLightUBO())
+                    {
+                        m_lightUBO->addShader(mat.shader);
+                    }
+                }
+            }
+#endif
+        }
+        m_lightUBO->setData(m_lightUniforms);
+    }
 
-    auto& entities = getEntities();
+    //iterate the model pool directly rather than our entity list
+    //so that we don't have to look up the components per entity
+    const auto view = getScene()->view<Model, Transform>();
 
 #ifdef USE_PARALLEL_PROCESSING
-    std::for_each(std::execution::par, entities.cbegin(), entities.cend(),
-        [&, dt](Entity entity)
+    std::for_each(std::execution::par, view.begin(), view.end(),
+        [&, dt](auto item)
 #else
-    for (auto entity : entities)
+    for (auto item : view)
 #endif
     {
-        const auto& tx = entity.getComponent<cro::Transform>();
-
-        auto& model = entity.getComponent<Model>();
+        auto& [entity, model, tx] = item;
         model.updateMaterialAnimations(dt);
 
         //this is used when updating the modelView mat for each
         //draw list, below, as well as during render()
         model.m_activeWorldMatrix = tx.getWorldTransform();
         model.m_activeNormalMatrix = glm::inverseTranspose(glm::mat3(model.m_activeWorldMatrix));
-
-        /*if (m_useTreeQueries)
-        {
-            if (!entity.destroyed())
-            {
-                const auto& tx = entity.getComponent<Transform>();
-                auto worldPosition = tx.getWorldPosition();
-                auto worldBounds = model.getAABB();
-
-                worldBounds += tx.getOrigin();
-                worldBounds = tx.getWorldTransform() * worldBounds;
-
-                m_tree.moveNode(model.m_treeID, worldBounds, worldPosition - model.m_lastWorldPosition);
-
-                model.m_lastWorldPosition = worldPosition;
-            }
-        }*/
     }
 #ifdef USE_PARALLEL_PROCESSING
     );
@@ -320,13 +340,20 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
 #ifdef BENCHMARK
     m_timer.restart();
 #endif
-    m_lightUBO.bind();
+    const bool recording = m_stateCache.isRecording();
+    if (!recording && m_lightUBO)
+    {
+        m_lightUBO->bind();
+    }
     
     const auto& camComponent = camera.getComponent<Camera>();
     const auto camIndex = camComponent.getDrawListIndex();
     if (camIndex < m_drawLists.size())
     {
-        m_cameraUBOs[camIndex][camComponent.getActivePassIndex()]->bind();
+        if (!recording && camIndex < m_cameraUBOs.size())
+        {
+            m_cameraUBOs[camIndex][camComponent.getActivePassIndex()]->bind();
+        }
         
         const auto& pass = camComponent.getActivePass();
         //why did we have this offset here??
@@ -336,8 +363,15 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
         auto cameraPosition = camTx.getWorldPosition();
         auto screenSize = glm::vec2(rt.getSize());
 
-        glCheck(glCullFace(pass.getCullFace()));
+        //other systems may have changed the state since we last rendered
+        m_stateCache.invalidate();
+        m_stateCache.resetStats();
+        m_passUniformPrograms.clear();
 
+        if (!recording)
+        {
+            glCheck(glCullFace(pass.getCullFace()));
+        }
 
         //DPRINT("Render count", std::to_string(m_visibleEntities.size()));
         const auto& visibleEntities = m_drawLists[camIndex][camComponent.getActivePassIndex()].renderables;
@@ -354,11 +388,14 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
 
             //foreach submesh / material:
             const auto& model = entity.getComponent<Model>();
-            glCheck(glFrontFace(model.m_facing));
+            m_stateCache.setFrontFace(model.m_facing);
 
 
 #ifndef PLATFORM_DESKTOP
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo));
+            if (!recording)
+            {
+                glCheck(glBindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo));
+            }
 #endif //PLATFORM
 
             for (auto i : sortData.matIDs)
@@ -367,33 +404,58 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
                 const auto& uniforms = material.uniforms;
 
                 //bind shader
-                glCheck(glUseProgram(material.shader));
-
-                //apply shader uniforms from material
-                //FUTURE ME: if you end up back here wondering why the matrices aren't calculated correctly
-                //remember CamerSystems need to be added to a Scene BEFORE any render systems...
-                glCheck(glUniformMatrix4fv(uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(sortData.worldViewMatrix)));
-                applyProperties(material, model, *getScene(), camComponent);
-
-                //apply standard uniforms
-                glCheck(glUniform2f(uniforms[Material::ScreenSize], screenSize.x, screenSize.y));
-                
-                if (!material.hasCameraUBO())
+                m_stateCache.useProgram(material.shader);
+
+                //uniform values are stored with the shader program, and the per-pass
+                //values don't change during this function, so only need setting once
+                const bool setPassUniforms = std::find(m_passUniformPrograms.cbegin(), m_passUniformPrograms.cend(), material.shader) == m_passUniformPrograms.cend();
+                if (setPassUniforms)
+                {
+                    m_passUniformPrograms.push_back(material.shader);
+                }
+
+                if (recording)
+                {
+                    std::uint32_t uniformCount = 3 + static_cast<std::uint32_t>(material.getResolvedProperties().size() + material.optionalUniformCount);
+                    if (setPassUniforms)
+                    {
+                        uniformCount += material.hasCameraUBO() ? 1 : 6;
+                    }
+                    m_stateCache.record(RenderCommand::Uniforms, material.shader, uniformCount);
+                }
+                else
                 {
-                    glCheck(glUniform3f(uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
-                    glCheck(glUniformMatrix4fv(uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(pass.viewMatrix)));
-                    glCheck(glUniformMatrix4fv(uniforms[Material::ViewProjection], 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
-                    glCheck(glUniformMatrix4fv(uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camComponent.getProjectionMatrix())));
-                    glCheck(glUniform4f(uniforms[Material::ClipPlane], clipPlane[0], clipPlane[1], clipPlane[2], clipPlane[3]));
+                    //apply shader uniforms from material
+                    //FUTURE ME: if you end up back here wondering why the matrices aren't calculated correctly
+                    //remember CamerSystems need to be added to a Scene BEFORE any render systems...
+                    glCheck(glUniformMatrix4fv(uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(sortData.worldViewMatrix)));
+                    applyProperties(material, model, *getScene(), camComponent);
+
+                    //apply standard uniforms
+                    if (setPassUniforms)
+                    {
+                        glCheck(glUniform2f(uniforms[Material::ScreenSize], screenSize.x, screenSize.y));
+
+                        if (!material.hasCameraUBO())
+                        {
+                            glCheck(glUniform3f(uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
+                            glCheck(glUniformMatrix4fv(uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(pass.viewMatrix)));
+                            glCheck(glUniformMatrix4fv(uniforms[Material::ViewProjection], 1, GL_FALSE, glm::value_ptr(pass.viewProjectionMatrix)));
+                            glCheck(glUniformMatrix4fv(uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camComponent.getProjectionMatrix())));
+                            glCheck(glUniform4f(uniforms[Material::ClipPlane], clipPlane[0], clipPlane[1], clipPlane[2], clipPlane[3]));
+                        }
+                    }
+                    glCheck(glUniformMatrix4fv(uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(model.m_activeWorldMatrix)));
+                    glCheck(glUniformMatrix3fv(uniforms[Material::Normal], 1, GL_FALSE, glm::value_ptr(model.m_activeNormalMatrix)));
                 }
-                glCheck(glUniformMatrix4fv(uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(model.m_activeWorldMatrix)));
-                glCheck(glUniformMatrix3fv(uniforms[Material::Normal], 1, GL_FALSE, glm::value_ptr(model.m_activeNormalMatrix)));
 
-                applyBlendMode(material);
+                m_stateCache.applyMaterial(material);
 
-                //TODO move these to custom settings list
-                glCheck(material.doubleSided ? glDisable(GL_CULL_FACE) : glEnable(GL_CULL_FACE));
-                glCheck(material.enableDepthTest ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST));
+                if (recording)
+                {
+                    m_stateCache.record(RenderCommand::Draw, model.m_vaos[i][Mesh::IndexData::Final], i);
+                    continue;
+                }
 
                 material.enableCustomSettings();
 
@@ -407,9 +469,10 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
                 const auto& attribs = model.m_materials[Mesh::IndexData::Final][i].attribs;
                 for (auto j = 0u; j < model.m_materials[Mesh::IndexData::Final][i].attribCount; ++j)
                 {
+                    const Detail::VertexAttribFormat format(attribs[j][Material::Data::Format], attribs[j][Material::Data::Size]);
                     glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
-                    glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-                        GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
+                    glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], format.size,
+                        format.type, format.normalised, static_cast<GLsizei>(model.m_meshData.vertexSize),
                         reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
                 }
 
@@ -429,22 +492,31 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
                 }
 #endif //PLATFORM 
                 material.disableCustomSettings();
+
+                if (material.hasCustomSettings())
+                {
+                    //these may have touched the state we're tracking
+                    m_stateCache.invalidate();
+                }
             }
         }
 
+        if (!recording)
+        {
 #ifdef PLATFORM_DESKTOP
-        glCheck(glBindVertexArray(0));
+            glCheck(glBindVertexArray(0));
 #else
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 #endif //PLATFORM
+        }
 
         //glCheck(glUseProgram(0));
 
-        glCheck(glFrontFace(GL_CCW));
-        glCheck(glDisable(GL_BLEND));
-        glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_TRUE)); //restore this else clearing the depth buffer fails
+        m_stateCache.setFrontFace(GL_CCW);
+        m_stateCache.setEnabled(GL_BLEND, false);
+        m_stateCache.setEnabled(GL_CULL_FACE, false);
+        m_stateCache.setEnabled(GL_DEPTH_TEST, false);
+        m_stateCache.setDepthMask(true); //restore this else clearing the depth buffer fails
     }
 #ifdef BENCHMARK
     if (m_benchmarks.size() <= camIndex) m_benchmarks.resize(camIndex+1); //hmmm we shouldn't need this
@@ -468,6 +540,35 @@ std::size_t ModelRenderer::getVisibleCount(std::size_t cameraIndex, std::int32_t
     return 0;
 }
 
+void ModelRenderer::setCommandRecorder(std::vector<RenderCommand>* recorder)
+{
+    m_stateCache = RenderStateCache(recorder);
+}
+
+void ModelRenderer::setUseTreeQueries(bool useTree)
+{
+    if (useTree != m_useTreeQueries)
+    {
+        m_useTreeQueries = useTree;
+        for (auto entity : getEntities())
+        {
+            if (useTree)
+            {
+                addToTree(entity);
+            }
+            else
+            {
+                auto& model = entity.getComponent<Model>();
+                m_tree.removeFromTree(model.m_treeID);
+                model.m_treeID = -1;
+            }
+        }
+
+        m_treeStats = {};
+        m_treeUpdatePending = true;
+    }
+}
+
 const std::string& ModelRenderer::getDefaultVertexShader(std::int32_t type)
 {
     static const std::string defaultVal;
@@ -509,7 +610,10 @@ void ModelRenderer::onEntityAdded(Entity entity)
     auto& model = entity.getComponent<Model>();
     model.updateBounds();
 
-    //model.m_treeID = m_tree.addToTree(entity, model.getAABB());
+    if (m_useTreeQueries)
+    {
+        addToTree(entity);
+    }
 
 #ifdef PLATFORM_DESKTOP
     
@@ -532,9 +636,9 @@ void ModelRenderer::onEntityAdded(Entity entity)
             }
         }
 
-        if (mat.hasLightUBO())
+        if (mat.hasLightUBO() && m_lightUBO)
         {
-            m_lightUBO.addShader(mat.shader);
+            m_lightUBO->addShader(mat.shader);
         }
     }
 
@@ -556,15 +660,23 @@ void ModelRenderer::onEntityAdded(Entity entity)
 
             //plus we can't assume that just because it has a camera ubo
             //that it also uses lighting...
-            m_lightUBO.removeShader(oldShader);
-            m_lightUBO.addShader(newShader);
+            if (m_lightUBO)
+            {
+                m_lightUBO->removeShader(oldShader);
+                m_lightUBO->addShader(newShader);
+            }
         };
 #endif
 }
 
 void ModelRenderer::onEntityRemoved(Entity entity)
 {
-    //m_tree.removeFromTree(entity.getComponent<Model>().m_treeID);
+    if (m_useTreeQueries)
+    {
+        auto& model = entity.getComponent<Model>();
+        m_tree.removeFromTree(model.m_treeID);
+        model.m_treeID = -1;
+    }
 
 #ifdef PLATFORM_DESKTOP
     //remove any materials from camera UBOs
@@ -581,7 +693,10 @@ void ModelRenderer::onEntityRemoved(Entity entity)
                 }
             }
         }
-        m_lightUBO.removeShader(model.getMaterialData(Mesh::IndexData::Final, i).shader);
+        if (m_lightUBO)
+        {
+            m_lightUBO->removeShader(model.getMaterialData(Mesh::IndexData::Final, i).shader);
+        }
     }
 #endif
 
@@ -613,6 +728,29 @@ void ModelRenderer::flushEntity(Entity entity)
 
 //private
 void ModelRenderer::updateDrawListDefault(Entity cameraEnt)
+{
+    cullEntities(cameraEnt, getEntities());
+}
+
+void ModelRenderer::updateDrawListBalancedTree(Entity cameraEnt)
+{
+    if (m_treeUpdatePending)
+    {
+        m_treeStats = {};
+        updateTree();
+        m_treeUpdatePending = false;
+    }
+
+    const auto& camComponent = cameraEnt.getComponent<Camera>();
+    const auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
+    queryTree(camComponent, passCount);
+
+    m_treeStats.entitiesCulled += getEntities().size() - m_treeCandidates.size();
+
+    cullEntities(cameraEnt, m_treeCandidates);
+}
+
+void ModelRenderer::cullEntities(Entity cameraEnt, const std::vector<Entity>& entities)
 {
     const auto& camComponent = cameraEnt.getComponent<Camera>();
     const auto cameraPos = cameraEnt.getComponent<Transform>().getWorldPosition();
@@ -620,7 +758,6 @@ void ModelRenderer::updateDrawListDefault(Entity cameraEnt)
     //entities for the second pass...
     const auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
 
-    const auto& entities = getEntities();
     auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
 
     //cull entities by viewable into draw lists by pass
@@ -636,322 +773,282 @@ void ModelRenderer::updateDrawListDefault(Entity cameraEnt)
         drawList[i].renderables.clear();
         drawList[i].viewMatrix = camComponent.getPass(i).viewMatrix;
     }
-#ifdef USE_PARALLEL_PROCESSING
-    std::mutex mutex;
-
-    std::for_each(std::execution::par, entities.cbegin(), entities.cend(), 
-        [&](Entity entity)
-#else
-    for (auto entity : entities)
-#endif
+    m_cullSpheres.resize(entities.size());
+    m_culler.cullChunks(entities.size(), passCount,
+        [&](std::size_t start, std::size_t end, std::vector<MaterialPair>* visibleLists)
     {
-        auto& model = entity.getComponent<Model>();
-        if (model.isHidden())
+        //update the world space bounding spheres for this chunk
+        for (auto i = start; i < end; ++i)
         {
-            EARLY_OUT;
-        }
+            auto entity = entities[i];
+            auto& model = entity.getComponent<Model>();
+            if (model.isHidden())
+            {
+                continue;
+            }
 
-        if (model.m_meshBox != model.m_meshData.boundingBox)
-        {
-            model.updateBounds();
-        }
+            if (model.m_meshBox != model.m_meshData.boundingBox)
+            {
+                model.updateBounds();
+            }
 
-        //use the bounding sphere for depth testing
-        auto sphere = model.getBoundingSphere();
-        const auto& tx = entity.getComponent<Transform>();
+            //use the bounding sphere for depth testing
+            auto sphere = model.getBoundingSphere();
+            const auto& tx = entity.getComponent<Transform>();
 
-        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-        auto scale = tx.getWorldScale();
+            sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
+            auto scale = tx.getWorldScale();
 
-        /*if (scale.x * scale.y * scale.z == 0)
-        {
-            continue;
-        }*/
+            sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
 
-        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
+            //for some reason the tighter fitting Spheres cause incorrect culling
+            //so this is a hack to mitigate it somewhat
+            sphere.radius *= 1.2f;
 
-        //for some reason the tighter fitting Spheres cause incorrect culling
-        //so this is a hack to mitigate it somewhat
-        sphere.radius *= 1.2f;
+            m_cullSpheres.set(i, sphere);
+        }
 
-        //for each pass in the list (different passes may use different projections, eg reflections)
+        //test the whole chunk against each pass frustum
+        std::array<std::array<std::uint64_t, Detail::ParallelCuller<MaterialPair>::ChunkSize / 64>, 2u> visibleMasks = {};
         for (auto p = 0; p < passCount; ++p)
         {
-            if ((model.m_renderFlags & camComponent.getPass(p).renderFlags) == 0)
-            {
-                continue;
-            }
-            
-            //this is a good approximation of distance based on the centre
-            //of the model (large models might suffer without face sorting...)
-            //assuming the forward vector is normalised - though WHY would you
-            //scale the view matrix???
-            auto direction = (sphere.centre - cameraPos);
-            float distance = glm::dot(camComponent.getPass(p).forwardVector, direction);
-
-            if (distance < -sphere.radius)
+            Spatial::cullSpheres(camComponent.getPass(p).getFrustum(), m_cullSpheres, start, end - start, visibleMasks[p].data());
+        }
+
+        for (auto i = start; i < end; ++i)
+        {
+            auto entity = entities[i];
+            auto& model = entity.getComponent<Model>();
+            if (model.isHidden())
             {
-                //model is behind the camera
                 continue;
             }
 
+            const auto sphere = m_cullSpheres.get(i);
+            const auto bit = i - start;
 
-            bool visible = true;
-            //if (camComponent.isOrthographic())
+            //for each pass in the list (different passes may use different projections, eg reflections)
+            for (auto p = 0; p < passCount; ++p)
             {
-                const auto& frustum = camComponent.getPass(p).getFrustum();
-
-                std::size_t j = 0;
-                while (visible && j < frustum.size())
+                if ((model.m_renderFlags & camComponent.getPass(p).renderFlags) == 0)
                 {
-                    visible = (Spatial::intersects(frustum[j++], sphere) != Planar::Back);
+                    continue;
                 }
-            }
-            /*else
-            {
-                //well measuring this says it's nearly twice as slow...
-                model.m_visible = cro::Util::Frustum::visible(camComponent.getFrustumData(), camComponent.getPass(p).viewMatrix * tx.getWorldTransform(), model.getAABB());
-            }*/
 
-            if (visible)
-            {
-                auto opaque = std::make_pair(entity, SortData());
-                auto transparent = std::make_pair(entity, SortData());
+                //this is a good approximation of distance based on the centre
+                //of the model (large models might suffer without face sorting...)
+                //assuming the forward vector is normalised - though WHY would you
+                //scale the view matrix???
+                auto direction = (sphere.centre - cameraPos);
+                float distance = glm::dot(camComponent.getPass(p).forwardVector, direction);
 
-                //foreach material
-                //add ent/index pair to alpha or opaque list
-                for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
+                if (distance < -sphere.radius)
                 {
-                    if (model.m_materials[Mesh::IndexData::Final][i].blendMode != Material::BlendMode::None)
+                    //model is behind the camera
+                    continue;
+                }
+
+                if (visibleMasks[p][bit / 64] & (std::uint64_t(1) << (bit % 64)))
+                {
+                    auto opaque = std::make_pair(entity, SortData());
+                    auto transparent = std::make_pair(entity, SortData());
+
+                    //foreach material
+                    //add ent/index pair to alpha or opaque list
+                    for (auto j = 0u; j < model.m_meshData.submeshCount; ++j)
                     {
-                        transparent.second.matIDs.push_back(static_cast<std::int32_t>(i));
-                        transparent.second.flags = static_cast<std::int64_t>(-distance * 1000000.f); //suitably large number to shift decimal point
-                        transparent.second.flags += 0x0FFF000000000000; //gaurentees embiggenment so that sorting places transparent last
+                        const auto& material = model.m_materials[Mesh::IndexData::Final][j];
+                        if (material.blendMode != Material::BlendMode::None)
+                        {
+                            transparent.second.matIDs.push_back(static_cast<std::int32_t>(j));
+                            transparent.second.flags = transparentSortKey(distance);
+                        }
+                        else
+                        {
+                            //keyed on the first opaque submesh
+                            if (opaque.second.matIDs.empty())
+                            {
+                                opaque.second.flags = opaqueSortKey(material.shader, model.m_vaos[j][Mesh::IndexData::Final], distance);
+                            }
+                            opaque.second.matIDs.push_back(static_cast<std::int32_t>(j));
+                        }
                     }
-                    else
+
+                    if (!opaque.second.matIDs.empty())
                     {
-                        opaque.second.matIDs.push_back(static_cast<std::int32_t>(i));
-                        opaque.second.flags = static_cast<std::int64_t>(distance * 1000000.f);
+                        model.m_drawlistCount++;
+                        visibleLists[p].push_back(std::move(opaque));
                     }
-                }
 
-                if (!opaque.second.matIDs.empty())
-                {
-                    model.m_drawlistCount++;
-#ifdef USE_PARALLEL_PROCESSING
-                    std::scoped_lock l(mutex);
-#endif
-                    drawList[p].renderables.push_back(opaque);
-                }
+                    if (!transparent.second.matIDs.empty())
+                    {
+                        model.m_drawlistCount++;
+                        visibleLists[p].push_back(std::move(transparent));
+                    }
 
-                if (!transparent.second.matIDs.empty())
-                {
-                    model.m_drawlistCount++;
-#ifdef USE_PARALLEL_PROCESSING
-                    std::scoped_lock l(mutex);
-#endif
-                    drawList[p].renderables.push_back(transparent);
+                    model.m_visibleInDrawList = true;
                 }
             }
         }
+    });
+
+    //sort lists by depth
+    //flag values make sure transparent materials are rendered last
+    //with opaque grouped by shader and going front to back, and
+    //transparent back to front
+    for (auto p = 0; p < passCount; ++p)
+    {
+        m_culler.gatherSorted(p, drawList[p].renderables,
+            [](const MaterialPair& a, const MaterialPair& b)
+            {
+                return a.second.flags < b.second.flags;
+            });
     }
-#ifdef USE_PARALLEL_PROCESSING    
-    );
-#endif
 }
 
-void ModelRenderer::updateDrawListBalancedTree(Entity cameraEnt)
+void ModelRenderer::addToTree(Entity entity)
 {
-    //const auto& camComponent = cameraEnt.getComponent<Camera>();
-    //auto cameraPos = cameraEnt.getComponent<Transform>().getWorldPosition();
-
-    //auto& drawList = m_drawLists[camComponent.getDrawListIndex()];
-
-    //for (auto& list : drawList)
-    //{
-    //    list.clear();
-    //}
-
-    //auto passCount = camComponent.reflectionBuffer.available() ? 2 : 1;
-
-    //for (auto p = 0; p < passCount; ++p)
-    //{
-    //    const auto& frustumBounds = camComponent.getPass(p).getAABB();
-    //    auto entities = queryTree(frustumBounds);
-
-    //    for (auto entity : entities)
-    //    {
-    //        auto& model = entity.getComponent<Model>();
-    //        if (model.isHidden())
-    //        {
-    //            continue;
-    //        }
-
-    //        if ((model.m_renderFlags & camComponent.getPass(p).renderFlags) == 0)
-    //        {
-    //            continue;
-    //        }
-
-    //        if (model.m_meshBox != model.m_meshData.boundingBox)
-    //        {
-    //            model.updateBounds();
-    //        }
-
-    //        //use the bounding sphere for depth testing
-    //        auto sphere = model.getBoundingSphere();
-    //        const auto& tx = entity.getComponent<Transform>();
-
-    //        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-    //        auto scale = tx.getScale();
-    //        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
-
-    //        auto direction = (sphere.centre - cameraPos);
-    //        float distance = glm::dot(camComponent.getPass(p).forwardVector, direction);
-
-    //        if (distance < -sphere.radius)
-    //        {
-    //            //model is behind the camera
-    //            continue;
-    //        }
-
-    //        //frustum test
-    //        bool visible = true;
-    //        //if (camComponent.isOrthographic())
-    //        {
-    //            const auto& frustum = camComponent.getPass(p).getFrustum();
-
-    //            visible = true;
-    //            std::size_t j = 0;
-    //            while (visible && j < frustum.size())
-    //            {
-    //                visible = (Spatial::intersects(frustum[j++], sphere) != Planar::Back);
-    //            }
-    //        }
-    //        /*else
-    //        {
-    //            model.m_visible = cro::Util::Frustum::visible(camComponent.getFrustumData(), camComponent.getPass(p).viewMatrix * tx.getWorldTransform(), model.getAABB());
-    //        }*/
-
-    //        //add visible ents to lists for depth sorting
-    //        if (visible)
-    //        {
-    //            auto opaque = std::make_pair(entity, SortData());
-    //            auto transparent = std::make_pair(entity, SortData());
-
-    //            //foreach material
-    //            //add ent/index pair to alpha or opaque list
-    //            for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
-    //            {
-    //                if (model.m_materials[Mesh::IndexData::Final][i].blendMode != Material::BlendMode::None)
-    //                {
-    //                    transparent.second.matIDs.push_back(static_cast<std::int32_t>(i));
-    //                    transparent.second.flags = static_cast<std::int64_t>(-distance * 1000000.f); //suitably large number to shift decimal point
-    //                    transparent.second.flags += 0x0FFF000000000000; //gaurentees embiggenment so that sorting places transparent last
-    //                }
-    //                else
-    //                {
-    //                    opaque.second.matIDs.push_back(static_cast<std::int32_t>(i));
-    //                    opaque.second.flags = static_cast<std::int64_t>(distance * 1000000.f);
-    //                }
-    //            }
-
-    //            if (!opaque.second.matIDs.empty())
-    //            {
-    //                drawList[p].push_back(opaque);
-    //            }
-
-    //            if (!transparent.second.matIDs.empty())
-    //            {
-    //                drawList[p].push_back(transparent);
-    //            }
-    //        }
-    //    }
-    //}
+    auto& model = entity.getComponent<Model>();
+    const auto& tx = entity.getComponent<Transform>();
+
+    //addToTree() offsets the bounds by the origin, but the
+    //origin is already part of the world transform
+    auto bounds = model.getAABB();
+    bounds += -tx.getOrigin();
+
+    model.m_treeID = m_tree.addToTree(entity, bounds);
+    model.m_lastWorldPosition = tx.getWorldPosition();
+}
+
+void ModelRenderer::updateTree()
+{
+    for (auto entity : getEntities())
+    {
+        auto& model = entity.getComponent<Model>();
+        if (model.m_static)
+        {
+            continue;
+        }
+
+        const auto& tx = entity.getComponent<Transform>();
+        const auto worldPosition = tx.getWorldPosition();
+        const auto worldBounds = tx.getWorldTransform() * model.getAABB();
+
+        if (m_tree.moveNode(model.m_treeID, worldBounds, worldPosition - model.m_lastWorldPosition))
+        {
+            m_treeStats.nodesUpdated++;
+        }
+        model.m_lastWorldPosition = worldPosition;
+    }
 }
 
-//std::vector<Entity> ModelRenderer::queryTree(Box area) const
-//{
-//    Detail::FixedStack<std::int32_t, 256> stack;
-//    stack.push(m_tree.getRoot());
-//
-//    std::vector<Entity> retVal;
-//    retVal.reserve(256);
-//
-//    while (stack.size() > 0)
-//    {
-//        auto treeID = stack.pop();
-//        if (treeID == Detail::TreeNode::Null)
-//        {
-//            continue;
-//        }
-//
-//        const auto& node = m_tree.getNodes()[treeID];
-//        if (area.intersects(node.fatBounds))
-//        {
-//            if (node.isLeaf() && node.entity.isValid())
-//            {
-//                //we have a candidate, stash
-//                retVal.push_back(node.entity);
-//            }
-//            else
-//            {
-//                stack.push(node.childA);
-//                stack.push(node.childB);
-//            }
-//        }
-//    }
-//    return retVal;
-//}
+void ModelRenderer::queryTree(const Camera& camera, std::int32_t passCount)
+{
+    m_treeCandidates.clear();
+
+    //returns true if the box is not fully behind any plane of the frustum
+    const auto intersects = [](const Frustum& frustum, const Box& box)
+    {
+        for (const auto& plane : frustum)
+        {
+            if (Spatial::intersects(plane, box) == Planar::Back)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    Detail::FixedStack<std::int32_t, 256> stack;
+    stack.push(m_tree.getRoot());
+
+    const auto& nodes = m_tree.getNodes();
+    while (stack.size() > 0)
+    {
+        auto treeID = stack.pop();
+        if (treeID == Detail::TreeNode::Null)
+        {
+            continue;
+        }
+
+        m_treeStats.nodesVisited++;
+
+        //the candidate list is shared between passes so it's enough
+        //for a node to be visible in any one of them
+        const auto& node = nodes[treeID];
+        bool visible = false;
+        for (auto p = 0; p < passCount && !visible; ++p)
+        {
+            visible = intersects(camera.getPass(p).getFrustum(), node.fatBounds);
+        }
+
+        if (visible)
+        {
+            if (node.isLeaf())
+            {
+                if (node.entity.isValid())
+                {
+                    m_treeCandidates.push_back(node.entity);
+                }
+            }
+            else
+            {
+                stack.push(node.childA);
+                stack.push(node.childB);
+            }
+        }
+    }
+}
 
 void ModelRenderer::applyProperties(const Material::Data& material, const Model& model, const Scene& scene, const Camera& camera)
 {
     std::uint32_t currentTextureUnit = 0;
-    for (const auto& prop : material.properties)
+    for (const auto& prop : material.getResolvedProperties())
     {
-        switch (prop.second.second.type)
+        switch (prop.property->type)
         {
         default: break;
         case Material::Property::TextureArray:
             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, prop.second.second.textureID));
-            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+            glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, prop.property->textureID));
+            glCheck(glUniform1i(prop.location, currentTextureUnit++));
             break;        
         case Material::Property::Texture:
             //TODO textures need to track which unit they're currently bound
             //to so that they don't get bound to multiple units
             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_2D, prop.second.second.textureID));
-            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+            glCheck(glBindTexture(GL_TEXTURE_2D, prop.property->textureID));
+            glCheck(glUniform1i(prop.location, currentTextureUnit++));
             break;
         case Material::Property::Cubemap:
             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, prop.second.second.textureID));
-            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+            glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, prop.property->textureID));
+            glCheck(glUniform1i(prop.location, currentTextureUnit++));
             break;
         case Material::Property::CubemapArray:
             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, prop.second.second.textureID));
-            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+            glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, prop.property->textureID));
+            glCheck(glUniform1i(prop.location, currentTextureUnit++));
             break;
         case Material::Property::Number:
-            glCheck(glUniform1f(prop.second.first,
-                prop.second.second.numberValue));
+            glCheck(glUniform1f(prop.location,
+                prop.property->numberValue));
             break;
         case Material::Property::Vec2:
-            glCheck(glUniform2f(prop.second.first, 
-                prop.second.second.vecValue[0],
-                prop.second.second.vecValue[1]));
+            glCheck(glUniform2f(prop.location, 
+                prop.property->vecValue[0],
+                prop.property->vecValue[1]));
             break;
         case Material::Property::Vec3:
-            glCheck(glUniform3f(prop.second.first, prop.second.second.vecValue[0],
-                prop.second.second.vecValue[1], prop.second.second.vecValue[2]));
+            glCheck(glUniform3f(prop.location, prop.property->vecValue[0],
+                prop.property->vecValue[1], prop.property->vecValue[2]));
             break;
         case Material::Property::Vec4:
-            glCheck(glUniform4f(prop.second.first, prop.second.second.vecValue[0],
-                prop.second.second.vecValue[1], prop.second.second.vecValue[2], prop.second.second.vecValue[3]));
+            glCheck(glUniform4f(prop.location, prop.property->vecValue[0],
+                prop.property->vecValue[1], prop.property->vecValue[2], prop.property->vecValue[3]));
             break;
         case Material::Property::Mat4:
-            glCheck(glUniformMatrix4fv(prop.second.first, 1, GL_FALSE, &prop.second.second.matrixValue[0].x));
+            glCheck(glUniformMatrix4fv(prop.location, 1, GL_FALSE, &prop.property->matrixValue[0].x));
             break;
         }
     }
@@ -1030,50 +1127,9 @@ void ModelRenderer::applyProperties(const Material::Data& material, const Model&
 
 void ModelRenderer::applyBlendMode(const Material::Data& material)
 {
-    //face culling is set by material 'double sided' property
-
-    switch (material.blendMode)
-    {
-    default: break;
-    case Material::BlendMode::Custom:
-        CRO_ASSERT(!material.blendData.enableProperties.empty(), "You'll probably want at least GL_BLEND and GL_DEPTH_TEST");
-        for (auto e : material.blendData.enableProperties)
-        {
-            glCheck(glEnable(e));
-        }
-        glCheck(glDepthMask(material.blendData.writeDepthMask));
-        glCheck(glBlendFunc(material.blendData.blendFunc[0], material.blendData.blendFunc[1]));
-        glCheck(glBlendEquation(material.blendData.equation));
-        break;
-    case Material::BlendMode::Additive:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glBlendFunc(GL_ONE, GL_ONE));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
-        break;
-    case Material::BlendMode::Alpha:
-        //make sure to test existing depth
-        //values, just don't write new ones.
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
-        break;
-    case Material::BlendMode::Multiply:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glBlendFunc(GL_DST_COLOR, GL_ZERO));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
-        break;
-    case Material::BlendMode::None:
-        glCheck(glDisable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_TRUE));
-        break;
-    }
+    //a new cache has no known state so always applies everything
+    RenderStateCache cache;
+    cache.applyBlendMode(material);
 }
 
 #ifdef PARALLEL_DISABLE
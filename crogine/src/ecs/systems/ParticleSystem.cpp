@@ -42,10 +42,13 @@ source distribution.
 #include <crogine/util/Matrix.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/ParticleSimulation.hpp"
 
 #include <crogine/detail/glm/gtc/type_ptr.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
 
+#include <cstring>
+
 //#define PARALLEL_DISABLE
 #ifdef PARALLEL_DISABLE
 #undef USE_PARALLEL_PROCESSING
@@ -53,10 +56,9 @@ source distribution.
 
 #ifdef USE_PARALLEL_PROCESSING
 #include <execution>
-#include <mutex>
 #endif
 
-#ifdef CRO_DEBUG_
+#if defined(CRO_DEBUG_) || defined(BENCHMARK)
 #include <crogine/gui/Gui.hpp>
 #endif
 
@@ -200,11 +202,9 @@ LIGHT_OUT = vec4(vec3(0.0), 1.0);
         }
     )";
 
-    constexpr std::size_t MaxVertData = ParticleEmitter::MaxParticles * (3 + 4 + 3); //pos, colour, rotation/scale vert attribs
-    const std::size_t MaxParticleSystems = 128; //max number of VBOs - must be divisible by min count
-    const std::size_t MinParticleSystems = 4; //min amount before resizing - this many added on resize (so don't make too large!!)
-    const std::size_t VertexSize = 10 * sizeof(float); //pos, colour, rotation/scale vert attribs
-
+    constexpr std::size_t VertexComponents = 3 + 4 + 3; //pos, colour, rotation/scale vert attribs
+    constexpr std::size_t VertexSize = VertexComponents * sizeof(float);
+    constexpr std::size_t MinStreamEmitters = 4; //initial size of the stream buffer, in full emitters
 
     bool inFrustum(const Frustum& frustum, const ParticleEmitter& emitter)
     {
@@ -222,23 +222,9 @@ LIGHT_OUT = vec4(vec3(0.0), 1.0);
 ParticleSystem::ParticleSystem(MessageBus& mb)
     : System            (mb, typeid(ParticleSystem)),
     m_drawLists         (1),
-    m_dataBuffer        (MaxVertData),
-    m_vboIDs            (MaxParticleSystems),
-    m_vaoIDs            (MaxParticleSystems),
-    m_nextBuffer        (0),
-    m_bufferCount       (0)
+    m_frameID           (0),
+    m_bytesUploaded     (0)
 {
-    for (auto& vbo : m_vboIDs)
-    {
-        vbo = 0;
-    }
-
-    //required for core profile on desktop
-    for (auto& vao : m_vaoIDs)
-    {
-        vao = 0;
-    }
-
     requireComponent<Transform>();
     requireComponent<ParticleEmitter>();
 
@@ -303,12 +289,9 @@ ParticleSystem::ParticleSystem(MessageBus& mb)
     img.create(2, 2, cro::Colour::White);
     m_fallbackTexture.loadFromImage(img);
 
-    //allocate some buffers up front to we don't stall
+    //allocate some space up front so we don't stall
     //the first time we load a particle emitter
-    for (auto i = 0u; i < MinParticleSystems; ++i)
-    {
-        allocateBuffer();
-    }
+    createStreamBuffer(ParticleEmitter::MaxParticles * MinStreamEmitters);
 
     m_randomColours[0] = cro::Colour::Red;
     m_randomColours[1] = cro::Colour::Green;
@@ -340,29 +323,39 @@ ParticleSystem::ParticleSystem(MessageBus& mb)
             {
                 ImGui::Text("Visible particle systems to Camera %lu: %lu", i, m_drawLists[i].size());
             }        
+            ImGui::Text("Particle data uploaded: %3.2f KiB", static_cast<float>(m_bytesUploaded) / 1024.f);
         });
 #endif
-}
 
-ParticleSystem::~ParticleSystem()
-{
-    //delete VBOs
-    for (auto vbo : m_vboIDs)
-    {
-        if (vbo)
+#ifdef BENCHMARK
+    registerWindow([&]()
         {
-            glCheck(glDeleteBuffers(1, &vbo));
-        }
-    }
-#ifdef PLATFORM_DESKTOP
-    for (auto vao : m_vaoIDs)
-    {
-        glCheck(glDeleteVertexArrays(1, &vao));
-    }
+            const std::string title = "Particle Update Time, Scene: " + std::to_string(getScene()->getInstanceID()) + " " + getScene()->getTitle();
 
+            if (ImGui::Begin(title.c_str()))
+            {
+                if ((m_benchIndex % 10) == 0)
+                {
+                    m_avgUpdateTime = 0.f;
+                    for (auto f : m_benchSamples)
+                    {
+                        m_avgUpdateTime += f;
+                    }
+                    m_avgUpdateTime /= MaxBenchSamples;
+                    m_avgUpdateTime *= 1000.f;
+                }
+                ImGui::Text("Avg update time for %lu emitters: %3.3f ms", getEntities().size(), m_avgUpdateTime);
+            }
+            ImGui::End();
+        });
 #endif
 }
 
+ParticleSystem::~ParticleSystem()
+{
+    deleteStreamBuffer();
+}
+
 //public
 void ParticleSystem::updateDrawList(Entity cameraEnt)
 {   
@@ -383,15 +376,8 @@ void ParticleSystem::updateDrawList(Entity cameraEnt)
     }
 
     const auto& entities = getEntities();
-
-#ifdef USE_PARALLEL_PROCESSING
-    std::mutex mutex;
-
-    for_each(std::execution::par, entities.cbegin(), entities.cend(), 
-        [&](Entity entity)
-#else
-    for (auto entity : entities)
-#endif
+    m_culler.cull(entities.cbegin(), entities.cend(), passCount,
+        [&](Entity entity, std::vector<Entity>* visibleLists)
         {
             auto& emitter = entity.getComponent<ParticleEmitter>();
             //emitter.m_culledLastFrame = false;
@@ -410,19 +396,10 @@ void ParticleSystem::updateDrawList(Entity cameraEnt)
 
                 if (glm::dot(forwardVec, emitterDirection) > 0)
                 {
-                    /*if (!emitter.m_pendingUpdate)
-                    {
-                        emitter.m_pendingUpdate = true;
-                        m_potentiallyVisible.push_back(entity);
-                    }*/
-
                     const auto& frustum = cam.getPass(i).getFrustum();
                     if (emitter.m_nextFreeParticle > 0 && inFrustum(frustum, emitter))
                     {
-#ifdef USE_PARALLEL_PROCESSING
-                        std::scoped_lock l(mutex);
-#endif
-                        drawlist[i].push_back(entity);
+                        visibleLists[i].push_back(entity);
 #ifdef CRO_DEBUG_
                         emitter.m_culledLastFrame = false;
                     }
@@ -435,10 +412,12 @@ void ParticleSystem::updateDrawList(Entity cameraEnt)
 #endif
                 }
             }
-        }
-#ifdef USE_PARALLEL_PROCESSING
-    );
-#endif
+        });
+
+    for (auto i = 0; i < passCount; ++i)
+    {
+        m_culler.gather(i, drawlist[i]);
+    }
 }
 
 void ParticleSystem::process(float dt)
@@ -448,16 +427,37 @@ void ParticleSystem::process(float dt)
         handle.boundThisFrame = false;
     }*/
 
-    const auto& entities = getEntities();
+#ifdef BENCHMARK
+    m_timer.restart();
+#endif
+
+    //mark any emitters which will be drawn so that
+    //only their vertex data is packed and uploaded
+    m_frameID++;
+    for (const auto& drawList : m_drawLists)
+    {
+        for (const auto& list : drawList)
+        {
+            for (auto entity : list)
+            {
+                if (!entity.destroyed())
+                {
+                    entity.getComponent<ParticleEmitter>().m_visibleFrame = m_frameID;
+                }
+            }
+        }
+    }
+
+    const auto view = getScene()->view<ParticleEmitter, Transform>();
     const auto fallbackTextureID = m_fallbackTexture.getGLHandle();
 #ifdef USE_PARALLEL_PROCESSING
-    std::for_each(std::execution::par, entities.begin(), entities.end(), [&, dt, fallbackTextureID](Entity e)
+    std::for_each(std::execution::par, view.begin(), view.end(), [&, dt, fallbackTextureID](auto item)
 #else
-    for (auto e : entities/*m_potentiallyVisible*/)
+    for (auto item : view)
 #endif
     {
         //check each emitter to see if it should spawn a new particle
-        auto& emitter = e.getComponent<ParticleEmitter>();
+        auto& [e, emitter, tx] = item;
 
         emitter.m_prevTimestamp = emitter.m_currentTimestamp;
         emitter.m_currentTimestamp += dt;
@@ -467,7 +467,6 @@ void ParticleSystem::process(float dt)
         if (/*emitter.m_pendingUpdate &&*/
             emitter.m_running)
         {
-            const auto& tx = e.getComponent<Transform>();
             const glm::quat rotation = glm::quat_cast(tx.getLocalTransform());
             const auto worldPos = tx.getWorldPosition();
             const auto worldScale = tx.getWorldScale();
@@ -475,6 +474,9 @@ void ParticleSystem::process(float dt)
 
             emitter.m_emissionTime += dt;
 
+            //this is thread local so we only need to fetch it once
+            auto& rng = Util::Random::getGenerator();
+
             while (emitter.m_emissionTime > rate)
             {
                 //make sure not to update this again unless it gets marked as visible next frame
@@ -498,6 +500,12 @@ void ParticleSystem::process(float dt)
 
                 static const float epsilon = 0.0001f;
                 auto emitCount = emitter.settings.emitCount;
+
+                //generate the spawn radius offsets for the whole burst at once
+                thread_local std::vector<glm::vec3> radiusOffsets;
+                radiusOffsets.resize(emitCount);
+                rng.fill(radiusOffsets.data(), emitCount, -emitter.settings.spawnRadius, emitter.settings.spawnRadius + epsilon);
+
                 while (emitCount--)
                 {
                     if (emitter.m_nextFreeParticle < emitter.m_particles.size() - 1)
@@ -506,34 +514,32 @@ void ParticleSystem::process(float dt)
                         const auto& settings = emitter.settings;
                         CRO_ASSERT(settings.emitRate > 0, "Emit rate must be grater than 0");
                         CRO_ASSERT(settings.lifetime > 0, "Lifetime must be greater than 0");
-                        auto& p = emitter.m_particles[emitter.m_nextFreeParticle];
-                        p.colour = settings.useRandomColour ? m_randomColours[Util::Random::value(0u, MaxRandomColours - 1)] : settings.colour;
+                        Particle p;
+                        p.colour = settings.useRandomColour ? m_randomColours[rng.value(0u, MaxRandomColours - 1)] : settings.colour;
                         p.gravity = settings.gravity;
-                        p.lifetime = settings.lifetime + cro::Util::Random::value(-settings.lifetimeVariance, settings.lifetimeVariance + epsilon);
+                        p.lifetime = settings.lifetime + rng.value(-settings.lifetimeVariance, settings.lifetimeVariance + epsilon);
                         //p.lifetime -= (emitter.m_currentTimestamp - emitter.m_emissionTimestamp);
                         p.maxLifeTime = p.lifetime;
                         //p.lifetime *= 1.f - t;
 
-                        auto randRot = glm::rotate(rotation, Util::Random::value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::X_AXIS);
-                        randRot = glm::rotate(randRot, Util::Random::value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::Z_AXIS);
+                        auto randRot = glm::rotate(rotation, rng.value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::X_AXIS);
+                        randRot = glm::rotate(randRot, rng.value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::Z_AXIS);
 
 
                         p.velocity = randRot * settings.initialVelocity;
-                        p.rotation = (settings.randomInitialRotation) ? Util::Random::value(-Util::Const::PI, Util::Const::PI) : 0.f;
+                        p.rotation = (settings.randomInitialRotation) ? rng.value(-Util::Const::PI, Util::Const::PI) : 0.f;
                         p.scale = EmitterScale;
                         p.acceleration = settings.acceleration;
-                        p.frameID = (settings.useRandomFrame && settings.frameCount > 1) ? cro::Util::Random::value(0, static_cast<std::int32_t>(settings.frameCount) - 1) : 0;
+                        p.frameID = (settings.useRandomFrame && settings.frameCount > 1) ? rng.value(0, static_cast<std::int32_t>(settings.frameCount) - 1) : 0;
                         p.frameTime = 0.f;
                         p.loopCount = settings.loopCount;
 
                         //spawn particle in world position
                         //auto basePosition = worldPos + interpolation;// tx.getWorldPosition();
-                        p.position = basePosition + (settings.initialVelocity * cro::Util::Random::value(0.001f, 0.007f) * EmitterScale);
+                        p.position = basePosition + (settings.initialVelocity * rng.value(0.001f, 0.007f) * EmitterScale);
 
-                        //add random radius placement - TODO how to do with a position table? CAN'T HAVE +- 0!!
-                        p.position.x += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon) * EmitterScale;
-                        p.position.y += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon) * EmitterScale;
-                        p.position.z += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon) * EmitterScale;
+                        //add random radius placement
+                        p.position += radiusOffsets[emitCount] * EmitterScale;
 
                         if (emitter.settings.inheritRotation)
                         {
@@ -547,6 +553,7 @@ void ParticleSystem::process(float dt)
                         offset *= worldScale;
                         p.position += offset;
 
+                        emitter.m_particles.set(emitter.m_nextFreeParticle, p);
                         emitter.m_nextFreeParticle++;
                         if (emitter.m_releaseCount > 0)
                         {
@@ -563,113 +570,129 @@ void ParticleSystem::process(float dt)
         }
 
         //update each particle
-        glm::vec3 minBounds(std::numeric_limits<float>::max());
-        glm::vec3 maxBounds(0.f);
+        const auto& settings = emitter.settings;
 
-        float framerate = 1.f / emitter.settings.framerate;
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        Detail::ParticleSimulationParams params;
+        params.velocityOffset = settings.gravity;
+        for (auto f : settings.forces)
         {
-            auto& p = emitter.m_particles[i];
+            params.velocityOffset += f;
+        }
+        params.velocityOffset *= dt;
+        params.acceleration = settings.acceleration;
+        params.dt = dt;
+        params.rotation = settings.rotationSpeed * dt;
+        params.scale = 1.f + (settings.scaleModifier * dt);
 
-            p.velocity *= p.acceleration;
-            p.velocity += p.gravity * dt;
-            for (auto f : emitter.settings.forces)
-            {
-                p.velocity += f * dt;
-            }
-            p.position += p.velocity * dt;
+        glm::vec3 minBounds(std::numeric_limits<float>::max());
+        glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
 
-            p.lifetime -= dt;
-            p.colour.setAlpha(std::min(1.f, std::max(p.lifetime / p.maxLifeTime, 0.f)));
+        auto& particles = emitter.m_particles;
+        const bool expired = Detail::simulateParticles(particles, emitter.m_nextFreeParticle, params, minBounds, maxBounds);
 
-            p.rotation += emitter.settings.rotationSpeed * dt;
-            p.scale += ((p.scale * emitter.settings.scaleModifier) * dt);
+        if (emitter.m_nextFreeParticle)
+        {
+            auto dist = (maxBounds - minBounds) / 2.f;
+            emitter.m_bounds.centre = dist + minBounds;
+            emitter.m_bounds.radius = glm::length(dist);
+        }
 
-            if (emitter.settings.animate)
+        if (settings.animate)
+        {
+            const float framerate = 1.f / settings.framerate;
+            for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
             {
-                p.frameTime += dt;
-                if (p.frameTime > framerate)
+                particles.frameTime[i] += dt;
+                if (particles.frameTime[i] > framerate)
                 {
-                    p.frameID++;
-                    if (p.frameID == emitter.settings.frameCount
-                        && p.loopCount)
+                    particles.frameID[i]++;
+                    if (particles.frameID[i] == settings.frameCount
+                        && particles.loopCount[i])
                     {
-                        p.loopCount--;
-                        p.frameID = 0;
+                        particles.loopCount[i]--;
+                        particles.frameID[i] = 0;
                     }
-                    p.frameTime -= framerate;
+                    particles.frameTime[i] -= framerate;
                 }
             }
-
-            //update bounds for culling
-            if (p.position.x < minBounds.x) minBounds.x = p.position.x;
-            if (p.position.y < minBounds.y) minBounds.y = p.position.y;
-            if (p.position.z < minBounds.z) minBounds.z = p.position.z;
-
-            if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
-            if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
-            if (p.position.z > maxBounds.z) maxBounds.z = p.position.z;
         }
-        auto dist = (maxBounds - minBounds) / 2.f;
-        emitter.m_bounds.centre = dist + minBounds;
-        emitter.m_bounds.radius = glm::length(dist);
 
-        //go over again and remove dead particles with pop/swap
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        //remove dead particles by moving the last particle into their place.
+        //frames only advance when animated, so we can skip this entirely
+        //if no lifetimes expired
+        if (expired || settings.animate)
         {
-            if (emitter.m_particles[i].lifetime < 0
-                || ((emitter.m_particles[i].frameID == emitter.settings.frameCount)
-                    && (emitter.m_particles[i].loopCount == 0)))
+            std::size_t i = 0;
+            while (i < emitter.m_nextFreeParticle)
             {
-                emitter.m_nextFreeParticle--;
-                std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);
+                if (particles.lifetime[i] < 0
+                    || ((particles.frameID[i] == settings.frameCount)
+                        && (particles.loopCount[i] == 0)))
+                {
+                    emitter.m_nextFreeParticle--;
+                    particles.copy(i, emitter.m_nextFreeParticle);
+                }
+                else
+                {
+                    i++;
+                }
             }
         }
         //DPRINT("Next free Particle", std::to_string(emitter.m_nextFreeParticle));
 
         //TODO sort verts by depth? should be drawing back to front for transparency really.
 
-        emitter.m_previousPosition = e.getComponent<cro::Transform>().getWorldPosition();
-
-#ifdef USE_PARALLEL_PROCESSING
-    });
-
+        emitter.m_previousPosition = tx.getWorldPosition();
 
-    //this still has to be done in the main thread cos OpenGL
-    for(auto e : entities)
-    {
-        auto& emitter = e.getComponent<ParticleEmitter>();
-#endif
-
-        //update VBO
-        std::size_t idx = 0;
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        //pack the vertex data here so only the upload is left for the main thread
+        if (emitter.m_visibleFrame == m_frameID)
         {
-            const auto& p = emitter.m_particles[i];
+            //only sized to the live particles, rather than MaxParticles, so
+            //small emitters don't each hold the worst case in memory
+            const auto& p = emitter.m_particles;
+            emitter.m_vertexData.resize(emitter.m_nextFreeParticle * VertexComponents);
 
-            //position
-            m_dataBuffer[idx++] = p.position.x;
-            m_dataBuffer[idx++] = p.position.y;
-            m_dataBuffer[idx++] = p.position.z;
-
-            //colour
-            m_dataBuffer[idx++] = p.colour.getRed();
-            m_dataBuffer[idx++] = p.colour.getGreen();
-            m_dataBuffer[idx++] = p.colour.getBlue();
-            m_dataBuffer[idx++] = p.colour.getAlpha();
-
-            //rotation/size/animation
-            m_dataBuffer[idx++] = p.rotation * Util::Const::degToRad;
-            m_dataBuffer[idx++] = p.scale;
-            m_dataBuffer[idx++] = static_cast<float>(p.frameID);
+            std::size_t idx = 0;
+            for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+            {
+                //position
+                emitter.m_vertexData[idx++] = p.positionX[i];
+                emitter.m_vertexData[idx++] = p.positionY[i];
+                emitter.m_vertexData[idx++] = p.positionZ[i];
+
+                //colour
+                emitter.m_vertexData[idx++] = p.colour[i].getRed();
+                emitter.m_vertexData[idx++] = p.colour[i].getGreen();
+                emitter.m_vertexData[idx++] = p.colour[i].getBlue();
+                emitter.m_vertexData[idx++] = p.alpha[i];
+
+                //rotation/size/animation
+                emitter.m_vertexData[idx++] = p.rotation[i] * Util::Const::degToRad;
+                emitter.m_vertexData[idx++] = p.scale[i];
+                emitter.m_vertexData[idx++] = static_cast<float>(p.frameID[i]);
+            }
+            emitter.m_vertexCount = emitter.m_nextFreeParticle;
+        }
+        else if (!emitter.m_running
+            && emitter.m_nextFreeParticle == 0
+            && emitter.m_vertexData.capacity() != 0)
+        {
+            //finished emitting so release the storage until it restarts
+            std::vector<float>().swap(emitter.m_vertexData);
+            emitter.m_vertexCount = 0;
         }
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
-        glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, idx * sizeof(float), m_dataBuffer.data()));
     }
+#ifdef USE_PARALLEL_PROCESSING
+    );
+#endif
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    //this still has to be done in the main thread cos OpenGL
+    uploadVertexData();
 
-    //m_potentiallyVisible.clear();
+#ifdef BENCHMARK
+    m_benchSamples[m_benchIndex] = m_timer.restart();
+    m_benchIndex = (m_benchIndex + 1) % MaxBenchSamples;
+#endif
 }
 
 void ParticleSystem::render(Entity camera, const RenderTarget& rt)
@@ -721,7 +744,20 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
         };
         glCheck(glActiveTexture(GL_TEXTURE0));
 
+#ifdef PLATFORM_DESKTOP
+        glCheck(glBindVertexArray(m_streamBuffer.vao));
+#else
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_streamBuffer.vbo));
 
+        //bind vertex attribs
+        for (auto [index, attribSize, offset] : m_shaderHandles[0].attribData)
+        {
+            glCheck(glEnableVertexAttribArray(index));
+            glCheck(glVertexAttribPointer(index, attribSize,
+                GL_FLOAT, GL_FALSE, VertexSize,
+                reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
+        }
+#endif //PLATFORM
 
         const auto& entities = m_drawLists[cam.getDrawListIndex()][cam.getActivePassIndex()];
         for (auto entity : entities)
@@ -734,6 +770,15 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
             }
 
             const auto& emitter = entity.getComponent<ParticleEmitter>();
+
+            //if the draw list was updated after this frame's upload
+            //the emitter won't have any valid vertex data until the next frame
+            if (emitter.m_uploadFrame != m_frameID
+                || emitter.m_vertexCount == 0)
+            {
+                continue;
+            }
+
             const auto wScale = entity.getComponent<cro::Transform>().getWorldScale();
             const auto sizeScale = (wScale.x + wScale.y) / 2.f;
 
@@ -760,36 +805,17 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
             glCheck(glBindTexture(GL_TEXTURE_2D, emitter.settings.textureID));
 
 
-#ifdef PLATFORM_DESKTOP
-            glCheck(glBindVertexArray(emitter.m_vao));
-            glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
-#else
-            //bind emitter vbo
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
-
-            //bind vertex attribs
-            for (auto [index, attribSize, offset] : m_shaderHandles[0].attribData)
-            {
-                glCheck(glEnableVertexAttribArray(index));
-                glCheck(glVertexAttribPointer(index, attribSize,
-                    GL_FLOAT, GL_FALSE, VertexSize,
-                    reinterpret_cast<void*>(static_cast<intptr_t>(offset))));
-            }
-
-            //draw
-            glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
-
-            //unbind attribs
-            for (auto j = 0u; j < m_shaderHandles[0].attribData.size(); ++j)
-            {
-                glCheck(glDisableVertexAttribArray(m_shaderHandles[0].attribData[j].index));
-            }
-#endif //PLATFORM
+            glCheck(glDrawArrays(GL_POINTS, static_cast<GLint>(emitter.m_vertexOffset), static_cast<GLsizei>(emitter.m_vertexCount)));
         }
 
 #ifdef PLATFORM_DESKTOP
         glCheck(glBindVertexArray(0));
 #else
+        //unbind attribs
+        for (auto j = 0u; j < m_shaderHandles[0].attribData.size(); ++j)
+        {
+            glCheck(glDisableVertexAttribArray(m_shaderHandles[0].attribData[j].index));
+        }
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 #endif //PLATFORM
 
@@ -810,42 +836,12 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
 //private
 void ParticleSystem::onEntityAdded(Entity entity)
 {    
-    //check VBO count and increase if needed
-    if (m_nextBuffer == m_bufferCount)
-    {
-        for (auto i = 0u; i < MinParticleSystems; ++i)
-        {
-            allocateBuffer();
-        }
-    }
-
     auto pos = entity.getComponent<cro::Transform>().getWorldPosition();
     entity.getComponent<cro::ParticleEmitter>().m_previousPosition = pos;
-
-    entity.getComponent<ParticleEmitter>().m_vbo = m_vboIDs[m_nextBuffer];
-    entity.getComponent<ParticleEmitter>().m_vao = m_vaoIDs[m_nextBuffer];
-    m_nextBuffer++;
 }
 
 void ParticleSystem::onEntityRemoved(Entity entity)
 {
-    auto vboID = entity.getComponent<ParticleEmitter>().m_vbo;
-    auto vaoID = entity.getComponent<ParticleEmitter>().m_vao;
-    
-    //update available VBOs
-    std::size_t idx = 0;
-    while (m_vboIDs[idx] != vboID) { idx++; }
-
-    std::swap(m_vboIDs[idx], m_vboIDs[m_nextBuffer]);
-
-    //and vaos
-    idx = 0;
-    while (m_vaoIDs[idx] != vaoID) { idx++; }
-
-    std::swap(m_vaoIDs[idx], m_vaoIDs[m_nextBuffer]);
-
-    m_nextBuffer--;
-
     //flush entity from draw lists
     flushEntity(entity);
 }
@@ -872,18 +868,49 @@ void ParticleSystem::flushEntity(Entity e)
     }
 }
 
-void ParticleSystem::allocateBuffer()
+void ParticleSystem::createStreamBuffer(std::size_t vertexCount)
 {
-    CRO_ASSERT(m_bufferCount < m_vboIDs.size(), "Max Buffers Reached!");
-    glCheck(glGenBuffers(1, &m_vboIDs[m_bufferCount]));
+    deleteStreamBuffer();
+
+    m_streamBuffer.capacity = vertexCount;
+    m_streamBuffer.head = 0;
+    m_streamBuffer.segment = 0;
+
+    glCheck(glGenBuffers(1, &m_streamBuffer.vbo));
 
 #ifdef PLATFORM_DESKTOP
-    glCheck(glGenVertexArrays(1, &m_vaoIDs[m_bufferCount]));
-    glCheck(glBindVertexArray(m_vaoIDs[m_bufferCount]));
+    glCheck(glGenVertexArrays(1, &m_streamBuffer.vao));
+    glCheck(glBindVertexArray(m_streamBuffer.vao));
 #endif //PLATFORM
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vboIDs[m_bufferCount]));
-    glCheck(glBufferData(GL_ARRAY_BUFFER, MaxVertData * sizeof(float), nullptr, GL_DYNAMIC_DRAW));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_streamBuffer.vbo));
+
+#if defined(PLATFORM_DESKTOP) && !defined(GL41)
+    m_streamBuffer.persistent = GLAD_GL_VERSION_4_4 != 0;
+    if (m_streamBuffer.persistent)
+    {
+        const auto size = static_cast<GLsizeiptr>(vertexCount * VertexSize * StreamBuffer::SegmentCount);
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCheck(glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags));
+        glCheck(m_streamBuffer.mappedData = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+
+        if (!m_streamBuffer.mappedData)
+        {
+            LogW << "Failed to map particle vertex buffer, falling back to orphaning" << std::endl;
+
+            //storage is immutable so we need a new buffer
+            glCheck(glDeleteBuffers(1, &m_streamBuffer.vbo));
+            glCheck(glGenBuffers(1, &m_streamBuffer.vbo));
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_streamBuffer.vbo));
+            m_streamBuffer.persistent = false;
+        }
+    }
+
+    if (!m_streamBuffer.persistent)
+#endif
+    {
+        glCheck(glBufferData(GL_ARRAY_BUFFER, vertexCount * VertexSize, nullptr, GL_STREAM_DRAW));
+    }
 
 #ifdef PLATFORM_DESKTOP
     //HMMMMMMM this only works because all the shaders use the same vertex shader
@@ -899,8 +926,153 @@ void ParticleSystem::allocateBuffer()
 #endif //PLATFORM
 
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
+void ParticleSystem::deleteStreamBuffer()
+{
+#if defined(PLATFORM_DESKTOP) && !defined(GL41)
+    for (auto& fence : m_streamBuffer.fences)
+    {
+        if (fence)
+        {
+            auto sync = static_cast<GLsync>(fence);
+            glCheck(glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max()));
+            glCheck(glDeleteSync(sync));
+            fence = nullptr;
+        }
+    }
 
-    m_bufferCount++;
+    if (m_streamBuffer.mappedData)
+    {
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_streamBuffer.vbo));
+        glCheck(glUnmapBuffer(GL_ARRAY_BUFFER));
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        m_streamBuffer.mappedData = nullptr;
+    }
+#endif
+
+    if (m_streamBuffer.vbo)
+    {
+        glCheck(glDeleteBuffers(1, &m_streamBuffer.vbo));
+        m_streamBuffer.vbo = 0;
+    }
+
+#ifdef PLATFORM_DESKTOP
+    if (m_streamBuffer.vao)
+    {
+        glCheck(glDeleteVertexArrays(1, &m_streamBuffer.vao));
+        m_streamBuffer.vao = 0;
+    }
+#endif
+}
+
+void ParticleSystem::uploadVertexData()
+{
+    m_uploadList.clear();
+    std::size_t vertexCount = 0;
+    for (auto entity : getEntities())
+    {
+        auto& emitter = entity.getComponent<ParticleEmitter>();
+        if (emitter.m_visibleFrame == m_frameID
+            && emitter.m_vertexCount != 0)
+        {
+            m_uploadList.push_back(&emitter);
+            vertexCount += emitter.m_vertexCount;
+        }
+    }
+
+    m_bytesUploaded = vertexCount * VertexSize;
+    if (vertexCount == 0)
+    {
+        return;
+    }
+
+#if defined(PLATFORM_DESKTOP) && !defined(GL41)
+    if (m_streamBuffer.persistent)
+    {
+        //fence the segment written last frame as it'll have been drawn by now
+        auto& lastFence = m_streamBuffer.fences[m_streamBuffer.segment];
+        CRO_ASSERT(lastFence == nullptr, "");
+        glCheck(lastFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        
+        m_streamBuffer.segment = (m_streamBuffer.segment + 1) % StreamBuffer::SegmentCount;
+    }
+#endif
+
+    if (vertexCount > m_streamBuffer.capacity)
+    {
+        createStreamBuffer(std::max(vertexCount, m_streamBuffer.capacity * 2));
+    }
+
+    std::size_t firstVertex = 0;
+    float* dst = nullptr;
+
+#if defined(PLATFORM_DESKTOP) && !defined(GL41)
+    if (m_streamBuffer.persistent)
+    {
+        //make sure the GPU has finished reading this segment
+        auto& fence = m_streamBuffer.fences[m_streamBuffer.segment];
+        if (fence)
+        {
+            auto sync = static_cast<GLsync>(fence);
+            glCheck(glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max()));
+            glCheck(glDeleteSync(sync));
+            fence = nullptr;
+        }
+
+        firstVertex = m_streamBuffer.segment * m_streamBuffer.capacity;
+        dst = static_cast<float*>(m_streamBuffer.mappedData) + (firstVertex * VertexComponents);
+    }
+    else
+#endif
+    {
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_streamBuffer.vbo));
+
+        //orphan the current storage rather than wait for the GPU to finish with it
+        if (m_streamBuffer.head + vertexCount > m_streamBuffer.capacity)
+        {
+            glCheck(glBufferData(GL_ARRAY_BUFFER, m_streamBuffer.capacity * VertexSize, nullptr, GL_STREAM_DRAW));
+            m_streamBuffer.head = 0;
+        }
+        firstVertex = m_streamBuffer.head;
+        m_streamBuffer.head += vertexCount;
+
+#ifdef PLATFORM_DESKTOP
+        //this range has not been used since the buffer was orphaned so it's safe not to synchronise
+        glCheck(dst = static_cast<float*>(glMapBufferRange(GL_ARRAY_BUFFER, firstVertex * VertexSize, vertexCount * VertexSize,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT)));
+#endif
+    }
+
+    auto vertexOffset = firstVertex;
+    for (auto* emitter : m_uploadList)
+    {
+        const auto size = emitter->m_vertexCount * VertexSize;
+        if (dst)
+        {
+            std::memcpy(dst, emitter->m_vertexData.data(), size);
+            dst += emitter->m_vertexCount * VertexComponents;
+        }
+        else
+        {
+            glCheck(glBufferSubData(GL_ARRAY_BUFFER, vertexOffset * VertexSize, size, emitter->m_vertexData.data()));
+        }
+
+        emitter->m_vertexOffset = vertexOffset;
+        emitter->m_uploadFrame = m_frameID;
+        vertexOffset += emitter->m_vertexCount;
+    }
+
+    if (!m_streamBuffer.persistent)
+    {
+#ifdef PLATFORM_DESKTOP
+        if (dst)
+        {
+            glCheck(glUnmapBuffer(GL_ARRAY_BUFFER));
+        }
+#endif
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    }
 }
 
 #ifdef PARALLEL_DISABLE
@@ -46,6 +46,7 @@ source distribution.
 #include "../../detail/GLCheck.hpp"
 #include "../../graphics/shaders/Sprite.hpp"
 
+#include <algorithm>
 #include <string>
 
 //#define PARALLEL_DISABLE
@@ -54,7 +55,6 @@ source distribution.
 #endif
 
 #ifdef USE_PARALLEL_PROCESSING
-#include <mutex>
 #include <execution>
 #endif
 
@@ -80,6 +80,10 @@ RenderSystem2D::RenderSystem2D(MessageBus& mb)
     requireComponent<Drawable2D>();
     requireComponent<Transform>();
 
+    //the entity list is kept sorted by draw order
+    //so removing entities mustn't reorder it
+    setOrderedRemoval(true);
+
     //load default shaders
     m_colouredShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Sprite::Fragment);
     m_texturedShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Sprite::Fragment, "#define TEXTURED\n");
@@ -121,22 +125,34 @@ void RenderSystem2D::updateDrawList(Entity camEnt)
     const auto viewRect = camEnt.getComponent<cro::Transform>().getWorldTransform() * camera.getViewSize();
     const auto renderFlags = camera.getPass(Camera::Pass::Final).renderFlags;
 
-    const auto& entities = getEntities();
+    auto& entities = getEntities();
 
+    if (m_needsSort)
+    {
+        //sort the entity list itself rather than the draw list. It then stays
+        //sorted until a drawable moves or the list changes, and gathering the
+        //culled entities in input order is enough on subsequent frames
+        const auto sortFunc = [](Entity a, Entity b)
+        {
+            return a.getComponent<Drawable2D>().m_sortCriteria < b.getComponent<Drawable2D>().m_sortCriteria;
+        };
 #ifdef USE_PARALLEL_PROCESSING
-    std::mutex mutex;
-    std::for_each(std::execution::par, entities.cbegin(), entities.cend(), 
-        [&](Entity entity)
+        std::stable_sort(std::execution::par, entities.begin(), entities.end(), sortFunc);
 #else
-    for (auto entity : entities)
+        std::stable_sort(entities.begin(), entities.end(), sortFunc);
 #endif
+        m_needsSort = false;
+    }
+
+    m_culler.cull(entities.cbegin(), entities.cend(), 1,
+        [&](Entity entity, std::vector<Entity>* visibleList)
         {
             auto& drawable = entity.getComponent<Drawable2D>();
             drawable.m_wasCulledLastFrame = true;
 
             if ((renderFlags & drawable.m_renderFlags) == 0)
             {
-                EARLY_OUT;
+                return;
             }
 
             if (drawable.m_autoCrop)
@@ -151,38 +167,18 @@ void RenderSystem2D::updateDrawList(Entity camEnt)
                     if (bounds.intersects(viewRect))
                     {
                         drawable.m_wasCulledLastFrame = false;
-#ifdef USE_PARALLEL_PROCESSING
-                        std::scoped_lock l(mutex);
-#endif
-                        drawlist.push_back(entity);
+                        visibleList->push_back(entity);
                     }
                 }
             }
             else
             {
                 drawable.m_wasCulledLastFrame = false;
-#ifdef USE_PARALLEL_PROCESSING
-                std::scoped_lock l(mutex);
-#endif
-                drawlist.push_back(entity);
+                visibleList->push_back(entity);
             }
-        }
-#ifdef USE_PARALLEL_PROCESSING
-    );
-#endif
+        });
 
-    if (m_needsSort)
-    {
-#ifdef USE_PARALLEL_PROCESSING
-        std::sort(std::execution::par, drawlist.begin(), drawlist.end(),
-#else
-        std::sort(drawlist.begin(), drawlist.end(),
-#endif
-            [](Entity a, Entity b)
-            {
-                return a.getComponent<Drawable2D>().m_sortCriteria < b.getComponent<Drawable2D>().m_sortCriteria;
-            });
-    }
+    m_culler.gather(0, drawlist);
 }
 
 void RenderSystem2D::process(float)
@@ -225,15 +221,24 @@ void RenderSystem2D::process(float)
 
         //set sort criteria based on position
         //faster to do a sort on int than float
+        std::int32_t sortCriteria = 0;
         if (m_sortOrder == DepthAxis::Y)
         {
             //multiplying by 100 preserves two places of precision
             //which is enough to sort on
-            drawable.m_sortCriteria = static_cast<std::int32_t>(-(pos.y - origin.y) * 100.f);
+            sortCriteria = static_cast<std::int32_t>(-(pos.y - origin.y) * 100.f);
         }
         else
         {
-            drawable.m_sortCriteria = static_cast<std::int32_t>((pos.z - origin.z) * 100.f);
+            sortCriteria = static_cast<std::int32_t>((pos.z - origin.z) * 100.f);
+        }
+
+        //the world position may also change via a parent
+        //so this catches moves the transform callback doesn't
+        if (sortCriteria != drawable.m_sortCriteria)
+        {
+            drawable.m_sortCriteria = sortCriteria;
+            m_needsSort = true;
         }
 
         //check if the cropping area is smaller than
@@ -41,6 +41,7 @@ source distribution.
 #include <crogine/util/Frustum.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/VertexAttribFormat.hpp"
 
 #include <crogine/detail/glm/gtc/type_ptr.hpp>
 #include <crogine/detail/glm/gtc/matrix_transform.hpp>
@@ -54,7 +55,6 @@ source distribution.
 
 #ifdef USE_PARALLEL_PROCESSING
 #include <execution>
-#include <mutex>
 #endif
 
 #ifdef CRO_DEBUG_
@@ -347,7 +347,7 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
 
         //store the results here to use in frustum culling
         std::vector<glm::vec3> lightPositions;
-        std::vector<Box> frustums; //frustae
+        std::vector<Frustum> frustums; //frustae
 #ifdef CRO_DEBUG_
         camera.lightCorners.clear();
 #endif
@@ -406,7 +406,9 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
             camera.m_shadowProjectionMatrices[i] = lightProj;
             camera.m_shadowViewProjectionMatrices[i] = lightProj * lightView;
 
-            frustums.emplace_back(minPos, maxPos);
+            //the planes of the ortho projection are the same as the light space AABB
+            //but in world space, so we can batch test the bounding spheres with them
+            Spatial::updateFrustum(frustums.emplace_back(), camera.m_shadowViewProjectionMatrices[i]);
 #ifdef CRO_DEBUG_
             camera.lightCorners.emplace_back() =
             {
@@ -425,114 +427,94 @@ void ShadowMapRenderer::updateDrawList(Entity camEnt)
 #endif
         }
 
-#ifdef USE_PARALLEL_PROCESSING
-        std::mutex listMutex;
-#endif
         //hmmm how do we make camera immutable from this point on?
 
-        //use depth frusta to cull entities
-        auto& entities = getEntities();
-#ifdef USE_PARALLEL_PROCESSING
-        std::for_each(std::execution::par, entities.cbegin(), entities.cend(),
-            [&](Entity entity)
+#ifdef PLATFORM_DESKTOP
+        const std::size_t listCount = camera.getCascadeCount();
 #else
-        for (auto entity : entities)
+        const std::size_t listCount = 1;
 #endif
+
+        //use depth frusta to cull entities
+        using ShadowCuller = Detail::ParallelCuller<Drawable>;
+        auto& entities = getEntities();
+        m_cullSpheres.resize(entities.size());
+        m_culler.cullChunks(entities.size(), listCount,
+            [&](std::size_t start, std::size_t end, std::vector<Drawable>* visibleLists)
         {
-            if (!entity.getComponent<ShadowCaster>().active)
-            {
-#ifdef USE_PARALLEL_PROCESSING
-                return;
-#else
-                continue;
-#endif
-            }
+            //bit set for each entity in this chunk which can cast a shadow
+            std::array<std::uint64_t, ShadowCuller::ChunkSize / 64> casters = {};
 
-            const auto& model = entity.getComponent<Model>();
-            if (model.isHidden())
+            for (auto i = start; i < end; ++i)
             {
-#ifdef USE_PARALLEL_PROCESSING
-                return;
-#else
-                continue;
-#endif
-            }
+                auto entity = entities[i];
+                if (!entity.getComponent<ShadowCaster>().active)
+                {
+                    continue;
+                }
 
-            if ((model.m_renderFlags & camera.getPass(Camera::Pass::Final).renderFlags) == 0)
-            {
-#ifdef USE_PARALLEL_PROCESSING
-                return;
-#else
-                continue;
-#endif
-            }
+                const auto& model = entity.getComponent<Model>();
+                if (model.isHidden())
+                {
+                    continue;
+                }
 
-            const auto& tx = entity.getComponent<Transform>();
-            auto sphere = model.getBoundingSphere();
+                if ((model.m_renderFlags & camera.getPass(Camera::Pass::Final).renderFlags) == 0)
+                {
+                    continue;
+                }
 
-            sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
-            auto scale = tx.getWorldScale();
+                const auto& tx = entity.getComponent<Transform>();
+                auto sphere = model.getBoundingSphere();
 
-            //if it's approaching zero scale then don't cast shadow
-            /*if (scale.x * scale.y * scale.z < 0.01f)
-            {
-                continue;
-            }*/
+                sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
+                auto scale = tx.getWorldScale();
 
-            sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
+                //if it's approaching zero scale then don't cast shadow
+                /*if (scale.x * scale.y * scale.z < 0.01f)
+                {
+                    continue;
+                }*/
 
-            std::vector<std::pair<std::size_t, std::size_t>> drawListOffsets;
+                sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
+                m_cullSpheres.set(i, sphere);
 
-            for (auto i = 0u; i < camera.getCascadeCount(); ++i)
+                const auto bit = i - start;
+                casters[bit / 64] |= (std::uint64_t(1) << (bit % 64));
+            }
+
+            std::array<std::uint64_t, ShadowCuller::ChunkSize / 64> visibleMask = {};
+            for (auto c = 0u; c < camera.getCascadeCount(); ++c)
             {
-                float distance = glm::dot(-lightDir, sphere.centre - lightPositions[i]);
+                Spatial::cullSpheres(frustums[c], m_cullSpheres, start, end - start, visibleMask.data());
 
-                //put sphere into lightspace and do an AABB test on the ortho projection
-                auto lightSphere = sphere;
-                lightSphere.centre = glm::vec3(camera.m_shadowViewMatrices[i] * glm::vec4(lightSphere.centre, 1.f));
-                
-                if (frustums[i].intersects(lightSphere))
+                for (auto i = start; i < end; ++i)
                 {
+                    const auto bit = i - start;
+                    if ((visibleMask[bit / 64] & casters[bit / 64]) & (std::uint64_t(1) << (bit % 64)))
+                    {
+                        const glm::vec3 centre(m_cullSpheres.x[i], m_cullSpheres.y[i], m_cullSpheres.z[i]);
+                        float distance = glm::dot(-lightDir, centre - lightPositions[c]);
 #ifdef PLATFORM_DESKTOP
-#ifdef USE_PARALLEL_PROCESSING
-                    std::scoped_lock lock(listMutex);
-#endif
-                    drawList[i].emplace_back(entity, distance);
+                        visibleLists[c].emplace_back(entities[i], distance);
 #else
-                    //just place them all in the same draw list
-                    drawList[0].emplace_back(entity, distance);
+                        //just place them all in the same draw list
+                        visibleLists[0].emplace_back(entities[i], distance);
 #endif
+                    }
                 }
             }
-        }
-#ifdef USE_PARALLEL_PROCESSING
-            );
-#endif
+        });
 
         //sort back to front
-#ifdef USE_PARALLEL_PROCESSING
-        std::for_each(std::execution::par, drawList.begin(), drawList.end(),
-            [&](std::vector<ShadowMapRenderer::Drawable>& cascade)
-        {
-#ifdef _WIN32
-                std::sort(std::execution::par, cascade.begin(), cascade.end(),
-#else
-                //gcc complains about no appropriate ctor - not sure why it needs a ctor for parallel sorting??
-                std::sort(cascade.begin(), cascade.end(),
-#endif
-#else
-        for (auto& cascade : drawList)
+        for (auto i = 0u; i < listCount; ++i)
         {
-            std::sort(cascade.begin(), cascade.end(),
-#endif
-                [](const ShadowMapRenderer::Drawable& a, const ShadowMapRenderer::Drawable& b)
+            m_culler.gatherSorted(i, drawList[i],
+                [](const Drawable& a, const Drawable& b)
                 {
                     return a.distance > b.distance;
                 });
         }
-#ifdef USE_PARALLEL_PROCESSING
-            );
-#endif
 
 #ifdef CRO_DEBUG_
         //used for debug drawing of light positions
@@ -622,23 +604,23 @@ void ShadowMapRenderer::render()
 
                     //check material properties for alpha clipping
                     std::uint32_t currentTextureUnit = 0;
-                    for (const auto& prop : mat.properties)
+                    for (const auto& prop : mat.getResolvedProperties())
                     {
-                        switch (prop.second.second.type)
+                        switch (prop.property->type)
                         {
                         default: break;
                         case Material::Property::TextureArray:
                             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-                            glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, prop.second.second.textureID));
-                            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+                            glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, prop.property->textureID));
+                            glCheck(glUniform1i(prop.location, currentTextureUnit++));
                             break;
                         case Material::Property::Texture:
                             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
-                            glCheck(glBindTexture(GL_TEXTURE_2D, prop.second.second.textureID));
-                            glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
+                            glCheck(glBindTexture(GL_TEXTURE_2D, prop.property->textureID));
+                            glCheck(glUniform1i(prop.location, currentTextureUnit++));
                             break;
                         case Material::Property::Number:
-                            glCheck(glUniform1f(prop.second.first, prop.second.second.numberValue));
+                            glCheck(glUniform1f(prop.location, prop.property->numberValue));
                             break;
                         }
                     }
@@ -663,9 +645,10 @@ void ShadowMapRenderer::render()
                     const auto& attribs = mat.attribs;
                     for (auto j = 0u; j < mat.attribCount; ++j)
                     {
+                        const Detail::VertexAttribFormat format(attribs[j][Material::Data::Format], attribs[j][Material::Data::Size]);
                         glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
-                        glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-                            GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
+                        glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], format.size,
+                            format.type, format.normalised, static_cast<GLsizei>(model.m_meshData.vertexSize),
                             reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
                     }
 
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -42,6 +42,8 @@ source distribution.
 
 #include <crogine/detail/glm/gtx/quaternion.hpp>
 
+#include "../../detail/PoseArena.hpp"
+
 //#define PARALLEL_DISABLE
 #ifdef PARALLEL_DISABLE
 #undef USE_PARALLEL_PROCESSING
@@ -51,31 +53,56 @@ source distribution.
 #include <execution>
 #endif
 
+#include <atomic>
+#include <cmath>
+
+
 using namespace cro;
 
 namespace
 {
-    //interp tx and rot separately
-    //TODO convert to 4x3 to free up some uniform space
-    glm::mat4 mixJoint(const Joint& a, const Joint& b, float time, Joint& output)
-    {
-        output.translation = glm::mix(a.translation, b.translation, time);
-        output.rotation = glm::slerp(a.rotation, b.rotation, time);
-        output.scale = glm::mix(a.scale, b.scale, time);
+    float playbackRate = 1.f;
 
-        CRO_ASSERT(a.parent == b.parent, "");
-        output.parent = a.parent; //if a and b's parents differ then something is very wrong
+    thread_local Detail::PoseArena poseArena;
 
-        glm::mat4 result = glm::translate(glm::mat4(1.f), output.translation);
-        result *= glm::toMat4(output.rotation);
-        return glm::scale(result, output.scale);
+    //builds the world transform of each joint from arena.output, writing the final
+    //result to the skeleton's current frame. This is the same as glm::translate() * glm::toMat4() * glm::scale()
+    //but without the matrix multiplications
+    void buildPose(Detail::PoseArena& arena, const Joint* parents, const std::vector<std::uint32_t>& jointOrder,
+        const glm::mat4& rootTransform, const std::vector<glm::mat4>& invBindPose, glm::mat4* output)
+    {
+        for (auto i : jointOrder)
+        {
+            const float x = arena.get(arena.output, Detail::PoseArena::RX)[i];
+            const float y = arena.get(arena.output, Detail::PoseArena::RY)[i];
+            const float z = arena.get(arena.output, Detail::PoseArena::RZ)[i];
+            const float w = arena.get(arena.output, Detail::PoseArena::RW)[i];
+            const float sx = arena.get(arena.output, Detail::PoseArena::SX)[i];
+            const float sy = arena.get(arena.output, Detail::PoseArena::SY)[i];
+            const float sz = arena.get(arena.output, Detail::PoseArena::SZ)[i];
+
+            auto& local = arena.localMatrices[i];
+            local[0] = glm::vec4(1.f - 2.f * (y * y + z * z), 2.f * (x * y + w * z), 2.f * (x * z - w * y), 0.f) * sx;
+            local[1] = glm::vec4(2.f * (x * y - w * z), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + w * x), 0.f) * sy;
+            local[2] = glm::vec4(2.f * (x * z + w * y), 2.f * (y * z - w * x), 1.f - 2.f * (x * x + y * y), 0.f) * sz;
+            local[3] = glm::vec4(arena.get(arena.output, Detail::PoseArena::TX)[i], arena.get(arena.output, Detail::PoseArena::TY)[i], arena.get(arena.output, Detail::PoseArena::TZ)[i], 1.f);
+
+            //parents are always updated first so we can reuse their result
+            const auto parent = parents[i].parent;
+            arena.worldMatrices[i] = parent < 0 ? local : arena.worldMatrices[parent] * local;
+
+            if (output)
+            {
+                output[i] = rootTransform * arena.worldMatrices[i] * invBindPose[i];
+            }
+        }
     }
-
-    float playbackRate = 1.f;
 }
 
 SkeletalAnimator::SkeletalAnimator(MessageBus& mb)
-    : System(mb, typeid(SkeletalAnimator))
+    : System        (mb, typeid(SkeletalAnimator)),
+    m_lodEnabled    (false),
+    m_frameCounter  (0)
 {
     requireComponent<Model>();
     requireComponent<Skeleton>();
@@ -89,6 +116,12 @@ void SkeletalAnimator::process(float dt)
     const auto camPos = getScene()->getActiveCamera().getComponent<cro::Transform>().getWorldPosition();
     const auto camDir = cro::Util::Matrix::getForwardVector(getScene()->getActiveCamera().getComponent<cro::Transform>().getWorldTransform());
 
+    //used to estimate the projected size of a model when picking LOD levels
+    const auto& camera = getScene()->getActiveCamera().getComponent<cro::Camera>();
+    const float viewHeight = camera.isOrthographic() ? camera.getViewSize().height : 2.f * std::tan(camera.getFOV() / 2.f);
+
+    std::atomic<std::uint32_t> evaluatedCount = 0;
+    std::array<std::atomic<std::uint32_t>, LODStats::LevelCount> levelCounts = {};
 
     const auto& entities = getEntities();
     
@@ -102,6 +135,7 @@ void SkeletalAnimator::process(float dt)
 #endif
         {
             auto& skel = entity.getComponent<Skeleton>();
+            auto& model = entity.getComponent<Model>();
 
             //check the model is roughly in front of the camera and within interp distance
             const auto direction = entity.getComponent<cro::Transform>().getWorldPosition() - camPos;
@@ -109,67 +143,137 @@ void SkeletalAnimator::process(float dt)
                 && glm::length2(direction) < skel.m_interpolationDistance
                 && skel.m_useInterpolation);
 
-            const AnimationContext ctx =
+            skel.m_lodLevel = 0;
+            if (m_lodEnabled)
             {
-                useInterpolation,
-                entity.getComponent<cro::Transform>().getWorldTransform(),
-                dt,
-                skel.m_nextAnimation < 0
-            };
-
+                if (model.m_visibleInDrawList && !model.isHidden())
+                {
+                    const auto& tx = entity.getComponent<cro::Transform>();
+                    const auto scale = glm::abs(tx.getWorldScale());
+                    const auto sphere = model.getBoundingSphere();
+                    const float radius = sphere.radius * std::max(scale.x, std::max(scale.y, scale.z));
+
+                    float screenSize = 1.f;
+                    if (camera.isOrthographic())
+                    {
+                        screenSize = (radius * 2.f) / viewHeight;
+                    }
+                    else
+                    {
+                        const auto centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre, 1.f));
+                        const float distance = glm::length(centre - camPos);
+                        if (distance > radius)
+                        {
+                            screenSize = (radius * 2.f) / (distance * viewHeight);
+                        }
+                    }
+
+                    skel.m_lodLevel = static_cast<std::int32_t>(m_lodSettings.screenSize.size());
+                    for (auto i = 0u; i < m_lodSettings.screenSize.size(); ++i)
+                    {
+                        if (screenSize >= m_lodSettings.screenSize[i])
+                        {
+                            skel.m_lodLevel = static_cast<std::int32_t>(i);
+                            break;
+                        }
+                    }
+                }
+                else
+                {
+                    skel.m_lodLevel = static_cast<std::int32_t>(LODStats::LevelCount - 1);
+                }
+            }
+            //this is set again by the renderer if the model is in the next draw list
+            model.m_visibleInDrawList = false;
+            levelCounts[skel.m_lodLevel]++;
 
-            //update current animation
-            updateAnimation(skel.m_animations[skel.m_currentAnimation], skel, entity, ctx);
+            //offsetting the phase by the entity ID means only 1/period
+            //of the skeletons at any one level are updated each frame
+            const std::uint32_t period = 1u << skel.m_lodLevel;
+            skel.m_lodTime += dt;
 
-            //if we have a new animation start updating it and blend its output
-            //with the current anim according to blend time
-            if (skel.m_nextAnimation > -1)
+            if (((m_frameCounter + entity.getIndex()) & (period - 1)) == 0)
             {
-                //update the next animation to start blending it in
-                updateAnimation(skel.m_animations[skel.m_nextAnimation], skel, entity, ctx);
+                evaluatedCount++;
 
-                //blend to next animation
-                skel.m_currentBlendTime += dt;
-                if (!entity.getComponent<Model>().isHidden())
+                const AnimationContext ctx =
                 {
-                    //hmm if interpolation is disabled we probably only want to blend once
-                    //per frame at the current framerate - although blend times are so short
-                    //in most cases it's probably not worth the effort
-                    float interpTime = std::min(1.f, skel.m_currentBlendTime / skel.m_blendTime);
-                    blendAnimations(skel.m_animations[skel.m_currentAnimation], skel.m_animations[skel.m_nextAnimation], interpTime, skel);
-                }
-
-                if (skel.m_currentBlendTime > skel.m_blendTime)
+                    useInterpolation,
+                    entity.getComponent<cro::Transform>().getWorldTransform(),
+                    skel.m_lodTime,
+                    skel.m_nextAnimation < 0
+                };
+                skel.m_lodTime = 0.f;
+
+                //update current animation
+                updateAnimation(skel.m_animations[skel.m_currentAnimation], skel, entity, ctx);
+
+                //if we have a new animation start updating it and blend its output
+                //with the current anim according to blend time
+                if (skel.m_nextAnimation > -1)
                 {
-                    //update to current animation to next animation
-                    skel.m_animations[skel.m_currentAnimation].playbackRate = 0.f;
-                    skel.m_currentAnimation = skel.m_nextAnimation;
-
-                    skel.m_nextAnimation = -1;
-                    skel.m_currentBlendTime = 0.f;
+                    //update the next animation to start blending it in
+                    updateAnimation(skel.m_animations[skel.m_nextAnimation], skel, entity, ctx);
+
+                    //blend to next animation
+                    skel.m_currentBlendTime += ctx.dt;
+                    if (!model.isHidden())
+                    {
+                        //hmm if interpolation is disabled we probably only want to blend once
+                        //per frame at the current framerate - although blend times are so short
+                        //in most cases it's probably not worth the effort
+                        float interpTime = std::min(1.f, skel.m_currentBlendTime / skel.m_blendTime);
+                        blendAnimations(skel.m_animations[skel.m_currentAnimation], skel.m_animations[skel.m_nextAnimation], interpTime, skel);
+                    }
+
+                    if (skel.m_currentBlendTime > skel.m_blendTime)
+                    {
+                        //update to current animation to next animation
+                        skel.m_animations[skel.m_currentAnimation].playbackRate = 0.f;
+                        skel.m_currentAnimation = skel.m_nextAnimation;
+
+                        skel.m_nextAnimation = -1;
+                        skel.m_currentBlendTime = 0.f;
+                    }
                 }
             }
 
-            //update the position of attachments.
+            //update the position of attachments. This is done even if the
+            //skeleton was skipped as the entity transform may have changed.
             //TODO only do this if the frame was updated (? won't account for entity transform changing though)
+            const auto& worldTransform = entity.getComponent<cro::Transform>().getWorldTransform();
             for (auto i = 0u; i < skel.m_attachments.size(); ++i)
             {
                 auto& ap = skel.m_attachments[i];
                 if (ap.getModel().isValid())
                 {
-                    ap.getModel().getComponent<cro::Transform>().m_attachmentTransform = ctx.worldTransform * skel.getAttachmentTransform(i);
+                    ap.getModel().getComponent<cro::Transform>().setAttachmentTransform(worldTransform * skel.getAttachmentTransform(i));
                 }
             }
         }
 #ifdef USE_PARALLEL_PROCESSING       
         );
 #endif
+
+    m_lodStats.evaluated = evaluatedCount;
+    m_lodStats.skipped = entities.size() - m_lodStats.evaluated;
+    for (auto i = 0u; i < LODStats::LevelCount; ++i)
+    {
+        m_lodStats.levelCounts[i] = levelCounts[i];
+    }
+    m_frameCounter++;
 }
 
 void SkeletalAnimator::debugUI() const
 {
     ImGui::SliderFloat("Playback Rate", &playbackRate, 0.1f, 2.f);
 
+    ImGui::Text("Evaluated: %u, Skipped: %u", static_cast<std::uint32_t>(m_lodStats.evaluated), static_cast<std::uint32_t>(m_lodStats.skipped));
+    ImGui::Text("LOD Levels: %u, %u, %u, %u",
+        static_cast<std::uint32_t>(m_lodStats.levelCounts[0]), static_cast<std::uint32_t>(m_lodStats.levelCounts[1]),
+        static_cast<std::uint32_t>(m_lodStats.levelCounts[2]), static_cast<std::uint32_t>(m_lodStats.levelCounts[3]));
+    ImGui::Separator();
+
     const std::int32_t max = static_cast<std::int32_t>(getEntities().size());
     static std::int32_t start = 0;
     static std::int32_t end = std::min(2, max);
@@ -215,6 +319,18 @@ float SkeletalAnimator::getPlaybackRate() const
     return playbackRate;
 }
 
+void SkeletalAnimator::setLODEnabled(bool enabled)
+{
+    m_lodEnabled = enabled;
+}
+
+void SkeletalAnimator::setLODSettings(const LODSettings& settings)
+{
+    CRO_ASSERT(settings.screenSize[0] >= settings.screenSize[1]
+        && settings.screenSize[1] >= settings.screenSize[2], "LOD sizes should be in descending order");
+    m_lodSettings = settings;
+}
+
 //private
 void SkeletalAnimator::onEntityAdded(Entity entity)
 {
@@ -232,6 +348,8 @@ void SkeletalAnimator::onEntityAdded(Entity entity)
         skeleton.m_invBindPose.resize(skeleton.m_frameSize);
     }
 
+    skeleton.buildJointOrder();
+
     //update the bounds for each key frame
     for (auto i = 0u; i < skeleton.m_frameCount; ++i)
     {
@@ -249,25 +367,20 @@ void SkeletalAnimator::updateAnimation(SkeletalAnim& anim, Skeleton& skel, Entit
     auto nextFrame = ((anim.currentFrame - anim.startFrame) + 1) % anim.frameCount;
     nextFrame += anim.startFrame;
 
-    if (anim.currentFrameTime > anim.frameTime)
+    //if LOD has skipped some updates dt may span more than one frame
+    //so keep advancing until we catch up, raising any events on the way
+    bool frameChanged = false;
+    while (anim.currentFrameTime > anim.frameTime
+        && anim.playbackRate != 0)
     {
         //frame is done, move to next
         anim.currentFrameTime -= anim.frameTime;
         anim.currentFrame = nextFrame;
+        frameChanged = true;
 
         nextFrame = ((anim.currentFrame - anim.startFrame) + 1) % anim.frameCount;
         nextFrame += anim.startFrame;
 
-        //apply the current frame
-        skel.buildKeyframe(anim.currentFrame);
-
-        //rebuild the anim cache in case we need it for blending
-        anim.resetInterp(skel);
-
-        auto& meshData = entity.getComponent<Model>().getMeshData();
-        meshData.boundingBox = skel.m_keyFrameBounds[anim.currentFrame];
-        meshData.boundingSphere = skel.m_keyFrameBounds[anim.currentFrame];
-
         //stop playback if frame ID has looped
         if (nextFrame < anim.currentFrame)
         {
@@ -306,6 +419,19 @@ void SkeletalAnimator::updateAnimation(SkeletalAnim& anim, Skeleton& skel, Entit
         }
     }
 
+    if (frameChanged)
+    {
+        //apply the current frame
+        skel.buildKeyframe(anim.currentFrame);
+
+        //rebuild the anim cache in case we need it for blending
+        anim.resetInterp(skel);
+
+        auto& meshData = entity.getComponent<Model>().getMeshData();
+        meshData.boundingBox = skel.m_keyFrameBounds[anim.currentFrame];
+        meshData.boundingSphere = skel.m_keyFrameBounds[anim.currentFrame];
+    }
+
     //only interpolate if model is visible and close to the active camera
     if (!entity.getComponent<Model>().isHidden()
         && anim.playbackRate != 0)
@@ -326,60 +452,41 @@ void SkeletalAnimator::interpolateAnimation(SkeletalAnim& source, std::size_t ta
     std::size_t startA = source.currentFrame * skeleton.m_frameSize;
     std::size_t startB = targetFrame * skeleton.m_frameSize;
 
-    //stores interpolated output in source so we can use it to blend.
-    //we mix all the joints first to prevent it happening multiple times
-    //when we create the world transforms.
-
-    std::vector<glm::mat4> mixBuffer(skeleton.m_frameSize);
-    for (auto i = 0u; i < skeleton.m_frameSize; ++i)
+    if (skeleton.m_jointOrder.size() != skeleton.m_frameSize)
     {
-        mixBuffer[i] = mixJoint(skeleton.m_frames[startA + i], skeleton.m_frames[startB + i], time, source.interpolationOutput[i]);
+        skeleton.buildJointOrder();
     }
 
-    for (auto i = 0u; i < skeleton.m_frameSize; ++i)
-    {
-        glm::mat4 worldMatrix = mixBuffer[i];
-
-        std::int32_t parent = skeleton.m_frames[startA + i].parent;
-        while (parent != -1)
-        {
-            worldMatrix = mixBuffer[parent] * worldMatrix;
-            parent = skeleton.m_frames[startA + parent].parent;
-        }
-
-        //note this gets overwritten if blending animations - might be
-        //useful to prevent it happening in those cases?
-        if (output)
-        {
-            skeleton.m_currentFrame[i] = skeleton.m_rootTransform * worldMatrix * skeleton.m_invBindPose[i];
-        }
-        
-    }
+    //stores interpolated output in source so we can use it to blend.
+    //we mix all the joints first to prevent it happening multiple times
+    //when we create the world transforms.
+    auto& arena = poseArena;
+    arena.resize(skeleton.m_frameSize);
+    arena.gather(arena.a, &skeleton.m_frames[startA], skeleton.m_frameSize);
+    arena.gather(arena.b, &skeleton.m_frames[startB], skeleton.m_frameSize);
+    Detail::mixPose(arena, skeleton.m_frameSize, time);
+    arena.scatter(source.interpolationOutput.data(), skeleton.m_frameSize);
+
+    //note the output gets overwritten if blending animations - might be
+    //useful to prevent it happening in those cases?
+    buildPose(arena, &skeleton.m_frames[startA], skeleton.m_jointOrder, skeleton.m_rootTransform, skeleton.m_invBindPose,
+        output ? skeleton.m_currentFrame.data() : nullptr);
 }
 
 void SkeletalAnimator::blendAnimations(const SkeletalAnim& a, const SkeletalAnim& b, float time, Skeleton& skeleton) const
 {
-    Joint temp; //we need something to pass as a func param
-    std::vector<glm::mat4> mixBuffer(skeleton.m_frameSize);
-
-    for (auto i = 0u; i < skeleton.m_frameSize; ++i)
+    if (skeleton.m_jointOrder.size() != skeleton.m_frameSize)
     {
-        mixBuffer[i] = mixJoint(a.interpolationOutput[i], b.interpolationOutput[i], time, temp);
+        skeleton.buildJointOrder();
     }
 
-    for (auto i = 0u; i < skeleton.m_frameSize; ++i)
-    {
-        auto worldMat = mixBuffer[i];
+    auto& arena = poseArena;
+    arena.resize(skeleton.m_frameSize);
+    arena.gather(arena.a, a.interpolationOutput.data(), skeleton.m_frameSize);
+    arena.gather(arena.b, b.interpolationOutput.data(), skeleton.m_frameSize);
+    Detail::mixPose(arena, skeleton.m_frameSize, time);
 
-        auto parent = a.interpolationOutput[i].parent;
-        while (parent != -1)
-        {
-            worldMat = mixBuffer[parent] * worldMat;
-            parent = a.interpolationOutput[parent].parent;
-        }
-
-        skeleton.m_currentFrame[i] = skeleton.m_rootTransform * worldMat * skeleton.m_invBindPose[i];
-    }
+    buildPose(arena, a.interpolationOutput.data(), skeleton.m_jointOrder, skeleton.m_rootTransform, skeleton.m_invBindPose, skeleton.m_currentFrame.data());
 }
 
 void SkeletalAnimator::updateBoundsFromCurrentFrame(Skeleton& dest, const Mesh::Data& source) const
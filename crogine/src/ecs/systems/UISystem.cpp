@@ -67,6 +67,10 @@ UISystem::UISystem(MessageBus& mb)
     requireComponent<UIInput>();
     requireComponent<Transform>();
 
+    //entities without an explicit selection index are
+    //given one in the order in which they were added
+    setOrderedRemoval(true);
+
     //default callback for components which don't have one assigned
     m_buttonCallbacks.push_back([](Entity, ButtonEvent) {});
     m_movementCallbacks.push_back([](Entity, glm::vec2, MotionEvent) {});
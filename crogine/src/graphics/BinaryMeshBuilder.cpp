@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/core/FileSystem.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/MappedFile.hpp"
 
 using namespace cro;
 
@@ -77,8 +78,22 @@ Mesh::Data BinaryMeshBuilder::build() const
 {
     Mesh::Data meshData;
 
+    //version 3 files are uploaded straight from the mapped file. Older
+    //files, or files which can't be mapped (such as those in an apk), are
+    //read as normal.
+    Detail::MappedFile mappedFile;
+    std::vector<std::uint8_t> fileData;
+
     RaiiRWops file;
-    file.file = SDL_RWFromFile(m_path.c_str(), "rb");
+    if (mappedFile.open(m_path))
+    {
+        file.file = SDL_RWFromConstMem(mappedFile.data(), static_cast<int>(mappedFile.size()));
+    }
+    else
+    {
+        file.file = SDL_RWFromFile(m_path.c_str(), "rb");
+    }
+
     if (file.file)    
     {
         Detail::ModelBinary::Header header;
@@ -99,7 +114,57 @@ Mesh::Data BinaryMeshBuilder::build() const
             return {};
         }
 
-        if (header.meshOffset)
+        if (header.meshOffset
+            && header.version >= Detail::ModelBinary::MappedVersion)
+        {
+            const auto* data = mappedFile.data();
+            auto size = mappedFile.size();
+            if (!mappedFile.isOpen())
+            {
+                fileData.resize(static_cast<std::size_t>(len));
+                SDL_RWseek(file.file, 0, RW_SEEK_SET);
+                SDL_RWread(file.file, fileData.data(), fileData.size(), 1);
+
+                data = fileData.data();
+                size = fileData.size();
+            }
+
+            Detail::ModelBinary::MeshView view;
+            if (!Detail::ModelBinary::getMeshView(data, size, view))
+            {
+                LogE << "Unable to open " << m_path << ": invalid mesh data" << std::endl;
+                return {};
+            }
+
+            meshData.attributes = Detail::ModelBinary::getAttributeSizes(view.header.flags);
+            meshData.attributeFlags = view.header.flags;
+            meshData.primitiveType = GL_TRIANGLES;
+            meshData.vertexSize = view.header.vertexSize;
+            meshData.vertexCount = view.header.vertexCount;
+
+            //vertex data is stored as floats, 16 byte aligned, so
+            //this is packed first if quantisation was requested
+            createVBO(meshData, reinterpret_cast<const float*>(view.vertexData));
+
+            const auto indexFormat = view.header.indexSize == sizeof(std::uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+            meshData.submeshCount = view.indexCounts.size();
+            for (auto i = 0u; i < meshData.submeshCount; ++i)
+            {
+                meshData.indexData[i].format = indexFormat;
+                meshData.indexData[i].primitiveType = meshData.primitiveType;
+                meshData.indexData[i].indexCount = view.indexCounts[i];
+                createIBO(meshData, view.indexData[i], i, view.header.indexSize);
+            }
+
+            const auto& bounds = view.header.boundingBox;
+            meshData.boundingBox[0] = { bounds[0], bounds[1], bounds[2] };
+            meshData.boundingBox[1] = { bounds[3], bounds[4], bounds[5] };
+
+            const auto& sphere = view.header.boundingSphere;
+            meshData.boundingSphere.centre = { sphere[0], sphere[1], sphere[2] };
+            meshData.boundingSphere.radius = sphere[3];
+        }
+        else if (header.meshOffset)
         {
             Detail::ModelBinary::MeshHeader meshHeader;
             SDL_RWread(file.file, &meshHeader, sizeof(meshHeader), 1);
@@ -304,10 +369,12 @@ Mesh::Data BinaryMeshBuilder::build() const
                 }
             }
 
-            //boundingbox / sphere
+            //boundingbox / sphere - vertexSize may have been changed by quantisation
+            //so step through the float data by the attribute sizes
+            const auto stride = getAttributeSize(meshData.attributes);
             meshData.boundingBox[0] = glm::vec3(std::numeric_limits<float>::max());
             meshData.boundingBox[1] = glm::vec3(std::numeric_limits<float>::lowest());
-            for (std::size_t i = 0; i < vertData.size(); i += (meshData.vertexSize / sizeof(float)))
+            for (std::size_t i = 0; i < vertData.size(); i += stride)
             {
                 //min point
                 if (meshData.boundingBox[0].x > vertData[i])
@@ -0,0 +1,1428 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "../detail/FileCache.hpp"
+
+#include <crogine/graphics/CompressedImage.hpp>
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+#include <crogine/util/String.hpp>
+
+#include <SDL_rwops.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+using namespace cro;
+
+namespace
+{
+    //all of the container headers are little endian, as
+    //are all the platforms we support, so these are read
+    //by copying straight from the buffer.
+    template <typename T>
+    T read(const std::uint8_t* src)
+    {
+        T t;
+        std::memcpy(&t, src, sizeof(T));
+        return t;
+    }
+
+    template <typename T>
+    void write(std::vector<std::uint8_t>& dst, T t)
+    {
+        const auto pos = dst.size();
+        dst.resize(pos + sizeof(T));
+        std::memcpy(dst.data() + pos, &t, sizeof(T));
+    }
+
+    struct FormatInfo final
+    {
+        std::uint32_t blockSize = 0;
+        std::uint32_t glFormat = 0;
+        std::uint32_t vkFormat = 0; //linear variant, used when writing
+        std::uint32_t vkFormatSRGB = 0;
+        std::string name;
+
+        //KTX2 data format descriptor. Up to two samples
+        //made up of channel ID, bit offset and bit length
+        std::uint8_t colourModel = 0;
+        std::array<std::array<std::uint8_t, 3>, 2u> samples = {};
+        std::uint32_t sampleCount = 0;
+    };
+
+    //GL enums not included in our loader as they are extensions
+    constexpr std::uint32_t GL_COMPRESSED_RGB_S3TC_DXT1 = 0x83F0;
+    constexpr std::uint32_t GL_COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1;
+    constexpr std::uint32_t GL_COMPRESSED_RGBA_S3TC_DXT3 = 0x83F2;
+    constexpr std::uint32_t GL_COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+    constexpr std::uint32_t GL_COMPRESSED_RED_RGTC1 = 0x8DBB;
+    constexpr std::uint32_t GL_COMPRESSED_RG_RGTC2 = 0x8DBD;
+    constexpr std::uint32_t GL_COMPRESSED_RGBA_BPTC_UNORM = 0x8E8C;
+    constexpr std::uint32_t GL_COMPRESSED_RGB8_ETC2 = 0x9274;
+    constexpr std::uint32_t GL_COMPRESSED_RGBA8_ETC2_EAC = 0x9278;
+
+    const std::array<FormatInfo, CompressedImage::Format::Count> Formats =
+    {
+        FormatInfo({0, 0, 0, 0, "None"}),
+        FormatInfo({8, GL_COMPRESSED_RGB_S3TC_DXT1, 131, 132, "BC1 RGB", 128, {{{0, 0, 64}}}, 1}),
+        FormatInfo({8, GL_COMPRESSED_RGBA_S3TC_DXT1, 133, 134, "BC1 RGBA", 128, {{{1, 0, 64}}}, 1}),
+        FormatInfo({16, GL_COMPRESSED_RGBA_S3TC_DXT3, 135, 136, "BC2", 129, {{{15, 0, 64}, {0, 64, 64}}}, 2}),
+        FormatInfo({16, GL_COMPRESSED_RGBA_S3TC_DXT5, 137, 138, "BC3", 130, {{{15, 0, 64}, {0, 64, 64}}}, 2}),
+        FormatInfo({8, GL_COMPRESSED_RED_RGTC1, 139, 139, "BC4", 131, {{{0, 0, 64}}}, 1}),
+        FormatInfo({16, GL_COMPRESSED_RG_RGTC2, 141, 141, "BC5", 132, {{{0, 0, 64}, {1, 64, 64}}}, 2}),
+        FormatInfo({16, GL_COMPRESSED_RGBA_BPTC_UNORM, 145, 146, "BC7", 134, {{{0, 0, 128}}}, 1}),
+        FormatInfo({8, GL_COMPRESSED_RGB8_ETC2, 147, 148, "ETC2 RGB", 161, {{{2, 0, 64}}}, 1}),
+        FormatInfo({16, GL_COMPRESSED_RGBA8_ETC2_EAC, 151, 152, "ETC2 RGBA", 161, {{{15, 0, 64}, {2, 64, 64}}}, 2}),
+    };
+
+    CompressedImage::Format::Type fromVkFormat(std::uint32_t vkFormat)
+    {
+        for (auto i = 1u; i < Formats.size(); ++i)
+        {
+            if (Formats[i].vkFormat == vkFormat
+                || Formats[i].vkFormatSRGB == vkFormat)
+            {
+                return static_cast<CompressedImage::Format::Type>(i);
+            }
+        }
+        return CompressedImage::Format::None;
+    }
+
+    CompressedImage::Format::Type fromDXGIFormat(std::uint32_t dxgiFormat)
+    {
+        switch (dxgiFormat)
+        {
+        default: return CompressedImage::Format::None;
+        case 71:
+        case 72:
+            return CompressedImage::Format::BC1RGBA;
+        case 74:
+        case 75:
+            return CompressedImage::Format::BC2;
+        case 77:
+        case 78:
+            return CompressedImage::Format::BC3;
+        case 80:
+            return CompressedImage::Format::BC4;
+        case 83:
+            return CompressedImage::Format::BC5;
+        case 98:
+        case 99:
+            return CompressedImage::Format::BC7;
+        }
+    }
+
+    constexpr std::uint32_t makeFourCC(const char* str)
+    {
+        return static_cast<std::uint32_t>(str[0])
+            | (static_cast<std::uint32_t>(str[1]) << 8)
+            | (static_cast<std::uint32_t>(str[2]) << 16)
+            | (static_cast<std::uint32_t>(str[3]) << 24);
+    }
+
+    CompressedImage::Format::Type fromFourCC(std::uint32_t fourCC)
+    {
+        switch (fourCC)
+        {
+        default: return CompressedImage::Format::None;
+        case makeFourCC("DXT1"):
+            //DXGI BC1 is always RGBA, so assume DXT1 is too
+            return CompressedImage::Format::BC1RGBA;
+        case makeFourCC("DXT2"):
+        case makeFourCC("DXT3"):
+            return CompressedImage::Format::BC2;
+        case makeFourCC("DXT4"):
+        case makeFourCC("DXT5"):
+            return CompressedImage::Format::BC3;
+        case makeFourCC("ATI1"):
+        case makeFourCC("BC4U"):
+            return CompressedImage::Format::BC4;
+        case makeFourCC("ATI2"):
+        case makeFourCC("BC5U"):
+            return CompressedImage::Format::BC5;
+        }
+    }
+
+    const std::array<std::uint8_t, 12u> KTX2Identifier =
+    {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+    constexpr std::size_t KTX2HeaderSize = 80;
+    constexpr std::size_t KTX2LevelIndexSize = 24;
+
+    constexpr std::uint32_t DDSMagic = makeFourCC("DDS ");
+    constexpr std::size_t DDSHeaderSize = 124;
+    constexpr std::size_t DDSHeaderDX10Size = 20;
+
+    std::uint32_t getMaxLevelCount(glm::uvec2 size)
+    {
+        std::uint32_t count = 1;
+        auto s = std::max(size.x, size.y);
+        while (s > 1)
+        {
+            s /= 2;
+            count++;
+        }
+        return count;
+    }
+
+    std::uint32_t getLevelDimension(std::uint32_t size, std::uint32_t level)
+    {
+        return level < 32 ? std::max(1u, size >> level) : 1u;
+    }
+
+    //returns the size in bytes of the given levels with all their layers and
+    //faces, or nullopt if the values (eg read from a file header) are large
+    //enough that the size would overflow
+    std::optional<std::size_t> getTotalSize(CompressedImage::Format::Type format, glm::uvec2 size,
+        std::uint32_t firstLevel, std::uint32_t levelCount, std::uint32_t layerCount, std::uint32_t faceCount)
+    {
+        constexpr auto MaxSize = std::numeric_limits<std::size_t>::max();
+        const auto multiply = [](std::size_t& dst, std::size_t value)
+        {
+            if (value != 0 && dst > MaxSize / value)
+            {
+                return false;
+            }
+            dst *= value;
+            return true;
+        };
+
+        std::size_t total = 0;
+        for (auto i = firstLevel; i < firstLevel + levelCount; ++i)
+        {
+            std::size_t levelSize = (static_cast<std::size_t>(getLevelDimension(size.x, i)) + 3) / 4;
+            if (!multiply(levelSize, (static_cast<std::size_t>(getLevelDimension(size.y, i)) + 3) / 4)
+                || !multiply(levelSize, CompressedImage::getBlockSize(format))
+                || !multiply(levelSize, layerCount)
+                || !multiply(levelSize, faceCount)
+                || levelSize > MaxSize - total)
+            {
+                return std::nullopt;
+            }
+            total += levelSize;
+        }
+        return total;
+    }
+
+    //---block flipping---//
+    //rows are permuted with this, which reverses the first
+    //'height' rows, so that partial blocks at the top of
+    //small mip levels stay in place.
+    using RowOrder = std::array<std::uint32_t, 4u>;
+
+    RowOrder getRowOrder(std::uint32_t height)
+    {
+        RowOrder order = { 0,1,2,3 };
+        const auto count = std::min(height, 4u);
+        for (auto i = 0u; i < count; ++i)
+        {
+            order[i] = count - 1 - i;
+        }
+        return order;
+    }
+
+    //BC1 style colour indices are one byte per row
+    void flipColourBlock(std::uint8_t* block, const RowOrder& order)
+    {
+        std::array<std::uint8_t, 4u> rows = {};
+        std::memcpy(rows.data(), block + 4, 4);
+        for (auto i = 0u; i < 4u; ++i)
+        {
+            block[4 + i] = rows[order[i]];
+        }
+    }
+
+    //BC2 explicit alpha is two bytes per row
+    void flipExplicitAlphaBlock(std::uint8_t* block, const RowOrder& order)
+    {
+        std::array<std::uint8_t, 8u> rows = {};
+        std::memcpy(rows.data(), block, 8);
+        for (auto i = 0u; i < 4u; ++i)
+        {
+            block[i * 2] = rows[order[i] * 2];
+            block[i * 2 + 1] = rows[order[i] * 2 + 1];
+        }
+    }
+
+    //BC3/4/5 interpolated alpha is 12 bits per row
+    void flipAlphaBlock(std::uint8_t* block, const RowOrder& order)
+    {
+        std::uint64_t bits = 0;
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            bits |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+        }
+
+        std::uint64_t flipped = 0;
+        for (auto i = 0u; i < 4u; ++i)
+        {
+            const auto row = (bits >> (12 * order[i])) & 0xfff;
+            flipped |= row << (12 * i);
+        }
+
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            block[2 + i] = static_cast<std::uint8_t>(flipped >> (8 * i));
+        }
+    }
+
+    void flipBlock(CompressedImage::Format::Type format, std::uint8_t* block, const RowOrder& order)
+    {
+        switch (format)
+        {
+        default: break;
+        case CompressedImage::Format::BC1RGB:
+        case CompressedImage::Format::BC1RGBA:
+            flipColourBlock(block, order);
+            break;
+        case CompressedImage::Format::BC2:
+            flipExplicitAlphaBlock(block, order);
+            flipColourBlock(block + 8, order);
+            break;
+        case CompressedImage::Format::BC3:
+            flipAlphaBlock(block, order);
+            flipColourBlock(block + 8, order);
+            break;
+        case CompressedImage::Format::BC4:
+            flipAlphaBlock(block, order);
+            break;
+        case CompressedImage::Format::BC5:
+            flipAlphaBlock(block, order);
+            flipAlphaBlock(block + 8, order);
+            break;
+        }
+    }
+
+    //---decompression---//
+    //each block is decoded to 16 RGBA pixels, in rows
+    using Block = std::array<std::uint8_t, 64u>;
+
+    std::uint8_t clampByte(std::int32_t v)
+    {
+        return static_cast<std::uint8_t>(std::clamp(v, 0, 255));
+    }
+
+    void decodeColourBlock(const std::uint8_t* src, Block& dst, bool alpha, bool fourColour)
+    {
+        const auto c0 = read<std::uint16_t>(src);
+        const auto c1 = read<std::uint16_t>(src + 2);
+
+        const auto expand =
+            [](std::uint16_t c, std::uint8_t* out)
+        {
+            const std::uint32_t r = (c >> 11) & 0x1f;
+            const std::uint32_t g = (c >> 5) & 0x3f;
+            const std::uint32_t b = c & 0x1f;
+            out[0] = static_cast<std::uint8_t>((r << 3) | (r >> 2));
+            out[1] = static_cast<std::uint8_t>((g << 2) | (g >> 4));
+            out[2] = static_cast<std::uint8_t>((b << 3) | (b >> 2));
+            out[3] = 255;
+        };
+
+        std::array<std::array<std::uint8_t, 4u>, 4u> palette = {};
+        expand(c0, palette[0].data());
+        expand(c1, palette[1].data());
+
+        if (fourColour || c0 > c1)
+        {
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                palette[2][i] = static_cast<std::uint8_t>((2 * palette[0][i] + palette[1][i] + 1) / 3);
+                palette[3][i] = static_cast<std::uint8_t>((palette[0][i] + 2 * palette[1][i] + 1) / 3);
+            }
+            palette[2][3] = palette[3][3] = 255;
+        }
+        else
+        {
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                palette[2][i] = static_cast<std::uint8_t>((palette[0][i] + palette[1][i] + 1) / 2);
+                palette[3][i] = 0;
+            }
+            palette[2][3] = 255;
+            palette[3][3] = alpha ? 0 : 255;
+        }
+
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            const auto index = (src[4 + (i / 4)] >> ((i % 4) * 2)) & 0x3;
+            std::memcpy(&dst[i * 4], palette[index].data(), 4);
+        }
+    }
+
+    //decodes a BC3/4/5 style block into the given channel
+    void decodeAlphaBlock(const std::uint8_t* src, Block& dst, std::uint32_t channel)
+    {
+        const std::int32_t a0 = src[0];
+        const std::int32_t a1 = src[1];
+
+        std::array<std::uint8_t, 8u> palette = {};
+        palette[0] = src[0];
+        palette[1] = src[1];
+
+        if (a0 > a1)
+        {
+            for (auto i = 1; i < 7; ++i)
+            {
+                palette[i + 1] = static_cast<std::uint8_t>(((7 - i) * a0 + i * a1 + 3) / 7);
+            }
+        }
+        else
+        {
+            for (auto i = 1; i < 5; ++i)
+            {
+                palette[i + 1] = static_cast<std::uint8_t>(((5 - i) * a0 + i * a1 + 2) / 5);
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        std::uint64_t bits = 0;
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            bits |= static_cast<std::uint64_t>(src[2 + i]) << (8 * i);
+        }
+
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            dst[i * 4 + channel] = palette[(bits >> (i * 3)) & 0x7];
+        }
+    }
+
+    void decodeExplicitAlphaBlock(const std::uint8_t* src, Block& dst)
+    {
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            const std::uint8_t a = (src[i / 2] >> ((i % 2) * 4)) & 0xf;
+            dst[i * 4 + 3] = static_cast<std::uint8_t>((a << 4) | a);
+        }
+    }
+
+    //ETC2 blocks are stored big endian
+    std::uint64_t readBigEndian(const std::uint8_t* src)
+    {
+        std::uint64_t bits = 0;
+        for (auto i = 0u; i < 8u; ++i)
+        {
+            bits = (bits << 8) | src[i];
+        }
+        return bits;
+    }
+
+    std::uint32_t getBits(std::uint64_t bits, std::uint32_t high, std::uint32_t count)
+    {
+        return static_cast<std::uint32_t>((bits >> (high + 1 - count)) & ((1ull << count) - 1));
+    }
+
+    constexpr std::array<std::array<std::int32_t, 2u>, 8u> ETCModifiers =
+    { {
+        {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+    } };
+
+    constexpr std::array<std::int32_t, 8u> ETCDistances =
+    {
+        3, 6, 11, 16, 23, 32, 41, 64
+    };
+
+    constexpr std::array<std::array<std::int32_t, 8u>, 16u> EACModifiers =
+    { {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    } };
+
+    std::int32_t extend4(std::uint32_t v) { return static_cast<std::int32_t>((v << 4) | v); }
+    std::int32_t extend5(std::uint32_t v) { return static_cast<std::int32_t>((v << 3) | (v >> 2)); }
+    std::int32_t extend6(std::uint32_t v) { return static_cast<std::int32_t>((v << 2) | (v >> 4)); }
+    std::int32_t extend7(std::uint32_t v) { return static_cast<std::int32_t>((v << 1) | (v >> 6)); }
+
+    //pixel indices are stored in columns
+    std::uint32_t getETCIndex(std::uint64_t bits, std::uint32_t x, std::uint32_t y)
+    {
+        const auto p = x * 4 + y;
+        const auto msb = (bits >> (16 + p)) & 1;
+        const auto lsb = (bits >> p) & 1;
+        return static_cast<std::uint32_t>((msb << 1) | lsb);
+    }
+
+    void decodeETC2Block(const std::uint8_t* src, Block& dst)
+    {
+        const auto bits = readBigEndian(src);
+
+        using Colour = std::array<std::int32_t, 3u>;
+        const auto writePixel =
+            [&](std::uint32_t x, std::uint32_t y, const Colour& c)
+        {
+            auto* px = &dst[(y * 4 + x) * 4];
+            px[0] = clampByte(c[0]);
+            px[1] = clampByte(c[1]);
+            px[2] = clampByte(c[2]);
+            px[3] = 255;
+        };
+
+        const auto writePaint =
+            [&](const std::array<Colour, 4u>& paint)
+        {
+            for (auto y = 0u; y < 4u; ++y)
+            {
+                for (auto x = 0u; x < 4u; ++x)
+                {
+                    writePixel(x, y, paint[getETCIndex(bits, x, y)]);
+                }
+            }
+        };
+
+        const bool differential = getBits(bits, 33, 1) != 0;
+        Colour base0 = {};
+        Colour base1 = {};
+
+        if (!differential)
+        {
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                base0[i] = extend4(getBits(bits, 63 - (i * 8), 4));
+                base1[i] = extend4(getBits(bits, 59 - (i * 8), 4));
+            }
+        }
+        else
+        {
+            std::array<std::int32_t, 3u> sum = {};
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                const auto c = static_cast<std::int32_t>(getBits(bits, 63 - (i * 8), 5));
+                auto d = static_cast<std::int32_t>(getBits(bits, 58 - (i * 8), 3));
+                d = (d & 0x4) ? d - 8 : d;
+                sum[i] = c + d;
+                base0[i] = extend5(c);
+                base1[i] = extend5(static_cast<std::uint32_t>(std::clamp(sum[i], 0, 31)));
+            }
+
+            if (sum[0] < 0 || sum[0] > 31)
+            {
+                //T mode
+                const auto r1 = (getBits(bits, 60, 2) << 2) | getBits(bits, 57, 2);
+                const Colour c1 = { extend4(r1), extend4(getBits(bits, 55, 4)), extend4(getBits(bits, 51, 4)) };
+                const Colour c2 = { extend4(getBits(bits, 47, 4)), extend4(getBits(bits, 43, 4)), extend4(getBits(bits, 39, 4)) };
+                const auto d = ETCDistances[(getBits(bits, 35, 2) << 1) | getBits(bits, 32, 1)];
+
+                writePaint({ c1,
+                    Colour({c2[0] + d, c2[1] + d, c2[2] + d}),
+                    c2,
+                    Colour({c2[0] - d, c2[1] - d, c2[2] - d}) });
+                return;
+            }
+
+            if (sum[1] < 0 || sum[1] > 31)
+            {
+                //H mode
+                const auto r1 = getBits(bits, 62, 4);
+                const auto g1 = (getBits(bits, 58, 3) << 1) | getBits(bits, 52, 1);
+                const auto b1 = (getBits(bits, 51, 1) << 3) | getBits(bits, 49, 3);
+                const auto r2 = getBits(bits, 46, 4);
+                const auto g2 = getBits(bits, 42, 4);
+                const auto b2 = getBits(bits, 38, 4);
+
+                const auto v1 = (r1 << 8) | (g1 << 4) | b1;
+                const auto v2 = (r2 << 8) | (g2 << 4) | b2;
+                const auto index = (getBits(bits, 34, 1) << 2) | (getBits(bits, 32, 1) << 1) | (v1 >= v2 ? 1 : 0);
+                const auto d = ETCDistances[index];
+
+                const Colour c1 = { extend4(r1), extend4(g1), extend4(b1) };
+                const Colour c2 = { extend4(r2), extend4(g2), extend4(b2) };
+
+                writePaint({ Colour({c1[0] + d, c1[1] + d, c1[2] + d}),
+                    Colour({c1[0] - d, c1[1] - d, c1[2] - d}),
+                    Colour({c2[0] + d, c2[1] + d, c2[2] + d}),
+                    Colour({c2[0] - d, c2[1] - d, c2[2] - d}) });
+                return;
+            }
+
+            if (sum[2] < 0 || sum[2] > 31)
+            {
+                //planar mode
+                const Colour o =
+                {
+                    extend6(getBits(bits, 62, 6)),
+                    extend7((getBits(bits, 56, 1) << 6) | getBits(bits, 54, 6)),
+                    extend6((getBits(bits, 48, 1) << 5) | (getBits(bits, 44, 2) << 3) | getBits(bits, 41, 3))
+                };
+                const Colour h =
+                {
+                    extend6((getBits(bits, 38, 5) << 1) | getBits(bits, 32, 1)),
+                    extend7(getBits(bits, 31, 7)),
+                    extend6(getBits(bits, 24, 6))
+                };
+                const Colour v =
+                {
+                    extend6(getBits(bits, 18, 6)),
+                    extend7(getBits(bits, 12, 7)),
+                    extend6(getBits(bits, 5, 6))
+                };
+
+                for (auto y = 0; y < 4; ++y)
+                {
+                    for (auto x = 0; x < 4; ++x)
+                    {
+                        Colour c = {};
+                        for (auto i = 0u; i < 3u; ++i)
+                        {
+                            c[i] = (x * (h[i] - o[i]) + y * (v[i] - o[i]) + 4 * o[i] + 2) >> 2;
+                        }
+                        writePixel(x, y, c);
+                    }
+                }
+                return;
+            }
+        }
+
+        //individual or differential mode
+        const auto& table0 = ETCModifiers[getBits(bits, 39, 3)];
+        const auto& table1 = ETCModifiers[getBits(bits, 36, 3)];
+        const bool flip = getBits(bits, 32, 1) != 0;
+
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                const bool second = flip ? (y > 1) : (x > 1);
+                const auto& base = second ? base1 : base0;
+                const auto& table = second ? table1 : table0;
+
+                const auto index = getETCIndex(bits, x, y);
+                auto modifier = table[index & 0x1];
+                if (index & 0x2)
+                {
+                    modifier = -modifier;
+                }
+
+                writePixel(x, y, { base[0] + modifier, base[1] + modifier, base[2] + modifier });
+            }
+        }
+    }
+
+    void decodeEACBlock(const std::uint8_t* src, Block& dst)
+    {
+        const auto bits = readBigEndian(src);
+        const std::int32_t base = src[0];
+        const std::int32_t multiplier = src[1] >> 4;
+        const auto& table = EACModifiers[src[1] & 0xf];
+
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                const auto p = x * 4 + y;
+                const auto index = (bits >> (45 - (p * 3))) & 0x7;
+                dst[(y * 4 + x) * 4 + 3] = clampByte(base + table[index] * multiplier);
+            }
+        }
+    }
+
+    void decodeBlock(CompressedImage::Format::Type format, const std::uint8_t* src, Block& dst)
+    {
+        switch (format)
+        {
+        default: break;
+        case CompressedImage::Format::BC1RGB:
+            decodeColourBlock(src, dst, false, false);
+            break;
+        case CompressedImage::Format::BC1RGBA:
+            decodeColourBlock(src, dst, true, false);
+            break;
+        case CompressedImage::Format::BC2:
+            decodeColourBlock(src + 8, dst, false, true);
+            decodeExplicitAlphaBlock(src, dst);
+            break;
+        case CompressedImage::Format::BC3:
+            decodeColourBlock(src + 8, dst, false, true);
+            decodeAlphaBlock(src, dst, 3);
+            break;
+        case CompressedImage::Format::BC4:
+            //matches sampling a single channel texture
+            std::fill(dst.begin(), dst.end(), 0);
+            decodeAlphaBlock(src, dst, 0);
+            for (auto i = 0u; i < 16u; ++i)
+            {
+                dst[i * 4 + 3] = 255;
+            }
+            break;
+        case CompressedImage::Format::BC5:
+            std::fill(dst.begin(), dst.end(), 0);
+            decodeAlphaBlock(src, dst, 0);
+            decodeAlphaBlock(src + 8, dst, 1);
+            for (auto i = 0u; i < 16u; ++i)
+            {
+                dst[i * 4 + 3] = 255;
+            }
+            break;
+        case CompressedImage::Format::ETC2RGB:
+            decodeETC2Block(src, dst);
+            break;
+        case CompressedImage::Format::ETC2RGBA:
+            decodeETC2Block(src + 8, dst);
+            decodeEACBlock(src, dst);
+            break;
+        }
+    }
+}
+
+CompressedImage::CompressedImage()
+    : m_format  (Format::None),
+    m_size      (0),
+    m_layerCount(0),
+    m_faceCount (0),
+    m_bottomUp  (false)
+{
+
+}
+
+//public
+bool CompressedImage::create(Format::Type format, glm::uvec2 size, std::uint32_t levelCount, std::uint32_t layerCount, std::uint32_t faceCount)
+{
+    if (format == Format::None || format >= Format::Count)
+    {
+        LogE << "Invalid compressed image format" << std::endl;
+        return false;
+    }
+
+    if (size.x == 0 || size.y == 0)
+    {
+        LogE << "Invalid compressed image size " << size << std::endl;
+        return false;
+    }
+
+    if (layerCount == 0
+        || (faceCount != 1 && faceCount != 6))
+    {
+        LogE << "Compressed images require at least one layer, and either 1 or 6 faces" << std::endl;
+        return false;
+    }
+
+    levelCount = std::clamp(levelCount, 1u, getMaxLevelCount(size));
+    if (!getTotalSize(format, size, 0, levelCount, layerCount, faceCount))
+    {
+        LogE << "Compressed image size " << size << " is too large" << std::endl;
+        return false;
+    }
+
+    m_format = format;
+    m_size = size;
+    m_layerCount = layerCount;
+    m_faceCount = faceCount;
+
+    m_levels.resize(levelCount);
+
+    std::size_t offset = 0;
+    for (auto i = 0u; i < levelCount; ++i)
+    {
+        m_levels[i].offset = offset;
+        m_levels[i].imageSize = getImageSize(format, getSize(i));
+        offset += m_levels[i].imageSize * layerCount * faceCount;
+    }
+
+    m_data.clear();
+    m_data.resize(offset);
+
+    return true;
+}
+
+bool CompressedImage::loadFromFile(const std::string& path)
+{
+    RaiiRWops rr;
+    rr.file = SDL_RWFromFile(path.c_str(), "rb");
+    if (!rr.file)
+    {
+        LogE << "Failed opening " << path << std::endl;
+        return false;
+    }
+
+    const auto fileSize = SDL_RWsize(rr.file);
+    if (fileSize <= 0)
+    {
+        LogE << path << ": file is empty" << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> fileData(static_cast<std::size_t>(fileSize));
+    if (SDL_RWread(rr.file, fileData.data(), fileData.size(), 1) != 1)
+    {
+        LogE << "Failed reading " << path << std::endl;
+        return false;
+    }
+
+    if (!loadFromMemory(fileData.data(), fileData.size()))
+    {
+        LogE << "Failed loading compressed image " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CompressedImage::loadFromMemory(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+
+    if (bytes && size > KTX2Identifier.size()
+        && std::memcmp(bytes, KTX2Identifier.data(), KTX2Identifier.size()) == 0)
+    {
+        return loadKTX2(bytes, size);
+    }
+
+    if (bytes && size > 4
+        && read<std::uint32_t>(bytes) == DDSMagic)
+    {
+        return loadDDS(bytes, size);
+    }
+
+    LogE << "Data is not a KTX2 or DDS container" << std::endl;
+    return false;
+}
+
+bool CompressedImage::saveToFile(const std::string& path) const
+{
+    if (m_format == Format::None)
+    {
+        LogE << "Failed saving " << path << ": image is empty" << std::endl;
+        return false;
+    }
+
+    const auto& info = Formats[m_format];
+    const auto levelCount = getLevelCount();
+
+    //data format descriptor, a single basic block
+    std::vector<std::uint8_t> dfd;
+    const std::uint32_t blockSize = 24 + (16 * info.sampleCount);
+    write<std::uint32_t>(dfd, 4 + blockSize);
+    write<std::uint32_t>(dfd, 0); //vendor ID and descriptor type
+    write<std::uint32_t>(dfd, 2 | (blockSize << 16)); //version 2
+    write<std::uint8_t>(dfd, info.colourModel);
+    write<std::uint8_t>(dfd, 1); //BT709 primaries
+    write<std::uint8_t>(dfd, 1); //linear transfer
+    write<std::uint8_t>(dfd, 0); //straight alpha
+    write<std::uint32_t>(dfd, 0x00000303); //4x4x1x1 texel blocks
+    write<std::uint8_t>(dfd, static_cast<std::uint8_t>(info.blockSize));
+    for (auto i = 0; i < 7; ++i)
+    {
+        write<std::uint8_t>(dfd, 0);
+    }
+    for (auto i = 0u; i < info.sampleCount; ++i)
+    {
+        const auto& sample = info.samples[i];
+        write<std::uint16_t>(dfd, sample[1]);
+        write<std::uint8_t>(dfd, static_cast<std::uint8_t>(sample[2] - 1));
+        write<std::uint8_t>(dfd, sample[0]);
+        write<std::uint32_t>(dfd, 0); //sample position
+        write<std::uint32_t>(dfd, 0);
+        write<std::uint32_t>(dfd, 0xffffffff);
+    }
+
+    //key/value data, sorted by key
+    std::vector<std::uint8_t> kvd;
+    const auto writeKeyValue =
+        [&kvd](const std::string& key, const std::string& value)
+    {
+        write<std::uint32_t>(kvd, static_cast<std::uint32_t>(key.size() + value.size() + 2));
+        kvd.insert(kvd.end(), key.begin(), key.end());
+        kvd.push_back(0);
+        kvd.insert(kvd.end(), value.begin(), value.end());
+        kvd.push_back(0);
+        while (kvd.size() % 4)
+        {
+            kvd.push_back(0);
+        }
+    };
+    writeKeyValue("KTXorientation", m_bottomUp ? "ru" : "rd");
+    writeKeyValue("KTXwriter", "crogine");
+
+    const auto dfdOffset = KTX2HeaderSize + (KTX2LevelIndexSize * levelCount);
+    const auto kvdOffset = dfdOffset + dfd.size();
+    auto dataOffset = kvdOffset + kvd.size();
+
+    std::vector<std::uint8_t> header;
+    header.insert(header.end(), KTX2Identifier.begin(), KTX2Identifier.end());
+    write<std::uint32_t>(header, info.vkFormat);
+    write<std::uint32_t>(header, 1); //type size
+    write<std::uint32_t>(header, m_size.x);
+    write<std::uint32_t>(header, m_size.y);
+    write<std::uint32_t>(header, 0); //depth
+    write<std::uint32_t>(header, m_layerCount == 1 ? 0 : m_layerCount);
+    write<std::uint32_t>(header, m_faceCount);
+    write<std::uint32_t>(header, levelCount);
+    write<std::uint32_t>(header, 0); //no supercompression
+    write<std::uint32_t>(header, static_cast<std::uint32_t>(dfdOffset));
+    write<std::uint32_t>(header, static_cast<std::uint32_t>(dfd.size()));
+    write<std::uint32_t>(header, static_cast<std::uint32_t>(kvdOffset));
+    write<std::uint32_t>(header, static_cast<std::uint32_t>(kvd.size()));
+    write<std::uint64_t>(header, 0); //supercompression global data
+    write<std::uint64_t>(header, 0);
+
+    //levels are stored smallest first, aligned to the block size
+    std::vector<std::uint64_t> levelOffsets(levelCount);
+    for (auto i = levelCount; i > 0; --i)
+    {
+        dataOffset = ((dataOffset + info.blockSize - 1) / info.blockSize) * info.blockSize;
+        levelOffsets[i - 1] = dataOffset;
+        dataOffset += m_levels[i - 1].imageSize * m_layerCount * m_faceCount;
+    }
+
+    for (auto i = 0u; i < levelCount; ++i)
+    {
+        const std::uint64_t levelSize = m_levels[i].imageSize * m_layerCount * m_faceCount;
+        write<std::uint64_t>(header, levelOffsets[i]);
+        write<std::uint64_t>(header, levelSize);
+        write<std::uint64_t>(header, levelSize);
+    }
+    header.insert(header.end(), dfd.begin(), dfd.end());
+    header.insert(header.end(), kvd.begin(), kvd.end());
+
+    RaiiRWops rr;
+    rr.file = SDL_RWFromFile(path.c_str(), "wb");
+    if (!rr.file)
+    {
+        LogE << "Failed opening " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    bool success = SDL_RWwrite(rr.file, header.data(), header.size(), 1) == 1;
+    
+    std::size_t written = header.size();
+    const std::array<std::uint8_t, 16u> padding = {};
+    for (auto i = levelCount; i > 0 && success; --i)
+    {
+        const auto padSize = static_cast<std::size_t>(levelOffsets[i - 1]) - written;
+        if (padSize)
+        {
+            success = SDL_RWwrite(rr.file, padding.data(), padSize, 1) == 1;
+        }
+
+        const auto& level = m_levels[i - 1];
+        const auto levelSize = level.imageSize * m_layerCount * m_faceCount;
+        success = success && SDL_RWwrite(rr.file, m_data.data() + level.offset, levelSize, 1) == 1;
+        written += padSize + levelSize;
+    }
+
+    if (!success)
+    {
+        LogE << "Failed writing " << path << std::endl;
+    }
+    return success;
+}
+
+glm::uvec2 CompressedImage::getSize(std::uint32_t level) const
+{
+    return { std::max(1u, m_size.x >> level), std::max(1u, m_size.y >> level) };
+}
+
+const std::uint8_t* CompressedImage::getData(std::uint32_t level, std::uint32_t layer, std::uint32_t face) const
+{
+    if (level >= m_levels.size()
+        || layer >= m_layerCount
+        || face >= m_faceCount)
+    {
+        return nullptr;
+    }
+
+    const auto& l = m_levels[level];
+    return m_data.data() + l.offset + (l.imageSize * ((layer * m_faceCount) + face));
+}
+
+std::uint8_t* CompressedImage::getData(std::uint32_t level, std::uint32_t layer, std::uint32_t face)
+{
+    return const_cast<std::uint8_t*>(std::as_const(*this).getData(level, layer, face));
+}
+
+std::size_t CompressedImage::getDataSize(std::uint32_t level) const
+{
+    return level < m_levels.size() ? m_levels[level].imageSize : 0;
+}
+
+bool CompressedImage::flipVertically()
+{
+    if (m_format == Format::None)
+    {
+        return false;
+    }
+
+    if (m_format == Format::BC7
+        || m_format == Format::ETC2RGB
+        || m_format == Format::ETC2RGBA)
+    {
+        //blocks can't be flipped without re-encoding them
+        return false;
+    }
+
+    for (auto i = 0u; i < m_levels.size(); ++i)
+    {
+        const auto height = getSize(i).y;
+        if (height > 4 && (height % 4) != 0)
+        {
+            //block rows don't line up once flipped
+            return false;
+        }
+    }
+
+    const auto blockSize = getBlockSize(m_format);
+    std::vector<std::uint8_t> rowBuffer;
+
+    for (auto i = 0u; i < m_levels.size(); ++i)
+    {
+        const auto size = getSize(i);
+        const auto blocksX = (size.x + 3) / 4;
+        const auto blocksY = (size.y + 3) / 4;
+        const auto rowSize = blocksX * blockSize;
+        const auto order = getRowOrder(size.y);
+        rowBuffer.resize(rowSize);
+
+        for (auto j = 0u; j < m_layerCount * m_faceCount; ++j)
+        {
+            auto* image = m_data.data() + m_levels[i].offset + (m_levels[i].imageSize * j);
+
+            for (auto y = 0u; y < blocksY / 2; ++y)
+            {
+                auto* a = image + (y * rowSize);
+                auto* b = image + ((blocksY - 1 - y) * rowSize);
+                std::memcpy(rowBuffer.data(), a, rowSize);
+                std::memcpy(a, b, rowSize);
+                std::memcpy(b, rowBuffer.data(), rowSize);
+            }
+
+            for (auto b = 0u; b < blocksX * blocksY; ++b)
+            {
+                flipBlock(m_format, image + (b * blockSize), order);
+            }
+        }
+    }
+
+    m_bottomUp = !m_bottomUp;
+    return true;
+}
+
+std::uint32_t CompressedImage::selectBaseLevel(std::uint32_t maxSize, std::uint32_t skip) const
+{
+    if (m_levels.empty())
+    {
+        return 0;
+    }
+
+    const auto lastLevel = getLevelCount() - 1;
+    auto level = std::min(skip, lastLevel);
+    while (level < lastLevel)
+    {
+        const auto size = getSize(level);
+        if (size.x <= maxSize && size.y <= maxSize)
+        {
+            break;
+        }
+        level++;
+    }
+    return level;
+}
+
+void CompressedImage::setBaseLevel(std::uint32_t level)
+{
+    if (level == 0 || level >= m_levels.size())
+    {
+        return;
+    }
+
+    const auto offset = m_levels[level].offset;
+    m_data.erase(m_data.begin(), m_data.begin() + offset);
+
+    m_size = getSize(level);
+    m_levels.erase(m_levels.begin(), m_levels.begin() + level);
+    for (auto& l : m_levels)
+    {
+        l.offset -= offset;
+    }
+}
+
+bool CompressedImage::decompress(std::vector<std::uint8_t>& dst, std::uint32_t level, std::uint32_t layer, std::uint32_t face) const
+{
+    if (!canDecompress(m_format))
+    {
+        LogE << getFormatName(m_format) << " images can't be decompressed" << std::endl;
+        return false;
+    }
+
+    const auto* src = getData(level, layer, face);
+    if (!src)
+    {
+        LogE << "Compressed image level " << level << ", layer " << layer << ", face " << face << " doesn't exist" << std::endl;
+        return false;
+    }
+
+    const auto size = getSize(level);
+    const auto blockSize = getBlockSize(m_format);
+    const auto blocksX = (size.x + 3) / 4;
+    const auto blocksY = (size.y + 3) / 4;
+
+    dst.resize(size.x * size.y * 4);
+
+    Block block = {};
+    for (auto by = 0u; by < blocksY; ++by)
+    {
+        for (auto bx = 0u; bx < blocksX; ++bx)
+        {
+            decodeBlock(m_format, src, block);
+            src += blockSize;
+
+            //partial blocks at the edge of the image only copy what fits
+            const auto width = std::min(4u, size.x - (bx * 4));
+            const auto height = std::min(4u, size.y - (by * 4));
+            for (auto y = 0u; y < height; ++y)
+            {
+                const auto dstOffset = (((by * 4 + y) * size.x) + (bx * 4)) * 4;
+                std::memcpy(dst.data() + dstOffset, &block[y * 16], width * 4);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CompressedImage::canDecompress(Format::Type format)
+{
+    return format != Format::None
+        && format != Format::BC7
+        && format < Format::Count;
+}
+
+std::size_t CompressedImage::getBlockSize(Format::Type format)
+{
+    return format < Format::Count ? Formats[format].blockSize : 0;
+}
+
+std::size_t CompressedImage::getImageSize(Format::Type format, glm::uvec2 size)
+{
+    return ((static_cast<std::size_t>(size.x) + 3) / 4) * ((static_cast<std::size_t>(size.y) + 3) / 4) * getBlockSize(format);
+}
+
+std::uint32_t CompressedImage::getGLFormat(Format::Type format)
+{
+    return format < Format::Count ? Formats[format].glFormat : 0;
+}
+
+const std::string& CompressedImage::getFormatName(Format::Type format)
+{
+    return format < Format::Count ? Formats[format].name : Formats[0].name;
+}
+
+std::string CompressedImage::getCompressedPath(const std::string& path)
+{
+    const auto ext = Util::String::toLower(FileSystem::getFileExtension(path));
+    if (ext == ".ktx2" || ext == ".dds")
+    {
+        return path;
+    }
+
+    if (ext.empty())
+    {
+        return {};
+    }
+
+    Detail::FileCache::TwinCheck twinCheck(path);
+    const auto basePath = path.substr(0, path.size() - ext.size());
+    for (const auto* twinExt : { ".ktx2", ".dds" })
+    {
+        if (const auto twinPath = basePath + twinExt;
+            twinCheck.isNewer(twinPath))
+        {
+            return twinPath;
+        }
+    }
+    return {};
+}
+
+std::string CompressedImage::getUncompressedPath(const std::string& path)
+{
+    const auto ext = FileSystem::getFileExtension(path);
+    const auto basePath = path.substr(0, path.size() - ext.size());
+
+    for (const auto* rawExt : { ".png", ".jpg", ".tga", ".bmp" })
+    {
+        auto* file = SDL_RWFromFile((basePath + rawExt).c_str(), "rb");
+        if (file)
+        {
+            SDL_RWclose(file);
+            return basePath + rawExt;
+        }
+    }
+    return {};
+}
+
+//private
+bool CompressedImage::loadKTX2(const std::uint8_t* data, std::size_t size)
+{
+    if (size < KTX2HeaderSize)
+    {
+        LogE << "KTX2 header is truncated" << std::endl;
+        return false;
+    }
+
+    const auto* header = data + KTX2Identifier.size();
+    const auto vkFormat = read<std::uint32_t>(header);
+    const auto width = read<std::uint32_t>(header + 8);
+    const auto height = read<std::uint32_t>(header + 12);
+    const auto depth = read<std::uint32_t>(header + 16);
+    const auto layerCount = std::max(1u, read<std::uint32_t>(header + 20));
+    const auto faceCount = read<std::uint32_t>(header + 24);
+    const auto levelCount = std::max(1u, read<std::uint32_t>(header + 28));
+    const auto supercompression = read<std::uint32_t>(header + 32);
+    const auto kvdOffset = read<std::uint32_t>(header + 44);
+    const auto kvdSize = read<std::uint32_t>(header + 48);
+
+    const auto format = fromVkFormat(vkFormat);
+    if (format == Format::None)
+    {
+        LogE << "KTX2 VkFormat " << vkFormat << " is not supported" << std::endl;
+        return false;
+    }
+
+    if (supercompression != 0)
+    {
+        LogE << "KTX2 supercompression is not supported" << std::endl;
+        return false;
+    }
+
+    if (height == 0 || depth > 1)
+    {
+        LogE << "Only 2D KTX2 images are supported" << std::endl;
+        return false;
+    }
+
+    if (levelCount > getMaxLevelCount({ width, height })
+        || KTX2HeaderSize + (levelCount * KTX2LevelIndexSize) > size)
+    {
+        LogE << "Invalid KTX2 level count" << std::endl;
+        return false;
+    }
+
+    //validate the level index against the header and the data we
+    //actually have before allocating anything based on the header
+    const auto totalSize = getTotalSize(format, { width, height }, 0, levelCount, layerCount, faceCount);
+    if (!totalSize || *totalSize > size)
+    {
+        LogE << "KTX2 image size " << width << ", " << height << " exceeds the file size" << std::endl;
+        return false;
+    }
+
+    const auto* levelIndex = data + KTX2HeaderSize;
+    for (auto i = 0u; i < levelCount; ++i)
+    {
+        const auto offset = read<std::uint64_t>(levelIndex + (i * KTX2LevelIndexSize));
+        const auto length = read<std::uint64_t>(levelIndex + (i * KTX2LevelIndexSize) + 8);
+        const auto expected = getTotalSize(format, { width, height }, i, 1, layerCount, faceCount);
+
+        if (!expected
+            || length != *expected
+            || offset > size
+            || size - offset < length)
+        {
+            LogE << "Invalid KTX2 data for level " << i << std::endl;
+            return false;
+        }
+    }
+
+    if (!create(format, { width, height }, levelCount, layerCount, faceCount))
+    {
+        return false;
+    }
+
+    for (auto i = 0u; i < levelCount; ++i)
+    {
+        const auto offset = read<std::uint64_t>(levelIndex + (i * KTX2LevelIndexSize));
+        const auto length = read<std::uint64_t>(levelIndex + (i * KTX2LevelIndexSize) + 8);
+        std::memcpy(m_data.data() + m_levels[i].offset, data + offset, length);
+    }
+
+    //the default orientation is top-down
+    m_bottomUp = false;
+    if (kvdOffset != 0 && kvdOffset <= size
+        && size - kvdOffset >= kvdSize)
+    {
+        const auto* kvd = data + kvdOffset;
+        std::size_t pos = 0;
+        while (pos + 4 <= kvdSize)
+        {
+            const auto length = read<std::uint32_t>(kvd + pos);
+            pos += 4;
+            if (length > kvdSize - pos)
+            {
+                break;
+            }
+
+            const std::string_view entry(reinterpret_cast<const char*>(kvd + pos), length);
+            const auto keyEnd = entry.find('\0');
+            if (keyEnd != std::string_view::npos
+                && entry.substr(0, keyEnd) == "KTXorientation")
+            {
+                const auto value = entry.substr(keyEnd + 1);
+                m_bottomUp = value.size() > 1 && value[1] == 'u';
+            }
+
+            pos += (length + 3) & ~3u;
+        }
+    }
+
+    return true;
+}
+
+bool CompressedImage::loadDDS(const std::uint8_t* data, std::size_t size)
+{
+    if (size < 4 + DDSHeaderSize)
+    {
+        LogE << "DDS header is truncated" << std::endl;
+        return false;
+    }
+
+    const auto* header = data + 4;
+    const auto height = read<std::uint32_t>(header + 8);
+    const auto width = read<std::uint32_t>(header + 12);
+    const auto levelCount = std::max(1u, read<std::uint32_t>(header + 24));
+    const auto pixelFlags = read<std::uint32_t>(header + 76);
+    const auto fourCC = read<std::uint32_t>(header + 80);
+    const auto caps2 = read<std::uint32_t>(header + 108);
+
+    constexpr std::uint32_t DDPF_FOURCC = 0x4;
+    constexpr std::uint32_t DDSCAPS2_CUBEMAP = 0x200;
+    constexpr std::uint32_t DDSCAPS2_CUBEMAP_ALLFACES = 0xfc00;
+    constexpr std::uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+    constexpr std::uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+
+    if ((pixelFlags & DDPF_FOURCC) == 0)
+    {
+        LogE << "Uncompressed DDS files are not supported" << std::endl;
+        return false;
+    }
+
+    auto format = Format::None;
+    std::uint32_t layerCount = 1;
+    std::uint32_t faceCount = 1;
+    std::size_t dataOffset = 4 + DDSHeaderSize;
+
+    if (fourCC == makeFourCC("DX10"))
+    {
+        if (size < dataOffset + DDSHeaderDX10Size)
+        {
+            LogE << "DDS header is truncated" << std::endl;
+            return false;
+        }
+
+        const auto* dx10 = data + dataOffset;
+        format = fromDXGIFormat(read<std::uint32_t>(dx10));
+        if (read<std::uint32_t>(dx10 + 4) != DDS_DIMENSION_TEXTURE2D)
+        {
+            LogE << "Only 2D DDS textures are supported" << std::endl;
+            return false;
+        }
+
+        if (read<std::uint32_t>(dx10 + 8) & DDS_RESOURCE_MISC_TEXTURECUBE)
+        {
+            faceCount = 6;
+        }
+        layerCount = std::max(1u, read<std::uint32_t>(dx10 + 12));
+        dataOffset += DDSHeaderDX10Size;
+    }
+    else
+    {
+        format = fromFourCC(fourCC);
+        if (caps2 & DDSCAPS2_CUBEMAP)
+        {
+            if ((caps2 & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES)
+            {
+                LogE << "DDS cubemaps must contain all six faces" << std::endl;
+                return false;
+            }
+            faceCount = 6;
+        }
+    }
+
+    if (format == Format::None)
+    {
+        LogE << "DDS pixel format is not supported" << std::endl;
+        return false;
+    }
+
+    if (levelCount > getMaxLevelCount({ width, height }))
+    {
+        LogE << "Invalid DDS mip map count" << std::endl;
+        return false;
+    }
+
+    //check the header against the data we actually have
+    //before allocating anything based on it
+    const auto dataSize = getTotalSize(format, { width, height }, 0, levelCount, layerCount, faceCount);
+    if (!dataSize || size - dataOffset < *dataSize)
+    {
+        LogE << "DDS data is truncated" << std::endl;
+        return false;
+    }
+
+    if (!create(format, { width, height }, levelCount, layerCount, faceCount))
+    {
+        return false;
+    }
+
+    //DDS stores each layer/face's complete mip chain in turn
+    //so shuffle these into levels
+    const auto* src = data + dataOffset;
+    for (auto i = 0u; i < layerCount * faceCount; ++i)
+    {
+        for (auto j = 0u; j < m_levels.size(); ++j)
+        {
+            const auto& level = m_levels[j];
+            std::memcpy(m_data.data() + level.offset + (level.imageSize * i), src, level.imageSize);
+            src += level.imageSize;
+        }
+    }
+
+    m_bottomUp = false;
+    return true;
+}
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2022 - 2024
+Matt Marchant 2022 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -29,6 +29,8 @@ source distribution.
 
 #include <crogine/graphics/CubemapTexture.hpp>
 #include <crogine/graphics/Image.hpp>
+#include <crogine/graphics/CompressedImage.hpp>
+#include <crogine/graphics/Texture.hpp>
 #include <crogine/core/ConfigFile.hpp>
 #include <crogine/core/Log.hpp>
 
@@ -102,6 +104,20 @@ std::uint32_t CubemapTexture::getGLHandle() const
 
 bool CubemapTexture::loadFromFile(const std::string& path)
 {
+    if (const auto compressedPath = CompressedImage::getCompressedPath(path); !compressedPath.empty())
+    {
+        if (loadCompressed(compressedPath))
+        {
+            return true;
+        }
+
+        if (compressedPath == path)
+        {
+            //nothing to fall back to
+            return false;
+        }
+    }
+
     std::array<std::string, CubemapDirection::Count> paths = {};
     if (!parseInputFile(path, paths))
     {
@@ -123,6 +139,7 @@ bool CubemapTexture::loadFromFile(const std::string& path)
         Image side(true);
 
         glCheck(glBindTexture(GL_TEXTURE_CUBE_MAP, m_handle));
+        glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 1000));
 
         Image* currImage = &fallback;
         GLenum format = GL_RGB;
@@ -304,6 +321,119 @@ void CubemapTexture::generateMipMaps()
 }
 
 //private
+bool CubemapTexture::loadCompressed(const std::string& path)
+{
+    CompressedImage image;
+    if (!image.loadFromFile(path))
+    {
+        return false;
+    }
+
+    if (image.getFaceCount() != 6)
+    {
+        LogE << path << ": not a cubemap" << std::endl;
+        return false;
+    }
+
+    GLint maxSize = 0;
+    glCheck(glGetIntegerv(GL_MAX_CUBE_MAP_TEXTURE_SIZE, &maxSize));
+    image.setBaseLevel(image.selectBaseLevel(static_cast<std::uint32_t>(maxSize), Texture::getMipLevelSkip()));
+
+    //faces are flipped to match those loaded from *.ccm files
+    const auto format = image.getFormat();
+    const bool supported = Texture::isFormatSupported(format);
+    const bool flipped = image.isBottomUp() || (supported && image.flipVertically());
+    const bool decompress = CompressedImage::canDecompress(format) && (!supported || !flipped);
+
+    if (!supported && !decompress)
+    {
+        LogE << path << ": " << CompressedImage::getFormatName(format) << " is not supported on this device" << std::endl;
+        return false;
+    }
+
+    if (!flipped && !decompress)
+    {
+        LogW << path << ": " << CompressedImage::getFormatName(format) << " images can't be flipped, cubemap will appear upside down" << std::endl;
+    }
+
+    if (m_handle == 0)
+    {
+        glCheck(glGenTextures(1, &m_handle));
+    }
+
+    const auto layerCount = image.getLayerCount();
+    const auto target = layerCount > 1 ? GL_TEXTURE_CUBE_MAP_ARRAY : GL_TEXTURE_CUBE_MAP;
+    auto levelCount = image.getLevelCount();
+    const auto size = image.getSize();
+
+    glCheck(glBindTexture(target, m_handle));
+
+    if (decompress)
+    {
+        //only the top level, use generateMipMaps() if needed
+        levelCount = 1;
+
+        if (layerCount > 1)
+        {
+            glCheck(glTexImage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 0, GL_RGBA, size.x, size.y, layerCount * 6, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+        }
+
+        std::vector<std::uint8_t> pixels;
+        Image face(!image.isBottomUp());
+        for (auto i = 0u; i < layerCount; ++i)
+        {
+            for (auto j = 0u; j < CubemapDirection::Count; ++j)
+            {
+                image.decompress(pixels, 0, i, j);
+                face.loadFromMemory(pixels.data(), size.x, size.y, ImageFormat::RGBA);
+
+                if (layerCount > 1)
+                {
+                    glCheck(glTexSubImage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 0, 0, 0, (i * 6) + j, size.x, size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, face.getPixelData()));
+                }
+                else
+                {
+                    glCheck(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + j, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, face.getPixelData()));
+                }
+            }
+        }
+    }
+    else
+    {
+        const auto glFormat = CompressedImage::getGLFormat(format);
+        for (auto i = 0u; i < levelCount; ++i)
+        {
+            const auto levelSize = image.getSize(i);
+            const auto dataSize = static_cast<GLsizei>(image.getDataSize(i));
+
+            if (layerCount > 1)
+            {
+                //layers and faces are stored contiguously in the same order GL expects
+                glCheck(glCompressedTexImage3D(GL_TEXTURE_CUBE_MAP_ARRAY, i, glFormat, levelSize.x, levelSize.y, layerCount * 6, 0, dataSize * layerCount * 6, image.getData(i)));
+            }
+            else
+            {
+                for (auto j = 0u; j < CubemapDirection::Count; ++j)
+                {
+                    glCheck(glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + j, i, glFormat, levelSize.x, levelSize.y, 0, dataSize, image.getData(i, 0, j)));
+                }
+            }
+        }
+    }
+
+    glCheck(glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    glCheck(glTexParameteri(target, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR));
+    glCheck(glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(target, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0));
+    glCheck(glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levelCount - 1));
+
+    m_cubemapCount = layerCount;
+
+    return true;
+}
+
 bool CubemapTexture::parseInputFile(const std::string& path, std::array<std::string, CubemapDirection::Count>& outPaths)
 {
     if (FileSystem::getFileExtension(path) != ".ccm")
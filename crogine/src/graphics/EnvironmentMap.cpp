@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -171,7 +171,9 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
 
     TempTexture tempTexture;
 
-    stbi_set_flip_vertically_on_load(1);
+    //set this only for this thread, so we don't flip
+    //any images being decoded on other threads
+    stbi_set_flip_vertically_on_load_thread(1);
     auto* data = stbi_loadf_from_callbacks(&io.stb_cbs, &io, &width, &height, &componentCount, 0);
     if (data)
     {
@@ -193,7 +195,7 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
         
         return false;
     }
-    stbi_set_flip_vertically_on_load(0);
+    stbi_set_flip_vertically_on_load_thread(0);
     SDL_RWclose(file);
 
     //create a temp render buffer/frame buffer to render the sides with
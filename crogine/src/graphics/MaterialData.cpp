@@ -35,9 +35,32 @@ source distribution.
 
 #include "../detail/GLCheck.hpp"
 
+#include <atomic>
+#include <algorithm>
+
 using namespace cro;
 using namespace cro::Material;
 
+namespace
+{
+    //properties may be set from parallel system updates
+    std::atomic<std::size_t> propertyLookups = 0;
+    std::atomic<std::size_t> resolvedAllocations = 0;
+
+    Material::Stats lastFrameStats;
+}
+
+const Material::Stats& Material::getFrameStats()
+{
+    return lastFrameStats;
+}
+
+void Material::updateFrameStats()
+{
+    lastFrameStats.propertyLookups = propertyLookups.exchange(0);
+    lastFrameStats.resolvedAllocations = resolvedAllocations.exchange(0);
+}
+
 TextureID::TextureID(const cro::Texture& t)
     : textureID(t.getGLHandle()), m_isArray(false) {}
 
@@ -91,109 +114,100 @@ Property::Property()
 void Data::setProperty(const std::string& name, float value)
 {
     VERIFY(name);
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        result->second.second.numberValue = value;
-        result->second.second.type = Property::Number;
+        property->numberValue = value;
+        property->type = Property::Number;
     }
 }
 
 void Data::setProperty(const std::string& name, glm::vec2 value)
 {
     VERIFY(name);
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        //result->second.second.lastVecValue[0] = result->second.second.vecValue[0];
-        //result->second.second.lastVecValue[1] = result->second.second.vecValue[1];
-        result->second.second.vecValue[0] = value.x;
-        result->second.second.vecValue[1] = value.y;
-        result->second.second.type = Property::Vec2;
+        //property->lastVecValue[0] = property->vecValue[0];
+        //property->lastVecValue[1] = property->vecValue[1];
+        property->vecValue[0] = value.x;
+        property->vecValue[1] = value.y;
+        property->type = Property::Vec2;
     }
 }
 
 void Data::setProperty(const std::string& name, glm::vec3 value)
 {
     VERIFY(name);
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        result->second.second.vecValue[0] = value.x;
-        result->second.second.vecValue[1] = value.y;
-        result->second.second.vecValue[2] = value.z;
-        result->second.second.type = Property::Vec3;
+        property->vecValue[0] = value.x;
+        property->vecValue[1] = value.y;
+        property->vecValue[2] = value.z;
+        property->type = Property::Vec3;
     }
 }
 
 void Data::setProperty(const std::string& name, glm::vec4 value)
 {
     VERIFY(name);
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        result->second.second.vecValue[0] = value.x;
-        result->second.second.vecValue[1] = value.y;
-        result->second.second.vecValue[2] = value.z;
-        result->second.second.vecValue[3] = value.w;
-        result->second.second.type = Property::Vec4;
+        property->vecValue[0] = value.x;
+        property->vecValue[1] = value.y;
+        property->vecValue[2] = value.z;
+        property->vecValue[3] = value.w;
+        property->type = Property::Vec4;
     }
 }
 
 void Data::setProperty(const std::string& name, glm::mat4 value)
 {
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        result->second.second.matrixValue = value;
-        result->second.second.type = Property::Mat4;
+        property->matrixValue = value;
+        property->type = Property::Mat4;
     }
 }
 
 void Data::setProperty(const std::string& name, Colour value)
 {
     VERIFY(name);
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        result->second.second.vecValue[0] = value.getRed();
-        result->second.second.vecValue[1] = value.getGreen();
-        result->second.second.vecValue[2] = value.getBlue();
-        result->second.second.vecValue[3] = value.getAlpha();
-        result->second.second.type = Property::Vec4;
+        property->vecValue[0] = value.getRed();
+        property->vecValue[1] = value.getGreen();
+        property->vecValue[2] = value.getBlue();
+        property->vecValue[3] = value.getAlpha();
+        property->type = Property::Vec4;
     }
 }
 
 void Data::setProperty(const std::string& name, const Texture& value)
 {
     VERIFY(name);
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        result->second.second.textureID = value.getGLHandle();
-        result->second.second.type = Property::Texture;
+        property->textureID = value.getGLHandle();
+        property->type = Property::Texture;
     }
 }
 
 void Data::setProperty(const std::string& name, TextureID value)
 {
     VERIFY(name);
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        result->second.second.textureID = value.textureID;
-        result->second.second.type = value.isArray() ? Property::TextureArray : Property::Texture;
+        property->textureID = value.textureID;
+        property->type = value.isArray() ? Property::TextureArray : Property::Texture;
     }
 }
 
 void Data::setProperty(const std::string& name, CubemapID value)
 {
     VERIFY(name);
-    auto result = properties.find(name);
-    if (result != properties.end())
+    if (auto* property = findProperty(name); property)
     {
-        result->second.second.textureID = value.textureID;
-        result->second.second.type = value.isArray() ? Property::CubemapArray : Property::Cubemap;
+        property->textureID = value.textureID;
+        property->type = value.isArray() ? Property::CubemapArray : Property::Cubemap;
     }
 }
 
@@ -405,13 +419,57 @@ void Data::setShader(const Shader& s)
         }
     }
 
+    m_resolvedProperties.dirty = true;
+
     //mark this material as having the any uniform
     //blocks available if the shader supposrts it
     m_hasCameraUBO = (glGetUniformBlockIndex(shader, "CameraUniforms") != GL_INVALID_INDEX);
     m_hasLightUBO = (glGetUniformBlockIndex(shader, "LightUniforms") != GL_INVALID_INDEX);
 }
 
+const std::vector<ResolvedProperty>& Data::getResolvedProperties() const
+{
+    //properties may have been added or erased directly, eg by SpriteSystem3D,
+    //which can leave the resolved pointers dangling even if the size is the same
+    if (m_resolvedProperties.dirty
+        || m_resolvedProperties.generation != properties.getGeneration())
+    {
+        auto& resolved = m_resolvedProperties.properties;
+        if (resolved.capacity() < properties.size())
+        {
+            resolvedAllocations++;
+        }
+
+        resolved.clear();
+        for (const auto& [name, prop] : properties)
+        {
+            resolved.push_back({ prop.first, &prop.second });
+        }
+
+        //unordered_map iteration order may differ between copies
+        std::sort(resolved.begin(), resolved.end(), 
+            [](const ResolvedProperty& a, const ResolvedProperty& b)
+            {
+                return a.location < b.location;
+            });
+
+        m_resolvedProperties.generation = properties.getGeneration();
+        m_resolvedProperties.dirty = false;
+    }
+    return m_resolvedProperties.properties;
+}
+
 //private
+Property* Data::findProperty(const std::string& name)
+{
+    propertyLookups++;
+    if (auto result = properties.find(name); result != properties.end())
+    {
+        return &result->second.second;
+    }
+    return nullptr;
+}
+
 void Material::Data::exists(const std::string& name)
 {
     if (properties.count(name) == 0)
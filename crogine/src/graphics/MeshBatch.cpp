@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -191,11 +191,22 @@ void MeshBatch::updateMeshData(Mesh::Data& data) const
 
     if (data.attributeFlags == m_flags)
     {
-        //upload to vbo/ibo
-        data.vertexCount = m_vertexData.size() / (data.vertexSize / sizeof(float));
-        
+        //upload to vbo/ibo - if the mesh was created with
+        //quantised attributes the batch data needs packing to match
+        const auto stride = Mesh::getUnpackedVertexSize(data) / sizeof(float);
+        data.vertexCount = m_vertexData.size() / stride;
+
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, data.vbo));
-        glCheck(glBufferData(GL_ARRAY_BUFFER, data.vertexSize * data.vertexCount, m_vertexData.data(), GL_STATIC_DRAW));
+        if (data.vertexSize == stride * sizeof(float))
+        {
+            glCheck(glBufferData(GL_ARRAY_BUFFER, data.vertexSize * data.vertexCount, m_vertexData.data(), GL_STATIC_DRAW));
+        }
+        else
+        {
+            std::vector<std::uint8_t> packedData;
+            Mesh::packVertexData(data, m_vertexData.data(), packedData);
+            glCheck(glBufferData(GL_ARRAY_BUFFER, packedData.size(), packedData.data(), GL_STATIC_DRAW));
+        }
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 
         for (auto i = 0u; i < data.submeshCount; ++i)
@@ -212,7 +223,7 @@ void MeshBatch::updateMeshData(Mesh::Data& data) const
         //boundingbox / sphere
         data.boundingBox[0] = glm::vec3(std::numeric_limits<float>::max());
         data.boundingBox[1] = glm::vec3(std::numeric_limits<float>::min());
-        for (std::size_t i = 0; i < m_vertexData.size(); i += (data.vertexSize / sizeof(float)))
+        for (std::size_t i = 0; i < m_vertexData.size(); i += stride)
         {
             //min point
             if (data.boundingBox[0].x > m_vertexData[i])
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -29,10 +29,73 @@ source distribution.
 
 #include <crogine/graphics/MeshBuilder.hpp>
 
+#include <crogine/detail/Assert.hpp>
+
 #include "../detail/GLCheck.hpp"
 
 using namespace cro;
 
+namespace
+{
+    bool formatSupported(std::int32_t attribute, std::uint8_t format)
+    {
+        switch (format)
+        {
+        default: return false;
+        case Mesh::AttributeFormat::Float:
+            return true;
+        case Mesh::AttributeFormat::HalfFloat:
+            return attribute != Mesh::Attribute::Position
+                && attribute != Mesh::Attribute::BlendIndices;
+        case Mesh::AttributeFormat::UNorm8:
+            return attribute == Mesh::Attribute::Colour
+                || attribute == Mesh::Attribute::BlendWeights;
+        case Mesh::AttributeFormat::SNorm10_10_10_2:
+            return attribute == Mesh::Attribute::Normal
+                || attribute == Mesh::Attribute::Tangent
+                || attribute == Mesh::Attribute::Bitangent;
+        }
+    }
+}
+
+//public
+void MeshBuilder::setAttributeFormat(Mesh::Attribute attribute, std::uint8_t format)
+{
+    CRO_ASSERT(attribute > Mesh::Attribute::Invalid && attribute < Mesh::Attribute::Total, "");
+
+#ifdef PLATFORM_MOBILE
+    if (format != Mesh::AttributeFormat::Float)
+    {
+        LogW << "Quantised vertex attributes are not supported on this platform" << std::endl;
+        return;
+    }
+#endif
+
+    if (!formatSupported(attribute, format))
+    {
+        LogW << "Format " << static_cast<std::int32_t>(format) << " is not supported by vertex attribute " << attribute << std::endl;
+        return;
+    }
+    m_attributeFormats[attribute] = format;
+}
+
+void MeshBuilder::setQuantised(bool quantised)
+{
+    m_attributeFormats = {};
+
+    if (quantised)
+    {
+        setAttributeFormat(Mesh::Attribute::Colour, Mesh::AttributeFormat::UNorm8);
+        setAttributeFormat(Mesh::Attribute::Normal, Mesh::AttributeFormat::SNorm10_10_10_2);
+        setAttributeFormat(Mesh::Attribute::Tangent, Mesh::AttributeFormat::SNorm10_10_10_2);
+        setAttributeFormat(Mesh::Attribute::Bitangent, Mesh::AttributeFormat::SNorm10_10_10_2);
+        setAttributeFormat(Mesh::Attribute::UV0, Mesh::AttributeFormat::HalfFloat);
+        setAttributeFormat(Mesh::Attribute::UV1, Mesh::AttributeFormat::HalfFloat);
+    }
+}
+
+//protected
+
 std::size_t MeshBuilder::getAttributeSize(const std::array<std::size_t, Mesh::Attribute::Total>& attrib)
 {
     std::size_t size = 0;
@@ -48,11 +111,42 @@ std::size_t MeshBuilder::getVertexSize(const std::array<std::size_t, Mesh::Attri
     return getAttributeSize(attrib) * sizeof(float);
 }
 
-void MeshBuilder::createVBO(Mesh::Data& meshData, const std::vector<float>& vertexData)
+void MeshBuilder::createVBO(Mesh::Data& meshData, const std::vector<float>& vertexData) const
+{
+    createVBO(meshData, vertexData.data());
+}
+
+void MeshBuilder::createVBO(Mesh::Data& meshData, const float* vertexData) const
+{
+    bool quantised = false;
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        //only pack attributes which actually exist in the mesh
+        meshData.attributeFormats[i] = meshData.attributes[i] != 0 ? m_attributeFormats[i] : Mesh::AttributeFormat::Float;
+        quantised = quantised || meshData.attributeFormats[i] != Mesh::AttributeFormat::Float;
+    }
+
+    if (!quantised)
+    {
+        createVBO(meshData, static_cast<const void*>(vertexData));
+        return;
+    }
+
+    std::vector<std::uint8_t> packedData;
+    meshData.vertexSize = Mesh::packVertexData(meshData, vertexData, packedData);
+    createVBO(meshData, static_cast<const void*>(packedData.data()));
+
+#ifdef CRO_DEBUG_
+    LogI << "Quantised mesh vertex data: " << (Mesh::getUnpackedVertexSize(meshData) * meshData.vertexCount)
+        << " bytes to " << packedData.size() << " bytes, saved " << Mesh::getQuantisedBytesSaved(meshData) << " bytes" << std::endl;
+#endif
+}
+
+void MeshBuilder::createVBO(Mesh::Data& meshData, const void* vertexData)
 {
     glCheck(glGenBuffers(1, &meshData.vbo));
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-    glCheck(glBufferData(GL_ARRAY_BUFFER, meshData.vertexSize * meshData.vertexCount, vertexData.data(), GL_STATIC_DRAW));
+    glCheck(glBufferData(GL_ARRAY_BUFFER, meshData.vertexSize * meshData.vertexCount, vertexData, GL_STATIC_DRAW));
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 }
 
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2021
+Matt Marchant 2021 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -28,10 +28,14 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/graphics/MeshData.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <crogine/detail/glm/gtc/packing.hpp>
 
 #include "../detail/GLCheck.hpp"
 
 #include <type_traits>
+#include <cstring>
 
 /*
 OK So this is basically esoteric template specialisation
@@ -50,10 +54,22 @@ namespace
             || std::is_same<T, std::uint32_t>::value, "must be uint8, uint16 or uint32");
 
         destVerts.clear();
-        destVerts.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-        glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, destVerts.data()));
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        if (getQuantisedBytesSaved(meshData) == 0)
+        {
+            destVerts.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
+            glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, destVerts.data()));
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        }
+        else
+        {
+            std::vector<std::uint8_t> packed(meshData.vertexCount * meshData.vertexSize);
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
+            glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, packed.size(), packed.data()));
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+
+            unpackVertexData(meshData, packed.data(), destVerts);
+        }
 
         destIndices.clear();
         destIndices.resize(meshData.submeshCount);
@@ -68,6 +84,181 @@ namespace
     }
 }
 
+std::size_t cro::Mesh::getAttributeByteSize(std::size_t componentCount, std::uint8_t format)
+{
+    if (componentCount == 0)
+    {
+        return 0;
+    }
+
+    std::size_t size = 0;
+    switch (format)
+    {
+    default:
+    case AttributeFormat::Float:
+        size = componentCount * sizeof(float);
+        break;
+    case AttributeFormat::HalfFloat:
+        size = componentCount * sizeof(std::uint16_t);
+        break;
+    case AttributeFormat::UNorm8:
+        size = componentCount;
+        break;
+    case AttributeFormat::SNorm10_10_10_2:
+        CRO_ASSERT(componentCount < 5, "");
+        size = sizeof(std::uint32_t);
+        break;
+    }
+
+    //keep each attribute 4 byte aligned
+    return (size + 3) & ~std::size_t(3);
+}
+
+std::array<std::size_t, Attribute::Total> cro::Mesh::getAttributeOffsets(const Data& meshData)
+{
+    std::array<std::size_t, Attribute::Total> retVal = {};
+    std::size_t offset = 0;
+    for (auto i = 0u; i < Attribute::Total; ++i)
+    {
+        retVal[i] = offset;
+        offset += getAttributeByteSize(meshData.attributes[i], meshData.attributeFormats[i]);
+    }
+    return retVal;
+}
+
+std::size_t cro::Mesh::getUnpackedVertexSize(const Data& meshData)
+{
+    std::size_t size = 0;
+    for (auto a : meshData.attributes)
+    {
+        size += a;
+    }
+    return size * sizeof(float);
+}
+
+std::size_t cro::Mesh::getQuantisedBytesSaved(const Data& meshData)
+{
+    const auto unpackedSize = getUnpackedVertexSize(meshData);
+    if (meshData.vertexSize >= unpackedSize)
+    {
+        return 0;
+    }
+    return (unpackedSize - meshData.vertexSize) * meshData.vertexCount;
+}
+
+std::size_t cro::Mesh::packVertexData(const Data& meshData, const float* src, std::vector<std::uint8_t>& dst)
+{
+    CRO_ASSERT(src, "");
+
+    const auto offsets = getAttributeOffsets(meshData);
+    const auto vertexSize = offsets.back() + getAttributeByteSize(meshData.attributes.back(), meshData.attributeFormats.back());
+
+    dst.clear();
+    dst.resize(vertexSize * meshData.vertexCount);
+
+    for (auto v = 0u; v < meshData.vertexCount; ++v)
+    {
+        auto* vertex = dst.data() + (v * vertexSize);
+
+        for (auto i = 0u; i < Attribute::Total; ++i)
+        {
+            const auto count = meshData.attributes[i];
+            auto* out = vertex + offsets[i];
+
+            switch (meshData.attributeFormats[i])
+            {
+            default:
+            case AttributeFormat::Float:
+                std::memcpy(out, src, count * sizeof(float));
+                break;
+            case AttributeFormat::HalfFloat:
+                for (auto j = 0u; j < count; ++j)
+                {
+                    const auto h = glm::packHalf1x16(src[j]);
+                    std::memcpy(out + (j * sizeof(h)), &h, sizeof(h));
+                }
+                break;
+            case AttributeFormat::UNorm8:
+                for (auto j = 0u; j < count; ++j)
+                {
+                    out[j] = glm::packUnorm1x8(src[j]);
+                }
+                break;
+            case AttributeFormat::SNorm10_10_10_2:
+            {
+                glm::vec4 value(0.f);
+                for (auto j = 0u; j < count; ++j)
+                {
+                    value[j] = src[j];
+                }
+                const auto p = glm::packSnorm3x10_1x2(value);
+                std::memcpy(out, &p, sizeof(p));
+            }
+                break;
+            }
+            src += count;
+        }
+    }
+
+    return vertexSize;
+}
+
+void cro::Mesh::unpackVertexData(const Data& meshData, const std::uint8_t* src, std::vector<float>& dst)
+{
+    CRO_ASSERT(src, "");
+
+    const auto offsets = getAttributeOffsets(meshData);
+    const auto componentCount = getUnpackedVertexSize(meshData) / sizeof(float);
+
+    dst.clear();
+    dst.resize(componentCount * meshData.vertexCount);
+    auto* out = dst.data();
+
+    for (auto v = 0u; v < meshData.vertexCount; ++v)
+    {
+        const auto* vertex = src + (v * meshData.vertexSize);
+
+        for (auto i = 0u; i < Attribute::Total; ++i)
+        {
+            const auto count = meshData.attributes[i];
+            const auto* in = vertex + offsets[i];
+
+            switch (meshData.attributeFormats[i])
+            {
+            default:
+            case AttributeFormat::Float:
+                std::memcpy(out, in, count * sizeof(float));
+                break;
+            case AttributeFormat::HalfFloat:
+                for (auto j = 0u; j < count; ++j)
+                {
+                    std::uint16_t h = 0;
+                    std::memcpy(&h, in + (j * sizeof(h)), sizeof(h));
+                    out[j] = glm::unpackHalf1x16(h);
+                }
+                break;
+            case AttributeFormat::UNorm8:
+                for (auto j = 0u; j < count; ++j)
+                {
+                    out[j] = glm::unpackUnorm1x8(in[j]);
+                }
+                break;
+            case AttributeFormat::SNorm10_10_10_2:
+            {
+                std::uint32_t p = 0;
+                std::memcpy(&p, in, sizeof(p));
+                const auto value = glm::unpackSnorm3x10_1x2(p);
+                for (auto j = 0u; j < count; ++j)
+                {
+                    out[j] = value[j];
+                }
+            }
+                break;
+            }
+            out += count;
+        }
+    }
+}
 
 void cro::Mesh::readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint8_t>>& destIndices)
 {
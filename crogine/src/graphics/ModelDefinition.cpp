@@ -298,6 +298,13 @@ bool ModelDefinition::loadFromFile(const std::string& inPath, bool instanced, bo
         m_castShadows = shadowProp->getValue<bool>();
     }
 
+    //static meshes can optionally pack their attributes
+    //into smaller formats to reduce their vertex size
+    if (auto* prop = cfg.findProperty("quantise_vertices"); prop != nullptr)
+    {
+        meshBuilder->setQuantised(prop->getValue<bool>());
+    }
+
     //do all the resource loading last when we know properties are valid,
     //to prevent partially loading a model and wasting resources.
     m_meshID = m_resources.meshes.loadMesh(*meshBuilder.get(), forceReload);
@@ -0,0 +1,259 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include <crogine/graphics/RenderStateCache.hpp>
+#include <crogine/graphics/MaterialData.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include "../detail/GLCheck.hpp"
+
+using namespace cro;
+
+RenderStateCache::RenderStateCache(std::vector<RenderCommand>* recorder)
+    : m_recorder    (recorder),
+    m_program       (Unknown),
+    m_frontFace     (Unknown),
+    m_depthMask     (Unknown),
+    m_blendEquation (Unknown)
+{
+    invalidate();
+}
+
+//public
+bool RenderStateCache::useProgram(std::uint32_t program)
+{
+    if (changed(m_program, program))
+    {
+        if (m_recorder)
+        {
+            m_recorder->push_back({ RenderCommand::UseProgram, program });
+        }
+        else
+        {
+            glCheck(glUseProgram(program));
+        }
+        return true;
+    }
+    return false;
+}
+
+void RenderStateCache::setFrontFace(std::uint32_t winding)
+{
+    if (changed(m_frontFace, winding))
+    {
+        if (m_recorder)
+        {
+            m_recorder->push_back({ RenderCommand::FrontFace, winding });
+        }
+        else
+        {
+            glCheck(glFrontFace(winding));
+        }
+    }
+}
+
+void RenderStateCache::setEnabled(std::uint32_t capability, bool enabled)
+{
+    std::int32_t index = -1;
+    switch (capability)
+    {
+    default: break;
+    case GL_BLEND:
+        index = Capability::Blend;
+        break;
+    case GL_CULL_FACE:
+        index = Capability::CullFace;
+        break;
+    case GL_DEPTH_TEST:
+        index = Capability::DepthTest;
+        break;
+    }
+
+    if (index == -1
+        || changed(m_capabilities[index], enabled ? 1 : 0))
+    {
+        if (index == -1)
+        {
+            m_stats.issued++;
+        }
+
+        if (m_recorder)
+        {
+            m_recorder->push_back({ enabled ? RenderCommand::Enable : RenderCommand::Disable, capability });
+        }
+        else if (enabled)
+        {
+            glCheck(glEnable(capability));
+        }
+        else
+        {
+            glCheck(glDisable(capability));
+        }
+    }
+}
+
+void RenderStateCache::setDepthMask(bool enabled)
+{
+    if (changed(m_depthMask, enabled ? 1 : 0))
+    {
+        if (m_recorder)
+        {
+            m_recorder->push_back({ RenderCommand::DepthMask, enabled ? 1u : 0u });
+        }
+        else
+        {
+            glCheck(glDepthMask(enabled ? GL_TRUE : GL_FALSE));
+        }
+    }
+}
+
+void RenderStateCache::setBlendFunc(std::uint32_t src, std::uint32_t dst)
+{
+    if (m_blendFunc[0] != src || m_blendFunc[1] != dst)
+    {
+        m_blendFunc = { src, dst };
+        m_stats.issued++;
+
+        if (m_recorder)
+        {
+            m_recorder->push_back({ RenderCommand::BlendFunc, src, dst });
+        }
+        else
+        {
+            glCheck(glBlendFunc(src, dst));
+        }
+    }
+    else
+    {
+        m_stats.skipped++;
+    }
+}
+
+void RenderStateCache::setBlendEquation(std::uint32_t equation)
+{
+    if (changed(m_blendEquation, equation))
+    {
+        if (m_recorder)
+        {
+            m_recorder->push_back({ RenderCommand::BlendEquation, equation });
+        }
+        else
+        {
+            glCheck(glBlendEquation(equation));
+        }
+    }
+}
+
+void RenderStateCache::applyBlendMode(const Material::Data& material)
+{
+    //face culling is set by material 'double sided' property
+
+    switch (material.blendMode)
+    {
+    default: break;
+    case Material::BlendMode::Custom:
+        CRO_ASSERT(!material.blendData.enableProperties.empty(), "You'll probably want at least GL_BLEND and GL_DEPTH_TEST");
+        for (auto e : material.blendData.enableProperties)
+        {
+            setEnabled(e, true);
+        }
+        setDepthMask(material.blendData.writeDepthMask);
+        setBlendFunc(material.blendData.blendFunc[0], material.blendData.blendFunc[1]);
+        setBlendEquation(material.blendData.equation);
+        break;
+    case Material::BlendMode::Additive:
+        setEnabled(GL_BLEND, true);
+        setEnabled(GL_DEPTH_TEST, true);
+        setDepthMask(false);
+        setBlendFunc(GL_ONE, GL_ONE);
+        setBlendEquation(GL_FUNC_ADD);
+        break;
+    case Material::BlendMode::Alpha:
+        //make sure to test existing depth
+        //values, just don't write new ones.
+        setEnabled(GL_BLEND, true);
+        setEnabled(GL_DEPTH_TEST, true);
+        setDepthMask(false);
+        setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        setBlendEquation(GL_FUNC_ADD);
+        break;
+    case Material::BlendMode::Multiply:
+        setEnabled(GL_BLEND, true);
+        setEnabled(GL_DEPTH_TEST, true);
+        setDepthMask(false);
+        setBlendFunc(GL_DST_COLOR, GL_ZERO);
+        setBlendEquation(GL_FUNC_ADD);
+        break;
+    case Material::BlendMode::None:
+        setEnabled(GL_BLEND, false);
+        setEnabled(GL_DEPTH_TEST, true);
+        setDepthMask(true);
+        break;
+    }
+}
+
+void RenderStateCache::applyMaterial(const Material::Data& material)
+{
+    applyBlendMode(material);
+
+    //TODO move these to custom settings list
+    setEnabled(GL_CULL_FACE, !material.doubleSided);
+    setEnabled(GL_DEPTH_TEST, material.enableDepthTest);
+}
+
+void RenderStateCache::record(RenderCommand::Type type, std::uint32_t a, std::uint32_t b)
+{
+    if (m_recorder)
+    {
+        m_recorder->push_back({ type, a, b });
+    }
+}
+
+void RenderStateCache::invalidate()
+{
+    m_program = Unknown;
+    m_frontFace = Unknown;
+    m_depthMask = Unknown;
+    m_blendFunc = { Unknown, Unknown };
+    m_blendEquation = Unknown;
+    m_capabilities.fill(Unknown);
+}
+
+//private
+bool RenderStateCache::changed(std::uint32_t& current, std::uint32_t value)
+{
+    if (current != value)
+    {
+        current = value;
+        m_stats.issued++;
+        return true;
+    }
+    m_stats.skipped++;
+    return false;
+}
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2024
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -30,11 +30,25 @@ source distribution.
 #include <crogine/core/Log.hpp>
 
 #include <crogine/graphics/Spatial.hpp>
+#include <crogine/detail/Assert.hpp>
 
 #include <crogine/detail/glm/vec3.hpp>
 #include <crogine/detail/glm/geometric.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
 
+#include <bitset>
+#include <cstring>
+
+//AVX is enough for 8 wide float compares, so we don't need to
+//require AVX2. This is enabled with the USE_AVX CMake option
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CRO_CULL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CRO_CULL_SSE
+#endif
+
 using namespace cro;
 
 Sphere::Sphere()
@@ -237,4 +251,90 @@ Box Spatial::updateFrustum(std::array<Plane, 6u>& frustum, glm::mat4 viewProj)
         });
 
     return { glm::vec3(minX->x, minY->y, minZ->z), glm::vec3(maxX->x, maxY->y, maxZ->z) };
-}
\ No newline at end of file
+}
+
+std::size_t Spatial::cullSpheres(const Frustum& frustum, const SphereBatch& spheres, std::size_t start, std::size_t count, std::uint64_t* output)
+{
+    CRO_ASSERT(start + count <= spheres.size(), "Range out of bounds");
+    CRO_ASSERT(output, "");
+
+    std::memset(output, 0, ((count + 63) / 64) * sizeof(std::uint64_t));
+
+    const float* px = spheres.x.data() + start;
+    const float* py = spheres.y.data() + start;
+    const float* pz = spheres.z.data() + start;
+    const float* pr = spheres.radius.data() + start;
+
+    //batches are always a multiple of 4 or 8 so the resulting bits
+    //never straddle a word boundary in the output
+    std::size_t i = 0;
+
+#if defined(CRO_CULL_AVX)
+    for (; i + 8 <= count; i += 8)
+    {
+        const auto x = _mm256_loadu_ps(px + i);
+        const auto y = _mm256_loadu_ps(py + i);
+        const auto z = _mm256_loadu_ps(pz + i);
+        const auto negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(pr + i));
+
+        auto visible = _mm256_cmp_ps(negRadius, negRadius, _CMP_EQ_OQ); //all set unless NaN
+        for (const auto& plane : frustum)
+        {
+            auto dist = _mm256_mul_ps(x, _mm256_set1_ps(plane.x));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(y, _mm256_set1_ps(plane.y)));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(z, _mm256_set1_ps(plane.z)));
+            dist = _mm256_add_ps(dist, _mm256_set1_ps(plane.w));
+
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(dist, negRadius, _CMP_GE_OQ));
+        }
+
+        const auto bits = static_cast<std::uint64_t>(_mm256_movemask_ps(visible));
+        output[i / 64] |= bits << (i % 64);
+    }
+#elif defined(CRO_CULL_SSE)
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto x = _mm_loadu_ps(px + i);
+        const auto y = _mm_loadu_ps(py + i);
+        const auto z = _mm_loadu_ps(pz + i);
+        const auto negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(pr + i));
+
+        auto visible = _mm_cmpeq_ps(negRadius, negRadius); //all set unless NaN
+        for (const auto& plane : frustum)
+        {
+            auto dist = _mm_mul_ps(x, _mm_set1_ps(plane.x));
+            dist = _mm_add_ps(dist, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            dist = _mm_add_ps(dist, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            dist = _mm_add_ps(dist, _mm_set1_ps(plane.w));
+
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(dist, negRadius));
+        }
+
+        const auto bits = static_cast<std::uint64_t>(_mm_movemask_ps(visible));
+        output[i / 64] |= bits << (i % 64);
+    }
+#endif
+
+    //remainder, or everything if there's no SIMD support
+    for (; i < count; ++i)
+    {
+        bool visible = true;
+        for (const auto& plane : frustum)
+        {
+            const float dist = (px[i] * plane.x) + (py[i] * plane.y) + (pz[i] * plane.z) + plane.w;
+            visible = visible && (dist >= -pr[i]);
+        }
+
+        if (visible)
+        {
+            output[i / 64] |= (std::uint64_t(1) << (i % 64));
+        }
+    }
+
+    std::size_t visibleCount = 0;
+    for (auto j = 0u; j < (count + 63) / 64; ++j)
+    {
+        visibleCount += std::bitset<64>(output[j]).count();
+    }
+    return visibleCount;
+}
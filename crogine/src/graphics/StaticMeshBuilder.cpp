@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -103,10 +103,12 @@ Mesh::Data StaticMeshBuilder::build() const
             createIBO(meshData, meshFile.indexArrays[i].data(), i, sizeof(std::uint32_t));
         }
 
-        //boundingbox / sphere
+        //boundingbox / sphere - vertexSize may have been changed by quantisation
+        //so step through the float data by the attribute sizes
+        const auto stride = getAttributeSize(meshData.attributes);
         meshData.boundingBox[0] = glm::vec3(std::numeric_limits<float>::max());
         meshData.boundingBox[1] = glm::vec3(std::numeric_limits<float>::lowest());
-        for (std::size_t i = 0; i < meshFile.vboData.size(); i += (meshData.vertexSize / sizeof(float)))
+        for (std::size_t i = 0; i < meshFile.vboData.size(); i += stride)
         {
             //min point
             if (meshData.boundingBox[0].x > meshFile.vboData[i])
@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/graphics/Colour.hpp>
 #include <crogine/detail/Assert.hpp>
 
+#include "TextureLoader.hpp"
 #include "../detail/GLCheck.hpp"
 #include "../detail/stb_image.h"
 #include "../detail/stb_image_write.h"
@@ -56,6 +57,25 @@ namespace
     //    return pow2;*/
     //    return size; //TODO this needs to not exlude combination resolutions such as 768
     //}
+
+    std::uint32_t mipLevelSkip = 0;
+
+    std::string resolvePath(const std::string& filePath)
+    {
+        std::filesystem::path p(filePath);
+        auto path = FileSystem::getResourcePath();
+        //only add resource path if not done so already
+        if (!p.is_absolute() &&
+            filePath.find(path) == std::string::npos)
+        {
+            path += filePath;
+        }
+        else
+        {
+            path = filePath;
+        }
+        return path;
+    }
 }
 
 Texture::Texture()
@@ -65,7 +85,9 @@ Texture::Texture()
     m_type          (GL_UNSIGNED_BYTE),
     m_smooth        (false),
     m_repeated      (false),
-    m_hasMipMaps    (false)
+    m_hasMipMaps    (false),
+    m_loading       (false),
+    m_compressedSize(0)
 {
 
 }
@@ -77,8 +99,16 @@ Texture::Texture(Texture&& other) noexcept
     m_type      (other.m_type),
     m_smooth    (other.m_smooth),
     m_repeated  (other.m_repeated),
-    m_hasMipMaps(other.m_hasMipMaps)
+    m_hasMipMaps(other.m_hasMipMaps),
+    m_loading   (false),
+    m_compressedSize(other.m_compressedSize)
 {
+    if (other.m_loading)
+    {
+        std::swap(m_loading, other.m_loading);
+        Detail::TextureLoader::swapTargets(&other, this);
+    }
+
     other.m_size = glm::uvec2(0);
     other.m_format = ImageFormat::None;
     other.m_handle = 0;
@@ -86,6 +116,7 @@ Texture::Texture(Texture&& other) noexcept
     other.m_smooth = false;
     other.m_repeated = false;
     other.m_hasMipMaps = false;
+    other.m_compressedSize = 0;
 }
 
 Texture& Texture::operator=(Texture&& other) noexcept
@@ -102,6 +133,13 @@ Texture& Texture::operator=(Texture&& other) noexcept
         m_smooth = other.m_smooth;
         m_repeated = other.m_repeated;
         m_hasMipMaps = other.m_hasMipMaps;
+        m_compressedSize = other.m_compressedSize;
+
+        if (other.m_loading)
+        {
+            std::swap(m_loading, other.m_loading);
+            Detail::TextureLoader::swapTargets(&other, this);
+        }
 
         other.m_size = glm::uvec2(0);
         other.m_format = ImageFormat::None;
@@ -110,12 +148,15 @@ Texture& Texture::operator=(Texture&& other) noexcept
         other.m_smooth = false;
         other.m_repeated = false;
         other.m_hasMipMaps = false;
+        other.m_compressedSize = 0;
     }
     return *this;
 }
 
 Texture::~Texture()
 {
+    cancelAsync();
+
     if(m_handle)
     {
         glCheck(glDeleteTextures(1, &m_handle));
@@ -172,6 +213,12 @@ void Texture::create(std::uint32_t width, std::uint32_t height, ImageFormat::Typ
     std::fill(buffer.begin(), buffer.end(), 0);
 
     glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
+    if (m_compressedSize != 0)
+    {
+        //a compressed image may have limited the mip chain
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000));
+        m_compressedSize = 0;
+    }
 //#ifdef GL41
     glCheck(glTexImage2D(GL_TEXTURE_2D, 0, floatingPoint ? internalFormat : uploadFormat, width, height, 0, uploadFormat, m_type, buffer.data()));
 //#else
@@ -188,22 +235,18 @@ void Texture::create(std::uint32_t width, std::uint32_t height, ImageFormat::Typ
 
 bool Texture::loadFromFile(const std::string& filePath, bool createMipMaps)
 {
-    std::filesystem::path p(filePath);
-    auto path = FileSystem::getResourcePath();
-    //only add resource path if not done so already
-    if (!p.is_absolute() &&
-        filePath.find(path) == std::string::npos)
-    {
-        path += filePath;
-    }
-    else
-    {
-        path = filePath;
-    }
+    cancelAsync();
+    const auto path = resolvePath(filePath);
 
+    CompressedImage compressed;
     ImageArray<std::uint8_t> arr;
-    if (arr.loadFromFile(path, true))
+    if (Detail::TextureLoader::decode(path, Detail::TextureLoader::getDecodeSettings(), compressed, arr))
     {
+        if (compressed.getFormat() != CompressedImage::Format::None)
+        {
+            return uploadCompressed(compressed, createMipMaps);
+        }
+
         m_type = GL_UNSIGNED_BYTE;
 
         auto size = arr.getDimensions();
@@ -215,8 +258,27 @@ bool Texture::loadFromFile(const std::string& filePath, bool createMipMaps)
     return false;
 }
 
+bool Texture::loadFromFileAsync(const std::string& filePath, bool createMipMaps)
+{
+    cancelAsync();
+
+    if (!m_handle)
+    {
+        //make sure we have a handle to give out
+        //while we're waiting for the real thing
+        create(2, 2);
+    }
+
+    m_loading = true;
+    Detail::TextureLoader::loadAsync(resolvePath(filePath), this, createMipMaps);
+
+    return true;
+}
+
 bool Texture::loadFromImage(const Image& image, bool createMipMaps)
 {
+    cancelAsync();
+
     if (image.getPixelData() == nullptr)
     {
         LogE << "Failed creating texture from image: Image is empty." << std::endl;
@@ -229,6 +291,34 @@ bool Texture::loadFromImage(const Image& image, bool createMipMaps)
     return update(image.getPixelData(), createMipMaps);
 }
 
+bool Texture::loadFromImage(const CompressedImage& image, bool useMipMaps)
+{
+    cancelAsync();
+
+    if (image.getFormat() == CompressedImage::Format::None)
+    {
+        LogE << "Failed creating texture from compressed image: Image is empty." << std::endl;
+        return false;
+    }
+
+    if (isFormatSupported(image.getFormat()))
+    {
+        return uploadCompressed(image, useMipMaps);
+    }
+
+    std::vector<std::uint8_t> pixels;
+    if (image.decompress(pixels))
+    {
+        const auto size = image.getSize();
+        m_type = GL_UNSIGNED_BYTE;
+        create(size.x, size.y, ImageFormat::RGBA);
+        return update(pixels.data(), useMipMaps);
+    }
+
+    LogE << "Failed creating texture: " << CompressedImage::getFormatName(image.getFormat()) << " is not supported on this device" << std::endl;
+    return false;
+}
+
 bool Texture::update(const std::uint8_t* pixels, bool createMipMaps, URect area)
 {
     m_type = GL_UNSIGNED_BYTE;
@@ -248,7 +338,8 @@ bool Texture::update(const Texture& other, std::uint32_t xPos, std::uint32_t yPo
     CRO_ASSERT(m_format == other.m_format, "Texture formats don't match");
     CRO_ASSERT(m_type == other.m_type, "Texture types don't match");
 
-    if (!m_handle || !other.m_handle || (other.m_handle == m_handle))
+    if (!m_handle || !other.m_handle || (other.m_handle == m_handle)
+        || m_compressedSize != 0 || other.m_compressedSize != 0)
     {
         return false;
     }
@@ -314,6 +405,39 @@ std::uint32_t Texture::getGLHandle() const
     return m_handle;
 }
 
+std::size_t Texture::getMemorySize() const
+{
+    if (m_compressedSize != 0)
+    {
+        return m_compressedSize;
+    }
+
+    std::size_t pixelSize = 0;
+    switch (m_format)
+    {
+    default: break;
+    case ImageFormat::A:
+        pixelSize = 1;
+        break;
+    case ImageFormat::RGB:
+        pixelSize = 3;
+        break;
+    case ImageFormat::RGBA:
+        pixelSize = 4;
+        break;
+    }
+
+    if (m_type == GL_UNSIGNED_SHORT)
+    {
+        pixelSize *= 2;
+    }
+
+    const auto size = static_cast<std::size_t>(m_size.x) * m_size.y * pixelSize;
+
+    //a full mip chain adds a third again
+    return m_hasMipMaps ? size + (size / 3) : size;
+}
+
 void Texture::setSmooth(bool smooth)
 {
     if (smooth != m_smooth)
@@ -391,6 +515,21 @@ std::uint32_t Texture::getMaxTextureSize()
     return 0;
 }
 
+bool Texture::isFormatSupported(CompressedImage::Format::Type format)
+{
+    return (getSupportedFormats() & (1u << format)) != 0;
+}
+
+void Texture::setMipLevelSkip(std::uint32_t skip)
+{
+    mipLevelSkip = skip;
+}
+
+std::uint32_t Texture::getMipLevelSkip()
+{
+    return mipLevelSkip;
+}
+
 void Texture::swap(Texture& other)
 {
     std::swap(m_size, other.m_size);
@@ -400,6 +539,13 @@ void Texture::swap(Texture& other)
     std::swap(m_smooth, other.m_smooth);
     std::swap(m_repeated, other.m_repeated);
     std::swap(m_hasMipMaps, other.m_hasMipMaps);
+    std::swap(m_compressedSize, other.m_compressedSize);
+
+    if (m_loading || other.m_loading)
+    {
+        Detail::TextureLoader::swapTargets(&other, this);
+        std::swap(m_loading, other.m_loading);
+    }
 }
 
 FloatRect Texture::getNormalisedSubrect(FloatRect rect) const
@@ -492,6 +638,12 @@ bool Texture::saveToBuffer(std::vector<float>& dst) const
 //private
 bool Texture::update(const void* pixels, bool createMipMaps, URect area)
 {
+    if (m_compressedSize != 0)
+    {
+        Logger::log("Failed updating image, compressed textures can't be updated", Logger::Type::Error);
+        return false;
+    }
+
     if (area.left + area.width > m_size.x)
     {
         Logger::log("Failed updating image, source pixels too wide", Logger::Type::Error);
@@ -539,6 +691,219 @@ bool Texture::update(const void* pixels, bool createMipMaps, URect area)
     return false;
 }
 
+void Texture::cancelAsync()
+{
+    if (m_loading)
+    {
+        Detail::TextureLoader::cancel(this);
+        m_loading = false;
+    }
+}
+
+void Texture::onAsyncLoad(const ImageArray<std::uint8_t>* image, bool createMipMaps, const void* pixels)
+{
+    CRO_ASSERT(m_loading, "");
+    m_loading = false;
+
+    if (!image)
+    {
+        //failed, so keep whatever we had
+        return;
+    }
+
+    const auto size = image->getDimensions();
+    if (size.x > getMaxTextureSize()
+        || size.y > getMaxTextureSize())
+    {
+        LogE << "Failed uploading texture: " << size << " is larger than the maximum texture size" << std::endl;
+        return;
+    }
+
+    m_size = size;
+    m_format = image->getFormat();
+    m_type = GL_UNSIGNED_BYTE;
+
+    GLint format = GL_RGB;
+    if (m_format == ImageFormat::RGBA)
+    {
+        format = GL_RGBA;
+    }
+    else if (m_format == ImageFormat::A)
+    {
+        format = GL_RED;
+    }
+
+    //reuse the existing handle so anything which already references
+    //it, such as a material, gets the new image. Unlike create() we
+    //upload the image directly rather than filling with zeros first.
+    //pixels may be nullptr if the data is in a bound pixel buffer.
+    const auto wrap = m_repeated ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
+    if (m_compressedSize != 0)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000));
+        m_compressedSize = 0;
+    }
+    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, format, size.x, size.y, 0, format, m_type, pixels));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_smooth ? GL_LINEAR : GL_NEAREST));
+
+    if (m_hasMipMaps || createMipMaps)
+    {
+        generateMipMaps();
+    }
+    else
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_smooth ? GL_LINEAR : GL_NEAREST));
+    }
+    glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+void Texture::onAsyncLoad(const CompressedImage& image, bool useMipMaps)
+{
+    CRO_ASSERT(m_loading, "");
+    m_loading = false;
+
+    uploadCompressed(image, useMipMaps);
+}
+
+bool Texture::uploadCompressed(const CompressedImage& image, bool useMipMaps)
+{
+    const auto size = image.getSize();
+    if (size.x > getMaxTextureSize()
+        || size.y > getMaxTextureSize())
+    {
+        LogE << "Failed uploading texture: " << size << " is larger than the maximum texture size" << std::endl;
+        return false;
+    }
+
+    if (!m_handle)
+    {
+        GLuint handle;
+        glCheck(glGenTextures(1, &handle));
+        m_handle = handle;
+    }
+
+    const auto glFormat = CompressedImage::getGLFormat(image.getFormat());
+    const auto levelCount = useMipMaps ? image.getLevelCount() : 1;
+
+    std::size_t dataSize = 0;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
+    for (auto i = 0u; i < levelCount; ++i)
+    {
+        const auto levelSize = image.getSize(i);
+        glCheck(glCompressedTexImage2D(GL_TEXTURE_2D, i, glFormat, levelSize.x, levelSize.y, 0,
+            static_cast<GLsizei>(image.getDataSize(i)), image.getData(i)));
+        dataSize += image.getDataSize(i);
+    }
+
+    //the file may not contain a complete chain
+    const auto wrap = m_repeated ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_smooth ? GL_LINEAR : GL_NEAREST));
+
+    m_hasMipMaps = levelCount > 1;
+    if (m_hasMipMaps)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST));
+    }
+    else
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_smooth ? GL_LINEAR : GL_NEAREST));
+    }
+    glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+
+    m_size = size;
+    m_type = GL_UNSIGNED_BYTE;
+    m_compressedSize = dataSize;
+
+    switch (image.getFormat())
+    {
+    default:
+        m_format = ImageFormat::RGBA;
+        break;
+    case CompressedImage::Format::BC1RGB:
+    case CompressedImage::Format::BC5:
+    case CompressedImage::Format::ETC2RGB:
+        m_format = ImageFormat::RGB;
+        break;
+    case CompressedImage::Format::BC4:
+        m_format = ImageFormat::A;
+        break;
+    }
+
+    return true;
+}
+
+std::uint32_t Texture::getSupportedFormats()
+{
+    static std::uint32_t formats = 0;
+    static bool queried = false;
+
+    if (!queried && Detail::SDLResource::valid())
+    {
+        queried = true;
+
+        std::vector<std::string> extensions;
+        GLint count = 0;
+        glCheck(glGetIntegerv(GL_NUM_EXTENSIONS, &count));
+        for (auto i = 0; i < count; ++i)
+        {
+            const auto* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (ext)
+            {
+                extensions.emplace_back(ext);
+            }
+        }
+
+        const auto hasExtension = 
+            [&extensions](const std::string& name)
+        {
+            return std::find(extensions.begin(), extensions.end(), name) != extensions.end();
+        };
+
+        const auto setFormat = 
+            [](CompressedImage::Format::Type format, bool supported)
+        {
+            if (supported)
+            {
+                formats |= (1u << format);
+            }
+        };
+
+        const auto version = (GLVersion.major * 10) + GLVersion.minor;
+        const bool s3tc = hasExtension("GL_EXT_texture_compression_s3tc");
+        setFormat(CompressedImage::Format::BC1RGB, s3tc);
+        setFormat(CompressedImage::Format::BC1RGBA, s3tc);
+        setFormat(CompressedImage::Format::BC2, s3tc);
+        setFormat(CompressedImage::Format::BC3, s3tc);
+
+#ifdef PLATFORM_DESKTOP
+        //RGTC is core from 3.0, BPTC from 4.2 and ETC2 from 4.3
+        setFormat(CompressedImage::Format::BC4, true);
+        setFormat(CompressedImage::Format::BC5, true);
+        setFormat(CompressedImage::Format::BC7, version >= 42 || hasExtension("GL_ARB_texture_compression_bptc"));
+        setFormat(CompressedImage::Format::ETC2RGB, version >= 43 || hasExtension("GL_ARB_ES3_compatibility"));
+        setFormat(CompressedImage::Format::ETC2RGBA, version >= 43 || hasExtension("GL_ARB_ES3_compatibility"));
+#else
+        //ETC2 is core in ES 3.0
+        setFormat(CompressedImage::Format::BC4, hasExtension("GL_EXT_texture_compression_rgtc"));
+        setFormat(CompressedImage::Format::BC5, hasExtension("GL_EXT_texture_compression_rgtc"));
+        setFormat(CompressedImage::Format::BC7, hasExtension("GL_EXT_texture_compression_bptc"));
+        setFormat(CompressedImage::Format::ETC2RGB, true);
+        setFormat(CompressedImage::Format::ETC2RGBA, true);
+        (void)version;
+#endif
+    }
+
+    return formats;
+}
+
 void Texture::generateMipMaps(/*const std::uint8_t* pixels, URect area*/)
 {
 #ifdef CRO_DEBUG_
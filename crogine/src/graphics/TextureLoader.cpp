@@ -0,0 +1,298 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "TextureLoader.hpp"
+#include "../detail/GLCheck.hpp"
+#include "../detail/JobPool.hpp"
+
+#include <crogine/graphics/Texture.hpp>
+#include <crogine/graphics/ImageArray.hpp>
+#include <crogine/graphics/CompressedImage.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    struct Job final
+    {
+        std::string path;
+        Texture* target = nullptr; //nullptr if cancelled
+        bool createMipMaps = false;
+        TextureLoader::DecodeSettings settings;
+        ImageArray<std::uint8_t> image;
+        CompressedImage compressed;
+        bool success = false;
+
+        std::size_t getUploadSize() const
+        {
+            if (compressed.getFormat() != CompressedImage::Format::None)
+            {
+                std::size_t size = 0;
+                for (auto i = 0u; i < compressed.getLevelCount(); ++i)
+                {
+                    size += compressed.getDataSize(i);
+                }
+                return size;
+            }
+            return image.size();
+        }
+
+        void run()
+        {
+            success = TextureLoader::decode(path, settings, compressed, image);
+        }
+    };
+
+    //decoding is CPU bound so unlike audio use most of the cores
+    JobPool<Job, Texture> workerPool(std::max(std::thread::hardware_concurrency(), 2u) - 1u);
+
+    std::size_t uploadBudget = 8 * 1024 * 1024;
+
+    //pixel data is staged through this so the driver can
+    //transfer it asynchronously rather than copying it
+    //from client memory during glTexImage2D()
+    std::uint32_t pixelBuffer = 0;
+}
+
+TextureLoader::DecodeSettings TextureLoader::getDecodeSettings()
+{
+    DecodeSettings settings;
+    settings.supportedFormats = Texture::getSupportedFormats();
+    settings.maxSize = Texture::getMaxTextureSize();
+    settings.levelSkip = Texture::getMipLevelSkip();
+    return settings;
+}
+
+bool TextureLoader::decode(const std::string& path, const DecodeSettings& settings, CompressedImage& compressed, ImageArray<std::uint8_t>& image)
+{
+    const auto compressedPath = CompressedImage::getCompressedPath(path);
+    if (compressedPath.empty())
+    {
+        //flipped as per Texture::loadFromFile()
+        return image.loadFromFile(path, true);
+    }
+
+    if (compressed.loadFromFile(compressedPath))
+    {
+        compressed.setBaseLevel(compressed.selectBaseLevel(settings.maxSize, settings.levelSkip));
+
+        const auto format = compressed.getFormat();
+        const bool supported = (settings.supportedFormats & (1u << format)) != 0;
+
+        if (supported
+            && (compressed.isBottomUp() || compressed.flipVertically()))
+        {
+            return true;
+        }
+
+        //either not supported, or it can't be flipped without decompressing it
+        if (CompressedImage::canDecompress(format))
+        {
+            std::vector<std::uint8_t> pixels;
+            if (compressed.decompress(pixels))
+            {
+                const auto size = compressed.getSize();
+                Image img(!compressed.isBottomUp());
+                img.loadFromMemory(pixels.data(), size.x, size.y, ImageFormat::RGBA);
+                image = std::move(img);
+
+                compressed = {};
+                return true;
+            }
+        }
+        else if (supported)
+        {
+            LogW << compressedPath << ": " << CompressedImage::getFormatName(format)
+                << " images can't be flipped, texture will appear upside down" << std::endl;
+            return true;
+        }
+        else
+        {
+            LogW << compressedPath << ": " << CompressedImage::getFormatName(format) 
+                << " is not supported on this device" << std::endl;
+        }
+    }
+    compressed = {};
+
+    //fall back to the uncompressed image, which may be
+    //the original path if we were looking for a twin
+    const auto rawPath = compressedPath == path ? CompressedImage::getUncompressedPath(path) : path;
+    if (rawPath.empty())
+    {
+        return false;
+    }
+    return image.loadFromFile(rawPath, true);
+}
+
+void TextureLoader::loadAsync(const std::string& path, Texture* dst, bool createMipMaps)
+{
+    loadAsync(path, dst, createMipMaps, getDecodeSettings());
+}
+
+void TextureLoader::loadAsync(const std::string& path, Texture* dst, bool createMipMaps, const DecodeSettings& settings)
+{
+    CRO_ASSERT(dst, "");
+
+    auto job = std::make_shared<Job>();
+    job->path = path;
+    job->target = dst;
+    job->createMipMaps = createMipMaps;
+    job->settings = settings;
+
+    workerPool.submit(std::move(job));
+}
+
+void TextureLoader::cancel(const Texture* dst)
+{
+    workerPool.cancel(dst);
+}
+
+void TextureLoader::swapTargets(const Texture* a, Texture* b)
+{
+    workerPool.swapTargets(a, b);
+}
+
+void TextureLoader::update()
+{
+    std::size_t bytesUploaded = 0;
+
+    while (true)
+    {
+        //leave the rest for next frame if this would take us over budget
+        auto job = workerPool.popCompleted([bytesUploaded](const Job& next)
+            {
+                return bytesUploaded == 0
+                    || bytesUploaded + next.getUploadSize() <= uploadBudget;
+            });
+
+        if (!job)
+        {
+            break;
+        }
+
+        //targets can only be cancelled or moved on this thread
+        //so it's safe to read them without the lock
+        if (!job->target)
+        {
+            continue;
+        }
+
+        if (!job->success)
+        {
+            LogE << "Failed loading texture " << job->path << std::endl;
+            job->target->onAsyncLoad(nullptr, false, nullptr);
+            continue;
+        }
+
+        if (job->compressed.getFormat() != CompressedImage::Format::None)
+        {
+            //these are small enough to upload directly
+            job->target->onAsyncLoad(job->compressed, job->createMipMaps);
+            bytesUploaded += job->getUploadSize();
+            continue;
+        }
+
+        const void* pixels = job->image.data();
+#ifdef PLATFORM_DESKTOP
+        if (pixelBuffer == 0)
+        {
+            glCheck(glGenBuffers(1, &pixelBuffer));
+        }
+
+        //orphan the previous storage so we don't wait on a transfer still in flight
+        const auto size = static_cast<GLsizeiptr>(job->image.size());
+        glCheck(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer));
+        glCheck(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+
+        auto* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (dst)
+        {
+            std::memcpy(dst, pixels, job->image.size());
+            glCheck(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+            pixels = nullptr; //read from offset 0 of the bound buffer
+        }
+        else
+        {
+            //fall back to uploading from client memory
+            glCheck(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        }
+#endif
+
+        job->target->onAsyncLoad(&job->image, job->createMipMaps, pixels);
+
+#ifdef PLATFORM_DESKTOP
+        glCheck(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+#endif
+        bytesUploaded += job->image.size();
+    }
+}
+
+void TextureLoader::setUploadBudget(std::size_t bytes)
+{
+    uploadBudget = bytes;
+}
+
+std::size_t TextureLoader::getUploadBudget()
+{
+    return uploadBudget;
+}
+
+std::size_t TextureLoader::getPendingCount()
+{
+    return workerPool.getPendingCount();
+}
+
+std::size_t TextureLoader::getDecodedCount()
+{
+    return workerPool.getCompletedCount();
+}
+
+std::size_t TextureLoader::getWorkerCount()
+{
+    return workerPool.getWorkerCount();
+}
+
+void TextureLoader::shutdown()
+{
+    workerPool.stop();
+
+    if (pixelBuffer)
+    {
+        glCheck(glDeleteBuffers(1, &pixelBuffer));
+        pixelBuffer = 0;
+    }
+}
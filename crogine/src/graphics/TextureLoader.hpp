@@ -0,0 +1,141 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace cro
+{
+    class Texture;
+    class CompressedImage;
+    template <typename T>
+    class ImageArray;
+
+    namespace Detail
+    {
+        /*!
+        \brief Decodes image files on a pool of worker threads, and
+        uploads them to their textures on the main thread with a limit
+        on the number of bytes uploaded each frame.
+        Decoding requires no GL context, uploading does.
+        */
+        class CRO_EXPORT_API TextureLoader final
+        {
+        public:
+            /*!
+            \brief Device limits used when decoding images, which
+            need to be read on the GL thread before decoding.
+            */
+            struct DecodeSettings final
+            {
+                std::uint32_t supportedFormats = 0; //bit per CompressedImage::Format
+                std::uint32_t maxSize = 0;
+                std::uint32_t levelSkip = 0;
+            };
+            static DecodeSettings getDecodeSettings();
+
+            /*!
+            \brief Loads the image at the given path, or its compressed version.
+            If a compressed image can be uploaded as it is then it is stored in
+            compressed, else the decompressed or fallback image is stored in image.
+            Requires no GL context, so is safe to call from worker threads.
+            \returns false if no image could be loaded
+            */
+            static bool decode(const std::string& path, const DecodeSettings&, CompressedImage& compressed, ImageArray<std::uint8_t>& image);
+
+            /*!
+            \brief Queues the image at the given absolute path to be decoded
+            on a worker thread. Once decoded the image is uploaded to dst
+            during update().
+            */
+            static void loadAsync(const std::string& path, Texture* dst, bool createMipMaps);
+
+            /*!
+            \brief Queues the image at the given path using the given settings
+            rather than reading them from the current device. Requires no GL
+            context, so decoding can be tested headless.
+            */
+            static void loadAsync(const std::string& path, Texture* dst, bool createMipMaps, const DecodeSettings& settings);
+
+            /*!
+            \brief Cancels any pending loads for the given Texture
+            */
+            static void cancel(const Texture* dst);
+
+            /*!
+            \brief Swaps the destinations of any pending loads between two
+            textures, used when Textures are moved or swapped
+            */
+            static void swapTargets(const Texture* a, Texture* b);
+
+            /*!
+            \brief Uploads decoded images to their textures, until the upload
+            budget for this frame is used. Called once per frame on the main
+            thread by the App, with an active GL context.
+            */
+            static void update();
+
+            /*!
+            \brief Sets the maximum number of bytes uploaded by update().
+            At least one image is always uploaded per frame, however large.
+            */
+            static void setUploadBudget(std::size_t bytes);
+            static std::size_t getUploadBudget();
+
+            /*!
+            \brief Returns the number of images queued, being decoded
+            or waiting to be uploaded
+            */
+            static std::size_t getPendingCount();
+
+            /*!
+            \brief Returns the number of images which have been decoded
+            and are waiting to be uploaded
+            */
+            static std::size_t getDecodedCount();
+
+            /*!
+            \brief Returns the number of worker threads used for decoding.
+            This is 0 until the first image is queued.
+            */
+            static std::size_t getWorkerCount();
+
+            /*!
+            \brief Stops the worker threads and releases the pixel buffer.
+            Called by the App while the GL context is still valid.
+            */
+            static void shutdown();
+        };
+    }
+}
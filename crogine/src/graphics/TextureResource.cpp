@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -30,6 +30,8 @@ source distribution.
 #include <crogine/graphics/TextureResource.hpp>
 #include <crogine/graphics/Image.hpp>
 
+#include "TextureLoader.hpp"
+
 using namespace cro;
 
 namespace
@@ -38,7 +40,11 @@ namespace
 }
 
 TextureResource::TextureResource()
-    : m_fallbackColour(Colour::Magenta)
+    : m_fallbackColour      (Colour::Magenta),
+    m_mutex                 (std::make_unique<std::mutex>()),
+    m_hitCount              (0),
+    m_missCount             (0),
+    m_asyncRequestCount     (0)
 {
 
 }
@@ -54,7 +60,9 @@ bool TextureResource::load(std::uint32_t id, const std::string& path, bool creat
             //loadFromFile() should print error message
             return false;
         }
-        m_textures.insert(std::make_pair(id, std::make_pair(path, std::move(tex))));
+
+        std::scoped_lock lock(*m_mutex);
+        insert(id, path, std::move(tex));
         return true;
     }
     else
@@ -68,6 +76,73 @@ bool TextureResource::load(std::uint32_t id, const std::string& path, bool creat
     return false;
 }
 
+TextureResource::Handle TextureResource::loadAsync(std::uint32_t id, const std::string& path, bool createMipMaps)
+{
+    Handle handle;
+    handle.m_resource = this;
+    handle.m_id = id;
+
+    if (m_textures.count(id) != 0)
+    {
+        const auto& currentPath = m_textures.at(id).first;
+        if (currentPath != path)
+        {
+            LogI << "Texture ID " << id << " already assigned to " << currentPath << std::endl;
+        }
+        return handle;
+    }
+
+    //fill with the fallback colour - the texture handle
+    //stays the same once the actual image is loaded
+    Image img;
+    img.create(32, 32, m_fallbackColour);
+
+    auto tex = std::make_unique<Texture>();
+    tex->loadFromImage(img);
+    tex->loadFromFileAsync(path, createMipMaps);
+
+    {
+        std::scoped_lock lock(*m_mutex);
+        insert(id, path, std::move(tex));
+    }
+
+    updatePending();
+    m_pendingIDs.push_back(id);
+    m_asyncRequestCount++;
+
+    return handle;
+}
+
+bool TextureResource::isLoading(std::uint32_t id) const
+{
+    if (const auto result = m_textures.find(id); result != m_textures.end())
+    {
+        return result->second.second->isLoading();
+    }
+    return false;
+}
+
+std::size_t TextureResource::getPendingCount() const
+{
+    updatePending();
+    return m_pendingIDs.size();
+}
+
+float TextureResource::getLoadProgress() const
+{
+    updatePending();
+    if (m_asyncRequestCount == 0)
+    {
+        return 1.f;
+    }
+    return static_cast<float>(m_asyncRequestCount - m_pendingIDs.size()) / static_cast<float>(m_asyncRequestCount);
+}
+
+void TextureResource::setUploadBudget(std::size_t bytes)
+{
+    Detail::TextureLoader::setUploadBudget(bytes);
+}
+
 bool TextureResource::loaded(std::uint32_t id) const
 {
     return m_textures.count(id) != 0;
@@ -86,6 +161,17 @@ Texture& TextureResource::get(std::uint32_t id)
 Texture& TextureResource::getByHandle(std::uint32_t handle)
 {
     CRO_ASSERT(handle != 0, "");
+    std::scoped_lock lock(*m_mutex);
+
+    if (const auto result = m_handleIndex.find(handle);
+        result != m_handleIndex.end() && result->second->getGLHandle() == handle)
+    {
+        m_hitCount++;
+        return *result->second;
+    }
+
+    //the texture may have been swapped with another since it
+    //was loaded, in which case search for it and update the index
     auto result = std::find_if(m_textures.begin(), m_textures.end(), 
         [handle](const auto& p)
         {
@@ -93,32 +179,56 @@ Texture& TextureResource::getByHandle(std::uint32_t handle)
         });
     if (result != m_textures.end())
     {
+        m_hitCount++;
+        m_handleIndex[handle] = result->second.second.get();
         return *result->second.second;
     }
+
+    m_missCount++;
     return getFallbackTexture();
 }
 
 Texture& TextureResource::get(const std::string& path, bool useMipMaps)
 {
-    auto result = std::find_if(m_textures.begin(), m_textures.end(), 
-        [&path](const auto& pair)
-        {
-            return pair.second.first == path;
-        });
+    std::scoped_lock lock(*m_mutex);
 
-    if (result == m_textures.end())
+    if (const auto result = m_pathIndex.find(path); result != m_pathIndex.end())
     {
-        auto tex = std::make_unique<Texture>();
-        if (!tex->loadFromFile(path, useMipMaps))
-        {
-            return getFallbackTexture();
-        }
+        m_hitCount++;
+        return *result->second;
+    }
+
+    m_missCount++;
+
+    auto tex = std::make_unique<Texture>();
+    if (!tex->loadFromFile(path, useMipMaps))
+    {
+        return getFallbackTexture();
+    }
+
+    return insert(fallbackID--, path, std::move(tex));
+}
+
+TextureResource::Stats TextureResource::getStats() const
+{
+    std::scoped_lock lock(*m_mutex);
 
-        auto id = fallbackID--;
-        m_textures.insert(std::make_pair(id, std::make_pair(path, std::move(tex))));
-        return *m_textures.at(id).second;
+    Stats stats;
+    stats.hits = m_hitCount;
+    stats.misses = m_missCount;
+    stats.textureCount = m_textures.size();
+    for (const auto& [id, texture] : m_textures)
+    {
+        stats.memoryUsage += texture.second->getMemorySize();
     }
-    return *result->second.second;
+    return stats;
+}
+
+void TextureResource::resetStats()
+{
+    std::scoped_lock lock(*m_mutex);
+    m_hitCount = 0;
+    m_missCount = 0;
 }
 
 void TextureResource::setFallbackColour(Colour colour)
@@ -131,7 +241,7 @@ Colour TextureResource::getFallbackColour() const
     return m_fallbackColour;
 }
 
-//provate
+//private
 Texture& TextureResource::getFallbackTexture()
 {
     if (m_fallbackTextures.count(m_fallbackColour) == 0)
@@ -145,4 +255,44 @@ Texture& TextureResource::getFallbackTexture()
         m_fallbackTextures.insert(std::make_pair(m_fallbackColour, std::move(fbTex)));
     }
     return *m_fallbackTextures.at(m_fallbackColour);
-}
\ No newline at end of file
+}
+
+Texture& TextureResource::insert(std::uint32_t id, const std::string& path, std::unique_ptr<Texture> texture)
+{
+    auto* tex = texture.get();
+    const auto entry = m_textures.insert(std::make_pair(id, std::make_pair(path, std::move(texture)))).first;
+
+    //if a path is loaded more than once get(path) returns the first
+    m_pathIndex.emplace(entry->second.first, tex);
+    if (const auto handle = tex->getGLHandle(); handle != 0)
+    {
+        m_handleIndex[handle] = tex;
+    }
+    return *tex;
+}
+
+void TextureResource::updatePending() const
+{
+    m_pendingIDs.erase(std::remove_if(m_pendingIDs.begin(), m_pendingIDs.end(),
+        [&](std::uint32_t id)
+        {
+            return !isLoading(id);
+        }), m_pendingIDs.end());
+
+    if (m_pendingIDs.empty())
+    {
+        m_asyncRequestCount = 0;
+    }
+}
+
+//handle
+bool TextureResource::Handle::isReady() const
+{
+    return m_resource && !m_resource->isLoading(m_id);
+}
+
+Texture& TextureResource::Handle::getTexture() const
+{
+    CRO_ASSERT(m_resource, "Handle was not returned from loadAsync()");
+    return m_resource->get(m_id);
+}
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2017 - 2020
+Matt Marchant 2017 - 2025
 http://trederia.blogspot.com
 
 crogine - Zlib license.
@@ -36,11 +36,46 @@ Poisson Disc sampling based on article at http://devmag.org.za/2009/05/03/poisso
 
 #include <crogine/detail/glm/gtx/norm.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 using namespace cro;
 using namespace cro::Util::Random;
 
 namespace
 {
+    //incremented each time all generators should be reseeded
+    std::atomic<std::uint64_t> seedEpoch = 0;
+    std::atomic<std::uint64_t> deterministicSeed = 0;
+    std::atomic<bool> deterministic = false;
+    //counts the threads seeded since deterministic mode was enabled
+    std::atomic<std::uint64_t> threadCounter = 0;
+
+    struct ThreadGenerator final
+    {
+        Generator generator;
+        std::uint64_t epoch = std::numeric_limits<std::uint64_t>::max();
+
+        void reseed(std::uint64_t currentEpoch)
+        {
+            epoch = currentEpoch;
+            if (deterministic)
+            {
+                //the seed is expanded with splitmix so adjacent indices are fine
+                generator.seed(deterministicSeed + (++threadCounter));
+            }
+            else
+            {
+                std::random_device rd;
+                const auto time = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                const auto thread = static_cast<std::uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+                generator.seed((static_cast<std::uint64_t>(rd()) << 32) ^ time ^ thread);
+            }
+        }
+    };
+    thread_local ThreadGenerator threadGenerator;
+
     const std::size_t maxGridPoints = 3;
 
     //it's not desirable but the only way I can think to hide this class
@@ -136,6 +171,42 @@ namespace
     };
 }
 
+Generator& cro::Util::Random::getGenerator()
+{
+    if (const auto epoch = seedEpoch.load(std::memory_order_relaxed);
+        threadGenerator.epoch != epoch)
+    {
+        threadGenerator.reseed(epoch);
+    }
+    return threadGenerator.generator;
+}
+
+void cro::Util::Random::setSeed(std::uint64_t seed)
+{
+    getGenerator().seed(seed);
+}
+
+void cro::Util::Random::setDeterministic(bool enabled, std::uint64_t seed)
+{
+    deterministicSeed = seed;
+    deterministic = enabled;
+    threadCounter = 0;
+    seedEpoch++;
+
+    if (enabled)
+    {
+        //the calling thread doesn't take an index so that other threads
+        //are numbered in the order they first use their generator from here
+        threadGenerator.epoch = seedEpoch;
+        threadGenerator.generator.seed(seed);
+    }
+}
+
+bool cro::Util::Random::isDeterministic()
+{
+    return deterministic;
+}
+
 std::vector<glm::vec2> cro::Util::Random::poissonDiscDistribution(const FloatRect& area, float minDist, std::size_t maxPoints)
 {
     std::vector<glm::vec2> workingPoints;
@@ -933,6 +933,10 @@ void ModelState::bakeLightmap()
     normalOffset *= sizeof(float);
     uvOffset *= sizeof(float);
 
+    //vertexData is read back as floats, so may have a different
+    //stride to the VBO if the mesh is quantised
+    const auto vertexStride = static_cast<int>(cro::Mesh::getUnpackedVertexSize(meshData));
+
     cro::Clock timer; //push progress update
 
     //std::int32_t bounces = 2;
@@ -947,9 +951,9 @@ void ModelState::bakeLightmap()
             lmSetTargetLightmap(ctx, m_lightmapBuffers[i].data(), LightmapSize, LightmapSize, 3);
 
             lmSetGeometry(ctx, &modelMatrix[0][0],
-                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data(), meshData.vertexSize, //position
-                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data() + normalOffset, meshData.vertexSize, //normal
-                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data() + uvOffset, meshData.vertexSize, //UV - TODO select which set to use
+                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data(), vertexStride, //position
+                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data() + normalOffset, vertexStride, //normal
+                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data() + uvOffset, vertexStride, //UV - TODO select which set to use
                 meshData.indexData[i].indexCount, GL_UNSIGNED_INT, m_modelProperties.indexData[i].data());
 
             GLint vp[4];            
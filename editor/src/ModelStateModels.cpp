@@ -1197,7 +1197,7 @@ void ModelState::flipNormals()
     {
         auto& verts = m_modelProperties.vertexData;
 
-        auto stride = meshData.vertexSize / sizeof(float);
+        auto stride = cro::Mesh::getUnpackedVertexSize(meshData) / sizeof(float);
         auto offset = 0u;
         for (auto i = 0u; i < cro::Mesh::Normal; ++i)
         {
@@ -1211,19 +1211,27 @@ void ModelState::flipNormals()
             verts[i+2] *= -1.f;
         }
 
+        //pack back into the mesh's attribute formats (if it's not
+        //quantised this is just a copy)
+        std::vector<std::uint8_t> packed;
+        cro::Mesh::packVertexData(meshData, verts.data(), packed);
+
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-        glCheck(glBufferData(GL_ARRAY_BUFFER, meshData.vertexCount * meshData.vertexSize, verts.data(), GL_STATIC_DRAW));
+        glCheck(glBufferData(GL_ARRAY_BUFFER, packed.size(), packed.data(), GL_STATIC_DRAW));
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
     }
 }
 
 void ModelState::readBackVertexData(cro::Mesh::Data meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint32_t>>& destIndices)
 {
-    destVerts.clear();
-    destVerts.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
+    //the VBO may contain quantised attributes, so download the raw
+    //bytes and unpack them. The vertices are then getUnpackedVertexSize()
+    //bytes apart, rather than meshData.vertexSize
+    std::vector<std::uint8_t> packed(meshData.vertexCount * meshData.vertexSize);
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-    glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, destVerts.data()));
+    glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, packed.size(), packed.data()));
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    cro::Mesh::unpackVertexData(meshData, packed.data(), destVerts);
 
     destIndices.clear();
     destIndices.resize(meshData.submeshCount);
@@ -1,6 +1,6 @@
 /*-----------------------------------------------------------------------
 
-Matt Marchant 2021 - 2022
+Matt Marchant 2021 - 2025
 http://trederia.blogspot.com
 
 Super Video Golf - zlib licence.
@@ -71,7 +71,7 @@ void CollisionMesh::updateCollisionMesh(const cro::Mesh::Data& meshData)
         btIndexedMesh groundMesh;
         groundMesh.m_vertexBase = reinterpret_cast<std::uint8_t*>(m_vertexData.data());
         groundMesh.m_numVertices = static_cast<int>(meshData.vertexCount);
-        groundMesh.m_vertexStride = static_cast<int>(meshData.vertexSize);
+        groundMesh.m_vertexStride = static_cast<int>(cro::Mesh::getUnpackedVertexSize(meshData));
 
         groundMesh.m_numTriangles = meshData.indexData[i].indexCount / 3;
         groundMesh.m_triangleIndexBase = reinterpret_cast<std::uint8_t*>(m_indexData[i].data());
@@ -0,0 +1,46 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <iostream>
+
+/*
+Minimal assertions for the headless tests. Failed checks are
+reported but don't abort the test, so that all failures are
+listed, and the test returns non-zero with TEST_RESULT
+*/
+namespace Test
+{
+    inline int failures = 0;
+}
+
+#define CHECK(x) do{if(!(x)){std::cerr << __FILE__ << "(" << __LINE__ << "): CHECK(" << #x << ") failed" << std::endl; Test::failures++;}}while(false)
+
+#define TEST_RESULT (Test::failures == 0 ? 0 : 1)
@@ -0,0 +1,232 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "Check.hpp"
+
+#include "audio/AudioDecoder.hpp"
+#include "detail/FileCache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//decodes a generated mp3 with the AudioDecoder and checks that
+//the decoded PCM is written to, and read back from, the cache
+
+using namespace cro;
+
+namespace
+{
+    const std::string CacheDir = "audio_cache_files/";
+
+    //MPEG-1 layer III, 128kbps, 44.1KHz mono, no CRC. Frames
+    //with empty side info and no main data decode to silence
+    constexpr std::array<std::uint8_t, 4> FrameHeader = { 0xff, 0xfb, 0x90, 0xc0 };
+    constexpr std::size_t FrameSize = 417; //144 * bitrate / frequency
+
+    bool writeMp3(const std::string& path, std::size_t frameCount)
+    {
+        std::vector<std::uint8_t> data(FrameSize * frameCount);
+        for (auto i = 0u; i < frameCount; ++i)
+        {
+            std::memcpy(data.data() + (i * FrameSize), FrameHeader.data(), FrameHeader.size());
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        return file.good();
+    }
+
+    //counts the files in the cache directory with the given extension
+    std::size_t countFiles(const std::string& ext)
+    {
+        std::size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(CacheDir))
+        {
+            if (entry.path().extension() == ext)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    bool isMiss(const Detail::DecodedAudio& audio)
+    {
+        return audio.audioFile && !audio.cacheFile.isOpen();
+    }
+
+    bool isHit(const Detail::DecodedAudio& audio)
+    {
+        return !audio.audioFile && audio.cacheFile.isOpen()
+            && audio.pcmData.data == audio.cacheFile.data() + 40; //header size
+    }
+
+    bool samePCM(const Detail::PCMData& a, const Detail::PCMData& b)
+    {
+        return a.format == b.format
+            && a.frequency == b.frequency
+            && a.size == b.size
+            && a.size != 0
+            && std::memcmp(a.data, b.data, a.size) == 0;
+    }
+}
+
+int main()
+{
+    const auto path = std::filesystem::absolute("audio_cache_test.mp3").generic_u8string();
+    if (!writeMp3(path, 32))
+    {
+        std::cerr << "Failed writing test mp3" << std::endl;
+        return 1;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(CacheDir, ec);
+
+    //without a cache directory files are always decoded
+    {
+        Detail::DecodedAudio audio;
+        CHECK(Detail::AudioDecoder::decode(path, audio));
+        CHECK(isMiss(audio));
+        CHECK(audio.pcmData.format == Detail::PCMData::Format::MONO16);
+        CHECK(audio.pcmData.frequency == 44100);
+    }
+
+    Detail::AudioDecoder::setCacheDirectory(CacheDir);
+    CHECK(Detail::AudioDecoder::getCacheDirectory() == CacheDir);
+    CHECK(std::filesystem::is_directory(CacheDir));
+
+    //the first decode misses and writes the cache, the second maps it
+    {
+        Detail::DecodedAudio miss;
+        CHECK(Detail::AudioDecoder::decode(path, miss));
+        CHECK(isMiss(miss));
+        CHECK(countFiles(".pcm") == 1);
+        CHECK(countFiles(".tmp") == 0);
+
+        Detail::DecodedAudio hit;
+        CHECK(Detail::AudioDecoder::decode(path, hit));
+        CHECK(isHit(hit));
+        CHECK(samePCM(miss.pcmData, hit.pcmData));
+    }
+
+    //modifying the source makes the cache stale
+    {
+        CHECK(writeMp3(path, 48));
+
+        Detail::DecodedAudio miss;
+        CHECK(Detail::AudioDecoder::decode(path, miss));
+        CHECK(isMiss(miss));
+
+        Detail::DecodedAudio hit;
+        CHECK(Detail::AudioDecoder::decode(path, hit));
+        CHECK(isHit(hit));
+        CHECK(samePCM(miss.pcmData, hit.pcmData));
+        CHECK(countFiles(".pcm") == 1);
+    }
+
+    //corrupt cache files are ignored and replaced
+    {
+        const auto cachePath = CacheDir + std::filesystem::directory_iterator(CacheDir)->path().filename().u8string();
+        std::filesystem::resize_file(cachePath, 20);
+
+        Detail::DecodedAudio miss;
+        CHECK(Detail::AudioDecoder::decode(path, miss));
+        CHECK(isMiss(miss));
+
+        Detail::DecodedAudio hit;
+        CHECK(Detail::AudioDecoder::decode(path, hit));
+        CHECK(isHit(hit));
+    }
+
+    //concurrent decodes of the same file all succeed,
+    //and never leave a temp file or partial cache file behind
+    {
+        std::filesystem::remove_all(CacheDir, ec);
+        Detail::AudioDecoder::setCacheDirectory(CacheDir);
+
+        constexpr std::size_t ThreadCount = 8;
+        std::array<Detail::DecodedAudio, ThreadCount> results;
+        std::array<bool, ThreadCount> success = {};
+        std::vector<std::thread> threads;
+        for (auto i = 0u; i < ThreadCount; ++i)
+        {
+            threads.emplace_back([&, i]()
+                {
+                    success[i] = Detail::AudioDecoder::decode(path, results[i]);
+                });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        CHECK(std::all_of(success.begin(), success.end(), [](bool b) {return b; }));
+        CHECK(countFiles(".pcm") == 1);
+        CHECK(countFiles(".tmp") == 0);
+
+        Detail::DecodedAudio hit;
+        CHECK(Detail::AudioDecoder::decode(path, hit));
+        CHECK(isHit(hit));
+        for (const auto& result : results)
+        {
+            CHECK(samePCM(result.pcmData, hit.pcmData));
+        }
+    }
+
+    //temp paths are unique per call, so concurrent writers don't collide
+    {
+        const auto a = Detail::FileCache::getTempPath(CacheDir + "file.pcm");
+        const auto b = Detail::FileCache::getTempPath(CacheDir + "file.pcm");
+        CHECK(a != b);
+        CHECK(a.rfind(CacheDir + "file.pcm", 0) == 0);
+
+        //failed writes don't leave anything behind
+        CHECK(!Detail::FileCache::writeAtomic(CacheDir + "failed.pcm", [](const std::string& tempPath)
+            {
+                std::ofstream(tempPath) << "partial";
+                return false;
+            }));
+        CHECK(!std::filesystem::exists(CacheDir + "failed.pcm"));
+        CHECK(countFiles(".tmp") == 0);
+    }
+
+    Detail::AudioDecoder::setCacheDirectory("");
+    CHECK(Detail::AudioDecoder::getCacheDirectory().empty());
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,194 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "detail/MappedFile.hpp"
+
+#include <crogine/detail/ModelBinary.hpp>
+#include <crogine/graphics/MeshBuilder.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//times loading the mesh data of 20 model binaries with 50k vertices each,
+//with position, colour, normal, tangent and UV attributes. Version 2 files
+//are loaded with ModelBinary::read(), which reads them with SDL and finds
+//the bounds, but doesn't include the repacking and bitangent expansion
+//that BinaryMeshBuilder did. Version 3 files are loaded with read(), and
+//by mapping the file and reading every byte of the MeshView once, which
+//is what BinaryMeshBuilder now does before passing it to glBufferData().
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    const std::string FileDir("cmb_load_bench_files/");
+
+    constexpr std::size_t MeshCount = 20;
+    constexpr std::size_t VertexCount = 50000;
+    constexpr std::size_t TriangleCount = VertexCount * 2;
+    constexpr std::size_t Passes = 5;
+
+    constexpr std::uint16_t Flags = VertexProperty::Position | VertexProperty::Colour
+        | VertexProperty::Normal | VertexProperty::Tangent | VertexProperty::UV0;
+    constexpr std::size_t VertexStride = 3 + 4 + 3 + 4 + 2;
+
+    template <typename T>
+    void write(std::ofstream& file, const T& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeLegacyFile(const std::string& path, std::uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+        std::uniform_int_distribution<std::uint32_t> index(0, VertexCount - 1);
+
+        ModelBinary::HeaderV2 header;
+        header.meshOffset = sizeof(header);
+
+        ModelBinary::MeshHeader meshHeader;
+        meshHeader.flags = Flags;
+        meshHeader.indexArrayCount = 1;
+        meshHeader.indexArrayOffset = static_cast<std::uint32_t>(sizeof(header) + sizeof(meshHeader)
+            + sizeof(std::uint32_t) + (VertexCount * VertexStride * sizeof(float)));
+
+        std::ofstream file(path, std::ios::binary);
+        write(file, header);
+        write(file, meshHeader);
+        write(file, static_cast<std::uint32_t>(TriangleCount * 3));
+
+        for (auto i = 0u; i < VertexCount * VertexStride; ++i)
+        {
+            write(file, dist(rng));
+        }
+
+        for (auto i = 0u; i < TriangleCount * 3; ++i)
+        {
+            write(file, index(rng));
+        }
+    }
+
+    template <typename Fn>
+    double time(Fn&& fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (auto p = 0u; p < Passes; ++p)
+        {
+            for (auto i = 0u; i < MeshCount; ++i)
+            {
+                fn(i);
+            }
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / Passes;
+    }
+
+    std::string getPath(std::size_t i, std::uint32_t version)
+    {
+        return FileDir + "mesh_" + std::to_string(i) + "_v" + std::to_string(version) + ".cmb";
+    }
+}
+
+int main()
+{
+    std::filesystem::remove_all(FileDir);
+    std::filesystem::create_directories(FileDir);
+
+    std::uintmax_t legacySize = 0;
+    std::uintmax_t mappedSize = 0;
+    for (auto i = 0u; i < MeshCount; ++i)
+    {
+        writeLegacyFile(getPath(i, 2), i);
+        if (!ModelBinary::convert(getPath(i, 2), getPath(i, 3)))
+        {
+            std::cout << "Failed converting " << getPath(i, 2) << std::endl;
+            return 1;
+        }
+        legacySize += std::filesystem::file_size(getPath(i, 2));
+        mappedSize += std::filesystem::file_size(getPath(i, 3));
+    }
+
+    std::vector<float> vertexData;
+    std::vector<std::vector<std::uint32_t>> indexData;
+    std::size_t vertexTotal = 0;
+
+    const auto legacyTime = time([&](std::size_t i)
+        {
+            vertexTotal += ModelBinary::read(getPath(i, 2), vertexData, indexData).vertexCount;
+        });
+
+    const auto readTime = time([&](std::size_t i)
+        {
+            vertexTotal += ModelBinary::read(getPath(i, 3), vertexData, indexData).vertexCount;
+        });
+
+    std::uint32_t checksum = 0;
+    const auto mappedTime = time([&](std::size_t i)
+        {
+            MappedFile file;
+            ModelBinary::MeshView view;
+            if (file.open(getPath(i, 3))
+                && ModelBinary::getMeshView(file.data(), file.size(), view))
+            {
+                const auto vertexBytes = std::size_t(view.header.vertexCount) * view.header.vertexSize;
+                for (auto j = 0u; j < vertexBytes; j += sizeof(std::uint32_t))
+                {
+                    std::uint32_t value = 0;
+                    std::memcpy(&value, view.vertexData + j, sizeof(value));
+                    checksum ^= value;
+                }
+
+                for (auto j = 0u; j < view.indexData.size(); ++j)
+                {
+                    const auto indexBytes = std::size_t(view.indexCounts[j]) * view.header.indexSize;
+                    for (auto k = 0u; k < indexBytes; ++k)
+                    {
+                        checksum += view.indexData[j][k];
+                    }
+                }
+                vertexTotal += view.header.vertexCount;
+            }
+        });
+
+    std::cout << MeshCount << " meshes x " << VertexCount << " vertices, " << Passes << " passes (" << vertexTotal << ", " << checksum << ")\n";
+    std::cout << "Version 2 read():          " << legacyTime << "ms (" << legacySize / 1024 << "KB)\n";
+    std::cout << "Version 3 read():          " << readTime << "ms (" << mappedSize / 1024 << "KB)\n";
+    std::cout << "Version 3 mapped MeshView: " << mappedTime << "ms" << std::endl;
+
+    std::filesystem::remove_all(FileDir);
+
+    return 0;
+}
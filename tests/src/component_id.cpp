@@ -0,0 +1,105 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/ecs/Component.hpp>
+
+#include <array>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+//checks component IDs are consistent when looked up from
+//several threads at once, as they are by parallel systems
+
+using namespace cro;
+
+namespace
+{
+    template <std::size_t N>
+    struct TestComponent final {};
+
+    constexpr std::size_t TypeCount = 4;
+    using IDs = std::array<ComponentManager::ID, TypeCount>;
+
+    IDs getIDs(ComponentManager& cm)
+    {
+        return { cm.getID<TestComponent<0>>(), cm.getID<TestComponent<1>>(),
+            cm.getID<TestComponent<2>>(), cm.getID<TestComponent<3>>() };
+    }
+}
+
+int main()
+{
+    constexpr std::size_t ThreadCount = 4;
+    constexpr std::size_t Iterations = 1000;
+
+    for (auto i = 0u; i < Iterations; ++i)
+    {
+        //register the types up front as a Scene does when adding systems,
+        //in reverse order so the IDs differ from the type indices. The IDs
+        //are then cached by whichever thread looks them up first
+        ComponentManager cm;
+        CHECK(cm.getFromTypeID(typeid(TestComponent<3>)) == 0);
+        CHECK(cm.getFromTypeID(typeid(TestComponent<2>)) == 1);
+        CHECK(cm.getFromTypeID(typeid(TestComponent<1>)) == 2);
+        CHECK(cm.getFromTypeID(typeid(TestComponent<0>)) == 3);
+        const IDs expected = { 3, 2, 1, 0 };
+
+        std::array<IDs, ThreadCount> results = {};
+        std::vector<std::thread> threads;
+        for (auto t = 0u; t < ThreadCount; ++t)
+        {
+            threads.emplace_back([&, t]() { results[t] = getIDs(cm); });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        for (const auto& result : results)
+        {
+            CHECK(result == expected);
+        }
+
+        //cached IDs match the uncached lookup
+        CHECK(getIDs(cm) == expected);
+    }
+
+    //IDs are per manager
+    ComponentManager a;
+    ComponentManager b;
+    a.getID<TestComponent<1>>();
+    CHECK(a.getID<TestComponent<0>>() == 1);
+    CHECK(b.getID<TestComponent<0>>() == 0);
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,183 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include <crogine/core/MessageBus.hpp>
+#include <crogine/ecs/Component.hpp>
+#include <crogine/ecs/ComponentPool.hpp>
+#include <crogine/ecs/Entity.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+//times Entity::getComponent() over 10k and 50k entities, which
+//is dominated by the component ID lookup and the pool cast.
+//An EntityManager holds at most Detail::MinFreeIDs live entities
+//so larger counts are spread over several, sharing one set of IDs.
+//For comparison the same components are also copied into pools
+//which are looked up the way getComponent() used to, by searching
+//for the component's type_index then dynamic_casting the pool
+
+using namespace cro;
+
+namespace
+{
+    struct Position final
+    {
+        float x = 0.f, y = 0.f, z = 0.f;
+    };
+
+    struct Velocity final
+    {
+        float x = 1.f, y = 2.f, z = 3.f;
+    };
+
+    template <std::size_t N>
+    struct Padding final {};
+
+    //a typical Scene registers a couple of dozen component types
+    //before the ones a game system is interested in
+    template <std::size_t... I>
+    void registerPadding(ComponentManager& cm, std::index_sequence<I...>)
+    {
+        (cm.getFromTypeID(typeid(Padding<I>)), ...);
+    }
+
+    //component pools indexed by component ID, as held by an EntityManager
+    using PoolList = std::vector<std::unique_ptr<Detail::Pool>>;
+
+    template <typename T>
+    T& getBaselineComponent(ComponentManager& cm, PoolList& pools, Entity entity)
+    {
+        const auto componentID = cm.getFromTypeID(std::type_index(typeid(T)));
+        auto* pool = dynamic_cast<Detail::ComponentPool<T>*>(pools[componentID].get());
+        return pool->at(entity.getIndex());
+    }
+
+    template <typename T>
+    void addBaselineComponent(ComponentManager& cm, PoolList& pools, Entity entity, std::size_t poolSize)
+    {
+        const auto componentID = cm.getFromTypeID(std::type_index(typeid(T)));
+        if (pools.size() <= componentID)
+        {
+            pools.resize(componentID + 1);
+        }
+
+        if (!pools[componentID])
+        {
+            pools[componentID] = std::make_unique<Detail::ComponentPool<T>>(poolSize);
+        }
+        static_cast<Detail::ComponentPool<T>*>(pools[componentID].get())->insert(entity.getIndex(), T());
+    }
+
+    void run(std::size_t entityCount)
+    {
+        constexpr std::size_t Passes = 100;
+
+        MessageBus mb;
+        ComponentManager cm;
+        registerPadding(cm, std::make_index_sequence<24>());
+
+        constexpr std::size_t MaxPerManager = Detail::MinFreeIDs;
+        std::vector<std::unique_ptr<EntityManager>> managers;
+
+        std::vector<PoolList> baselinePools;
+
+        std::vector<Entity> entities;
+        for (auto i = 0u; i < entityCount; ++i)
+        {
+            if (i % MaxPerManager == 0)
+            {
+                managers.push_back(std::make_unique<EntityManager>(mb, cm));
+                baselinePools.emplace_back();
+            }
+
+            auto e = managers.back()->createEntity();
+            e.addComponent<Position>();
+            e.addComponent<Velocity>();
+            entities.push_back(e);
+
+            addBaselineComponent<Position>(cm, baselinePools.back(), e, MaxPerManager);
+            addBaselineComponent<Velocity>(cm, baselinePools.back(), e, MaxPerManager);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (auto p = 0u; p < Passes; ++p)
+        {
+            for (auto i = 0u; i < entities.size(); ++i)
+            {
+                auto& pools = baselinePools[i / MaxPerManager];
+                auto& pos = getBaselineComponent<Position>(cm, pools, entities[i]);
+                const auto& vel = getBaselineComponent<Velocity>(cm, pools, entities[i]);
+                pos.x += vel.x;
+                pos.y += vel.y;
+                pos.z += vel.z;
+            }
+        }
+        const auto baselineElapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (auto p = 0u; p < Passes; ++p)
+        {
+            for (auto e : entities)
+            {
+                auto& pos = e.getComponent<Position>();
+                const auto& vel = e.getComponent<Velocity>();
+                pos.x += vel.x;
+                pos.y += vel.y;
+                pos.z += vel.z;
+            }
+        }
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        //read the results so the loop isn't optimised away
+        float sum = 0.f;
+        for (auto i = 0u; i < entities.size(); ++i)
+        {
+            sum += entities[i].getComponent<Position>().x;
+            sum += getBaselineComponent<Position>(cm, baselinePools[i / MaxPerManager], entities[i]).x;
+        }
+
+        const auto lookups = static_cast<double>(entityCount * Passes * 2);
+        std::cout << entityCount << " entities: " << elapsed / Passes << "ms per pass, "
+            << (elapsed * 1000000.0) / lookups << "ns per getComponent() (" << sum << ")\n";
+        std::cout << entityCount << " entities: " << baselineElapsed / Passes << "ms per pass, "
+            << (baselineElapsed * 1000000.0) / lookups << "ns per type_index/dynamic_cast lookup" << std::endl;
+    }
+}
+
+int main()
+{
+    run(10000);
+    run(50000);
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/ecs/ComponentPool.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    struct TestComponent final
+    {
+        std::uint32_t owner = 0;
+    };
+
+    std::vector<std::uint32_t> getActive(Detail::ComponentPool<TestComponent>& pool)
+    {
+        std::vector<std::uint32_t> retVal;
+        pool.forEachActive([&](const TestComponent& c) { retVal.push_back(c.owner); });
+        std::sort(retVal.begin(), retVal.end());
+        return retVal;
+    }
+
+    std::vector<std::uint32_t> getOwned(Detail::ComponentPool<TestComponent>& pool)
+    {
+        std::vector<std::uint32_t> retVal;
+        for (auto i = 0u; i < pool.getSlotCount(); ++i)
+        {
+            const auto idx = pool.getSlotOwner(i);
+            if (idx != Detail::Pool::nullindex)
+            {
+                CHECK(idx == pool.getSlot(i).owner);
+                retVal.push_back(idx);
+            }
+        }
+        std::sort(retVal.begin(), retVal.end());
+        return retVal;
+    }
+
+    void insert(Detail::ComponentPool<TestComponent>& pool, std::uint32_t idx)
+    {
+        pool.insert(idx, TestComponent({ idx }));
+    }
+}
+
+int main()
+{
+    Detail::ComponentPool<TestComponent> pool;
+
+    insert(pool, 0);
+    insert(pool, 1);
+    insert(pool, 2);
+    CHECK(pool.used() == 3);
+    CHECK(getActive(pool) == std::vector<std::uint32_t>({ 0, 1, 2 }));
+
+    //removing the first component leaves its slot free
+    //and the remaining components must all still be visited
+    pool.reset(0);
+    CHECK(pool.used() == 2);
+    CHECK(getActive(pool) == std::vector<std::uint32_t>({ 1, 2 }));
+    CHECK(getOwned(pool) == std::vector<std::uint32_t>({ 1, 2 }));
+
+    //the freed slot is reused by the next insertion
+    insert(pool, 3);
+    CHECK(pool.used() == 3);
+    CHECK(pool.at(3).owner == 3);
+    CHECK(getActive(pool) == std::vector<std::uint32_t>({ 1, 2, 3 }));
+    CHECK(getOwned(pool) == std::vector<std::uint32_t>({ 1, 2, 3 }));
+
+    //remove from the middle and the end
+    pool.reset(2);
+    pool.reset(3);
+    insert(pool, 4);
+    CHECK(getActive(pool) == std::vector<std::uint32_t>({ 1, 4 }));
+    CHECK(getOwned(pool) == std::vector<std::uint32_t>({ 1, 4 }));
+
+    //resetting an entity without a component does nothing
+    pool.reset(2);
+    CHECK(pool.used() == 2);
+
+    pool.reset(1);
+    pool.reset(4);
+    CHECK(pool.used() == 0);
+    CHECK(getActive(pool).empty());
+
+    pool.clear();
+    insert(pool, 5);
+    CHECK(getActive(pool) == std::vector<std::uint32_t>({ 5 }));
+
+    return TEST_RESULT;
+}
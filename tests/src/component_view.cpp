@@ -0,0 +1,188 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/core/MessageBus.hpp>
+#include <crogine/ecs/Component.hpp>
+#include <crogine/ecs/Entity.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <execution>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+//counts allocations so we can check iterating
+//a view doesn't touch the heap
+namespace
+{
+    std::atomic<std::size_t> allocationCount = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    allocationCount++;
+    if (auto* ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace cro;
+
+namespace
+{
+    struct Position final
+    {
+        std::uint32_t owner = 0;
+    };
+
+    struct Velocity final
+    {
+        std::uint32_t owner = 0;
+    };
+
+    std::vector<std::uint32_t> getViewed(EntityManager& em)
+    {
+        std::vector<std::uint32_t> retVal;
+        for (auto [entity, position, velocity] : em.view<Position, Velocity>())
+        {
+            CHECK(entity.getIndex() == position.owner);
+            CHECK(entity.getIndex() == velocity.owner);
+            retVal.push_back(entity.getIndex());
+        }
+        return retVal;
+    }
+}
+
+int main()
+{
+    MessageBus mb;
+    ComponentManager cm;
+    EntityManager em(mb, cm);
+
+    std::vector<Entity> entities;
+    for (auto i = 0u; i < 8u; ++i)
+    {
+        auto e = em.createEntity();
+        e.addComponent<Position>().owner = e.getIndex();
+        if (i % 2 == 0)
+        {
+            e.addComponent<Velocity>().owner = e.getIndex();
+        }
+        entities.push_back(e);
+    }
+
+    //only entities with both components are visited, in pool order
+    CHECK((getViewed(em) == std::vector<std::uint32_t>({ 0, 2, 4, 6 })));
+
+    //single component views visit everything in the pool
+    std::size_t count = 0;
+    for (auto [entity, position] : em.view<Position>())
+    {
+        CHECK(entity.getIndex() == position.owner);
+        count++;
+    }
+    CHECK(count == entities.size());
+
+    //destroyed entities are skipped
+    em.markDestroyed(entities[2]);
+    em.destroyEntity(entities[2]);
+    em.markDestroyed(entities[4]);
+    em.destroyEntity(entities[4]);
+    CHECK((getViewed(em) == std::vector<std::uint32_t>({ 0, 6 })));
+
+    //and new ones are picked up
+    auto e = em.createEntity();
+    e.addComponent<Position>().owner = e.getIndex();
+    e.addComponent<Velocity>().owner = e.getIndex();
+    entities.push_back(e);
+    auto viewed = getViewed(em);
+    std::sort(viewed.begin(), viewed.end());
+    CHECK((viewed == std::vector<std::uint32_t>({ 0, 6, 8 })));
+
+    //walking a view must not allocate once it has been created
+    auto view = em.view<Position, Velocity>();
+    const auto allocations = allocationCount.load();
+    std::uint32_t sum = 0;
+    for (auto [entity, position, velocity] : view)
+    {
+        sum += position.owner + velocity.owner;
+    }
+    CHECK(allocationCount.load() == allocations);
+    CHECK(sum == 28);
+
+    //views are random access, so may be used with parallel algorithms
+    static_assert(std::is_same_v<std::iterator_traits<decltype(view.begin())>::iterator_category, std::random_access_iterator_tag>);
+    CHECK(view.size() == 3);
+    CHECK(view.end() - view.begin() == 3);
+    CHECK(std::get<0>(view.begin()[2]) == std::get<0>(*(view.end() - 1)));
+    CHECK(std::get<0>(view[1]) == std::get<0>(*(view.begin() + 1)));
+    CHECK(view.begin() < view.end());
+
+    std::for_each(std::execution::par, view.begin(), view.end(),
+        [](auto item)
+        {
+            auto& [entity, position, velocity] = item;
+            velocity.owner = position.owner * 2;
+        });
+    for (auto [entity, position, velocity] : view)
+    {
+        CHECK(velocity.owner == entity.getIndex() * 2);
+        velocity.owner = entity.getIndex();
+    }
+
+    //a view with no matching entities is empty
+    for (auto ent : entities)
+    {
+        if (em.entityValid(ent))
+        {
+            em.markDestroyed(ent);
+            em.destroyEntity(ent);
+        }
+    }
+    CHECK(getViewed(em).empty());
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,305 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/graphics/CompressedImage.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+//parses KTX2 and DDS containers from memory, including
+//truncated files and headers with invalid dimensions
+
+using namespace cro;
+
+namespace
+{
+    void write32(std::vector<std::uint8_t>& dst, std::size_t offset, std::uint32_t value)
+    {
+        std::memcpy(dst.data() + offset, &value, sizeof(value));
+    }
+
+    std::uint8_t getValue(std::size_t i)
+    {
+        return static_cast<std::uint8_t>((i * 37 + 11) & 0xff);
+    }
+
+    void fill(CompressedImage& img)
+    {
+        std::size_t i = 0;
+        for (auto level = 0u; level < img.getLevelCount(); ++level)
+        {
+            auto* data = img.getData(level);
+            const auto size = img.getDataSize(level) * img.getLayerCount() * img.getFaceCount();
+            for (auto j = 0u; j < size; ++j)
+            {
+                data[j] = getValue(i++);
+            }
+        }
+    }
+
+    bool equal(const CompressedImage& a, const CompressedImage& b)
+    {
+        if (a.getFormat() != b.getFormat()
+            || a.getSize() != b.getSize()
+            || a.getLevelCount() != b.getLevelCount()
+            || a.getLayerCount() != b.getLayerCount()
+            || a.getFaceCount() != b.getFaceCount())
+        {
+            return false;
+        }
+
+        for (auto level = 0u; level < a.getLevelCount(); ++level)
+        {
+            const auto size = a.getDataSize(level) * a.getLayerCount() * a.getFaceCount();
+            if (a.getDataSize(level) != b.getDataSize(level)
+                || std::memcmp(a.getData(level), b.getData(level), size) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //every prefix of a valid file should be rejected
+    void checkTruncated(const std::vector<std::uint8_t>& file)
+    {
+        for (auto size = 0u; size < file.size(); ++size)
+        {
+            CompressedImage img;
+            CHECK(!img.loadFromMemory(file.data(), size));
+            CHECK(img.getFormat() == CompressedImage::Format::None);
+        }
+    }
+
+    //a DXT5 or DX10 DDS file, with each layer's mip chain stored in turn
+    std::vector<std::uint8_t> createDDS(std::uint32_t width, std::uint32_t height,
+        std::uint32_t levelCount, std::uint32_t dxgiFormat = 0, std::uint32_t layerCount = 1)
+    {
+        constexpr std::size_t HeaderSize = 128;
+        constexpr std::size_t DX10Size = 20;
+
+        std::vector<std::uint8_t> file(HeaderSize + (dxgiFormat ? DX10Size : 0));
+        std::memcpy(file.data(), "DDS ", 4);
+        write32(file, 4, 124);
+        write32(file, 8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);
+        write32(file, 12, height);
+        write32(file, 16, width);
+        write32(file, 28, levelCount);
+        write32(file, 76, 32);
+        write32(file, 80, 0x4); //DDPF_FOURCC
+        std::memcpy(file.data() + 84, dxgiFormat ? "DX10" : "DXT5", 4);
+        write32(file, 108, 0x1000);
+
+        if (dxgiFormat)
+        {
+            write32(file, HeaderSize, dxgiFormat);
+            write32(file, HeaderSize + 4, 3); //2D
+            write32(file, HeaderSize + 12, layerCount);
+        }
+
+        std::size_t i = 0;
+        for (auto layer = 0u; layer < layerCount; ++layer)
+        {
+            for (auto level = 0u; level < levelCount; ++level)
+            {
+                const auto w = std::max(1u, width >> level);
+                const auto h = std::max(1u, height >> level);
+                const auto size = ((w + 3) / 4) * ((h + 3) / 4) * 16;
+                for (auto j = 0u; j < size; ++j)
+                {
+                    file.push_back(getValue(i++));
+                }
+            }
+        }
+        return file;
+    }
+}
+
+int main()
+{
+    //KTX2 files written by saveToFile() load back the same
+    {
+        CompressedImage src;
+        CHECK(src.create(CompressedImage::Format::BC1RGBA, { 16, 8 }, 5));
+        CHECK(src.getLevelCount() == 5);
+        fill(src);
+        src.setBottomUp(true);
+        CHECK(src.saveToFile("compressed_image.ktx2"));
+
+        std::ifstream file("compressed_image.ktx2", std::ios::binary);
+        const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        CHECK(!data.empty());
+
+        CompressedImage img;
+        CHECK(img.loadFromMemory(data.data(), data.size()));
+        CHECK(equal(src, img));
+        CHECK(img.isBottomUp());
+
+        CompressedImage fromFile;
+        CHECK(fromFile.loadFromFile("compressed_image.ktx2"));
+        CHECK(equal(src, fromFile));
+
+        checkTruncated(data);
+
+        //dimensions larger than the file can hold are rejected
+        //before anything is allocated for them
+        for (auto size : { 0x10000u, 0x7fffffffu, 0xffffffffu })
+        {
+            auto bad = data;
+            write32(bad, 20, size);
+            write32(bad, 24, size);
+            CompressedImage badImg;
+            CHECK(!badImg.loadFromMemory(bad.data(), bad.size()));
+            CHECK(badImg.getFormat() == CompressedImage::Format::None);
+        }
+
+        //as are layer counts
+        {
+            auto bad = data;
+            write32(bad, 32, 0xffffffff);
+            CompressedImage badImg;
+            CHECK(!badImg.loadFromMemory(bad.data(), bad.size()));
+        }
+
+        //and level lengths which don't match the header
+        {
+            auto bad = data;
+            write32(bad, 80 + 8, 0xffff);
+            CompressedImage badImg;
+            CHECK(!badImg.loadFromMemory(bad.data(), bad.size()));
+        }
+
+        //mip selection
+        CHECK(img.selectBaseLevel(16) == 0);
+        CHECK(img.selectBaseLevel(4) == 2);
+        CHECK(img.selectBaseLevel(4, 3) == 3);
+        CHECK(img.selectBaseLevel(0) == 4);
+
+        std::vector<std::uint8_t> level2(img.getData(2), img.getData(2) + img.getDataSize(2));
+        img.setBaseLevel(2);
+        CHECK(img.getSize() == glm::uvec2(4, 2));
+        CHECK(img.getLevelCount() == 3);
+        CHECK(img.getDataSize(0) == level2.size());
+        CHECK(std::memcmp(img.getData(0), level2.data(), level2.size()) == 0);
+    }
+
+    //legacy DDS
+    {
+        const auto file = createDDS(8, 8, 4);
+        CompressedImage img;
+        CHECK(img.loadFromMemory(file.data(), file.size()));
+        CHECK(img.getFormat() == CompressedImage::Format::BC3);
+        CHECK(img.getSize() == glm::uvec2(8, 8));
+        CHECK(img.getLevelCount() == 4);
+        CHECK(!img.isBottomUp());
+
+        std::size_t offset = 128;
+        for (auto level = 0u; level < img.getLevelCount(); ++level)
+        {
+            CHECK(std::memcmp(img.getData(level), file.data() + offset, img.getDataSize(level)) == 0);
+            offset += img.getDataSize(level);
+        }
+        CHECK(offset == file.size());
+
+        checkTruncated(file);
+
+        for (auto size : { 0x10000u, 0x7fffffffu, 0xffffffffu })
+        {
+            auto bad = file;
+            write32(bad, 12, size);
+            write32(bad, 16, size);
+            write32(bad, 28, 1);
+            CompressedImage badImg;
+            CHECK(!badImg.loadFromMemory(bad.data(), bad.size()));
+            CHECK(badImg.getFormat() == CompressedImage::Format::None);
+        }
+    }
+
+    //DX10 DDS arrays are shuffled from layers into levels
+    {
+        constexpr std::uint32_t BC7 = 98;
+        const auto file = createDDS(8, 8, 2, BC7, 2);
+        CompressedImage img;
+        CHECK(img.loadFromMemory(file.data(), file.size()));
+        CHECK(img.getFormat() == CompressedImage::Format::BC7);
+        CHECK(img.getLayerCount() == 2);
+        CHECK(img.getLevelCount() == 2);
+
+        const auto* src = file.data() + 148;
+        for (auto layer = 0u; layer < 2u; ++layer)
+        {
+            for (auto level = 0u; level < 2u; ++level)
+            {
+                CHECK(std::memcmp(img.getData(level, layer), src, img.getDataSize(level)) == 0);
+                src += img.getDataSize(level);
+            }
+        }
+
+        checkTruncated(file);
+
+        auto bad = file;
+        write32(bad, 128 + 12, 0xffffffff);
+        CompressedImage badImg;
+        CHECK(!badImg.loadFromMemory(bad.data(), bad.size()));
+
+        //BC7 is uploaded as is, or not at all
+        CHECK(!CompressedImage::canDecompress(CompressedImage::Format::BC7));
+        std::vector<std::uint8_t> pixels;
+        CHECK(!img.decompress(pixels));
+    }
+
+    //decompression fallback for formats which can be decoded on the CPU
+    {
+        CompressedImage img;
+        CHECK(img.create(CompressedImage::Format::BC1RGBA, { 4, 4 }));
+
+        //white and black endpoints, all texels use the first
+        const std::uint8_t block[] = { 0xff, 0xff, 0, 0, 0, 0, 0, 0 };
+        std::memcpy(img.getData(), block, sizeof(block));
+
+        CHECK(CompressedImage::canDecompress(CompressedImage::Format::BC1RGBA));
+        std::vector<std::uint8_t> pixels;
+        CHECK(img.decompress(pixels));
+        CHECK(pixels.size() == 4 * 4 * 4);
+        CHECK(std::all_of(pixels.begin(), pixels.end(), [](std::uint8_t b) {return b == 0xff; }));
+
+        //create() itself rejects sizes which overflow
+        CompressedImage huge;
+        CHECK(!huge.create(CompressedImage::Format::BC7, { 0xffffffff, 0xffffffff }, 1, 0xffffffff, 6));
+        CHECK(huge.getFormat() == CompressedImage::Format::None);
+    }
+
+    return TEST_RESULT;
+}
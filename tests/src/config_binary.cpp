@@ -0,0 +1,283 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "Check.hpp"
+
+#include <crogine/core/ConfigFile.hpp>
+
+#include <crogine/detail/glm/vec4.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+//round trips config files through the compiled binary
+//format, and checks that damaged binary files are rejected
+
+using namespace cro;
+
+namespace
+{
+    const std::string TextPath = "config_binary_test.cfg";
+    const std::string BinaryPath = "config_binary_test.cfb";
+    const std::string DamagedPath = "config_binary_damaged.cfb";
+    const std::string CacheDir = "config_binary_cache/";
+
+    ConfigObject createConfig()
+    {
+        ConfigObject cfg("root", "main");
+        cfg.addProperty("string").setValue("hello world");
+        const std::string utf8 = u8"\u00e9t\u00e9 \u65e5\u672c";
+        cfg.addProperty("unicode").setValue(String::fromUtf8(utf8.begin(), utf8.end()));
+        cfg.addProperty("int").setValue(-42);
+        cfg.addProperty("uint").setValue(42u);
+        cfg.addProperty("float").setValue(3.25f);
+        cfg.addProperty("bool").setValue(true);
+        cfg.addProperty("vec2").setValue(glm::vec2(1.f, -2.f));
+        cfg.addProperty("vec3").setValue(glm::vec3(0.5f, 1.5f, 2.5f));
+        cfg.addProperty("vec4").setValue(glm::vec4(1.f, 2.f, 3.f, 4.f));
+        cfg.addProperty("colour").setValue(Colour(0.1f, 0.2f, 0.3f, 1.f));
+
+        for (auto i = 0; i < 3; ++i)
+        {
+            auto* obj = cfg.addObject("child", "child_" + std::to_string(i));
+            obj->addProperty("index").setValue(i);
+            obj->addProperty("name").setValue("child number " + std::to_string(i));
+
+            auto* nested = obj->addObject("nested");
+            nested->addProperty("depth").setValue(2);
+            nested->addObject("empty");
+        }
+        return cfg;
+    }
+
+    bool equal(const ConfigObject& a, const ConfigObject& b)
+    {
+        if (a.getName() != b.getName()
+            || a.getId() != b.getId()
+            || a.getProperties().size() != b.getProperties().size()
+            || a.getObjects().size() != b.getObjects().size())
+        {
+            return false;
+        }
+
+        for (auto i = 0u; i < a.getProperties().size(); ++i)
+        {
+            const auto& pa = a.getProperties()[i];
+            const auto& pb = b.getProperties()[i];
+            if (pa.getName() != pb.getName()
+                || pa.getValue<std::string>() != pb.getValue<std::string>()
+                || pa.getValue<glm::vec4>() != pb.getValue<glm::vec4>()
+                || pa.getValue<bool>() != pb.getValue<bool>())
+            {
+                return false;
+            }
+        }
+
+        for (auto i = 0u; i < a.getObjects().size(); ++i)
+        {
+            if (!equal(a.getObjects()[i], b.getObjects()[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isEmpty(const ConfigObject& cfg)
+    {
+        return cfg.getName().empty() && cfg.getId().empty()
+            && cfg.getProperties().empty() && cfg.getObjects().empty();
+    }
+
+    std::vector<std::uint8_t> readFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+    void writeFile(const std::string& path, const std::vector<std::uint8_t>& data, std::size_t size)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), size);
+    }
+
+    std::size_t countFiles(const std::string& ext)
+    {
+        std::size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(CacheDir))
+        {
+            if (entry.path().extension() == ext)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+}
+
+int main()
+{
+    std::error_code ec;
+    std::filesystem::remove(TextPath + ConfigObject::BinaryExtension, ec);
+    std::filesystem::remove_all(CacheDir, ec);
+
+    auto source = createConfig();
+    CHECK(source.save(TextPath));
+
+    ConfigObject text;
+    CHECK(text.loadFromFile(TextPath, false));
+    CHECK(equal(source, text));
+
+    //saveBinary -> loadFromBinary produces the same tree as the text file
+    {
+        CHECK(text.saveBinary(BinaryPath));
+
+        ConfigObject binary;
+        CHECK(binary.loadFromFile(BinaryPath, false));
+        CHECK(equal(text, binary));
+
+        //loading again replaces rather than appends
+        CHECK(binary.loadFromFile(BinaryPath, false));
+        CHECK(equal(text, binary));
+
+        //and a binary twin is loaded in place of the text file
+        CHECK(text.saveBinary(TextPath + ConfigObject::BinaryExtension));
+        ConfigObject twin;
+        CHECK(twin.loadFromFile(TextPath, false));
+        CHECK(equal(text, twin));
+        std::filesystem::remove(TextPath + ConfigObject::BinaryExtension, ec);
+    }
+
+    //twins are only loaded when they're newer than the text file
+    {
+        const auto twinPath = TextPath + ConfigObject::BinaryExtension;
+        ConfigObject other("root", "other");
+        CHECK(other.saveBinary(twinPath));
+
+        const auto sourceTime = std::filesystem::last_write_time(TextPath);
+        std::filesystem::last_write_time(twinPath, sourceTime, ec);
+        ConfigObject same;
+        CHECK(same.loadFromFile(TextPath, false));
+        CHECK(equal(text, same));
+
+        std::filesystem::last_write_time(twinPath, sourceTime + std::chrono::seconds(2), ec);
+        ConfigObject newer;
+        CHECK(newer.loadFromFile(TextPath, false));
+        CHECK(equal(other, newer));
+
+        std::filesystem::last_write_time(twinPath, sourceTime - std::chrono::seconds(2), ec);
+        ConfigObject older;
+        CHECK(older.loadFromFile(TextPath, false));
+        CHECK(equal(text, older));
+        std::filesystem::remove(twinPath, ec);
+    }
+
+    //loading a text file compiles it into the cache, which is loaded next time
+    {
+        ConfigObject::setCacheDirectory(CacheDir);
+        CHECK(ConfigObject::getCacheDirectory() == CacheDir);
+
+        ConfigObject miss;
+        CHECK(miss.loadFromFile(TextPath, false));
+        CHECK(equal(text, miss));
+        CHECK(countFiles(ConfigObject::BinaryExtension) == 1);
+        CHECK(countFiles(".tmp") == 0);
+
+        ConfigObject hit;
+        CHECK(hit.loadFromFile(TextPath, false));
+        CHECK(equal(text, hit));
+
+        ConfigObject::setCacheDirectory("");
+    }
+
+    const auto fileData = readFile(BinaryPath);
+    CHECK(fileData.size() > 16);
+
+    //every truncation of the file is rejected, and leaves the object empty
+    {
+        bool allRejected = true;
+        for (auto size = 0u; size < fileData.size(); ++size)
+        {
+            writeFile(DamagedPath, fileData, size);
+
+            ConfigObject cfg = createConfig();
+            allRejected = !cfg.loadFromFile(DamagedPath, false) && isEmpty(cfg) && allRejected;
+        }
+        CHECK(allRejected);
+    }
+
+    //bad headers are rejected
+    {
+        const auto rejects = [&](std::size_t offset, std::uint8_t value)
+            {
+                auto data = fileData;
+                data[offset] = value;
+                writeFile(DamagedPath, data, data.size());
+
+                ConfigObject cfg;
+                return !cfg.loadFromFile(DamagedPath, false) && isEmpty(cfg);
+            };
+
+        CHECK(rejects(0, 0)); //magic
+        CHECK(rejects(4, 0xff)); //version
+        CHECK(rejects(11, 0xff)); //string count
+    }
+
+    //randomly damaged files either load or are rejected, but never crash
+    {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<std::size_t> offset(16, fileData.size() - 1);
+        std::uniform_int_distribution<std::uint32_t> byte(0, 255);
+
+        for (auto i = 0; i < 256; ++i)
+        {
+            auto data = fileData;
+            for (auto j = 0; j < 4; ++j)
+            {
+                data[offset(rng)] = static_cast<std::uint8_t>(byte(rng));
+            }
+            writeFile(DamagedPath, data, data.size());
+
+            ConfigObject cfg;
+            if (!cfg.loadFromFile(DamagedPath, false))
+            {
+                CHECK(isEmpty(cfg));
+            }
+        }
+    }
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,117 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/core/ConfigFile.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+//times ConfigObject::loadFromFile() parsing a generated text file of
+//1000 objects, similar to a large sprite sheet or model definition, and
+//loading the same tree from the binary file written by saveBinary()
+
+using namespace cro;
+
+namespace
+{
+    constexpr std::size_t ObjectCount = 1000;
+    constexpr std::size_t Passes = 20;
+
+    const std::string TextPath("config_parse_bench.cfg");
+    const std::string BinaryPath(TextPath + ConfigObject::BinaryExtension);
+
+    void writeTextFile()
+    {
+        std::ofstream file(TextPath, std::ios::binary);
+        file << "spritesheet bench\n{\n";
+        file << "    src = \"assets/images/sprites.png\"\n";
+        file << "    blendmode = alpha\n\n";
+
+        for (auto i = 0u; i < ObjectCount; ++i)
+        {
+            file << "    //sprite " << i << "\n";
+            file << "    sprite sprite_" << i << "\n    {\n";
+            file << "        bounds = " << i << ", " << i * 2 << ", 64, 32\n";
+            file << "        colour = 1, 0.5, 0.25, 1\n";
+            file << "        name = \"Sprite number " << i << "\"\n";
+            file << "        looped = true\n";
+            file << "        framerate = 12.5\n\n";
+            file << "        animation idle\n        {\n";
+            file << "            frame = 0, 0, 32, 32\n";
+            file << "            frame = 32, 0, 32, 32\n";
+            file << "            loop_start = 0\n";
+            file << "        }\n";
+            file << "    }\n\n";
+        }
+        file << "}\n";
+    }
+
+    double time(const std::string& path)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (auto i = 0u; i < Passes; ++i)
+        {
+            ConfigObject obj;
+            if (!obj.loadFromFile(path, false))
+            {
+                std::cout << "Failed loading " << path << std::endl;
+                return 0.0;
+            }
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / Passes;
+    }
+}
+
+int main()
+{
+    std::error_code ec;
+    std::filesystem::remove(BinaryPath, ec);
+    writeTextFile();
+
+    const auto textTime = time(TextPath);
+
+    ConfigObject obj;
+    obj.loadFromFile(TextPath, false);
+    obj.saveBinary(BinaryPath);
+
+    const auto binaryTime = time(BinaryPath);
+
+    std::cout << ObjectCount << " objects, " << Passes << " passes\n";
+    std::cout << "Text:   " << textTime << "ms per load (" << std::filesystem::file_size(TextPath, ec) << " bytes)\n";
+    std::cout << "Binary: " << binaryTime << "ms per load (" << std::filesystem::file_size(BinaryPath, ec) << " bytes)" << std::endl;
+
+    std::filesystem::remove(TextPath, ec);
+    std::filesystem::remove(BinaryPath, ec);
+
+    return 0;
+}
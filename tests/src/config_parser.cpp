@@ -0,0 +1,276 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "Check.hpp"
+
+#include <crogine/core/ConfigFile.hpp>
+#include <crogine/detail/glm/vec4.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+//compares the trees created by ConfigObject::loadFromFile() with the
+//trees created by the parser it replaced, which read a line at a time
+//and tokenised each line into separate strings. The expected output
+//was generated by loading each file with the previous parser
+
+using namespace cro;
+
+namespace
+{
+    const std::string FileDir("config_parser_files/");
+
+    struct TestCase final
+    {
+        const char* name = nullptr;
+        const char* input = nullptr;
+        const char* expected = nullptr;
+    };
+
+    const TestCase TestCases[] =
+    {
+        {
+            "basic",
+            "model\n"
+            "{\n"
+            "    mesh = \"assets/models/ship.cmb\"\n"
+            "    count = 12\n"
+            "    scale = 0.5\n"
+            "    colour = 1,0.5,0.25,1\n"
+            "    visible = true\n"
+            "    hidden = false\n"
+            "\n"
+            "    material Textured\n"
+            "    {\n"
+            "        diffuse = \"assets/images/ship.png\"\n"
+            "        smooth = true\n"
+            "    }\n"
+            "\n"
+            "    material\n"
+            "    {\n"
+            "        colour = 0.1, 0.2, 0.3\n"
+            "    }\n"
+            "}\n",
+
+            "object model \n"
+            "  mesh|assets/models/ship.cmb|false|0|0,0,0,0\n"
+            "  count|null|false|12|12,0,0,0\n"
+            "  scale|null|false|0|0.5,0,0,0\n"
+            "  colour|null|false|1|1,0.5,0.25,1\n"
+            "  visible|null|true|0|0,0,0,0\n"
+            "  hidden|null|false|0|0,0,0,0\n"
+            "  object material Textured\n"
+            "    diffuse|assets/images/ship.png|false|0|0,0,0,0\n"
+            "    smooth|null|true|0|0,0,0,0\n"
+            "  object material \n"
+            "    colour|null|false|0|0.100000001,0.200000003,0.300000012,0\n"
+        },
+        {
+            "whitespace",
+            "root id_1\r\n"
+            "{\r\n"
+            "\tname=\"value\"\r\n"
+            "\tpos =1.5,2.5\r\n"
+            "\tsize= 3 , 4\r\n"
+            "\tspaced   =   7\r\n"
+            "    trailing = 8    \r\n"
+            "\tchild\r\n"
+            "\t{\r\n"
+            "\t\tnumber = -1.5e3\r\n"
+            "\t\tfraction = .5\r\n"
+            "\t}\r\n"
+            "}\r\n",
+
+            "object root id_1\n"
+            "  name|value|false|0|0,0,0,0\n"
+            "  pos|null|false|1|1.5,2.5,0,0\n"
+            "  size|null|false|3|3,4,0,0\n"
+            "  spaced|null|false|7|7,0,0,0\n"
+            "  trailing|null|false|8|8,0,0,0\n"
+            "  object child \n"
+            "    number|null|false|4294965796|-1500,0,0,0\n"
+            "    fraction|null|false|0|0.5,0,0,0\n"
+        },
+        {
+            "comments",
+            "//leading comment\n"
+            "root\n"
+            "{\n"
+            "    //a comment\n"
+            "    a = 1 //trailing comment\n"
+            "    url = \"http://example.com\" //not part of the value\n"
+            "    b = 2//no space\n"
+            "    //c = 3\n"
+            "}\n",
+
+            "object root \n"
+            "  a|null|false|1|1,0,0,0\n"
+            "  url|http://example.com|false|0|0,0,0,0\n"
+            "  b|null|false|2|2,0,0,0\n"
+        },
+        {
+            "strings",
+            "root\n"
+            "{\n"
+            "    texture = assets/images/tex.png\n"
+            "    mixed = 1,abc,2\n"
+            "    empty = \"\"\n"
+            "    unterminated = \"no closing quote\n"
+            "    word = hello\n"
+            "    number = 42\n"
+            "}\n",
+
+            "object root \n"
+            "  texture|assets/images/tex.png|false|0|0,0,0,0\n"
+            "  mixed|1,abc,2|false|1|1,2,0,0\n"
+            "  empty||false|0|0,0,0,0\n"
+            "  unterminated|no closing quote|false|0|0,0,0,0\n"
+            "  word|hello|false|0|0,0,0,0\n"
+            "  number|null|false|42|42,0,0,0\n"
+        },
+        {
+            "nested",
+            "a\n"
+            "{\n"
+            "    b\n"
+            "    {\n"
+            "        c\n"
+            "        {\n"
+            "            d idD\n"
+            "            {\n"
+            "                value = 1\n"
+            "            }\n"
+            "        }\n"
+            "        after = 2\n"
+            "    }\n"
+            "    last = 3\n"
+            "}\n",
+
+            "object a \n"
+            "  last|null|false|3|3,0,0,0\n"
+            "  object b \n"
+            "    after|null|false|2|2,0,0,0\n"
+            "    object c \n"
+            "      object d idD\n"
+            "        value|null|false|1|1,0,0,0\n"
+        },
+        {
+            "numbers",
+            "root\n"
+            "{\n"
+            "    big = 4294967295\n"
+            "    negative = -2147483648\n"
+            "    precise = 0.1234567890123\n"
+            "    many = 1,2,3,4,5,6,7,8\n"
+            "    utf = \"caf\xc3\xa9 \xe2\x82\xac\"\n"
+            "}\n",
+
+            "object root \n"
+            "  big|null|false|4294967295|4.2949673e+09,0,0,0\n"
+            "  negative|null|false|2147483648|-2.14748365e+09,0,0,0\n"
+            "  precise|null|false|0|0.123456791,0,0,0\n"
+            "  many|null|false|1|1,2,3,4\n"
+            "  utf|caf\xc3\xa9 \xe2\x82\xac|false|0|0,0,0,0\n"
+        }
+    };
+
+    //writes each object and property using the public getters, so that
+    //numeric values are compared at full float precision, and values
+    //hidden by save(), such as numbers mixed with strings, are included
+    void dump(const ConfigObject& obj, std::string& dst, std::size_t depth = 0)
+    {
+        const std::string indent(depth * 2, ' ');
+        dst += indent + "object " + obj.getName() + " " + obj.getId() + "\n";
+        for (const auto& p : obj.getProperties())
+        {
+            const auto v = p.getValue<glm::vec4>();
+            char buffer[160] = {};
+            std::snprintf(buffer, sizeof(buffer), "|%s|%u|%.9g,%.9g,%.9g,%.9g",
+                p.getValue<bool>() ? "true" : "false", p.getValue<std::uint32_t>(), v.x, v.y, v.z, v.w);
+            dst += indent + "  " + p.getName() + "|" + p.getValue<std::string>() + buffer + "\n";
+        }
+
+        for (const auto& o : obj.getObjects())
+        {
+            dump(o, dst, depth + 1);
+        }
+    }
+
+    std::string writeFile(const std::string& name, const std::string& contents)
+    {
+        const auto path = FileDir + name + ".cfg";
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+        return path;
+    }
+}
+
+int main()
+{
+    std::filesystem::remove_all(FileDir);
+    std::filesystem::create_directories(FileDir);
+
+    for (const auto& test : TestCases)
+    {
+        const auto path = writeFile(test.name, test.input);
+
+        ConfigObject obj;
+        CHECK(obj.loadFromFile(path, false));
+
+        std::string result;
+        dump(obj, result);
+        CHECK(result == test.expected);
+        if (result != test.expected)
+        {
+            std::fprintf(stderr, "%s:\n%s\n", test.name, result.c_str());
+        }
+    }
+
+    //the previous parser dropped a final line with no newline, which
+    //is usually the closing brace. This is now read, so the tree is
+    //the same as if the newline were there.
+    {
+        const std::string input = TestCases[0].input;
+        const auto path = writeFile("no_newline", input.substr(0, input.size() - 1));
+
+        ConfigObject obj;
+        CHECK(obj.loadFromFile(path, false));
+
+        std::string result;
+        dump(obj, result);
+        CHECK(result == TestCases[0].expected);
+    }
+
+    std::filesystem::remove_all(FileDir);
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,113 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/graphics/Spatial.hpp>
+#include <crogine/detail/glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+//compares Spatial::cullSpheres() with testing each sphere against each
+//plane. Whichever SIMD path the library was built with is compared with
+//the scalar result, so this should also be run in a USE_AVX build
+
+using namespace cro;
+
+namespace
+{
+    bool isVisible(const Frustum& frustum, const Sphere& sphere)
+    {
+        for (const auto& plane : frustum)
+        {
+            if (Spatial::intersects(plane, sphere) == Planar::Back)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    Frustum frustum = {};
+    const auto projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f);
+    const auto view = glm::lookAt(glm::vec3(0.f, 2.f, 10.f), glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f));
+    Spatial::updateFrustum(frustum, projection * view);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-60.f, 60.f);
+    std::uniform_real_distribution<float> radius(0.f, 5.f);
+
+    //not a multiple of 8 so the remainder is tested too
+    constexpr std::size_t SphereCount = 1003;
+    SphereBatch batch;
+    batch.resize(SphereCount);
+    for (auto i = 0u; i < SphereCount; ++i)
+    {
+        batch.set(i, Sphere(radius(rng), glm::vec3(position(rng), position(rng), position(rng))));
+    }
+
+    //ranges starting at different offsets, as used by the parallel culler
+    for (auto start : { 0u, 1u, 7u, 64u, 500u })
+    {
+        const std::size_t count = SphereCount - start;
+        std::vector<std::uint64_t> output((count + 63) / 64, ~0ull);
+        const auto visibleCount = Spatial::cullSpheres(frustum, batch, start, count, output.data());
+
+        std::size_t expectedCount = 0;
+        for (auto i = 0u; i < count; ++i)
+        {
+            const bool expected = isVisible(frustum, batch.get(start + i));
+            const bool visible = (output[i / 64] & (std::uint64_t(1) << (i % 64))) != 0;
+            CHECK(visible == expected);
+
+            if (expected)
+            {
+                expectedCount++;
+            }
+        }
+        CHECK(visibleCount == expectedCount);
+
+        //bits past the end of the range are cleared
+        if (count % 64)
+        {
+            CHECK((output.back() >> (count % 64)) == 0);
+        }
+    }
+
+    //sanity check there's a mix of results
+    std::vector<std::uint64_t> output((SphereCount + 63) / 64);
+    const auto visibleCount = Spatial::cullSpheres(frustum, batch, 0, SphereCount, output.data());
+    CHECK(visibleCount > 0 && visibleCount < SphereCount);
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,144 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/graphics/Spatial.hpp>
+#include <crogine/detail/glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//times Spatial::cullSpheres() against 100k spheres, compared with
+//testing each Sphere against each plane as the renderers did before,
+//and with the same branchless test as cullSpheres() but without SIMD.
+//Build the library with USE_AVX to compare the AVX path.
+
+using namespace cro;
+
+namespace
+{
+    constexpr std::size_t SphereCount = 100000;
+    constexpr std::size_t Passes = 100;
+
+    template <typename Fn>
+    double time(Fn&& fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (auto i = 0u; i < Passes; ++i)
+        {
+            fn();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / Passes;
+    }
+}
+
+int main()
+{
+    Frustum frustum = {};
+    const auto projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f);
+    const auto view = glm::lookAt(glm::vec3(0.f, 2.f, 10.f), glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f));
+    Spatial::updateFrustum(frustum, projection * view);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-60.f, 60.f);
+    std::uniform_real_distribution<float> radius(0.f, 5.f);
+
+    std::vector<Sphere> spheres;
+    SphereBatch batch;
+    batch.resize(SphereCount);
+    for (auto i = 0u; i < SphereCount; ++i)
+    {
+        spheres.emplace_back(radius(rng), glm::vec3(position(rng), position(rng), position(rng)));
+        batch.set(i, spheres.back());
+    }
+
+    std::vector<std::uint64_t> output((SphereCount + 63) / 64);
+    std::size_t sphereVisible = 0;
+    const auto sphereTime = time([&]()
+        {
+            sphereVisible = 0;
+            for (const auto& sphere : spheres)
+            {
+                bool visible = true;
+                std::size_t i = 0;
+                while (visible && i < frustum.size())
+                {
+                    visible = (Spatial::intersects(frustum[i++], sphere) != Planar::Back);
+                }
+
+                if (visible)
+                {
+                    sphereVisible++;
+                }
+            }
+        });
+
+    std::size_t scalarVisible = 0;
+    const auto scalarTime = time([&]()
+        {
+            std::fill(output.begin(), output.end(), 0);
+            for (auto i = 0u; i < SphereCount; ++i)
+            {
+                bool visible = true;
+                for (const auto& plane : frustum)
+                {
+                    const float dist = (batch.x[i] * plane.x) + (batch.y[i] * plane.y) + (batch.z[i] * plane.z) + plane.w;
+                    visible = visible && (dist >= -batch.radius[i]);
+                }
+
+                if (visible)
+                {
+                    output[i / 64] |= (std::uint64_t(1) << (i % 64));
+                }
+            }
+
+            scalarVisible = 0;
+            for (auto bits : output)
+            {
+                scalarVisible += std::bitset<64>(bits).count();
+            }
+        });
+
+    std::size_t batchVisible = 0;
+    const auto batchTime = time([&]()
+        {
+            batchVisible = Spatial::cullSpheres(frustum, batch, 0, SphereCount, output.data());
+        });
+
+    std::cout << SphereCount << " spheres, " << sphereVisible << " visible\n";
+    std::cout << "Per sphere:      " << sphereTime << "ms\n";
+    std::cout << "Batched scalar:  " << scalarTime << "ms (" << scalarVisible << " visible)\n";
+    std::cout << "cullSpheres():   " << batchTime << "ms (" << batchVisible << " visible)" << std::endl;
+
+    return (sphereVisible == batchVisible && scalarVisible == batchVisible) ? 0 : 1;
+}
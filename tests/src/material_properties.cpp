@@ -0,0 +1,133 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "Check.hpp"
+
+#include <crogine/graphics/MaterialData.hpp>
+
+#include <string>
+
+using namespace cro;
+
+namespace
+{
+    Material::Property makeNumber(float value)
+    {
+        Material::Property prop;
+        prop.type = Material::Property::Number;
+        prop.numberValue = value;
+        return prop;
+    }
+
+    //every resolved entry should point at the current element in the list
+    bool resolvedMatches(const Material::Data& data)
+    {
+        const auto& resolved = data.getResolvedProperties();
+        if (resolved.size() != data.properties.size())
+        {
+            return false;
+        }
+
+        for (const auto& r : resolved)
+        {
+            bool found = false;
+            for (const auto& [name, prop] : data.properties)
+            {
+                if (r.property == &prop.second
+                    && r.location == prop.first)
+                {
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    Material::Data data;
+    data.properties.insert(std::make_pair("u_a", std::make_pair(0, makeNumber(1.f))));
+    data.properties.insert(std::make_pair("u_b", std::make_pair(1, makeNumber(2.f))));
+    data.properties.insert(std::make_pair("u_c", std::make_pair(2, makeNumber(3.f))));
+
+    CHECK(resolvedMatches(data));
+    CHECK(data.getResolvedProperties()[0].location == 0);
+    CHECK(data.getResolvedProperties()[2].location == 2);
+
+    //setting a value changes nothing structurally so needs no rebuild
+    const auto generation = data.properties.getGeneration();
+    const auto* before = data.getResolvedProperties().data();
+    data.setProperty("u_b", 20.f);
+    CHECK(data.properties.getGeneration() == generation);
+    CHECK(data.getResolvedProperties().data() == before);
+    CHECK(data.getResolvedProperties()[1].property->numberValue == 20.f);
+
+    //erase and insert leaves the size unchanged but the old pointer dangling
+    data.properties.erase("u_c");
+    data.properties.insert(std::make_pair("u_d", std::make_pair(3, makeNumber(4.f))));
+    CHECK(data.properties.size() == 3);
+    CHECK(data.properties.getGeneration() != generation);
+    CHECK(resolvedMatches(data));
+    CHECK(data.getResolvedProperties()[2].location == 3);
+    CHECK(data.getResolvedProperties()[2].property->numberValue == 4.f);
+
+    //same again via iterator erase and operator[]
+    data.properties.erase(data.properties.find("u_a"));
+    data.properties["u_e"] = std::make_pair(4, makeNumber(5.f));
+    CHECK(resolvedMatches(data));
+    CHECK(data.getResolvedProperties()[0].location == 1);
+
+    //failed insertions and assigning existing keys don't invalidate
+    const auto current = data.properties.getGeneration();
+    data.properties.insert(std::make_pair("u_e", std::make_pair(4, makeNumber(6.f))));
+    data.properties["u_e"].second.numberValue = 7.f;
+    CHECK(data.properties.getGeneration() == current);
+
+    //clearing and refilling with the same number of elements
+    data.properties.clear();
+    data.properties.emplace("u_f", std::make_pair(5, makeNumber(8.f)));
+    data.properties.emplace("u_g", std::make_pair(6, makeNumber(9.f)));
+    data.properties.emplace("u_h", std::make_pair(7, makeNumber(10.f)));
+    CHECK(resolvedMatches(data));
+
+    //copies resolve against their own list
+    Material::Data copy = data;
+    CHECK(resolvedMatches(copy));
+    CHECK(copy.getResolvedProperties()[0].property != data.getResolvedProperties()[0].property);
+
+    return TEST_RESULT;
+}
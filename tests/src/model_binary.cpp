@@ -0,0 +1,255 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "Check.hpp"
+
+#include <crogine/detail/ModelBinary.hpp>
+#include <crogine/graphics/MeshBuilder.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+//converts a version 2 model binary to version 3 and checks the
+//MeshView created by getMeshView() from it, then checks that
+//truncated files and corrupted headers are rejected
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    const std::string FileDir("model_binary_files/");
+
+    constexpr std::uint16_t Flags = VertexProperty::Position | VertexProperty::Normal | VertexProperty::UV0;
+    constexpr std::size_t VertexStride = 3 + 3 + 2;
+    constexpr std::uint32_t GridSize = 16;
+
+    template <typename T>
+    void writeValue(std::vector<std::uint8_t>& dst, const T& value)
+    {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+        dst.insert(dst.end(), bytes, bytes + sizeof(T));
+    }
+
+    //a flat grid with two index arrays, one for each half
+    struct TestMesh final
+    {
+        std::vector<float> vertexData;
+        std::vector<std::vector<std::uint32_t>> indexData;
+
+        TestMesh()
+        {
+            for (auto y = 0u; y < GridSize; ++y)
+            {
+                for (auto x = 0u; x < GridSize; ++x)
+                {
+                    const float position[] = { static_cast<float>(x), 0.5f, -static_cast<float>(y) };
+                    const float normal[] = { 0.f, 1.f, 0.f };
+                    const float uv[] = { x / float(GridSize - 1), y / float(GridSize - 1) };
+                    vertexData.insert(vertexData.end(), std::begin(position), std::end(position));
+                    vertexData.insert(vertexData.end(), std::begin(normal), std::end(normal));
+                    vertexData.insert(vertexData.end(), std::begin(uv), std::end(uv));
+                }
+            }
+
+            indexData.resize(2);
+            for (auto y = 0u; y < GridSize - 1; ++y)
+            {
+                auto& indices = indexData[y < GridSize / 2 ? 0 : 1];
+                for (auto x = 0u; x < GridSize - 1; ++x)
+                {
+                    const auto i = y * GridSize + x;
+                    const std::uint32_t quad[] = { i, i + GridSize, i + 1, i + 1, i + GridSize, i + GridSize + 1 };
+                    indices.insert(indices.end(), std::begin(quad), std::end(quad));
+                }
+            }
+        }
+
+        std::vector<std::uint8_t> createLegacyFile() const
+        {
+            ModelBinary::HeaderV2 header;
+            header.meshOffset = sizeof(header);
+
+            ModelBinary::MeshHeader meshHeader;
+            meshHeader.flags = Flags;
+            meshHeader.indexArrayCount = static_cast<std::uint16_t>(indexData.size());
+            meshHeader.indexArrayOffset = static_cast<std::uint32_t>(sizeof(header) + sizeof(meshHeader)
+                + (indexData.size() * sizeof(std::uint32_t)) + (vertexData.size() * sizeof(float)));
+
+            std::vector<std::uint8_t> file;
+            writeValue(file, header);
+            writeValue(file, meshHeader);
+            for (const auto& indices : indexData)
+            {
+                writeValue(file, static_cast<std::uint32_t>(indices.size()));
+            }
+
+            for (auto f : vertexData)
+            {
+                writeValue(file, f);
+            }
+
+            for (const auto& indices : indexData)
+            {
+                for (auto i : indices)
+                {
+                    writeValue(file, i);
+                }
+            }
+            return file;
+        }
+    };
+
+    std::vector<std::uint8_t> readFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+    bool isValid(const std::vector<std::uint8_t>& data, std::size_t size)
+    {
+        ModelBinary::MeshView view;
+        return ModelBinary::getMeshView(data.data(), size, view);
+    }
+
+    template <typename T>
+    std::vector<std::uint8_t> corrupt(std::vector<std::uint8_t> data, std::size_t offset, T value)
+    {
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+        return data;
+    }
+}
+
+int main()
+{
+    std::filesystem::remove_all(FileDir);
+    std::filesystem::create_directories(FileDir);
+
+    const TestMesh mesh;
+    const auto legacyPath = FileDir + "legacy.cmb";
+    const auto mappedPath = FileDir + "mapped.cmb";
+    {
+        const auto legacy = mesh.createLegacyFile();
+        std::ofstream file(legacyPath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(legacy.data()), legacy.size());
+    }
+    CHECK(ModelBinary::convert(legacyPath, mappedPath));
+
+    const auto data = readFile(mappedPath);
+    CHECK(!data.empty());
+
+    //a valid file
+    ModelBinary::MeshView view;
+    CHECK(ModelBinary::getMeshView(data.data(), data.size(), view));
+
+    const auto& header = view.header;
+    CHECK(header.flags == Flags);
+    CHECK(header.vertexCount == GridSize * GridSize);
+    CHECK(header.vertexSize == VertexStride * sizeof(float));
+    CHECK(header.vertexOffset % 16 == 0);
+    CHECK(header.indexSize == sizeof(std::uint16_t));
+    CHECK(view.vertexData == data.data() + header.vertexOffset);
+    CHECK(std::memcmp(view.vertexData, mesh.vertexData.data(), mesh.vertexData.size() * sizeof(float)) == 0);
+
+    CHECK(view.indexCounts.size() == mesh.indexData.size());
+    CHECK(view.indexData.size() == mesh.indexData.size());
+    std::size_t dataEnd = 0;
+    for (auto i = 0u; i < view.indexData.size() && i < mesh.indexData.size(); ++i)
+    {
+        CHECK(view.indexCounts[i] == mesh.indexData[i].size());
+
+        std::vector<std::uint16_t> indices(view.indexCounts[i]);
+        std::memcpy(indices.data(), view.indexData[i], indices.size() * sizeof(std::uint16_t));
+        CHECK(std::equal(indices.begin(), indices.end(), mesh.indexData[i].begin(), mesh.indexData[i].end()));
+
+        const auto offset = static_cast<std::size_t>(view.indexData[i] - data.data());
+        CHECK(offset % 4 == 0);
+        dataEnd = std::max(dataEnd, offset + (indices.size() * sizeof(std::uint16_t)));
+    }
+
+    CHECK(header.boundingBox[0] == 0.f && header.boundingBox[1] == 0.5f && header.boundingBox[2] == -float(GridSize - 1));
+    CHECK(header.boundingBox[3] == float(GridSize - 1) && header.boundingBox[4] == 0.5f && header.boundingBox[5] == 0.f);
+
+    //read() returns the same data widened to 32 bit indices
+    {
+        std::vector<float> vertexData;
+        std::vector<std::vector<std::uint32_t>> indexData;
+        const auto meshData = ModelBinary::read(mappedPath, vertexData, indexData);
+        CHECK(meshData.vertexCount == header.vertexCount);
+        CHECK(vertexData == mesh.vertexData);
+        CHECK(indexData == mesh.indexData);
+    }
+
+    //truncated anywhere before the end of the last index array
+    CHECK(dataEnd != 0 && dataEnd <= data.size());
+    bool truncatedRejected = true;
+    for (auto size = 0u; size < dataEnd; ++size)
+    {
+        truncatedRejected = truncatedRejected && !isValid(data, size);
+    }
+    CHECK(truncatedRejected);
+    CHECK(isValid(data, dataEnd));
+    CHECK(!ModelBinary::getMeshView(nullptr, data.size(), view));
+
+    //corrupt headers
+    ModelBinary::Header fileHeader;
+    std::memcpy(&fileHeader, data.data(), sizeof(fileHeader));
+
+    const auto meshOffset = fileHeader.meshOffset;
+    CHECK(!isValid(corrupt(data, offsetof(ModelBinary::Header, magic), ModelBinary::MAGIC_V1), data.size()));
+    CHECK(!isValid(corrupt(data, offsetof(ModelBinary::Header, version), std::uint32_t(2)), data.size()));
+    CHECK(!isValid(corrupt(data, offsetof(ModelBinary::Header, meshOffset), std::uint32_t(0)), data.size()));
+    CHECK(!isValid(corrupt(data, offsetof(ModelBinary::Header, meshOffset), static_cast<std::uint32_t>(data.size())), data.size()));
+    CHECK(!isValid(corrupt(data, offsetof(ModelBinary::Header, meshOffset), std::numeric_limits<std::uint32_t>::max()), data.size()));
+
+    CHECK(!isValid(corrupt(data, meshOffset + offsetof(ModelBinary::MeshHeaderV3, flags), std::uint16_t(VertexProperty::Normal)), data.size()));
+    CHECK(!isValid(corrupt(data, meshOffset + offsetof(ModelBinary::MeshHeaderV3, flags), std::uint16_t(Flags | VertexProperty::Colour)), data.size()));
+    CHECK(!isValid(corrupt(data, meshOffset + offsetof(ModelBinary::MeshHeaderV3, vertexSize), std::uint16_t(header.vertexSize + 4)), data.size()));
+    CHECK(!isValid(corrupt(data, meshOffset + offsetof(ModelBinary::MeshHeaderV3, indexSize), std::uint16_t(3)), data.size()));
+    CHECK(!isValid(corrupt(data, meshOffset + offsetof(ModelBinary::MeshHeaderV3, indexArrayCount), std::uint16_t(Mesh::IndexData::MaxBuffers + 1)), data.size()));
+    CHECK(!isValid(corrupt(data, meshOffset + offsetof(ModelBinary::MeshHeaderV3, vertexCount), std::numeric_limits<std::uint32_t>::max()), data.size()));
+    CHECK(!isValid(corrupt(data, meshOffset + offsetof(ModelBinary::MeshHeaderV3, vertexOffset), static_cast<std::uint32_t>(data.size())), data.size()));
+    CHECK(!isValid(corrupt(data, meshOffset + offsetof(ModelBinary::MeshHeaderV3, indexArrayOffset), static_cast<std::uint32_t>(data.size())), data.size()));
+
+    //index counts follow the mesh header
+    const auto sizesOffset = meshOffset + sizeof(ModelBinary::MeshHeaderV3);
+    CHECK(!isValid(corrupt(data, sizesOffset, std::numeric_limits<std::uint32_t>::max()), data.size()));
+
+    std::filesystem::remove_all(FileDir);
+
+    return TEST_RESULT;
+}
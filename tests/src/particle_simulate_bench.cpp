@@ -0,0 +1,195 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "detail/ParticleSimulation.hpp"
+
+#include <crogine/ecs/components/ParticleEmitter.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+//times the particle update of 8 full emitters, comparing the array of
+//structs loop ParticleSystem used previously with the structure of
+//arrays kernel, which is vectorised when AVX or SSE2 are available.
+//Animation and the removal of expired particles are the same for both
+//so lifetimes are long enough that nothing expires.
+
+using namespace cro;
+
+namespace
+{
+    constexpr std::size_t EmitterCount = 8;
+    constexpr std::size_t ParticleCount = ParticleEmitter::MaxParticles;
+    constexpr std::size_t Frames = 200;
+    constexpr float dt = 1.f / 60.f;
+
+    EmitterSettings createSettings()
+    {
+        EmitterSettings settings;
+        settings.gravity = { 0.f, -9.f, 0.f };
+        settings.forces[0] = { 0.5f, 0.f, 0.2f };
+        settings.acceleration = 0.99f;
+        settings.rotationSpeed = 2.f;
+        settings.scaleModifier = 0.1f;
+        return settings;
+    }
+
+    std::vector<Particle> createParticles(std::uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-10.f, 10.f);
+
+        std::vector<Particle> particles(ParticleCount);
+        for (auto& p : particles)
+        {
+            p.position = { dist(rng), dist(rng), dist(rng) };
+            p.velocity = { dist(rng), dist(rng), dist(rng) };
+            p.lifetime = p.maxLifeTime = 100.f;
+        }
+        return particles;
+    }
+
+    //the update previously performed by ParticleSystem::process()
+    void updateArrayOfStructs(std::vector<Particle>& particles, const EmitterSettings& settings, glm::vec3& minBounds, glm::vec3& maxBounds)
+    {
+        for (auto& p : particles)
+        {
+            p.velocity *= settings.acceleration;
+            p.velocity += settings.gravity * dt;
+            for (auto f : settings.forces)
+            {
+                p.velocity += f * dt;
+            }
+            p.position += p.velocity * dt;
+
+            p.lifetime -= dt;
+            p.colour.setAlpha(std::min(1.f, std::max(p.lifetime / p.maxLifeTime, 0.f)));
+
+            p.rotation += settings.rotationSpeed * dt;
+            p.scale += ((p.scale * settings.scaleModifier) * dt);
+
+            if (p.position.x < minBounds.x) minBounds.x = p.position.x;
+            if (p.position.y < minBounds.y) minBounds.y = p.position.y;
+            if (p.position.z < minBounds.z) minBounds.z = p.position.z;
+
+            if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
+            if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
+            if (p.position.z > maxBounds.z) maxBounds.z = p.position.z;
+        }
+    }
+
+    Detail::ParticleSimulationParams createParams(const EmitterSettings& settings)
+    {
+        Detail::ParticleSimulationParams params;
+        params.velocityOffset = settings.gravity;
+        for (auto f : settings.forces)
+        {
+            params.velocityOffset += f;
+        }
+        params.velocityOffset *= dt;
+        params.acceleration = settings.acceleration;
+        params.dt = dt;
+        params.rotation = settings.rotationSpeed * dt;
+        params.scale = 1.f + (settings.scaleModifier * dt);
+        return params;
+    }
+}
+
+int main()
+{
+    const auto settings = createSettings();
+
+    std::vector<std::vector<Particle>> structs;
+    std::vector<ParticleData> arrays;
+    for (auto i = 0u; i < EmitterCount; ++i)
+    {
+        structs.push_back(createParticles(i));
+
+        auto& data = arrays.emplace_back(ParticleCount);
+        for (auto j = 0u; j < ParticleCount; ++j)
+        {
+            data.set(j, structs.back()[j]);
+        }
+    }
+
+    glm::vec3 boundsSum(0.f);
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto f = 0u; f < Frames; ++f)
+    {
+        for (auto& particles : structs)
+        {
+            glm::vec3 minBounds(std::numeric_limits<float>::max());
+            glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+            updateArrayOfStructs(particles, settings, minBounds, maxBounds);
+            boundsSum += maxBounds - minBounds;
+        }
+    }
+    const auto structTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / Frames;
+
+    const auto params = createParams(settings);
+    start = std::chrono::steady_clock::now();
+    for (auto f = 0u; f < Frames; ++f)
+    {
+        for (auto& particles : arrays)
+        {
+            glm::vec3 minBounds(std::numeric_limits<float>::max());
+            glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+            Detail::simulateParticles(particles, ParticleCount, params, minBounds, maxBounds);
+            boundsSum += maxBounds - minBounds;
+        }
+    }
+    const auto arrayTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / Frames;
+
+    //the forces are summed in a different order so allow for some rounding
+    float maxError = 0.f;
+    for (auto i = 0u; i < EmitterCount; ++i)
+    {
+        for (auto j = 0u; j < ParticleCount; ++j)
+        {
+            const auto& p = structs[i][j];
+            maxError = std::max(maxError, std::abs(p.position.x - arrays[i].positionX[j]));
+            maxError = std::max(maxError, std::abs(p.position.y - arrays[i].positionY[j]));
+            maxError = std::max(maxError, std::abs(p.position.z - arrays[i].positionZ[j]));
+        }
+    }
+
+    std::cout << EmitterCount << " emitters x " << ParticleCount << " particles, " << Frames << " frames\n";
+    std::cout << "Array of structs:   " << structTime << "ms per frame\n";
+    std::cout << "Structure of arrays: " << arrayTime << "ms per frame\n";
+    std::cout << "Max position difference: " << maxError << " (" << boundsSum.x << ")" << std::endl;
+
+    return 0;
+}
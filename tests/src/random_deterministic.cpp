@@ -0,0 +1,172 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/util/Random.hpp>
+
+#include <array>
+#include <future>
+#include <thread>
+
+using namespace cro;
+
+namespace
+{
+    constexpr std::size_t SequenceLength = 32;
+    using Sequence = std::array<std::uint64_t, SequenceLength>;
+
+    Sequence generate()
+    {
+        Sequence sequence = {};
+        for (auto& v : sequence)
+        {
+            v = Util::Random::getGenerator()();
+        }
+        return sequence;
+    }
+
+    //reads a sequence from the generator of a new thread
+    Sequence generateOnThread()
+    {
+        Sequence sequence = {};
+        std::thread t([&sequence]() { sequence = generate(); });
+        t.join();
+        return sequence;
+    }
+
+    struct Run final
+    {
+        Sequence main = {};
+        Sequence first = {};
+        Sequence second = {};
+        std::array<float, SequenceLength> values = {};
+    };
+
+    //enables deterministic mode then samples the calling thread and two
+    //worker threads, which are started one after the other so that the
+    //order in which they use their generators is always the same
+    Run deterministicRun(std::uint64_t seed)
+    {
+        Util::Random::setDeterministic(true, seed);
+
+        Run run;
+        run.main = generate();
+        run.first = generateOnThread();
+        run.second = generateOnThread();
+        for (auto& v : run.values)
+        {
+            v = Util::Random::value(-1.f, 1.f);
+        }
+        return run;
+    }
+}
+
+int main()
+{
+    //explicitly seeded generators
+    {
+        Util::Random::Generator a(1234);
+        Util::Random::Generator b(1234);
+        Util::Random::Generator c(4321);
+
+        bool same = true;
+        bool differs = false;
+        for (auto i = 0u; i < SequenceLength; ++i)
+        {
+            const auto va = a();
+            same = same && va == b();
+            differs = differs || va != c();
+        }
+        CHECK(same);
+        CHECK(differs);
+
+        a.seed(99);
+        b.seed(99);
+        CHECK(a.value(0, 1000) == b.value(0, 1000));
+        CHECK(a.value(0.f, 1.f) == b.value(0.f, 1.f));
+    }
+
+    //setSeed() reseeds the calling thread
+    {
+        Util::Random::setSeed(5678);
+        const auto first = generate();
+        Util::Random::setSeed(5678);
+        CHECK(generate() == first);
+    }
+
+    //deterministic mode
+    {
+        const auto first = deterministicRun(42);
+        CHECK(Util::Random::isDeterministic());
+
+        //the worker threads from the first run have exited, so these are all new
+        const auto second = deterministicRun(42);
+        CHECK(first.main == second.main);
+        CHECK(first.first == second.first);
+        CHECK(first.second == second.second);
+        CHECK(first.values == second.values);
+
+        //each thread gets its own sequence
+        CHECK(first.main != first.first);
+        CHECK(first.main != first.second);
+        CHECK(first.first != first.second);
+
+        //and a different seed gives different sequences
+        const auto other = deterministicRun(43);
+        CHECK(other.main != first.main);
+        CHECK(other.first != first.first);
+        CHECK(other.second != first.second);
+
+        //a thread which used its generator before deterministic mode was
+        //enabled is reseeded on its next use, so it gets the first sequence
+        Util::Random::setDeterministic(false);
+        std::promise<void> started;
+        std::promise<void> enabled;
+        Sequence workerSequence = {};
+        std::thread t([&]()
+            {
+                generate();
+                started.set_value();
+                enabled.get_future().wait();
+                workerSequence = generate();
+            });
+        started.get_future().wait();
+        Util::Random::setDeterministic(true, 42);
+        enabled.set_value();
+        t.join();
+        CHECK(workerSequence == first.first);
+
+        Util::Random::setDeterministic(false);
+        CHECK(!Util::Random::isDeterministic());
+        CHECK(generateOnThread() != first.first);
+    }
+
+    return TEST_RESULT;
+}
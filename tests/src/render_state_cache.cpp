@@ -0,0 +1,225 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "Check.hpp"
+
+#include "detail/GLCheck.hpp"
+
+#include <crogine/graphics/MaterialData.hpp>
+#include <crogine/graphics/RenderStateCache.hpp>
+
+#include <algorithm>
+#include <vector>
+
+//records the state changes made by a RenderStateCache, without
+//a GL context, and checks that redundant changes are skipped
+
+using namespace cro;
+
+namespace
+{
+    std::size_t count(const std::vector<RenderCommand>& commands, RenderCommand::Type type)
+    {
+        return std::count_if(commands.begin(), commands.end(),
+            [type](const RenderCommand& cmd) {return cmd.type == type; });
+    }
+
+    //applies the same state, in the same order, as ModelRenderer::render()
+    void draw(RenderStateCache& cache, const std::vector<const Material::Data*>& drawList)
+    {
+        cache.invalidate();
+        cache.resetStats();
+
+        for (const auto* material : drawList)
+        {
+            cache.setFrontFace(GL_CCW);
+            cache.useProgram(material->shader);
+            cache.applyMaterial(*material);
+            cache.record(RenderCommand::Draw);
+        }
+    }
+
+    Material::Data createMaterial(std::uint32_t shader, Material::BlendMode blendMode)
+    {
+        Material::Data material;
+        material.shader = shader;
+        material.blendMode = blendMode;
+        return material;
+    }
+}
+
+int main()
+{
+    //the first change is always issued, and repeating it is skipped
+    {
+        std::vector<RenderCommand> commands;
+        RenderStateCache cache(&commands);
+        CHECK(cache.isRecording());
+
+        CHECK(cache.useProgram(1));
+        CHECK(!cache.useProgram(1));
+        CHECK(cache.useProgram(2));
+        cache.setEnabled(GL_BLEND, true);
+        cache.setEnabled(GL_BLEND, true);
+        cache.setBlendFunc(GL_ONE, GL_ONE);
+        cache.setBlendFunc(GL_ONE, GL_ONE);
+        cache.setBlendFunc(GL_ONE, GL_ZERO);
+
+        CHECK(commands.size() == 5);
+        CHECK(count(commands, RenderCommand::UseProgram) == 2);
+        CHECK(count(commands, RenderCommand::Enable) == 1);
+        CHECK(count(commands, RenderCommand::BlendFunc) == 2);
+        CHECK(cache.getStats().issued == 5);
+        CHECK(cache.getStats().skipped == 3);
+
+        //invalidating makes everything unknown again
+        cache.invalidate();
+        CHECK(cache.useProgram(2));
+        cache.setEnabled(GL_BLEND, true);
+        CHECK(commands.size() == 7);
+
+        //untracked capabilities are always passed through
+        commands.clear();
+        cache.resetStats();
+        cache.setEnabled(GL_STENCIL_TEST, true);
+        cache.setEnabled(GL_STENCIL_TEST, true);
+        CHECK(count(commands, RenderCommand::Enable) == 2);
+        CHECK(cache.getStats().issued == 2);
+        CHECK(cache.getStats().skipped == 0);
+
+        //commands which aren't cached are recorded as they are
+        commands.clear();
+        cache.record(RenderCommand::Draw, 3, 4);
+        CHECK(commands.size() == 1);
+        CHECK(commands[0].type == RenderCommand::Draw && commands[0].a == 3 && commands[0].b == 4);
+    }
+
+    //a draw list grouped by shader binds each program once, whereas
+    //an interleaved list binds a program for every draw
+    {
+        constexpr std::size_t DrawCount = 100;
+        const auto a = createMaterial(1, Material::BlendMode::None);
+        const auto b = createMaterial(2, Material::BlendMode::None);
+
+        std::vector<const Material::Data*> sorted(DrawCount, &a);
+        sorted.insert(sorted.end(), DrawCount, &b);
+
+        std::vector<const Material::Data*> interleaved;
+        for (auto i = 0u; i < DrawCount; ++i)
+        {
+            interleaved.push_back(&a);
+            interleaved.push_back(&b);
+        }
+
+        //each draw makes 7 calls to the cache: front face, program,
+        //blend, depth test, depth mask, culling, and depth test again
+        constexpr std::size_t CallsPerDraw = 7;
+        constexpr std::size_t StateCount = 5; //front face, blend, depth test, depth mask, culling
+
+        std::vector<RenderCommand> commands;
+        RenderStateCache cache(&commands);
+        draw(cache, sorted);
+
+        CHECK(count(commands, RenderCommand::Draw) == DrawCount * 2);
+        CHECK(count(commands, RenderCommand::UseProgram) == 2);
+        CHECK(count(commands, RenderCommand::FrontFace) == 1);
+        CHECK(count(commands, RenderCommand::Enable) == 2); //depth test, culling
+        CHECK(count(commands, RenderCommand::Disable) == 1); //blend
+        CHECK(count(commands, RenderCommand::DepthMask) == 1);
+        CHECK(cache.getStats().issued == 2 + StateCount);
+        CHECK(cache.getStats().skipped == (DrawCount * 2 * CallsPerDraw) - cache.getStats().issued);
+
+        commands.clear();
+        draw(cache, interleaved);
+
+        CHECK(count(commands, RenderCommand::Draw) == DrawCount * 2);
+        CHECK(count(commands, RenderCommand::UseProgram) == DrawCount * 2);
+        CHECK(count(commands, RenderCommand::FrontFace) == 1);
+        CHECK(cache.getStats().issued == (DrawCount * 2) + StateCount);
+        CHECK(cache.getStats().skipped == (DrawCount * 2 * CallsPerDraw) - cache.getStats().issued);
+    }
+
+    //blend state is only changed where the blend mode differs
+    {
+        const auto opaque = createMaterial(1, Material::BlendMode::None);
+        const auto alpha = createMaterial(2, Material::BlendMode::Alpha);
+        auto additive = createMaterial(2, Material::BlendMode::Additive);
+        additive.doubleSided = true;
+
+        std::vector<RenderCommand> commands;
+        RenderStateCache cache(&commands);
+        draw(cache, { &opaque, &opaque, &alpha, &alpha, &additive, &additive, &alpha });
+
+        CHECK(count(commands, RenderCommand::UseProgram) == 2);
+        CHECK(count(commands, RenderCommand::BlendFunc) == 3); //alpha, additive, alpha
+        CHECK(count(commands, RenderCommand::BlendEquation) == 1); //all GL_FUNC_ADD
+        CHECK(count(commands, RenderCommand::DepthMask) == 2); //on, then off for blending
+        CHECK(count(commands, RenderCommand::Disable) == 2); //blend, then culling for the double sided material
+        CHECK(count(commands, RenderCommand::Enable) == 4); //depth test, culling, blend, culling after the double sided material
+    }
+
+    //custom blend modes apply exactly the state they list
+    {
+        auto custom = createMaterial(1, Material::BlendMode::Custom);
+        custom.blendData.enableProperties = { GL_BLEND, GL_DEPTH_TEST };
+        custom.blendData.writeDepthMask = 0;
+        custom.blendData.blendFunc = { GL_ONE, GL_ONE_MINUS_SRC_ALPHA };
+        custom.blendData.equation = GL_FUNC_ADD;
+        custom.doubleSided = true;
+
+        std::vector<RenderCommand> commands;
+        RenderStateCache cache(&commands);
+        cache.applyMaterial(custom);
+
+        const std::vector<RenderCommand> expected =
+        {
+            { RenderCommand::Enable, GL_BLEND },
+            { RenderCommand::Enable, GL_DEPTH_TEST },
+            { RenderCommand::DepthMask, 0 },
+            { RenderCommand::BlendFunc, GL_ONE, GL_ONE_MINUS_SRC_ALPHA },
+            { RenderCommand::BlendEquation, GL_FUNC_ADD },
+            { RenderCommand::Disable, GL_CULL_FACE }
+        };
+
+        CHECK(commands.size() == expected.size());
+        CHECK(std::equal(commands.begin(), commands.end(), expected.begin(), expected.end(),
+            [](const RenderCommand& l, const RenderCommand& r)
+            {
+                return l.type == r.type && l.a == r.a && l.b == r.b;
+            }));
+
+        //applying it again changes nothing
+        commands.clear();
+        cache.applyMaterial(custom);
+        CHECK(commands.empty());
+    }
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,176 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include "detail/PoseArena.hpp"
+
+#include <crogine/detail/glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace cro;
+
+/*
+Compares the polynomial slerp used by the SkeletalAnimator against
+glm::slerp(). Joints are mixed both all together, which uses SSE2
+when the library was built with it, and one at a time, which always
+uses the scalar path that non-SSE targets rely on.
+*/
+
+namespace
+{
+    //largest difference allowed in any quaternion component. Each of
+    //the 8 term coefficients is within 1.9e-5 of sin(t*theta)/sin(theta)
+    //even in double precision, the worst case being around 90 degrees
+    //at t = 0.5, and both are summed into the result. Measured max is 2.7e-5
+    constexpr float RotationTolerance = 5e-5f;
+    constexpr float LerpTolerance = 1e-5f;
+
+    glm::quat randomQuat(std::mt19937& rng)
+    {
+        std::normal_distribution<float> dist;
+        return glm::normalize(glm::quat(dist(rng), dist(rng), dist(rng), dist(rng)));
+    }
+
+    glm::quat rotate(glm::quat q, float angle, std::mt19937& rng)
+    {
+        std::normal_distribution<float> dist;
+        const auto axis = glm::normalize(glm::vec3(dist(rng), dist(rng), dist(rng)));
+        return glm::normalize(q * glm::angleAxis(angle, axis));
+    }
+
+    float maxDifference(glm::quat a, glm::quat b)
+    {
+        return std::max({ std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z), std::abs(a.w - b.w) });
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> posDist(-10.f, 10.f);
+    std::uniform_real_distribution<float> scaleDist(0.1f, 4.f);
+
+    std::vector<Joint> a;
+    std::vector<Joint> b;
+    const auto addPair = [&](glm::quat qa, glm::quat qb)
+    {
+        auto& ja = a.emplace_back();
+        ja.translation = { posDist(rng), posDist(rng), posDist(rng) };
+        ja.rotation = qa;
+        ja.scale = { scaleDist(rng), scaleDist(rng), scaleDist(rng) };
+
+        auto& jb = b.emplace_back();
+        jb.translation = { posDist(rng), posDist(rng), posDist(rng) };
+        jb.rotation = qb;
+        jb.scale = { scaleDist(rng), scaleDist(rng), scaleDist(rng) };
+    };
+
+    //identical, and the same rotation with the opposite sign
+    const auto q = randomQuat(rng);
+    addPair(q, q);
+    addPair(q, -q);
+
+    //sweep the angle between the pair from almost nothing to (nearly) antipodal.
+    //glm::slerp() switches to lerp when the angle is tiny, and flips b when the
+    //dot product is negative, so negate every other pair to test the sign handling
+    const std::vector<float> angles = { 1e-4f, 1e-3f, 0.01f, 0.1f, 0.5f, 1.f, glm::half_pi<float>(), 2.f, 2.5f, 3.f, 3.1f, 3.14f };
+    for (auto angle : angles)
+    {
+        for (auto i = 0; i < 4; ++i)
+        {
+            const auto qa = randomQuat(rng);
+            const auto qb = rotate(qa, angle, rng);
+            addPair(qa, (i % 2) ? -qb : qb);
+        }
+    }
+
+    //and some which are entirely random
+    for (auto i = 0; i < 33; ++i)
+    {
+        addPair(randomQuat(rng), randomQuat(rng));
+    }
+
+    //mixes joints [first, first + count) of a and b for each t and compares them
+    //with glm. The arena only uses SIMD for whole blocks of 4 joints, so mixing
+    //them one at a time runs the scalar path on every pair
+    float maxError = 0.f;
+    const auto test = [&](std::size_t first, std::size_t count)
+    {
+        Detail::PoseArena arena;
+        arena.resize(count);
+        arena.gather(arena.a, a.data() + first, count);
+        arena.gather(arena.b, b.data() + first, count);
+
+        std::vector<Joint> output(count);
+        for (auto step = 0; step <= 10; ++step)
+        {
+            const float t = static_cast<float>(step) / 10.f;
+            Detail::mixPose(arena, count, t);
+            arena.scatter(output.data(), count);
+
+            for (auto j = 0u; j < count; ++j)
+            {
+                const auto i = first + j;
+                const auto expected = glm::slerp(a[i].rotation, b[i].rotation, t);
+                const auto error = maxDifference(output[j].rotation, expected);
+                maxError = std::max(maxError, error);
+                if (error > RotationTolerance)
+                {
+                    std::cerr << "joint " << i << " of " << count << " t " << t << " rotation error " << error << std::endl;
+                }
+                CHECK(error <= RotationTolerance);
+
+                const auto translation = glm::mix(a[i].translation, b[i].translation, t);
+                const auto scale = glm::mix(a[i].scale, b[i].scale, t);
+                CHECK(glm::length(output[j].translation - translation) < LerpTolerance * 10.f);
+                CHECK(glm::length(output[j].scale - scale) < LerpTolerance);
+            }
+        }
+    };
+
+    //all together, which uses SSE2 where available
+    test(0, a.size());
+    std::cout << "max slerp error " << maxError << std::endl;
+
+    //and one at a time, which is always scalar
+    maxError = 0.f;
+    for (auto i = 0u; i < a.size(); ++i)
+    {
+        test(i, 1);
+    }
+    std::cout << "max scalar slerp error " << maxError << std::endl;
+
+    return TEST_RESULT;
+}
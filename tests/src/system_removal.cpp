@@ -0,0 +1,145 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/core/MessageBus.hpp>
+#include <crogine/ecs/Component.hpp>
+#include <crogine/ecs/Entity.hpp>
+#include <crogine/ecs/System.hpp>
+
+#include <algorithm>
+#include <vector>
+
+//checks System::removeEntity() in both the default constant
+//time mode and with setOrderedRemoval(true)
+
+using namespace cro;
+
+namespace
+{
+    class TestSystem final : public System
+    {
+    public:
+        TestSystem(MessageBus& mb, bool ordered)
+            : System(mb, typeid(TestSystem))
+        {
+            setOrderedRemoval(ordered);
+        }
+
+        void onEntityRemoved(Entity e) override
+        {
+            removed.push_back(e.getIndex());
+        }
+
+        std::vector<std::uint32_t> removed;
+    };
+
+    std::vector<std::uint32_t> getIndices(const System& system)
+    {
+        std::vector<std::uint32_t> retVal;
+        for (auto e : system.getEntities())
+        {
+            retVal.push_back(e.getIndex());
+        }
+        return retVal;
+    }
+}
+
+int main()
+{
+    MessageBus mb;
+    ComponentManager cm;
+    EntityManager em(mb, cm);
+
+    std::vector<Entity> entities;
+    for (auto i = 0u; i < 6u; ++i)
+    {
+        entities.push_back(em.createEntity());
+    }
+
+    //ordered removal keeps the insertion order
+    {
+        TestSystem system(mb, true);
+        for (auto e : entities)
+        {
+            system.addEntity(e);
+        }
+
+        system.removeEntity(entities[1]);
+        system.removeEntity(entities[4]);
+        CHECK((getIndices(system) == std::vector<std::uint32_t>({ 0, 2, 3, 5 })));
+
+        //removing twice, or something never added, does nothing
+        system.removeEntity(entities[1]);
+        CHECK(system.removed.size() == 2);
+
+        //the slot index is still correct after shifting
+        system.removeEntity(entities[5]);
+        system.removeEntity(entities[0]);
+        CHECK((getIndices(system) == std::vector<std::uint32_t>({ 2, 3 })));
+        CHECK((system.removed == std::vector<std::uint32_t>({ 1, 4, 5, 0 })));
+    }
+
+    //the default swaps the last entity into the removed slot
+    {
+        TestSystem system(mb, false);
+        for (auto e : entities)
+        {
+            system.addEntity(e);
+        }
+
+        system.removeEntity(entities[1]);
+        CHECK((getIndices(system) == std::vector<std::uint32_t>({ 0, 5, 2, 3, 4 })));
+
+        system.removeEntity(entities[1]);
+        system.removeEntity(entities[0]);
+        CHECK((getIndices(system) == std::vector<std::uint32_t>({ 4, 5, 2, 3 })));
+        CHECK((system.removed == std::vector<std::uint32_t>({ 1, 0 })));
+    }
+
+    //derived systems may reorder the list themselves
+    {
+        TestSystem system(mb, true);
+        for (auto e : entities)
+        {
+            system.addEntity(e);
+        }
+
+        auto& list = system.getEntities();
+        std::reverse(list.begin(), list.end());
+
+        system.removeEntity(entities[2]);
+        system.removeEntity(entities[5]);
+        CHECK((getIndices(system) == std::vector<std::uint32_t>({ 4, 3, 1, 0 })));
+        CHECK((system.removed == std::vector<std::uint32_t>({ 2, 5 })));
+    }
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,233 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include "graphics/TextureLoader.hpp"
+
+#include <crogine/graphics/CompressedImage.hpp>
+#include <crogine/graphics/Image.hpp>
+#include <crogine/graphics/ImageArray.hpp>
+#include <crogine/graphics/Texture.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+//decodes images with the TextureLoader on worker threads without
+//a GL context. Textures used as targets are never uploaded to, as
+//their loads are cancelled before update() is called.
+
+using namespace cro;
+
+namespace
+{
+    constexpr std::size_t ImageCount = 16;
+    constexpr std::uint32_t ImageSize = 64;
+
+    std::string getPath(std::size_t i)
+    {
+        return "texture_loader_" + std::to_string(i) + ".png";
+    }
+
+    std::uint8_t getValue(std::size_t i, std::uint32_t x, std::uint32_t y, std::uint32_t channel)
+    {
+        return static_cast<std::uint8_t>((i * 31 + x * 7 + y * 13 + channel * 59) & 0xff);
+    }
+
+    bool writeImages()
+    {
+        std::vector<std::uint8_t> pixels(ImageSize * ImageSize * 4);
+        for (auto i = 0u; i < ImageCount; ++i)
+        {
+            for (auto y = 0u; y < ImageSize; ++y)
+            {
+                for (auto x = 0u; x < ImageSize; ++x)
+                {
+                    for (auto c = 0u; c < 4u; ++c)
+                    {
+                        pixels[((y * ImageSize) + x) * 4 + c] = getValue(i, x, y, c);
+                    }
+                }
+            }
+
+            Image img;
+            if (!img.loadFromMemory(pixels.data(), ImageSize, ImageSize, ImageFormat::RGBA)
+                || !img.write(getPath(i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //images are flipped on load, so row 0 of the
+    //decoded image is the last row of the file
+    bool matches(std::size_t i, const ImageArray<std::uint8_t>& image)
+    {
+        if (image.getDimensions() != glm::uvec2(ImageSize)
+            || image.getChannels() != 4)
+        {
+            return false;
+        }
+
+        const auto* data = image.data();
+        for (auto y = 0u; y < ImageSize; ++y)
+        {
+            const auto row = ImageSize - 1 - y;
+            for (auto x = 0u; x < ImageSize; ++x)
+            {
+                for (auto c = 0u; c < 4u; ++c)
+                {
+                    if (data[((row * ImageSize) + x) * 4 + c] != getValue(i, x, y, c))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    bool waitFor(Fn&& fn)
+    {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (!fn())
+        {
+            if (std::chrono::steady_clock::now() > timeout)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    if (!writeImages())
+    {
+        std::cerr << "Failed writing test images" << std::endl;
+        return 1;
+    }
+
+    //settings as they would be on a device without any
+    //compressed formats, so no GL queries are needed
+    Detail::TextureLoader::DecodeSettings settings;
+    settings.maxSize = 4096;
+
+    //decode() is static and may be called from any thread at once
+    {
+        constexpr std::size_t ThreadCount = 4;
+        std::array<std::vector<bool>, ThreadCount> results;
+        std::vector<std::thread> threads;
+        for (auto t = 0u; t < ThreadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+                {
+                    for (auto i = 0u; i < ImageCount; ++i)
+                    {
+                        CompressedImage compressed;
+                        ImageArray<std::uint8_t> image;
+                        const bool decoded = Detail::TextureLoader::decode(getPath(i), settings, compressed, image);
+                        results[t].push_back(decoded
+                            && compressed.getFormat() == CompressedImage::Format::None
+                            && matches(i, image));
+                    }
+                });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        for (const auto& result : results)
+        {
+            CHECK(result.size() == ImageCount);
+            CHECK(std::all_of(result.begin(), result.end(), [](bool b) {return b; }));
+        }
+
+        CompressedImage compressed;
+        ImageArray<std::uint8_t> image;
+        CHECK(!Detail::TextureLoader::decode("texture_loader_missing.png", settings, compressed, image));
+    }
+
+    //queued loads are decoded by the worker pool while this thread waits
+    {
+        CHECK(Detail::TextureLoader::getWorkerCount() == 0);
+
+        std::array<Texture, ImageCount + 1> textures;
+        for (auto i = 0u; i < ImageCount; ++i)
+        {
+            Detail::TextureLoader::loadAsync(getPath(i), &textures[i], false, settings);
+        }
+        //failed decodes are still delivered
+        Detail::TextureLoader::loadAsync("texture_loader_missing.png", &textures[ImageCount], false, settings);
+
+        const auto expectedWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+        CHECK(Detail::TextureLoader::getWorkerCount() == expectedWorkers);
+        CHECK(Detail::TextureLoader::getPendingCount() == textures.size());
+
+        CHECK(waitFor([&]() { return Detail::TextureLoader::getDecodedCount() == textures.size(); }));
+        CHECK(Detail::TextureLoader::getPendingCount() == textures.size());
+
+        //nothing has been uploaded so cancelling drops everything
+        //without touching the textures when update() is called
+        for (const auto& t : textures)
+        {
+            Detail::TextureLoader::cancel(&t);
+        }
+        Detail::TextureLoader::update();
+        CHECK(Detail::TextureLoader::getDecodedCount() == 0);
+        CHECK(Detail::TextureLoader::getPendingCount() == 0);
+
+        //loads cancelled before they're decoded are also discarded
+        for (auto i = 0u; i < ImageCount; ++i)
+        {
+            Detail::TextureLoader::loadAsync(getPath(i), &textures[i], false, settings);
+            Detail::TextureLoader::cancel(&textures[i]);
+        }
+        CHECK(waitFor([]()
+            {
+                Detail::TextureLoader::update();
+                return Detail::TextureLoader::getPendingCount() == 0;
+            }));
+    }
+
+    Detail::TextureLoader::shutdown();
+    CHECK(Detail::TextureLoader::getWorkerCount() == 0);
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,175 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/ecs/components/Transform.hpp>
+
+#include <array>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    bool equal(glm::vec3 a, glm::vec3 b)
+    {
+        return glm::length(a - b) < 0.0001f;
+    }
+
+    Transform::ResolveStats resolve(const Transform& root)
+    {
+        Transform::ResolveStats stats;
+        root.resolveHierarchy(&stats);
+        return stats;
+    }
+}
+
+int main()
+{
+    //a chain of root -> mid -> leaf
+    Transform root;
+    Transform mid;
+    Transform leaf;
+    root.addChild(mid);
+    mid.addChild(leaf);
+
+    root.setPosition({ 1.f, 0.f, 0.f });
+    mid.setPosition({ 0.f, 2.f, 0.f });
+    leaf.setPosition({ 0.f, 0.f, 3.f });
+
+    CHECK(root.getDirty());
+    CHECK(mid.getDirty());
+    CHECK(leaf.getDirty());
+
+    //everything is new so everything is recomputed
+    auto stats = resolve(root);
+    CHECK(stats.recomputed == 3);
+    CHECK(stats.reused == 0);
+    CHECK(!root.getDirty());
+    CHECK(!mid.getDirty());
+    CHECK(!leaf.getDirty());
+    CHECK(equal(leaf.getWorldPosition(), { 1.f, 2.f, 3.f }));
+
+    //nothing changed so everything is reused
+    stats = resolve(root);
+    CHECK(stats.recomputed == 0);
+    CHECK(stats.reused == 3);
+
+    //modifying the leaf only dirties the leaf
+    leaf.move({ 0.f, 0.f, 1.f });
+    CHECK(!root.getDirty());
+    CHECK(!mid.getDirty());
+    CHECK(leaf.getDirty());
+    stats = resolve(root);
+    CHECK(stats.recomputed == 1);
+    CHECK(stats.reused == 2);
+    CHECK(equal(leaf.getWorldPosition(), { 1.f, 2.f, 4.f }));
+
+    //modifying the middle dirties everything below it
+    mid.setScale({ 2.f, 2.f, 2.f });
+    CHECK(!root.getDirty());
+    CHECK(mid.getDirty());
+    CHECK(leaf.getDirty());
+    stats = resolve(root);
+    CHECK(stats.recomputed == 2);
+    CHECK(stats.reused == 1);
+    CHECK(equal(leaf.getWorldPosition(), { 1.f, 2.f, 8.f }));
+    CHECK(equal(leaf.getWorldScale(), { 2.f, 2.f, 2.f }));
+
+    //reading a dirty leaf lazily resolves its parents first
+    root.move({ 10.f, 0.f, 0.f });
+    CHECK(leaf.getDirty());
+    CHECK(equal(leaf.getWorldPosition(), { 11.f, 2.f, 8.f }));
+    CHECK(!root.getDirty());
+    CHECK(!mid.getDirty());
+    CHECK(!leaf.getDirty());
+    stats = resolve(root);
+    CHECK(stats.recomputed == 0);
+    CHECK(stats.reused == 3);
+
+    //removing a child makes it a root, and dirty
+    mid.removeChild(leaf);
+    CHECK(leaf.isRoot());
+    CHECK(leaf.getDirty());
+    CHECK(equal(leaf.getWorldPosition(), { 0.f, 0.f, 4.f }));
+
+    //many children of one dirty parent read lazily from
+    //several threads at once, as the parallel cull loops do
+    {
+        constexpr std::size_t ChildCount = 64;
+        constexpr std::size_t ThreadCount = 8;
+
+        Transform parent;
+        std::array<Transform, ChildCount> children;
+        for (auto i = 0u; i < ChildCount; ++i)
+        {
+            children[i].setPosition({ static_cast<float>(i), 0.f, 0.f });
+            parent.addChild(children[i]);
+        }
+
+        for (auto pass = 0; pass < 20; ++pass)
+        {
+            const glm::vec3 offset(0.f, static_cast<float>(pass), 1.f);
+            parent.setPosition(offset);
+
+            std::array<bool, ThreadCount> results = {};
+            std::vector<std::thread> threads;
+            for (auto t = 0u; t < ThreadCount; ++t)
+            {
+                threads.emplace_back([&, t]()
+                    {
+                        bool result = true;
+                        for (auto i = 0u; i < ChildCount; ++i)
+                        {
+                            //threads start at different children
+                            const auto idx = (i + t * 7) % ChildCount;
+                            result = result && equal(children[idx].getWorldPosition(), offset + glm::vec3(static_cast<float>(idx), 0.f, 0.f));
+                        }
+                        results[t] = result;
+                    });
+            }
+
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+
+            for (auto r : results)
+            {
+                CHECK(r);
+            }
+            CHECK(!parent.getDirty());
+        }
+    }
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,226 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Check.hpp"
+
+#include <crogine/graphics/MeshData.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+//packs and unpacks vertex data in each Mesh::AttributeFormat,
+//neither of which requires a GL context
+
+using namespace cro;
+
+namespace
+{
+    constexpr std::size_t VertexCount = 1000;
+
+    //largest expected difference between a value and its
+    //unpacked value for a given format
+    float getTolerance(std::uint8_t format, float range)
+    {
+        switch (format)
+        {
+        default:
+        case Mesh::AttributeFormat::Float:
+            return 0.f;
+        case Mesh::AttributeFormat::HalfFloat:
+            //10 bit mantissa
+            return range / 1024.f;
+        case Mesh::AttributeFormat::UNorm8:
+            return (0.5f / 255.f) + 0.00001f;
+        case Mesh::AttributeFormat::SNorm10_10_10_2:
+            return (0.5f / 511.f) + 0.00001f;
+        }
+    }
+
+    //generates values in the range which the format can represent
+    std::vector<float> getSource(const Mesh::Data& meshData, float range, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> signedDist(-1.f, 1.f);
+        std::uniform_real_distribution<float> unsignedDist(0.f, 1.f);
+
+        std::vector<float> retVal;
+        for (auto v = 0u; v < meshData.vertexCount; ++v)
+        {
+            for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+            {
+                for (auto j = 0u; j < meshData.attributes[i]; ++j)
+                {
+                    switch (meshData.attributeFormats[i])
+                    {
+                    default:
+                    case Mesh::AttributeFormat::Float:
+                    case Mesh::AttributeFormat::HalfFloat:
+                        retVal.push_back(signedDist(rng) * range);
+                        break;
+                    case Mesh::AttributeFormat::UNorm8:
+                        retVal.push_back(unsignedDist(rng));
+                        break;
+                    case Mesh::AttributeFormat::SNorm10_10_10_2:
+                        //the 4th component only has 2 bits, so is used for signs
+                        retVal.push_back(j == 3 ? (signedDist(rng) < 0.f ? -1.f : 1.f) : signedDist(rng));
+                        break;
+                    }
+                }
+            }
+        }
+        return retVal;
+    }
+
+    bool roundTrip(const Mesh::Data& source, float range, std::mt19937& rng)
+    {
+        auto meshData = source;
+        const auto src = getSource(meshData, range, rng);
+        CHECK(src.size() * sizeof(float) == Mesh::getUnpackedVertexSize(meshData) * meshData.vertexCount);
+
+        std::vector<std::uint8_t> packed;
+        meshData.vertexSize = Mesh::packVertexData(meshData, src.data(), packed);
+        CHECK(packed.size() == meshData.vertexSize * meshData.vertexCount);
+
+        //vertex size matches the attribute offsets
+        const auto offsets = Mesh::getAttributeOffsets(meshData);
+        CHECK(meshData.vertexSize == offsets.back() + Mesh::getAttributeByteSize(meshData.attributes.back(), meshData.attributeFormats.back()));
+        CHECK(meshData.vertexSize % 4 == 0);
+
+        std::vector<float> dst;
+        Mesh::unpackVertexData(meshData, packed.data(), dst);
+        if (dst.size() != src.size())
+        {
+            return false;
+        }
+
+        std::size_t idx = 0;
+        for (auto v = 0u; v < meshData.vertexCount; ++v)
+        {
+            for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+            {
+                const auto tolerance = getTolerance(meshData.attributeFormats[i], range);
+                for (auto j = 0u; j < meshData.attributes[i]; ++j, ++idx)
+                {
+                    if (std::abs(src[idx] - dst[idx]) > tolerance)
+                    {
+                        std::cerr << "attribute " << i << " format " << int(meshData.attributeFormats[i])
+                            << ": " << src[idx] << " unpacked as " << dst[idx] << std::endl;
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+
+    //sizes are padded to 4 bytes
+    CHECK(Mesh::getAttributeByteSize(0, Mesh::AttributeFormat::HalfFloat) == 0);
+    CHECK(Mesh::getAttributeByteSize(3, Mesh::AttributeFormat::Float) == 12);
+    CHECK(Mesh::getAttributeByteSize(3, Mesh::AttributeFormat::HalfFloat) == 8);
+    CHECK(Mesh::getAttributeByteSize(2, Mesh::AttributeFormat::HalfFloat) == 4);
+    CHECK(Mesh::getAttributeByteSize(3, Mesh::AttributeFormat::UNorm8) == 4);
+    CHECK(Mesh::getAttributeByteSize(4, Mesh::AttributeFormat::UNorm8) == 4);
+    CHECK(Mesh::getAttributeByteSize(3, Mesh::AttributeFormat::SNorm10_10_10_2) == 4);
+    CHECK(Mesh::getAttributeByteSize(4, Mesh::AttributeFormat::SNorm10_10_10_2) == 4);
+
+    //each format on its own, with every component count
+    //that format supports, placed after a float position
+    for (std::uint8_t format = 0; format < Mesh::AttributeFormat::Count; ++format)
+    {
+        for (auto count = 1u; count < 5u; ++count)
+        {
+            Mesh::Data meshData;
+            meshData.vertexCount = VertexCount;
+            meshData.attributes[Mesh::Attribute::Position] = 3;
+            meshData.attributes[Mesh::Attribute::Normal] = count;
+            meshData.attributeFormats[Mesh::Attribute::Normal] = format;
+
+            CHECK(roundTrip(meshData, 1.f, rng));
+
+            //floats and half floats may hold values outside 0-1
+            if (format == Mesh::AttributeFormat::Float
+                || format == Mesh::AttributeFormat::HalfFloat)
+            {
+                CHECK(roundTrip(meshData, 4.f, rng));
+            }
+        }
+    }
+
+    //a typical quantised static mesh, mixing all the formats
+    {
+        Mesh::Data meshData;
+        meshData.vertexCount = VertexCount;
+        meshData.attributes[Mesh::Attribute::Position] = 3;
+        meshData.attributes[Mesh::Attribute::Colour] = 4;
+        meshData.attributes[Mesh::Attribute::Normal] = 3;
+        meshData.attributes[Mesh::Attribute::Tangent] = 4;
+        meshData.attributes[Mesh::Attribute::UV0] = 2;
+        meshData.attributes[Mesh::Attribute::UV1] = 2;
+        meshData.attributeFormats[Mesh::Attribute::Colour] = Mesh::AttributeFormat::UNorm8;
+        meshData.attributeFormats[Mesh::Attribute::Normal] = Mesh::AttributeFormat::SNorm10_10_10_2;
+        meshData.attributeFormats[Mesh::Attribute::Tangent] = Mesh::AttributeFormat::SNorm10_10_10_2;
+        meshData.attributeFormats[Mesh::Attribute::UV0] = Mesh::AttributeFormat::HalfFloat;
+        meshData.attributeFormats[Mesh::Attribute::UV1] = Mesh::AttributeFormat::HalfFloat;
+
+        CHECK(roundTrip(meshData, 1.f, rng));
+
+        //12 + 4 + 4 + 4 + 4 + 4 vs 72 bytes of floats
+        std::vector<std::uint8_t> packed;
+        const std::vector<float> src(Mesh::getUnpackedVertexSize(meshData) / sizeof(float) * VertexCount);
+        meshData.vertexSize = Mesh::packVertexData(meshData, src.data(), packed);
+        CHECK(meshData.vertexSize == 32);
+        CHECK(Mesh::getUnpackedVertexSize(meshData) == 72);
+        CHECK(Mesh::getQuantisedBytesSaved(meshData) == 40 * VertexCount);
+    }
+
+    //all floats pack to an identical copy
+    {
+        Mesh::Data meshData;
+        meshData.vertexCount = VertexCount;
+        meshData.attributes[Mesh::Attribute::Position] = 3;
+        meshData.attributes[Mesh::Attribute::Normal] = 3;
+        meshData.attributes[Mesh::Attribute::UV0] = 2;
+
+        const auto src = getSource(meshData, 100.f, rng);
+        std::vector<std::uint8_t> packed;
+        meshData.vertexSize = Mesh::packVertexData(meshData, src.data(), packed);
+        CHECK(meshData.vertexSize == Mesh::getUnpackedVertexSize(meshData));
+        CHECK(Mesh::getQuantisedBytesSaved(meshData) == 0);
+        CHECK(std::memcmp(packed.data(), src.data(), packed.size()) == 0);
+    }
+
+    return TEST_RESULT;
+}
@@ -0,0 +1,189 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+/*
+Compiles ConfigFile text assets such as models (*.cmt) and sprite
+sheets (*.spt) in a directory into their binary form, and writes
+them next to the source files so that they're loaded in place of
+the text files at run time. Only files which have changed since
+they were last compiled are recompiled.
+
+usage: config_compiler [-f] [-c] [-e .ext1,.ext2] <asset directory>
+    -f  force all files to be recompiled
+    -c  remove compiled files instead of creating them
+    -e  comma separated list of file extensions to compile
+*/
+
+#include <crogine/core/ConfigFile.hpp>
+#include <crogine/util/String.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const std::vector<std::string> DefaultExtensions =
+    {
+        ".cmt", ".spt", ".xcm", ".hole", ".course", ".ball"
+    };
+
+    void printUsage()
+    {
+        std::cout << "usage: config_compiler [-f] [-c] [-e .ext1,.ext2] <asset directory>\n"
+            << "    -f  force all files to be recompiled\n"
+            << "    -c  remove compiled files instead of creating them\n"
+            << "    -e  comma separated list of file extensions to compile\n";
+    }
+
+    bool isOutOfDate(const fs::path& source, const fs::path& binary)
+    {
+        std::error_code ec;
+        const auto binaryTime = fs::last_write_time(binary, ec);
+        if (ec)
+        {
+            return true;
+        }
+        return binaryTime < fs::last_write_time(source);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool force = false;
+    bool clean = false;
+    std::vector<std::string> extensions = DefaultExtensions;
+    std::string directory;
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (arg == "-f")
+        {
+            force = true;
+        }
+        else if (arg == "-c")
+        {
+            clean = true;
+        }
+        else if (arg == "-e" && i < argc - 1)
+        {
+            extensions = cro::Util::String::tokenize(argv[++i], ',');
+        }
+        else if (directory.empty())
+        {
+            directory = arg;
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (directory.empty()
+        || !fs::is_directory(directory))
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::size_t compiled = 0;
+    std::size_t skipped = 0;
+    std::size_t failed = 0;
+
+    for (const auto& entry : fs::recursive_directory_iterator(directory))
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        const auto& path = entry.path();
+        auto ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+
+        if (std::find(extensions.begin(), extensions.end(), ext) == extensions.end())
+        {
+            continue;
+        }
+
+        auto binaryPath = path;
+        binaryPath += cro::ConfigFile::BinaryExtension;
+
+        if (clean)
+        {
+            std::error_code ec;
+            if (fs::remove(binaryPath, ec))
+            {
+                compiled++;
+            }
+            continue;
+        }
+
+        if (!force
+            && !isOutOfDate(path, binaryPath))
+        {
+            skipped++;
+            continue;
+        }
+
+        //remove any existing binary, else the config
+        //file will attempt to load from that instead
+        std::error_code ec;
+        fs::remove(binaryPath, ec);
+
+        cro::ConfigFile cfg;
+        if (cfg.loadFromFile(path.u8string(), false)
+            && cfg.saveBinary(binaryPath.u8string()))
+        {
+            compiled++;
+        }
+        else
+        {
+            std::cerr << "Failed compiling " << path.u8string() << "\n";
+            failed++;
+        }
+    }
+
+    if (clean)
+    {
+        std::cout << "Removed " << compiled << " compiled files\n";
+    }
+    else
+    {
+        std::cout << "Compiled " << compiled << " files, " << skipped << " up to date, " << failed << " failed\n";
+    }
+
+    return failed == 0 ? 0 : 1;
+}
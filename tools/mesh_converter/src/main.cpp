@@ -0,0 +1,150 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+/*
+Converts the model binaries (*.cmb) in a directory to version 3 in
+place. Version 3 files store their vertex data in the same layout in
+which it's uploaded to the GPU, so BinaryMeshBuilder can upload them
+directly from a mapped file. Files which are already version 3 are
+skipped.
+
+usage: mesh_converter [-n] <asset directory>
+    -n  list the files which would be converted without converting them
+*/
+
+#include <crogine/detail/ModelBinary.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: mesh_converter [-n] <asset directory>\n"
+            << "    -n  list the files which would be converted without converting them\n";
+    }
+
+    bool isOutOfDate(const fs::path& path)
+    {
+        cro::Detail::ModelBinary::Header header;
+        std::ifstream file(path, std::ios::binary);
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            //let convert() report the error
+            return true;
+        }
+        return header.version < cro::Detail::ModelBinary::MappedVersion;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool listOnly = false;
+    std::string directory;
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (arg == "-n")
+        {
+            listOnly = true;
+        }
+        else if (directory.empty())
+        {
+            directory = arg;
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (directory.empty()
+        || !fs::is_directory(directory))
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::size_t converted = 0;
+    std::size_t skipped = 0;
+    std::size_t failed = 0;
+
+    for (const auto& entry : fs::recursive_directory_iterator(directory))
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        const auto& path = entry.path();
+        auto ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+
+        if (ext != ".cmb")
+        {
+            continue;
+        }
+
+        if (!isOutOfDate(path))
+        {
+            skipped++;
+            continue;
+        }
+
+        if (listOnly)
+        {
+            std::cout << path.u8string() << "\n";
+            converted++;
+            continue;
+        }
+
+        const auto pathStr = path.u8string();
+        if (cro::Detail::ModelBinary::convert(pathStr, pathStr))
+        {
+            converted++;
+        }
+        else
+        {
+            std::cerr << "Failed converting " << pathStr << "\n";
+            failed++;
+        }
+    }
+
+    std::cout << (listOnly ? "Would convert " : "Converted ") << converted << " files, " << skipped << " up to date, " << failed << " failed\n";
+
+    return failed == 0 ? 0 : 1;
+}
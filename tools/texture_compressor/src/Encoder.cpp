@@ -0,0 +1,758 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "Encoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace cro;
+
+namespace
+{
+    //16 RGBA pixels, in rows
+    using Block = std::array<std::uint8_t, 64u>;
+
+    //blocks which overlap the edge of the image repeat the edge pixels
+    void fetchBlock(const std::uint8_t* rgba, glm::uvec2 size, std::uint32_t bx, std::uint32_t by, Block& block)
+    {
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            const auto sy = std::min(by * 4 + y, size.y - 1);
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                const auto sx = std::min(bx * 4 + x, size.x - 1);
+                std::memcpy(&block[(y * 4 + x) * 4], rgba + ((sy * size.x + sx) * 4), 4);
+            }
+        }
+    }
+
+    std::int32_t square(std::int32_t v) { return v * v; }
+
+    //---BC1 colour---//
+    std::uint16_t to565(const std::array<float, 3u>& c)
+    {
+        const auto r = static_cast<std::uint16_t>(std::clamp(std::lround(c[0] * 31.f / 255.f), 0l, 31l));
+        const auto g = static_cast<std::uint16_t>(std::clamp(std::lround(c[1] * 63.f / 255.f), 0l, 63l));
+        const auto b = static_cast<std::uint16_t>(std::clamp(std::lround(c[2] * 31.f / 255.f), 0l, 31l));
+        return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    std::array<std::int32_t, 3u> from565(std::uint16_t c)
+    {
+        const std::int32_t r = (c >> 11) & 0x1f;
+        const std::int32_t g = (c >> 5) & 0x3f;
+        const std::int32_t b = c & 0x1f;
+        return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+    }
+
+    struct ColourFit final
+    {
+        std::uint16_t c0 = 0;
+        std::uint16_t c1 = 0;
+        std::array<std::uint8_t, 16u> indices = {};
+        std::int64_t error = std::numeric_limits<std::int64_t>::max();
+    };
+
+    //always uses four colour mode, which requires c0 > c1
+    ColourFit evaluateColours(const Block& block, std::uint16_t c0, std::uint16_t c1)
+    {
+        ColourFit fit;
+        if (c0 < c1)
+        {
+            std::swap(c0, c1);
+        }
+        fit.c0 = c0;
+        fit.c1 = c1;
+        fit.error = 0;
+
+        std::array<std::array<std::int32_t, 3u>, 4u> palette = {};
+        palette[0] = from565(c0);
+        palette[1] = from565(c1);
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i] + 1) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i] + 1) / 3;
+        }
+
+        //equal end points decode in three colour mode, where only
+        //index 0 is the same, so use that for every pixel
+        const auto paletteSize = c0 == c1 ? 1u : 4u;
+
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            const auto* px = &block[i * 4];
+            std::int32_t bestError = std::numeric_limits<std::int32_t>::max();
+            for (auto j = 0u; j < paletteSize; ++j)
+            {
+                const auto error = square(px[0] - palette[j][0]) + square(px[1] - palette[j][1]) + square(px[2] - palette[j][2]);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    fit.indices[i] = static_cast<std::uint8_t>(j);
+                }
+            }
+            fit.error += bestError;
+        }
+        return fit;
+    }
+
+    void encodeColourBlock(const Block& block, std::uint8_t* dst)
+    {
+        std::array<float, 3u> mean = {};
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            for (auto j = 0u; j < 3u; ++j)
+            {
+                mean[j] += block[i * 4 + j];
+            }
+        }
+        for (auto& m : mean)
+        {
+            m /= 16.f;
+        }
+
+        //find the principal axis of the colours
+        std::array<float, 6u> cov = {}; //rr rg rb gg gb bb
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            const float r = block[i * 4] - mean[0];
+            const float g = block[i * 4 + 1] - mean[1];
+            const float b = block[i * 4 + 2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
+
+        std::array<float, 3u> axis = { 1.f, 1.f, 1.f };
+        for (auto i = 0; i < 8; ++i)
+        {
+            const std::array<float, 3u> v =
+            {
+                cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]
+            };
+            const auto len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+            if (len < 0.0001f)
+            {
+                break;
+            }
+            axis = { v[0] / len, v[1] / len, v[2] / len };
+        }
+
+        float minT = std::numeric_limits<float>::max();
+        float maxT = std::numeric_limits<float>::lowest();
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            const auto t = (block[i * 4] - mean[0]) * axis[0]
+                + (block[i * 4 + 1] - mean[1]) * axis[1]
+                + (block[i * 4 + 2] - mean[2]) * axis[2];
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+
+        //inset the end points slightly, as the extremes are rarely used
+        const auto inset = (maxT - minT) / 16.f;
+        minT += inset;
+        maxT -= inset;
+
+        std::array<float, 3u> e0 = {};
+        std::array<float, 3u> e1 = {};
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            e0[i] = mean[i] + axis[i] * maxT;
+            e1[i] = mean[i] + axis[i] * minT;
+        }
+
+        auto best = evaluateColours(block, to565(e0), to565(e1));
+
+        //refine the end points with a least squares fit of the chosen indices
+        if (best.c0 != best.c1)
+        {
+            constexpr std::array<float, 4u> Weights = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+            float aa = 0.f, bb = 0.f, ab = 0.f;
+            std::array<float, 3u> ax = {};
+            std::array<float, 3u> bx = {};
+            for (auto i = 0u; i < 16u; ++i)
+            {
+                const auto a = Weights[best.indices[i]];
+                const auto b = 1.f - a;
+                aa += a * a;
+                bb += b * b;
+                ab += a * b;
+                for (auto j = 0u; j < 3u; ++j)
+                {
+                    ax[j] += a * block[i * 4 + j];
+                    bx[j] += b * block[i * 4 + j];
+                }
+            }
+
+            const auto det = aa * bb - ab * ab;
+            if (std::abs(det) > 0.0001f)
+            {
+                for (auto j = 0u; j < 3u; ++j)
+                {
+                    e0[j] = (ax[j] * bb - bx[j] * ab) / det;
+                    e1[j] = (bx[j] * aa - ax[j] * ab) / det;
+                }
+
+                auto refined = evaluateColours(block, to565(e0), to565(e1));
+                if (refined.error < best.error)
+                {
+                    best = refined;
+                }
+            }
+        }
+
+        std::memcpy(dst, &best.c0, 2);
+        std::memcpy(dst + 2, &best.c1, 2);
+        for (auto y = 0u; y < 4u; ++y)
+        {
+            std::uint8_t row = 0;
+            for (auto x = 0u; x < 4u; ++x)
+            {
+                row |= best.indices[y * 4 + x] << (x * 2);
+            }
+            dst[4 + y] = row;
+        }
+    }
+
+    //---BC3 alpha/BC4---//
+    void encodeAlphaBlock(const Block& block, std::uint32_t channel, std::uint8_t* dst)
+    {
+        std::uint8_t minVal = 255;
+        std::uint8_t maxVal = 0;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            minVal = std::min(minVal, block[i * 4 + channel]);
+            maxVal = std::max(maxVal, block[i * 4 + channel]);
+        }
+
+        std::memset(dst, 0, 8);
+        dst[0] = maxVal;
+        dst[1] = minVal;
+
+        if (minVal == maxVal)
+        {
+            return;
+        }
+
+        //eight value mode as a0 > a1
+        std::array<std::int32_t, 8u> palette = {};
+        palette[0] = maxVal;
+        palette[1] = minVal;
+        for (auto i = 1; i < 7; ++i)
+        {
+            palette[i + 1] = ((7 - i) * maxVal + i * minVal + 3) / 7;
+        }
+
+        std::uint64_t bits = 0;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            const std::int32_t v = block[i * 4 + channel];
+            std::uint64_t bestIndex = 0;
+            std::int32_t bestError = std::numeric_limits<std::int32_t>::max();
+            for (auto j = 0u; j < 8u; ++j)
+            {
+                const auto error = std::abs(v - palette[j]);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestIndex = j;
+                }
+            }
+            bits |= bestIndex << (i * 3);
+        }
+
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            dst[2 + i] = static_cast<std::uint8_t>(bits >> (i * 8));
+        }
+    }
+
+    //---ETC2---//
+    constexpr std::array<std::array<std::int32_t, 2u>, 8u> ETCModifiers =
+    { {
+        {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+    } };
+
+    constexpr std::array<std::array<std::int32_t, 8u>, 16u> EACModifiers =
+    { {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    } };
+
+    std::int32_t clampByte(std::int32_t v)
+    {
+        return std::clamp(v, 0, 255);
+    }
+
+    void writeBigEndian(std::uint64_t bits, std::uint8_t* dst)
+    {
+        for (auto i = 0u; i < 8u; ++i)
+        {
+            dst[i] = static_cast<std::uint8_t>(bits >> (56 - (i * 8)));
+        }
+    }
+
+    std::uint64_t setBits(std::uint64_t value, std::uint32_t high, std::uint32_t count)
+    {
+        return (value & ((1ull << count) - 1)) << (high + 1 - count);
+    }
+
+    bool inSubblock(std::uint32_t x, std::uint32_t y, bool flip, std::uint32_t subblock)
+    {
+        const bool second = flip ? (y > 1) : (x > 1);
+        return second == (subblock == 1);
+    }
+
+    struct SubblockFit final
+    {
+        std::uint32_t table = 0;
+        std::uint64_t indexBits = 0;
+        std::int64_t error = std::numeric_limits<std::int64_t>::max();
+    };
+
+    SubblockFit fitSubblock(const Block& block, const std::array<std::int32_t, 3u>& base, bool flip, std::uint32_t subblock)
+    {
+        SubblockFit best;
+        for (auto t = 0u; t < ETCModifiers.size(); ++t)
+        {
+            SubblockFit fit;
+            fit.table = t;
+            fit.error = 0;
+
+            for (auto y = 0u; y < 4u; ++y)
+            {
+                for (auto x = 0u; x < 4u; ++x)
+                {
+                    if (!inSubblock(x, y, flip, subblock))
+                    {
+                        continue;
+                    }
+
+                    const auto* px = &block[(y * 4 + x) * 4];
+                    std::int32_t bestError = std::numeric_limits<std::int32_t>::max();
+                    std::uint64_t bestIndex = 0;
+                    for (auto i = 0u; i < 4u; ++i)
+                    {
+                        const auto modifier = (i & 0x2) ? -ETCModifiers[t][i & 0x1] : ETCModifiers[t][i & 0x1];
+                        const auto error = square(px[0] - clampByte(base[0] + modifier))
+                            + square(px[1] - clampByte(base[1] + modifier))
+                            + square(px[2] - clampByte(base[2] + modifier));
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            bestIndex = i;
+                        }
+                    }
+
+                    //indices are stored in columns, msb and lsb in separate halves
+                    const auto p = x * 4 + y;
+                    fit.indexBits |= ((bestIndex >> 1) << (16 + p)) | ((bestIndex & 0x1) << p);
+                    fit.error += bestError;
+                }
+            }
+
+            if (fit.error < best.error)
+            {
+                best = fit;
+            }
+        }
+        return best;
+    }
+
+    struct ETCFit final
+    {
+        std::uint64_t bits = 0;
+        std::int64_t error = std::numeric_limits<std::int64_t>::max();
+    };
+
+    ETCFit fitPlanar(const Block& block)
+    {
+        //least squares fit of O, H and V where
+        //c(x,y) = O + x(H - O) / 4 + y(V - O) / 4
+        std::array<float, 9u> m = {};
+        std::array<std::array<float, 3u>, 3u> rhs = {}; //per channel
+        for (auto y = 0; y < 4; ++y)
+        {
+            for (auto x = 0; x < 4; ++x)
+            {
+                const std::array<float, 3u> w = { 1.f - (x / 4.f) - (y / 4.f), x / 4.f, y / 4.f };
+                for (auto i = 0u; i < 3u; ++i)
+                {
+                    for (auto j = 0u; j < 3u; ++j)
+                    {
+                        m[i * 3 + j] += w[i] * w[j];
+                    }
+                    for (auto c = 0u; c < 3u; ++c)
+                    {
+                        rhs[c][i] += w[i] * block[(y * 4 + x) * 4 + c];
+                    }
+                }
+            }
+        }
+
+        const auto det3 = [](const std::array<float, 9u>& a)
+        {
+            return a[0] * (a[4] * a[8] - a[5] * a[7])
+                - a[1] * (a[3] * a[8] - a[5] * a[6])
+                + a[2] * (a[3] * a[7] - a[4] * a[6]);
+        };
+
+        const auto det = det3(m);
+        if (std::abs(det) < 0.0001f)
+        {
+            return {};
+        }
+
+        //O, H, V for each channel, quantised to 676 bits
+        std::array<std::array<std::int32_t, 3u>, 3u> quantised = {};
+        std::array<std::array<std::int32_t, 3u>, 3u> expanded = {};
+        const std::array<std::int32_t, 3u> bitCounts = { 6, 7, 6 };
+        for (auto c = 0u; c < 3u; ++c)
+        {
+            const auto maxVal = (1 << bitCounts[c]) - 1;
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                //Cramer's rule
+                auto mi = m;
+                for (auto j = 0u; j < 3u; ++j)
+                {
+                    mi[j * 3 + i] = rhs[c][j];
+                }
+                const auto v = det3(mi) / det;
+                const auto q = std::clamp(static_cast<std::int32_t>(std::lround(v * maxVal / 255.f)), 0, maxVal);
+                quantised[i][c] = q;
+                expanded[i][c] = bitCounts[c] == 6 ? (q << 2) | (q >> 4) : (q << 1) | (q >> 6);
+            }
+        }
+
+        ETCFit fit;
+        fit.error = 0;
+        for (auto y = 0; y < 4; ++y)
+        {
+            for (auto x = 0; x < 4; ++x)
+            {
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    const auto& o = expanded[0][c];
+                    const auto& h = expanded[1][c];
+                    const auto& v = expanded[2][c];
+                    const auto value = clampByte((x * (h - o) + y * (v - o) + 4 * o + 2) >> 2);
+                    fit.error += square(value - block[(y * 4 + x) * 4 + c]);
+                }
+            }
+        }
+
+        const auto& o = quantised[0];
+        const auto& h = quantised[1];
+        const auto& v = quantised[2];
+
+        std::uint64_t bits = setBits(o[0], 62, 6)
+            | setBits(o[1] >> 6, 56, 1) | setBits(o[1], 54, 6)
+            | setBits(o[2] >> 5, 48, 1) | setBits(o[2] >> 3, 44, 2) | setBits(o[2], 41, 3)
+            | setBits(h[0] >> 1, 38, 5) | setBits(1, 33, 1) | setBits(h[0], 32, 1)
+            | setBits(h[1], 31, 7) | setBits(h[2], 24, 6)
+            | setBits(v[0], 18, 6) | setBits(v[1], 12, 7) | setBits(v[2], 5, 6);
+
+        //the unused bits need setting so that the block reads as
+        //a differential block where only the blue channel overflows
+        const auto overflows = [](std::uint64_t b, std::uint32_t high)
+        {
+            const auto base = static_cast<std::int32_t>((b >> (high - 4)) & 0x1f);
+            auto delta = static_cast<std::int32_t>((b >> (high - 7)) & 0x7);
+            delta = (delta & 0x4) ? delta - 8 : delta;
+            return base + delta < 0 || base + delta > 31;
+        };
+
+        constexpr std::array<std::uint32_t, 6u> FreeBits = { 63, 55, 47, 46, 45, 42 };
+        for (auto i = 0u; i < 64u; ++i)
+        {
+            auto candidate = bits;
+            for (auto j = 0u; j < FreeBits.size(); ++j)
+            {
+                candidate |= static_cast<std::uint64_t>((i >> j) & 0x1) << FreeBits[j];
+            }
+
+            if (!overflows(candidate, 63)
+                && !overflows(candidate, 55)
+                && overflows(candidate, 47))
+            {
+                fit.bits = candidate;
+                return fit;
+            }
+        }
+        return {};
+    }
+
+    void encodeETC2Block(const Block& block, std::uint8_t* dst)
+    {
+        ETCFit best;
+
+        for (auto flip = 0u; flip < 2u; ++flip)
+        {
+            std::array<std::array<float, 3u>, 2u> average = {};
+            for (auto y = 0u; y < 4u; ++y)
+            {
+                for (auto x = 0u; x < 4u; ++x)
+                {
+                    const auto sub = inSubblock(x, y, flip != 0, 0) ? 0 : 1;
+                    for (auto c = 0u; c < 3u; ++c)
+                    {
+                        average[sub][c] += block[(y * 4 + x) * 4 + c] / 8.f;
+                    }
+                }
+            }
+
+            //individual mode, 444 colours
+            {
+                std::array<std::array<std::int32_t, 3u>, 2u> quantised = {};
+                std::array<std::array<std::int32_t, 3u>, 2u> base = {};
+                for (auto i = 0u; i < 2u; ++i)
+                {
+                    for (auto c = 0u; c < 3u; ++c)
+                    {
+                        quantised[i][c] = std::clamp(static_cast<std::int32_t>(std::lround(average[i][c] * 15.f / 255.f)), 0, 15);
+                        base[i][c] = (quantised[i][c] << 4) | quantised[i][c];
+                    }
+                }
+
+                const auto fit0 = fitSubblock(block, base[0], flip != 0, 0);
+                const auto fit1 = fitSubblock(block, base[1], flip != 0, 1);
+                if (fit0.error + fit1.error < best.error)
+                {
+                    best.error = fit0.error + fit1.error;
+                    best.bits = setBits(quantised[0][0], 63, 4) | setBits(quantised[1][0], 59, 4)
+                        | setBits(quantised[0][1], 55, 4) | setBits(quantised[1][1], 51, 4)
+                        | setBits(quantised[0][2], 47, 4) | setBits(quantised[1][2], 43, 4)
+                        | setBits(fit0.table, 39, 3) | setBits(fit1.table, 36, 3)
+                        | setBits(flip, 32, 1) | fit0.indexBits | fit1.indexBits;
+                }
+            }
+
+            //differential mode, 555 colours with a 333 offset
+            {
+                std::array<std::array<std::int32_t, 3u>, 2u> base = {};
+                std::array<std::int32_t, 3u> quantised = {};
+                std::array<std::int32_t, 3u> delta = {};
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    quantised[c] = std::clamp(static_cast<std::int32_t>(std::lround(average[0][c] * 31.f / 255.f)), 0, 31);
+                    const auto second = std::clamp(static_cast<std::int32_t>(std::lround(average[1][c] * 31.f / 255.f)), 0, 31);
+                    delta[c] = std::clamp(second - quantised[c], -4, 3);
+
+                    const auto q1 = quantised[c] + delta[c];
+                    base[0][c] = (quantised[c] << 3) | (quantised[c] >> 2);
+                    base[1][c] = (q1 << 3) | (q1 >> 2);
+                }
+
+                const auto fit0 = fitSubblock(block, base[0], flip != 0, 0);
+                const auto fit1 = fitSubblock(block, base[1], flip != 0, 1);
+                if (fit0.error + fit1.error < best.error)
+                {
+                    best.error = fit0.error + fit1.error;
+                    best.bits = setBits(quantised[0], 63, 5) | setBits(static_cast<std::uint32_t>(delta[0]), 58, 3)
+                        | setBits(quantised[1], 55, 5) | setBits(static_cast<std::uint32_t>(delta[1]), 50, 3)
+                        | setBits(quantised[2], 47, 5) | setBits(static_cast<std::uint32_t>(delta[2]), 42, 3)
+                        | setBits(fit0.table, 39, 3) | setBits(fit1.table, 36, 3)
+                        | setBits(1, 33, 1) | setBits(flip, 32, 1) | fit0.indexBits | fit1.indexBits;
+                }
+            }
+        }
+
+        //smooth gradients are better represented in planar mode
+        if (const auto planar = fitPlanar(block); planar.error < best.error)
+        {
+            best = planar;
+        }
+
+        writeBigEndian(best.bits, dst);
+    }
+
+    void encodeEACBlock(const Block& block, std::uint8_t* dst)
+    {
+        std::int32_t minVal = 255;
+        std::int32_t maxVal = 0;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            minVal = std::min(minVal, static_cast<std::int32_t>(block[i * 4 + 3]));
+            maxVal = std::max(maxVal, static_cast<std::int32_t>(block[i * 4 + 3]));
+        }
+
+        if (minVal == maxVal)
+        {
+            //table 13 has a zero modifier at index 4
+            std::uint64_t bits = setBits(minVal, 63, 8) | setBits(1, 55, 4) | setBits(13, 51, 4);
+            for (auto p = 0u; p < 16u; ++p)
+            {
+                bits |= 4ull << (45 - (p * 3));
+            }
+            writeBigEndian(bits, dst);
+            return;
+        }
+
+        std::int64_t bestError = std::numeric_limits<std::int64_t>::max();
+        std::uint64_t bestBits = 0;
+
+        for (auto t = 0u; t < EACModifiers.size(); ++t)
+        {
+            const auto& table = EACModifiers[t];
+            const auto span = table[7] - table[3];
+            const auto estimate = static_cast<std::int32_t>(std::lround(static_cast<float>(maxVal - minVal) / span));
+
+            for (auto m = std::max(1, estimate - 1); m <= std::min(15, estimate + 1); ++m)
+            {
+                const auto baseEstimate = static_cast<std::int32_t>(std::lround((maxVal + minVal) / 2.f - (m * (table[7] + table[3])) / 2.f));
+                for (auto b = std::max(0, baseEstimate - 1); b <= std::min(255, baseEstimate + 1); ++b)
+                {
+                    std::int64_t error = 0;
+                    std::uint64_t indices = 0;
+                    for (auto y = 0u; y < 4u; ++y)
+                    {
+                        for (auto x = 0u; x < 4u; ++x)
+                        {
+                            const std::int32_t a = block[(y * 4 + x) * 4 + 3];
+                            std::int32_t pixelError = std::numeric_limits<std::int32_t>::max();
+                            std::uint64_t index = 0;
+                            for (auto i = 0u; i < 8u; ++i)
+                            {
+                                const auto e = square(a - clampByte(b + table[i] * m));
+                                if (e < pixelError)
+                                {
+                                    pixelError = e;
+                                    index = i;
+                                }
+                            }
+                            error += pixelError;
+                            indices |= index << (45 - ((x * 4 + y) * 3));
+                        }
+                    }
+
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestBits = setBits(b, 63, 8) | setBits(m, 55, 4) | setBits(t, 51, 4) | indices;
+                    }
+                }
+            }
+        }
+        writeBigEndian(bestBits, dst);
+    }
+}
+
+bool Encoder::encode(CompressedImage::Format::Type format, const std::uint8_t* rgba, glm::uvec2 size, std::uint8_t* dst)
+{
+    if (format != CompressedImage::Format::BC1RGB
+        && format != CompressedImage::Format::BC3
+        && format != CompressedImage::Format::BC4
+        && format != CompressedImage::Format::ETC2RGB
+        && format != CompressedImage::Format::ETC2RGBA)
+    {
+        return false;
+    }
+
+    const auto blockSize = CompressedImage::getBlockSize(format);
+    const auto blocksX = (size.x + 3) / 4;
+    const auto blocksY = (size.y + 3) / 4;
+
+    Block block = {};
+    for (auto by = 0u; by < blocksY; ++by)
+    {
+        for (auto bx = 0u; bx < blocksX; ++bx)
+        {
+            fetchBlock(rgba, size, bx, by, block);
+
+            switch (format)
+            {
+            default: break;
+            case CompressedImage::Format::BC1RGB:
+                encodeColourBlock(block, dst);
+                break;
+            case CompressedImage::Format::BC3:
+                encodeAlphaBlock(block, 3, dst);
+                encodeColourBlock(block, dst + 8);
+                break;
+            case CompressedImage::Format::BC4:
+                encodeAlphaBlock(block, 0, dst);
+                break;
+            case CompressedImage::Format::ETC2RGB:
+                encodeETC2Block(block, dst);
+                break;
+            case CompressedImage::Format::ETC2RGBA:
+                encodeEACBlock(block, dst);
+                encodeETC2Block(block, dst + 8);
+                break;
+            }
+            dst += blockSize;
+        }
+    }
+    return true;
+}
+
+glm::uvec2 Encoder::downsample(const std::vector<std::uint8_t>& src, glm::uvec2 size, std::vector<std::uint8_t>& dst)
+{
+    const glm::uvec2 dstSize(std::max(1u, size.x / 2), std::max(1u, size.y / 2));
+    dst.resize(dstSize.x * dstSize.y * 4);
+
+    for (auto y = 0u; y < dstSize.y; ++y)
+    {
+        const auto y0 = std::min(y * 2, size.y - 1);
+        const auto y1 = std::min(y * 2 + 1, size.y - 1);
+        for (auto x = 0u; x < dstSize.x; ++x)
+        {
+            const auto x0 = std::min(x * 2, size.x - 1);
+            const auto x1 = std::min(x * 2 + 1, size.x - 1);
+            for (auto c = 0u; c < 4u; ++c)
+            {
+                const auto sum = src[(y0 * size.x + x0) * 4 + c] + src[(y0 * size.x + x1) * 4 + c]
+                    + src[(y1 * size.x + x0) * 4 + c] + src[(y1 * size.x + x1) * 4 + c];
+                dst[(y * dstSize.x + x) * 4 + c] = static_cast<std::uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+    return dstSize;
+}
@@ -0,0 +1,61 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/graphics/CompressedImage.hpp>
+#include <crogine/detail/glm/vec2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/*
+Block compression encoders for BC1, BC3, BC4 and ETC2 RGB/RGBA.
+These favour simplicity over quality - each block is fitted
+along the principal axis of its colours (BC), or by searching
+all the available tables (ETC2), which gives results in line
+with the fast modes of most other encoders.
+*/
+namespace Encoder
+{
+    /*!
+    \brief Compresses the given RGBA pixels into dst, which
+    must be at least CompressedImage::getImageSize() bytes.
+    Only BC1RGB, BC3, BC4, ETC2RGB and ETC2RGBA are supported.
+    BC4 encodes the red channel.
+    \returns false if the format is not supported
+    */
+    bool encode(cro::CompressedImage::Format::Type format, const std::uint8_t* rgba, glm::uvec2 size, std::uint8_t* dst);
+
+    /*!
+    \brief Halves the size of the given RGBA image with a box filter
+    \returns The size of the new image, which is never less than 1
+    */
+    glm::uvec2 downsample(const std::vector<std::uint8_t>& src, glm::uvec2 size, std::vector<std::uint8_t>& dst);
+}
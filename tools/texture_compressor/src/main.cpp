@@ -0,0 +1,463 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2025
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+/*
+Compresses the images in a directory into block compressed *.ktx2
+files, and writes them next to the source images so that Texture
+and CubemapTexture load them in place of the originals at run time.
+Cubemaps are compressed from the faces listed in *.ccm files. Only
+images which have changed since they were last compressed are
+recompressed.
+
+Desktop GPUs support the BC formats, mobile and web GPUs support ETC2.
+Single channel images are stored as BC4, images with transparency as
+BC3 and everything else as BC1 - or ETC2 RGB/RGBA if ETC2 is targeted.
+
+usage: texture_compressor [-f] [-c] [-m] [-t bc|etc2] <asset directory>
+    -f  force all files to be recompressed
+    -c  remove compressed files instead of creating them
+    -m  don't create mip maps
+    -t  target bc (default) or etc2 formats
+*/
+
+#include "Encoder.hpp"
+
+#include <crogine/core/ConfigFile.hpp>
+#include <crogine/graphics/CompressedImage.hpp>
+#include <crogine/graphics/ImageArray.hpp>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const std::vector<std::string> ImageExtensions =
+    {
+        ".png", ".jpg", ".jpeg", ".tga", ".bmp"
+    };
+
+    const std::array<std::string, 6u> CubemapLabels =
+    {
+        "right", "left", "up", "down", "front", "back"
+    };
+
+    struct Target final
+    {
+        enum
+        {
+            BC, ETC2
+        };
+    };
+
+    struct Settings final
+    {
+        std::int32_t target = Target::BC;
+        bool mipmaps = true;
+    };
+
+    void printUsage()
+    {
+        std::cout << "usage: texture_compressor [-f] [-c] [-m] [-t bc|etc2] <asset directory>\n"
+            << "    -f  force all files to be recompressed\n"
+            << "    -c  remove compressed files instead of creating them\n"
+            << "    -m  don't create mip maps\n"
+            << "    -t  target bc (default) or etc2 formats\n";
+    }
+
+    bool isOutOfDate(const std::vector<fs::path>& sources, const fs::path& output)
+    {
+        std::error_code ec;
+        const auto outputTime = fs::last_write_time(output, ec);
+        if (ec)
+        {
+            return true;
+        }
+
+        for (const auto& source : sources)
+        {
+            if (outputTime < fs::last_write_time(source, ec)
+                || ec)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //images are flipped on load to match cro::Image, and
+    //expanded to RGBA as that's what the encoders expect
+    bool loadImage(const fs::path& path, std::vector<std::uint8_t>& dst, glm::uvec2& size, std::uint32_t& channels)
+    {
+        cro::ImageArray<std::uint8_t> image;
+        if (!image.loadFromFile(path.u8string(), true))
+        {
+            return false;
+        }
+
+        size = image.getDimensions();
+        channels = image.getChannels();
+
+        const auto pixelCount = size.x * size.y;
+        dst.resize(pixelCount * 4);
+
+        for (auto i = 0u; i < pixelCount; ++i)
+        {
+            const auto* src = image.data() + (i * channels);
+            auto* px = &dst[i * 4];
+            switch (channels)
+            {
+            default: return false;
+            case 1:
+                px[0] = src[0]; px[1] = src[0]; px[2] = src[0]; px[3] = 255;
+                break;
+            case 2:
+                px[0] = src[0]; px[1] = src[0]; px[2] = src[0]; px[3] = src[1];
+                break;
+            case 3:
+                px[0] = src[0]; px[1] = src[1]; px[2] = src[2]; px[3] = 255;
+                break;
+            case 4:
+                px[0] = src[0]; px[1] = src[1]; px[2] = src[2]; px[3] = src[3];
+                break;
+            }
+        }
+        return true;
+    }
+
+    cro::CompressedImage::Format::Type selectFormat(const std::vector<std::uint8_t>& rgba, std::uint32_t channels, std::int32_t target)
+    {
+        bool hasAlpha = false;
+        for (auto i = 3u; i < rgba.size() && !hasAlpha; i += 4)
+        {
+            hasAlpha = rgba[i] < 255;
+        }
+
+        if (target == Target::ETC2)
+        {
+            return hasAlpha ? cro::CompressedImage::Format::ETC2RGBA : cro::CompressedImage::Format::ETC2RGB;
+        }
+
+        if (channels == 1)
+        {
+            return cro::CompressedImage::Format::BC4;
+        }
+        return hasAlpha ? cro::CompressedImage::Format::BC3 : cro::CompressedImage::Format::BC1RGB;
+    }
+
+    std::uint32_t getLevelCount(glm::uvec2 size, bool mipmaps)
+    {
+        std::uint32_t count = 1;
+        while (mipmaps && (size.x > 1 || size.y > 1))
+        {
+            size = { std::max(1u, size.x / 2), std::max(1u, size.y / 2) };
+            count++;
+        }
+        return count;
+    }
+
+    //encodes the given RGBA face and all its mip levels into the output image
+    void encodeFace(cro::CompressedImage& output, std::vector<std::uint8_t> rgba, std::uint32_t face, std::uint32_t channels)
+    {
+        const auto format = output.getFormat();
+        auto size = output.getSize();
+
+        //single channel images in ETC2 are stored in the red channel
+        //which matches the way they're uploaded when not compressed
+        if (channels == 1
+            && format == cro::CompressedImage::Format::ETC2RGB)
+        {
+            for (auto i = 0u; i < rgba.size(); i += 4)
+            {
+                rgba[i + 1] = 0;
+                rgba[i + 2] = 0;
+            }
+        }
+
+        std::vector<std::uint8_t> next;
+        for (auto level = 0u; level < output.getLevelCount(); ++level)
+        {
+            Encoder::encode(format, rgba.data(), size, output.getData(level, 0, face));
+
+            if (level + 1 < output.getLevelCount())
+            {
+                size = Encoder::downsample(rgba, size, next);
+                rgba.swap(next);
+            }
+        }
+    }
+
+    bool compressImage(const fs::path& path, const fs::path& output, const Settings& settings)
+    {
+        std::vector<std::uint8_t> rgba;
+        glm::uvec2 size(0);
+        std::uint32_t channels = 0;
+        if (!loadImage(path, rgba, size, channels))
+        {
+            return false;
+        }
+
+        cro::CompressedImage image;
+        if (!image.create(selectFormat(rgba, channels, settings.target), size, getLevelCount(size, settings.mipmaps)))
+        {
+            return false;
+        }
+
+        encodeFace(image, std::move(rgba), 0, channels);
+        image.setBottomUp(true);
+
+        return image.saveToFile(output.u8string());
+    }
+
+    bool compressCubemap(const std::vector<fs::path>& faces, const fs::path& output, const Settings& settings)
+    {
+        std::array<std::vector<std::uint8_t>, 6u> rgba;
+        glm::uvec2 size(0);
+        std::uint32_t channels = 0;
+
+        for (auto i = 0u; i < faces.size(); ++i)
+        {
+            glm::uvec2 faceSize(0);
+            std::uint32_t faceChannels = 0;
+            if (!loadImage(faces[i], rgba[i], faceSize, faceChannels))
+            {
+                return false;
+            }
+
+            channels = std::max(channels, faceChannels);
+            if (i == 0)
+            {
+                size = faceSize;
+            }
+            else if (faceSize != size)
+            {
+                std::cerr << faces[i].u8string() << ": cubemap faces are not all the same size\n";
+                return false;
+            }
+        }
+
+        //the format must be the same for all faces
+        auto format = selectFormat(rgba[0], channels, settings.target);
+        for (auto i = 1u; i < rgba.size(); ++i)
+        {
+            const auto faceFormat = selectFormat(rgba[i], channels, settings.target);
+            if (faceFormat == cro::CompressedImage::Format::BC3
+                || faceFormat == cro::CompressedImage::Format::ETC2RGBA)
+            {
+                format = faceFormat;
+            }
+        }
+
+        cro::CompressedImage image;
+        if (!image.create(format, size, getLevelCount(size, settings.mipmaps), 1, 6))
+        {
+            return false;
+        }
+
+        for (auto i = 0u; i < rgba.size(); ++i)
+        {
+            encodeFace(image, std::move(rgba[i]), i, channels);
+        }
+        image.setBottomUp(true);
+
+        return image.saveToFile(output.u8string());
+    }
+
+    //returns the paths to the faces listed in a *.ccm file
+    bool parseCubemap(const fs::path& path, std::vector<fs::path>& faces)
+    {
+        cro::ConfigFile cfg;
+        if (!cfg.loadFromFile(path.u8string(), false))
+        {
+            return false;
+        }
+
+        for (const auto& label : CubemapLabels)
+        {
+            const auto* prop = cfg.findProperty(label);
+            if (!prop)
+            {
+                std::cerr << path.u8string() << ": missing " << label << " face\n";
+                return false;
+            }
+
+            auto facePath = prop->getValue<std::string>();
+            std::replace(facePath.begin(), facePath.end(), '\\', '/');
+            if (facePath.find('/') == std::string::npos)
+            {
+                //assume this is in the same dir, as CubemapTexture does
+                faces.push_back(path.parent_path() / fs::u8path(facePath));
+            }
+            else
+            {
+                faces.push_back(fs::u8path(facePath));
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool force = false;
+    bool clean = false;
+    Settings settings;
+    std::string directory;
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (arg == "-f")
+        {
+            force = true;
+        }
+        else if (arg == "-c")
+        {
+            clean = true;
+        }
+        else if (arg == "-m")
+        {
+            settings.mipmaps = false;
+        }
+        else if (arg == "-t" && i < argc - 1)
+        {
+            const std::string target(argv[++i]);
+            if (target == "bc")
+            {
+                settings.target = Target::BC;
+            }
+            else if (target == "etc2")
+            {
+                settings.target = Target::ETC2;
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+        else if (directory.empty())
+        {
+            directory = arg;
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (directory.empty()
+        || !fs::is_directory(directory))
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::size_t compressed = 0;
+    std::size_t skipped = 0;
+    std::size_t failed = 0;
+
+    for (const auto& entry : fs::recursive_directory_iterator(directory))
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        const auto& path = entry.path();
+        auto ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+
+        const bool isCubemap = ext == ".ccm";
+        if (!isCubemap
+            && std::find(ImageExtensions.begin(), ImageExtensions.end(), ext) == ImageExtensions.end())
+        {
+            continue;
+        }
+
+        auto outputPath = path;
+        outputPath.replace_extension(".ktx2");
+
+        if (clean)
+        {
+            std::error_code ec;
+            if (fs::remove(outputPath, ec))
+            {
+                compressed++;
+            }
+            continue;
+        }
+
+        std::vector<fs::path> sources = { path };
+        if (isCubemap
+            && !parseCubemap(path, sources))
+        {
+            failed++;
+            continue;
+        }
+
+        if (!force
+            && !isOutOfDate(sources, outputPath))
+        {
+            skipped++;
+            continue;
+        }
+
+        const bool success = isCubemap ?
+            compressCubemap({ sources.begin() + 1, sources.end() }, outputPath, settings) :
+            compressImage(path, outputPath, settings);
+
+        if (success)
+        {
+            compressed++;
+        }
+        else
+        {
+            std::cerr << "Failed compressing " << path.u8string() << "\n";
+            failed++;
+        }
+    }
+
+    if (clean)
+    {
+        std::cout << "Removed " << compressed << " compressed files\n";
+    }
+    else
+    {
+        std::cout << "Compressed " << compressed << " files, " << skipped << " up to date, " << failed << " failed\n";
+    }
+
+    return failed == 0 ? 0 : 1;
+}